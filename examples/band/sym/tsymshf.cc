@@ -0,0 +1,125 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE TSymShf.cc.
+   Example program that illustrates how to solve a real symmetric
+   tridiagonal standard eigenvalue problem in shift and invert mode
+   using the ARluSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in shift and
+      invert mode, where A is the finite difference discretization
+      of the 1-dimensional Schrodinger operator -u'' + V(x)*u on
+      [0,1], with V(x) = 100*x*x and zero Dirichlet boundary
+      conditions.
+
+   2) Data structure used to represent matrix A:
+
+      {D, E}: the n elements of the main diagonal and the n-1 elements
+      of the subdiagonal of A. A*v costs O(n), and A-sigma*I is
+      factored in O(n) by pttrf (or gttrf when it is indefinite),
+      without expanding A to band storage.
+
+   3) Library called by this example:
+
+      The LAPACK package is called by ARluSymStdEig to solve
+      some linear systems involving (A-sigma*I). This is needed to
+      implement the shift and invert strategy.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      artsmat.h        The ARtdSymMatrix class definition.
+      artssym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include <vector>
+#include "artsmat.h"
+#include "artssym.h"
+#include "lsymsol.h"
+
+
+template<class T>
+void SchrodingerMatrix(int n, std::vector<T>& D, std::vector<T>& E)
+// Diagonal and subdiagonal of the discretized -u'' + 100*x*x*u.
+{
+
+  T h  = 1.0/T(n+1);
+  T h2 = h*h;
+
+  D.resize(n);
+  E.assign(n-1, -1.0/h2);
+
+  for (int i = 0; i < n; i++) {
+    T x  = T(i+1)*h;
+    D[i] = 2.0/h2 + 100.0*x*x;
+  }
+
+} // SchrodingerMatrix.
+
+
+int main()
+{
+
+  int n   = 1000; // Dimension of the problem.
+  int nev = 4;    // Number of requested eigenvalues.
+  int ret = 0;
+
+  std::vector<double> D, E;
+
+  // Creating a 1000x1000 tridiagonal matrix.
+
+  SchrodingerMatrix(n, D, E);
+  ARtdSymMatrix<double> matrix(n, D.data(), E.data());
+
+  // Defining what we need: the four eigenvectors of A nearest to 0.0.
+  // A is positive definite, so A-0.0*I is factored by pttrf.
+
+  ARluSymStdEig<double> dprob(nev, matrix, 0.0);
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(matrix, dprob);
+
+  if (dprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+
+  // Looking for the eigenvalues nearest to 500.0, inside the spectrum.
+  // A-500.0*I is indefinite, so it is factored by gttrf.
+
+  dprob.ChangeShift(500.0);
+  dprob.FindEigenvectors();
+
+  Solution(matrix, dprob);
+
+  if (dprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+
+  // Counting the eigenvalues of A below 500.0 from the factorization
+  // of A-500.0*I (Sylvester's law of inertia).
+
+  int neg, zero, pos;
+
+  matrix.Inertia(neg, zero, pos);
+  std::cout << "Eigenvalues of A smaller than 500.0: " << neg << std::endl;
+
+  return ret;
+
+} // main
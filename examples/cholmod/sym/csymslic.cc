@@ -0,0 +1,149 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE CSymSlic.cc.
+   Example program that illustrates how to find all the eigenvalues
+   of a real symmetric generalized problem that lie in an interval
+   using the ARSliceSymGenEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = B*x*lambda for all the
+      eigenvalues lambda in [1.0e4, 1.0e6), where A and B are obtained
+      from the finite element discretization of the 1-dimensional
+      discrete Laplacian
+                                  d^2u / dx^2
+      on the interval [0,1] with zero Dirichlet boundary conditions
+      using piecewise linear elements. The interval is split into
+      slices with about 40 eigenvalues each, and the slices are solved
+      at the same time on all the available cores.
+
+   2) Data structure used to represent matrices A and B:
+
+      {nnzA, irowA, pcolA, valA}: lower triangular part of matrix A
+                                  stored in CSC format.
+      {nnzB, irowB, pcolB, valB}: lower triangular part of matrix B
+                                  stored in CSC format.
+
+   3) Library called by this example:
+
+      The CHOLMOD package is called by ARchSymPencil to factor
+      A-sigma*B, to count the eigenvalues below sigma and to solve
+      some linear systems involving (A-sigma*B).
+
+   4) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      lsmatrxc.h       SymmetricMatrixC, a function that generates
+                       matrix A in CSC format.
+      lsmatrxd.h       SymmetricMatrixD, a function that generates
+                       matrix B in CSC format.
+      arcsmat.h        The ARchSymMatrix class definition.
+      arcspen.h        The ARchSymPencil class definition.
+      arsslice.h       The ARSliceSymGenEig class definition.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "lsmatrxc.h"
+#include "lsmatrxd.h"
+#include "arcsmat.h"
+#include "arcspen.h"
+#include "arsslice.h"
+
+
+int main()
+{
+
+  int    n;              // Dimension of the problem.
+  int    nnzA,   nnzB;   // Number of nonzero elements in A and B.
+  int    *irowA, *irowB; // pointer to an array that stores the row
+                         // indices of the nonzeros in A and B.
+  int    *pcolA, *pcolB; // pointer to an array of pointers to the
+                         // beginning of each column of A (B) in valA (valB).
+  double *valA,  *valB;  // pointer to an array that stores the nonzero
+                         // elements of A and B.
+
+  // Creating matrices A and B.
+
+  n = 2000;
+  SymmetricMatrixC(n, nnzA, valA, irowA, pcolA);
+  ARchSymMatrix<double> A(n, nnzA, valA, irowA, pcolA);
+
+  SymmetricMatrixD(n, nnzB, valB, irowB, pcolB);
+  ARchSymMatrix<double> B(n, nnzB, valB, irowB, pcolB);
+
+  ARchSymPencil<double> Pencil(A, B);
+
+  // Defining what we need: all the eigenvalues in [1.0e4, 1.0e6),
+  // about 40 per slice, using all the cores.
+
+  ARSliceSymGenEig<double, ARchSymPencil<double> >
+    dprob(n, Pencil, 1.0e4, 1.0e6, 40, 0);
+
+  dprob.SetNativeBackend();
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  int nconv = dprob.ConvergedEigenvalues();
+  int nexp  = dprob.ExpectedEigenvalues();
+
+  std::cout << std::endl << "Testing ARPACK++ class ARSliceSymGenEig"
+            << std::endl << "Spectrum slicing of a real symmetric "
+            << "generalized problem" << std::endl << std::endl;
+
+  std::cout << "Dimension of the system            : " << n << std::endl;
+  std::cout << "Number of slices                   : "
+            << dprob.GetSlices() << std::endl;
+  std::cout << "Eigenvalues in [1.0e4, 1.0e6)      : " << nexp << std::endl;
+  std::cout << "Number of converged eigenvalues    : " << nconv << std::endl;
+  std::cout << std::endl;
+
+  // Printing the first and the last eigenvalues and the largest
+  // relative residual ||A*x - lambda*B*x||/|lambda|.
+
+  std::vector<double> Ax(n), Bx(n);
+  double              resmax = 0.0;
+
+  for (int i = 0; i < nconv; i++) {
+    double  lambda = dprob.Eigenvalue(i);
+    double* x      = const_cast<double*>(dprob.RawEigenvector(i));
+    double  res    = 0.0;
+    A.MultMv(x, &Ax[0]);
+    B.MultMv(x, &Bx[0]);
+    for (int j = 0; j < n; j++) {
+      res += (Ax[j]-lambda*Bx[j])*(Ax[j]-lambda*Bx[j]);
+    }
+    res = std::sqrt(res)/std::abs(lambda);
+    if (res > resmax) resmax = res;
+    if ((i < 4) || (i >= nconv-4)) {
+      std::cout << "lambda[" << (i+1) << "]: " << lambda << std::endl;
+    }
+    else if (i == 4) {
+      std::cout << "..." << std::endl;
+    }
+  }
+
+  std::cout << std::endl << "Largest relative residual          : "
+            << resmax << std::endl << std::endl;
+
+  return nconv < nexp ? EXIT_FAILURE : EXIT_SUCCESS;
+} // main.
+
@@ -0,0 +1,134 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE CSymUpd.cc.
+   Example program that illustrates how to solve a sequence of real
+   symmetric standard eigenvalue problems with the same sparsity
+   pattern in shift and invert mode using the ARluSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A(t)*x = x*lambda in shift and
+      invert mode for t = 0, 1, ..., 4, where A(t) = A + t*D, A is
+      derived from the central difference discretization of the
+      one-dimensional Laplacian on [0, 1] with zero Dirichlet
+      boundary conditions and D is a diagonal potential.
+      At each step only the values of A(t) change, so UpdateValues
+      redoes the numeric factorization of A(t)-sigma*I only, and
+      RestartFromEigenvectors starts the Arnoldi process from the
+      eigenvectors of the previous step.
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, irow, pcol, A}: lower triangular part of matrix A
+                            stored in CSC format.
+
+   3) Library called by this example:
+
+      The CHOLMOD package is called by ARluSymStdEig to solve
+      some linear systems involving (A-sigma*I). This is needed to
+      implement the shift and invert strategy.
+
+   4) Included header files:
+
+      File             Contents
+      -----------      --------------------------------------------
+      lsmatrxb.h       SymmetricMatrixB, a function that generates
+                       matrix A in CSC format.
+      arcsmat.h        The ARchSymMatrix class definition.
+      arcssym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+
+   5) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include <vector>
+#include "lsmatrxb.h"
+#include "arcsmat.h"
+#include "arcssym.h"
+#include "lsymsol.h"
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     n;          // Dimension of the problem.
+  int     nnz;        // Number of nonzero elements in A.
+  int*    irow;       // pointer to an array that stores the row
+                      // indices of the nonzeros in A.
+  int*    pcol;       // pointer to an array of pointers to the
+                      // beginning of each column of A in vector A.
+  double* A;          // pointer to an array that stores the
+                      // nonzero elements of A.
+
+  int nev = 4; // Number of requested eigenvalues.
+  int ret = EXIT_SUCCESS;
+
+  // Creating a 100x100 matrix.
+
+  n = 100;
+  SymmetricMatrixB(n, nnz, A, irow, pcol);
+  ARchSymMatrix<double> matrix(n, nnz, A, irow, pcol);
+
+  // Keeping the values of A(0).
+
+  std::vector<double> A0(A, A+nnz);
+  std::vector<double> At(nnz);
+
+  // Defining what we need: the four eigenvectors of A nearest to 1.0.
+
+  ARluSymStdEig<double> dprob(nev, matrix, 1.0);
+
+  for (int t = 0; t < 5; t++) {
+
+    if (t > 0) {
+
+      // Adding t*D to the diagonal of A (the first entry of each
+      // column). A(t)-1.0*I is factored again, with the same analysis.
+
+      At = A0;
+      for (int j = 0; j < n; j++) {
+        double x = double(j+1)/double(n+1);
+        At[pcol[j]] += t*1000.0*x*x;
+      }
+      matrix.UpdateValues(At.data());
+
+      // Starting from the eigenvectors of A(t-1).
+
+      dprob.RestartFromEigenvectors();
+
+    }
+
+    // Finding eigenvalues and eigenvectors.
+
+    dprob.FindEigenvectors();
+
+    // Printing solution.
+
+    std::cout << "t = " << t << ", " << dprob.GetIter()
+              << " Arnoldi iterations" << std::endl;
+    Solution(matrix, dprob);
+
+    if (dprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+
+  }
+
+  delete[] A;
+  delete[] irow;
+  delete[] pcol;
+
+  return ret;
+
+} // main
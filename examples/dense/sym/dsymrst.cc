@@ -0,0 +1,143 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE DSymRst.cc.
+   Example program that illustrates how to solve a sequence of
+   real symmetric dense standard eigenvalue problems, starting
+   each one from the eigenvectors of the previous one with the
+   ARluSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A(t)*x = x*lambda in regular
+      mode for t = 0, 1, ..., 4, where A(0) is the one dimensional
+      discrete Laplacian on the interval [0,1] with zero Dirichlet
+      boundary conditions and A(t) = A(0) + t*D, D being a small
+      diagonal matrix. Each problem after the first one is restarted
+      from the eigenvectors of the previous one (RestartFromEigenvectors)
+      and the number of iterations is compared to the one needed to
+      solve the same problem from a random starting vector. Both use
+      the native thick-restart Lanczos method (SetNativeBackend) and a
+      tolerance of 1.0e-6. The starting vector built from the previous
+      eigenvectors is already accurate to about the size of D, so it
+      roughly halves the number of iterations.
+
+   2) Data structure used to represent matrix A:
+
+      The lower triangular part of A is stored, by columns, in the
+      vector A. ARdsSymMatrix keeps a pointer to A, so the values of
+      A may be changed between two calls to FindEigenvectors.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      dsmatrxb.h       DenseMatrixB, a function that generates
+                       matrix A(0).
+      ardsmat.h        The ARdsSymMatrix class definition.
+      ardssym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include <vector>
+#include "dsmatrxb.h"
+#include "ardsmat.h"
+#include "ardssym.h"
+#include "lsymsol.h"
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     n;   // Dimension of the problem.
+  double* A;   // Pointer to an array that stores the lower triangular
+               // elements of A.
+
+  int nev   = 6; // Number of requested eigenvalues.
+  int warm  = 0; // Iterations needed from the previous eigenvectors.
+  int cold  = 0; // Iterations needed from random starting vectors.
+  int ret   = EXIT_SUCCESS;
+
+  // Creating a 100x100 matrix.
+
+  n = 100;
+  DenseMatrixB(n, A);
+  ARdsSymMatrix<double> matrix(n, A);
+
+  // Keeping the values of A(0).
+
+  std::vector<double> A0(A, A+(n*n+n)/2);
+
+  // Defining what we need: the six eigenvectors of A with largest magnitude,
+  // computed with a relative accuracy of 1.0e-6.
+
+  ARluSymStdEig<double> dprob(nev, matrix, "LM", 0, 1.0e-6);
+  dprob.SetNativeBackend();
+
+  for (int t = 0; t < 5; t++) {
+
+    if (t > 0) {
+
+      // Adding t*D to the diagonal of A (the first entry of each column).
+
+      for (int j = 0, k = 0; j < n; k += n-(j++)) {
+        double x = double(j+1)/double(n+1);
+        A[k] = A0[k] + 0.001*t*x*x;
+      }
+
+      // Starting from the eigenvectors of A(t-1).
+
+      dprob.RestartFromEigenvectors();
+
+    }
+
+    // Finding eigenvalues and eigenvectors.
+
+    dprob.FindEigenvectors();
+
+    // Solving the same problem from a random vector.
+
+    ARluSymStdEig<double> rprob(nev, matrix, "LM", 0, 1.0e-6);
+    rprob.SetNativeBackend();
+    rprob.FindEigenvectors();
+
+    // Printing solution.
+
+    std::cout << "t = " << t << ", " << dprob.GetIter()
+              << " Lanczos iterations (" << rprob.GetIter()
+              << " from a random vector)" << std::endl;
+    Solution(matrix, dprob);
+
+    if (dprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+
+    if (t > 0) {
+      warm += dprob.GetIter();
+      cold += rprob.GetIter();
+    }
+
+  }
+
+  // The previous eigenvectors must save some work.
+
+  if (warm >= cold) ret = EXIT_FAILURE;
+
+  delete[] A;
+
+  return ret;
+
+} // main.
+
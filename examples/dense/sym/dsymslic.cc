@@ -0,0 +1,148 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE DSymSlic.cc.
+   Example program that illustrates how to find all the eigenvalues
+   of a real symmetric generalized problem that lie in an interval,
+   when some of them are multiple, using the ARSliceSymGenEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = B*x*lambda for all the
+      eigenvalues lambda in [1.0, 100.0), where A and B are made of
+      nb uncoupled copies of the matrices obtained from the finite
+      element discretization of the 1-dimensional discrete Laplacian
+                                  d^2u / dx^2
+      on the interval [0,1] with zero Dirichlet boundary conditions
+      using piecewise linear elements. Each eigenvalue of A*x = B*x*lambda
+      has multiplicity nb, so the slices cannot be chosen to separate
+      its copies, and a slice must find all of them.
+
+   2) Data structure used to represent matrices A and B:
+
+      The lower triangular parts of A and B are stored, by columns,
+      in the vectors A and B.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      dsmatrxb.h       DenseMatrixB, a function that generates one
+                       copy of matrix A.
+      dsmatrxc.h       DenseMatrixC, a function that generates one
+                       copy of matrix B.
+      ardsmat.h        The ARdsSymMatrix class definition.
+      ardspen.h        The ARdsSymPencil class definition.
+      arsslice.h       The ARSliceSymGenEig class definition.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <iostream>
+#include <vector>
+#include "dsmatrxb.h"
+#include "dsmatrxc.h"
+#include "ardsmat.h"
+#include "ardspen.h"
+#include "arsslice.h"
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     m  = 20;  // Dimension of each copy.
+  int     nb = 20;  // Number of copies.
+  int     n  = m*nb; // Dimension of the problem.
+  double* Ab;       // Lower triangular part of one copy of A.
+  double* Bb;       // Lower triangular part of one copy of B.
+
+  // Creating one copy of A and B.
+
+  DenseMatrixB(m, Ab);
+  DenseMatrixC(m, Bb);
+
+  // Creating matrices A and B, with nb copies of Ab and Bb on the
+  // diagonal. Only the diagonal and the subdiagonal of Ab and Bb are
+  // defined. Element (i,j) of the lower triangle of an n x n matrix
+  // is stored in position j*n-j*(j-1)/2+(i-j).
+
+  std::vector<double> valA((n*n+n)/2, 0.0), valB((n*n+n)/2, 0.0);
+
+  for (int b = 0; b < nb; b++) {
+    for (int q = 0, k = 0; q < m; k += m-(q++)) {
+      int j = b*m+q;
+      valA[j*n-j*(j-1)/2] = Ab[k];
+      valB[j*n-j*(j-1)/2] = Bb[k];
+      if (q < m-1) {
+        valA[j*n-j*(j-1)/2+1] = Ab[k+1];
+        valB[j*n-j*(j-1)/2+1] = Bb[k+1];
+      }
+    }
+  }
+
+  ARdsSymMatrix<double> A(n, &valA[0]);
+  ARdsSymMatrix<double> B(n, &valB[0]);
+
+  ARdsSymPencil<double> Pencil(A, B);
+
+  // Defining what we need: all the eigenvalues in [1.0, 100.0),
+  // about 5 per slice (fewer than the copies of each eigenvalue),
+  // using all the cores.
+
+  ARSliceSymGenEig<double, ARdsSymPencil<double> >
+    dprob(n, Pencil, 1.0, 100.0, 5, 0);
+
+  dprob.SetNativeBackend();
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  int nconv = dprob.ConvergedEigenvalues();
+  int nexp  = dprob.ExpectedEigenvalues();
+
+  std::cout << std::endl << "Testing ARPACK++ class ARSliceSymGenEig"
+            << std::endl << "Spectrum slicing of a real symmetric "
+            << "generalized problem" << std::endl
+            << "with multiple eigenvalues" << std::endl << std::endl;
+
+  std::cout << "Dimension of the system            : " << n << std::endl;
+  std::cout << "Multiplicity of the eigenvalues    : " << nb << std::endl;
+  std::cout << "Number of slices                   : "
+            << dprob.GetSlices() << std::endl;
+  std::cout << "Eigenvalues in [1.0, 100.0)        : " << nexp << std::endl;
+  std::cout << "Number of converged eigenvalues    : " << nconv << std::endl;
+  std::cout << std::endl;
+
+  // Printing each distinct eigenvalue and the number of copies found.
+
+  for (int i = 0; i < nconv; ) {
+    int j = i+1;
+    while ((j < nconv) &&
+           (dprob.Eigenvalue(j)-dprob.Eigenvalue(i) <
+            1.0e-8*dprob.Eigenvalue(i))) j++;
+    std::cout << "lambda = " << dprob.Eigenvalue(i) << ", found "
+              << (j-i) << " times" << std::endl;
+    i = j;
+  }
+  std::cout << std::endl;
+
+  delete[] Ab;
+  delete[] Bb;
+
+  return nconv != nexp ? EXIT_FAILURE : EXIT_SUCCESS;
+} // main.
+
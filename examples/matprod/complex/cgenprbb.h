@@ -32,7 +32,7 @@ class ComplexGenProblemB {
  private:
 
   int          n, decsize;
-  int          *ipiv;
+  ARint        *ipiv;
   arcomplex<T> rho;
   arcomplex<T> shift;
   arcomplex<T> *Ad, *Adl, *Adu, *Adu2;
@@ -83,7 +83,8 @@ template<class T>
 void ComplexGenProblemB<T>::FactorOP()
 {
 
-  int          j, ierr;
+  int          j;
+  ARint        ierr;
   arcomplex<T> h, s, s1, s2, s3;
 
   const arcomplex<T> one(1.0, 0.0);
@@ -97,7 +98,7 @@ void ComplexGenProblemB<T>::FactorOP()
     Adl  = new arcomplex<T>[n];
     Adu  = new arcomplex<T>[n];
     Adu2 = new arcomplex<T>[n];
-    ipiv = new int[n];
+    ipiv = new ARint[n];
   }
 
   h  = one/arcomplex<T>((n+1),0.0);
@@ -122,7 +123,7 @@ template<class T>
 void ComplexGenProblemB<T>::MultOPv(arcomplex<T>* v, arcomplex<T>* w)
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   copy(n, v, 1, w, 1);
@@ -33,7 +33,7 @@ class CompMatrixB: public MatrixWithProduct<arcomplex<T> > {
   arcomplex<T> rho;
   arcomplex<T> shift;
   arcomplex<T> *Ad, *Adl, *Adu, *Adu2;
-  int          *ipiv;
+  ARint        *ipiv;
   int          decsize;
 
   void FactorDataDeallocate();
@@ -80,7 +80,8 @@ void CompMatrixB<T>::FactorOP()
 
 {
 
-  int          j, ierr;
+  int          j;
+  ARint        ierr;
   arcomplex<T> h, h2, s, s1, s2, s3;
 
   const arcomplex<T> one(1.0, 0.0);
@@ -93,7 +94,7 @@ void CompMatrixB<T>::FactorOP()
     Adl  = new arcomplex<T>[this->ncols()];
     Adu  = new arcomplex<T>[this->ncols()];
     Adu2 = new arcomplex<T>[this->ncols()];
-    ipiv = new int[this->ncols()];
+    ipiv = new ARint[this->ncols()];
   }
 
   h  = one/arcomplex<T>((this->ncols()+1),0.0);
@@ -153,7 +154,7 @@ void CompMatrixB<T>::MultOPv(arcomplex<T>* v, arcomplex<T>* w)
 
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   copy(this->ncols(), v, 1, w, 1);
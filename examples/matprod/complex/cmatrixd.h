@@ -29,7 +29,7 @@ class ComplexMatrixD: public MatrixWithProduct<arcomplex<T> > {
  private:
 
   arcomplex<T> *Ad, *Adl, *Adu, *Adu2;
-  int          *ipiv;
+  ARint        *ipiv;
   int          decsize;
 
   void FactorDataDeallocate();
@@ -75,7 +75,8 @@ template<class T>
 void ComplexMatrixD<T>::FactorM()
 {
 
-  int          j, ierr;
+  int          j;
+  ARint        ierr;
   arcomplex<T> h;
 
   const arcomplex<T> one(1.0, 0.0);
@@ -88,7 +89,7 @@ void ComplexMatrixD<T>::FactorM()
     Adl  = new arcomplex<T>[decsize];
     Adu  = new arcomplex<T>[decsize];
     Adu2 = new arcomplex<T>[decsize];
-    ipiv = new int[decsize];
+    ipiv = new ARint[decsize];
   }
 
   h  = one/arcomplex<T>((this->ncols()+1),0.0);
@@ -131,7 +132,7 @@ template<class T>
 inline void ComplexMatrixD<T>::SolveM(arcomplex<T> *v)
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   gttrs(type, this->ncols(), 1, Adl, Ad, Adu, Adu2, ipiv, v, this->ncols(), ierr);
@@ -30,7 +30,7 @@ class NonSymGenProblemB {
  private:
 
   int  n, decsize;
-  int  *ipiv;
+  ARint *ipiv;
   T    rho;
   T    shiftR, shiftI;
   T    *Ad, *Adl, *Adu, *Adu2;
@@ -85,7 +85,8 @@ template<class T>
 void NonSymGenProblemB<T>::FactorOP()
 {
 
-  int  j, ierr;
+  int  j;
+  ARint ierr;
   T    h, s, s1, s2, s3;
 
   const T one = 1.0;
@@ -98,7 +99,7 @@ void NonSymGenProblemB<T>::FactorOP()
     Adl  = new T[n];
     Adu  = new T[n];
     Adu2 = new T[n];
-    ipiv = new int[n];
+    ipiv = new ARint[n];
   }
 
   h  = one/T(n+1);
@@ -123,7 +124,7 @@ template<class T>
 void NonSymGenProblemB<T>::MultOPv(T* v, T* w)
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   copy(n, v, 1, w, 1);
@@ -31,7 +31,7 @@ class NonSymGenProblemC {
  private:
 
   int          n, decsize;
-  int          *ipiv;
+  ARint        *ipiv;
   T            shiftR, shiftI;
   arcomplex<T> *Ad, *Adl, *Adu, *Adu2, *ctemp;
 
@@ -87,7 +87,8 @@ template<class T>
 void NonSymGenProblemC<T>::FactorOP()
 {
 
-  int          j, ierr;
+  int          j;
+  ARint        ierr;
 
   arcomplex<T> c1(-2.0-shiftR, -shiftI);
   arcomplex<T> c2( 2.0-4.0*shiftR, -4.0*shiftI);
@@ -101,7 +102,7 @@ void NonSymGenProblemC<T>::FactorOP()
     Adu   = new arcomplex<T>[n];
     Adu2  = new arcomplex<T>[n];
     ctemp = new arcomplex<T>[n];
-    ipiv  = new int[n];
+    ipiv  = new ARint[n];
   }
 
   for (j=0; j<n-1; j++) {
@@ -120,7 +121,8 @@ template<class T>
 void NonSymGenProblemC<T>::MultOPvRe(T* v, T* w)
 {
 
-  int   i, ierr;
+  int   i;
+  ARint ierr;
   const char* type = "N";
 
   for (i=0; i<n; i++) {
@@ -138,7 +140,8 @@ template<class T>
 void NonSymGenProblemC<T>::MultOPvIm(T* v, T* w)
 {
 
-  int   i, ierr;
+  int   i;
+  ARint ierr;
   const char* type = "N";
 
   for (i=0; i<n; i++) {
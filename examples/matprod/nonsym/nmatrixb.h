@@ -32,7 +32,7 @@ class NonSymMatrixB: public MatrixWithProduct<T> {
   T    rho;
   T    shift;
   T    *Ad, *Adl, *Adu, *Adu2;
-  int  *ipiv;
+  ARint *ipiv;
   int  decsize;
 
   void FactorDataDeallocate();
@@ -77,7 +77,8 @@ void NonSymMatrixB<T>::FactorOP()
 
 {
 
-  int  j, ierr;
+  int  j;
+  ARint ierr;
   T    h, s, s1, s2, s3;
 
   const T one = 1.0;
@@ -90,7 +91,7 @@ void NonSymMatrixB<T>::FactorOP()
     Adl  = new T[this->ncols()];
     Adu  = new T[this->ncols()];
     Adu2 = new T[this->ncols()];
-    ipiv = new int[this->ncols()];
+    ipiv = new ARint[this->ncols()];
   }
 
   h  = one/T(this->ncols()+1);
@@ -150,7 +151,7 @@ void NonSymMatrixB<T>::MultOPv(T* v, T* w)
 
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   copy(this->ncols(), v, 1, w, 1);
@@ -71,7 +71,8 @@ void NonSymMatrixD<T>::FactorM()
 
 {
 
-  int  i, ierr;
+  int  i;
+  ARint ierr;
   T    h;
 
   const T one  = 1.0;
@@ -123,7 +124,7 @@ template<class T>
 inline void NonSymMatrixD<T>::SolveM(T* v)
 {
 
-  int  ierr;
+  ARint ierr;
 
   pttrs(this->ncols(), 1, Md, Me, v, this->ncols(), ierr);
 
@@ -31,7 +31,7 @@ class SymGenProblemB {
  private:
 
   int  n, decsize;
-  int  *ipiv;
+  ARint *ipiv;
   ART  shift;
   ART  *Ad, *Adl, *Adu, *Adu2;
 
@@ -85,7 +85,8 @@ template<class ART>
 void SymGenProblemB<ART>::FactorOP()
 {
 
-  int  i, ierr;
+  int  i;
+  ARint ierr;
   ART  h, r1, r2;
 
   const ART one  = 1.0;
@@ -100,7 +101,7 @@ void SymGenProblemB<ART>::FactorOP()
     Adl  = new ART[n];
     Adu  = new ART[n];
     Adu2 = new ART[n];
-    ipiv = new int[n];
+    ipiv = new ARint[n];
   }
 
   h  = one/ART(n+1);
@@ -122,7 +123,7 @@ template<class ART>
 void SymGenProblemB<ART>::MultOPv(ART* v, ART* w)
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   copy(n, v, 1, w, 1);
@@ -29,7 +29,7 @@ class SymMatrixB: public MatrixWithProduct<ART> {
 
   ART  shift;
   ART  *Ad, *Adl, *Adu, *Adu2;
-  int  *ipiv;
+  ARint *ipiv;
   int  decsize;
 
   void FactorDataDeallocate();
@@ -74,7 +74,8 @@ void SymMatrixB<ART>::FactorOP()
 
 {
 
-  int  i, ierr;
+  int  i;
+  ARint ierr;
   ART  h2;
 
   const ART one = 1.0;
@@ -87,7 +88,7 @@ void SymMatrixB<ART>::FactorOP()
     Adl  = new ART[this->ncols()];
     Adu  = new ART[this->ncols()];
     Adu2 = new ART[this->ncols()];
-    ipiv = new int[this->ncols()];
+    ipiv = new ARint[this->ncols()];
   }
 
   h2 = ART((this->ncols()+1)*(this->ncols()+1));
@@ -140,7 +141,7 @@ void SymMatrixB<ART>::MultOPv(ART* v, ART* w)
 
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   copy(this->ncols(), v, 1, w, 1);
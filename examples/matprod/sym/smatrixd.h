@@ -28,7 +28,7 @@ class SymMatrixD: public MatrixWithProduct<ART> {
  private:
 
   ART  *Ad, *Adl, *Adu, *Adu2;
-  int  *ipiv;
+  ARint *ipiv;
   int  decsize;
 
   void FactorDataDeallocate();
@@ -69,7 +69,8 @@ void SymMatrixD<ART>::FactorM()
 
 {
 
-  int  i, ierr;
+  int  i;
+  ARint ierr;
   ART  h, r1, r2;
 
   const ART one  = 1.0;
@@ -83,7 +84,7 @@ void SymMatrixD<ART>::FactorM()
     Adl  = new ART[this->ncols()];
     Adu  = new ART[this->ncols()];
     Adu2 = new ART[this->ncols()];
-    ipiv = new int[this->ncols()];
+    ipiv = new ARint[this->ncols()];
   }
 
   h  = one/ART(this->ncols()+1);
@@ -107,7 +108,7 @@ inline void SymMatrixD<ART>::SolveM(ART* v)
 
 {
 
-  int  ierr;
+  ARint ierr;
   const char *type = "N";
 
   gttrs(type, this->ncols(), 1, Adl, Ad, Adu, Adu2, ipiv, v, this->ncols(), ierr);
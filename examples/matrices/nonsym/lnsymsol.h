@@ -30,6 +30,8 @@
 #elif defined ARDNSMAT_H
 #include "ardsnsym.h"
 #include "ardgnsym.h"
+#elif defined ARTNSMAT_H
+#include "artsnsym.h"
 #else
 #include "arbsnsym.h"
 #include "arbgnsym.h"
@@ -135,6 +137,8 @@ void Solution(ARMATRIX &A, ARluNonSymStdEig<ARFLOAT> &Prob)
 } // Solution
 
 
+#ifndef ARTNSMAT_H // There are no tridiagonal pencils.
+
 template<class MATRA, class MATRB, class ARFLOAT>
 void Solution(MATRA &A, MATRB &B, ARluNonSymGenEig<ARFLOAT> &Prob)
 /*
@@ -247,5 +251,7 @@ void Solution(MATRA &A, MATRB &B, ARluNonSymGenEig<ARFLOAT> &Prob)
 } // Solution
 
 
+#endif // ARTNSMAT_H
+
 #endif // LNSYMSOL_H
 
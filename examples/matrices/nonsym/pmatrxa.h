@@ -0,0 +1,86 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE PMatrxA.h
+   Function template for rows first to last-1 of the matrix
+
+                          | T -I          |
+                          |-I  T -I       |
+                      A = |   -I  T       |
+                          |        ...  -I|
+                          |           -I T|
+
+   derived from the standard central difference discretization of the
+   2-dimensional convection-diffusion operator
+                     (Laplacian u) + rho*(du/dx)
+   on the unit square with zero Dirichlet boundary conditions (the
+   Laplacian alone if rho = 0). The rows are stored in compressed row
+   storage (prow, jcol, A) with global column indices, as required by
+   the ARParMatrix class.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PMATRXA_H
+#define PMATRXA_H
+
+template<class ARFLOAT, class ARINT>
+void ParMatrixA(ARINT nx, ARFLOAT rho, ARINT first, ARINT last, ARINT& nnz,
+                ARFLOAT* &A, ARINT* &jcol, ARINT* &prow)
+
+{
+
+  // Defining internal variables.
+
+  ARINT    i, k, n;
+  ARFLOAT  h, h2, dd, dl, du, dv;
+
+  // Defining constants.
+
+  n   = nx*nx;
+  h   = 1.0/ARFLOAT(nx+1);
+  h2  = h*h;
+  dd  = 4.0/h2;
+  dv  = -1.0/h2;
+  dl  = -1.0/h2-rho/(2.0*h);
+  du  = -1.0/h2+rho/(2.0*h);
+
+  // Creating output vectors (at most five elements per row).
+
+  A    = new ARFLOAT[5*(last-first)];
+  jcol = new ARINT[5*(last-first)];
+  prow = new ARINT[last-first+1];
+
+  // Defining rows first to last-1 of A.
+
+  prow[0] = 0;
+  k       = 0;
+
+  for (i = first; i < last; i++) {
+    if (i >= nx) {
+      A[k] = dv;   jcol[k++] = i-nx;
+    }
+    if ((i%nx) != 0) {
+      A[k] = dl;   jcol[k++] = i-1;
+    }
+    A[k] = dd;     jcol[k++] = i;
+    if (((i+1)%nx) != 0) {
+      A[k] = du;   jcol[k++] = i+1;
+    }
+    if (i < n-nx) {
+      A[k] = dv;   jcol[k++] = i+nx;
+    }
+    prow[i-first+1] = k;
+  }
+  nnz = k;
+
+} // ParMatrixA.
+
+#endif // PMATRXA_H
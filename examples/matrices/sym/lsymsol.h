@@ -33,6 +33,8 @@
 #elif defined ARCSMAT_H
 #include "arcssym.h"
 #include "arcgsym.h"
+#elif defined ARTSMAT_H
+#include "artssym.h"
 #else
 #include "arbssym.h"
 #include "arbgsym.h"
@@ -113,6 +115,8 @@ void Solution(ARMATRIX &A, ARluSymStdEig<ARFLOAT> &Prob)
 } // Solution
 
 
+#ifndef ARTSMAT_H // There are no tridiagonal pencils.
+
 template<class MATRA, class MATRB, class ARFLOAT>
 void Solution(MATRA &A, MATRB &B, ARluSymGenEig<ARFLOAT> &Prob)
 /*
@@ -196,5 +200,7 @@ void Solution(MATRA &A, MATRB &B, ARluSymGenEig<ARFLOAT> &Prob)
 } // Solution
 
 
+#endif // ARTSMAT_H
+
 #endif // LSYMSOL_H
 
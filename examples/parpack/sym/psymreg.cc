@@ -0,0 +1,168 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE PSymReg.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem distributed among several MPI
+   processes using the ARParSymStdEig class (PARPACK).
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode,
+      where A is derived from the central difference discretization
+      of the 2-dimensional Laplacian on the unit square [0,1]x[0,1]
+      with zero Dirichlet boundary conditions.
+
+   2) Data distribution:
+
+      Each process stores a contiguous range of rows of A and of all
+      vectors. Matrix A is stored in an ARParMatrix object, whose
+      MultMv function receives the local rows of v, exchanges with the
+      neighbouring processes the elements of v it needs, and returns
+      the local rows of w = A*v.
+
+   3) The reverse communication interface:
+
+      As in the examples of the reverse directory, a sequence of calls
+      to TakeStep, combined with matrix-vector products, is used to
+      find an Arnoldi basis. GetVector and PutVector point to the local
+      rows of the vectors. All processes must call TakeStep, MultMv and
+      FindEigenvectors the same number of times.
+
+   4) Running the example:
+
+      mpirun -np 4 psymreg
+
+   5) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      pmatrxa.h        The ParMatrixA function (local rows of A).
+      arpmat.h         The ARParMatrix class definition.
+      arpssym.h        The ARParSymStdEig class definition.
+
+   6) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <mpi.h>
+#include "pmatrxa.h"
+#include "arpmat.h"
+#include "arpssym.h"
+
+
+int main(int argc, char* argv[])
+{
+
+  MPI_Init(&argc, &argv);
+
+  int nx  = 20; // n = 20*20 is the dimension of the problem.
+  int nev = 4;  // Number of requested eigenvalues.
+  int rank, nprocs, nconv;
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+
+  // Defining the rows stored by this process.
+
+  ARindex n     = nx*nx;
+  ARindex first = (n*rank)/nprocs;
+  ARindex last  = (n*(rank+1))/nprocs;
+
+  {
+    // Creating the local rows of A.
+
+    ARindex  nnz;
+    double*  valA;
+    ARindex* jcol;
+    ARindex* prow;
+
+    ParMatrixA((ARindex)nx, 0.0, first, last, nnz, valA, jcol, prow);
+    ARParMatrix<double> A(MPI_COMM_WORLD, first, last, prow, jcol, valA);
+    delete[] valA;
+    delete[] jcol;
+    delete[] prow;
+
+    // Creating a distributed eigenvalue problem and defining what we
+    // need: the four eigenvectors of A with smallest magnitude.
+
+    ARParSymStdEig<double> prob(MPI_COMM_WORLD, first, last, nev, "SM", 20);
+
+    // Finding an Arnoldi basis.
+
+    while (!prob.ArnoldiBasisFound()) {
+
+      prob.TakeStep();
+
+      if ((prob.GetIdo() == 1)||(prob.GetIdo() == -1)) {
+
+        // Performing the matrix-vector product on the local rows.
+
+        A.MultMv(prob.GetVector(), prob.PutVector());
+
+      }
+
+    }
+
+    // Finding eigenvalues and eigenvectors.
+
+    prob.FindEigenvectors();
+    nconv = prob.ConvergedEigenvalues();
+
+    // Computing the residual norms ||A*x - lambda*x|| of the whole
+    // eigenvectors (each process adds the squares of its rows).
+
+    std::vector<double> Ax(last-first);
+    std::vector<double> res(nconv);
+
+    for (int i=0; i<nconv; i++) {
+      double* x = prob.RawEigenvector(i);
+      A.MultMv(x, &Ax[0]);
+      res[i] = 0.0;
+      for (ARindex j=0; j<last-first; j++) {
+        double r = Ax[j]-prob.Eigenvalue(i)*x[j];
+        res[i] += r*r;
+      }
+    }
+    if (nconv > 0) {
+      MPI_Allreduce(MPI_IN_PLACE, &res[0], nconv, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+    }
+
+    // Printing the solution.
+
+    if (rank == 0) {
+      std::cout << std::endl << "Testing ARPACK++ class ARParSymStdEig" << std::endl;
+      std::cout << "Real symmetric eigenvalue problem: A*x - lambda*x" << std::endl;
+      std::cout << "Number of processes                : " << nprocs           << std::endl;
+      std::cout << "Dimension of the system            : " << prob.GetGlobalN() << std::endl;
+      std::cout << "Number of 'requested' eigenvalues  : " << prob.GetNev()    << std::endl;
+      std::cout << "Number of 'converged' eigenvalues  : " << nconv            << std::endl;
+      std::cout << "Number of Arnoldi vectors generated: " << prob.GetNcv()    << std::endl;
+      std::cout << "Number of iterations taken         : " << prob.GetIter()   << std::endl;
+      std::cout << std::endl << "Eigenvalues and residual norms:" << std::endl;
+      for (int i=0; i<nconv; i++) {
+        std::cout << "  lambda[" << (i+1) << "]: " << prob.Eigenvalue(i)
+                  << "   ||A*x(" << (i+1) << ") - lambda(" << (i+1) << ")*x("
+                  << (i+1) << ")||: " << std::sqrt(res[i]) << std::endl;
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  MPI_Finalize();
+
+  return nconv < nev ? EXIT_FAILURE : EXIT_SUCCESS;
+
+} // main.
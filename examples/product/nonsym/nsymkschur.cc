@@ -0,0 +1,98 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE NSymKSchur.cc.
+   Example program that illustrates how to solve real nonsymmetric
+   standard eigenvalue problems with the native Krylov-Schur method
+   (ARKrylovSchur) instead of FORTRAN ARPACK, using the
+   ARNonSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode
+      and B*x = x*lambda in shift and invert mode, where A is obtained
+      from the standard central difference discretization of the
+      convection-diffusion operator
+                     (Laplacian u) + rho*(du / dx)
+      on the unit square [0,1]x[0,1] and B from the 1-dimensional
+      convection-diffusion operator on [0,1], both with zero Dirichlet
+      boundary conditions. The native method keeps all its state in the
+      problem object, so the two problems are solved at the same time
+      in two threads.
+
+   2) Data structure used to represent matrices A and B:
+
+      When using ARNonSymStdEig, the user is required to provide a
+      class that contains a member function which computes the
+      the matrix-vector product w = Av (or w = OPv). In this example,
+      these classes are called NonSymMatrixA and NonSymMatrixB.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      nmatrixa.h       The NonSymMatrixA class definition.
+      nmatrixb.h       The NonSymMatrixB class definition.
+      arsnsym.h        The ARNonSymStdEig class definition.
+      nsymsol.h        The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <thread>
+#include "nmatrixa.h"
+#include "nmatrixb.h"
+#include "nsymsol.h"
+#include "arsnsym.h"
+
+
+int main()
+{
+
+  int nev = 4; // Number of requested eigenvalues.
+  int ret = 0;
+
+  // Creating the matrices.
+
+  NonSymMatrixA<double> A(10);              // n = 10*10.
+  NonSymMatrixB<double> B(100, 1.0, 10.0);  // n = 100, shift = 1, rho = 10.
+
+  // Defining what we need: the four eigenvectors of A with largest
+  // magnitude and the four eigenvectors of B nearest to 1.0.
+
+  ARNonSymStdEig<double, NonSymMatrixA<double> >
+    aprob(A.ncols(), nev, &A, &NonSymMatrixA<double>::MultMv);
+  ARNonSymStdEig<double, NonSymMatrixB<double> >
+    bprob(B.ncols(), nev, &B, &NonSymMatrixB<double>::MultOPv, 1.0);
+
+  // Using the native Krylov-Schur method.
+
+  aprob.SetNativeBackend();
+  bprob.SetNativeBackend();
+
+  // Finding eigenvalues and eigenvectors, one problem in each thread.
+
+  std::thread worker([&]() { bprob.FindEigenvectors(); });
+  aprob.FindEigenvectors();
+  worker.join();
+
+  // Printing solutions.
+
+  Solution(A, aprob);
+  Solution(B, bprob);
+
+  if (aprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+  if (bprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+
+  return ret;
+
+} // main.
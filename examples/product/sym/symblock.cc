@@ -0,0 +1,126 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymBlock.cc.
+   Example program that illustrates how to solve a real symmetric
+   standard eigenvalue problem in regular mode using the
+   ARSymStdEig class and a matrix made of dense 3x3 blocks.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode,
+      where A is the stiffness matrix of a chain of nodes with three
+      degrees of freedom each, so that A is block tridiagonal with
+      3x3 blocks.
+
+   2) Data structure used to represent matrix A:
+
+      A is stored in an ARBlockSparseMatrix<T, 3>. Only the lower
+      block triangle is given. MultMv is the function that performs
+      the product w <- A.v. To use a shift and invert mode, the
+      matrix can be written in compressed column format with
+      ConvertToCSC and passed to ARchSymMatrix or ARumSymMatrix.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      arbspmat.h       The ARBlockSparseMatrix class definition.
+      arssym.h         The ARSymStdEig class definition.
+      symsol.h         The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <cmath>
+#include <vector>
+#include "arbspmat.h"
+#include "arssym.h"
+#include "symsol.h"
+
+
+template<class T>
+void BlockChainMatrix(int nnode, std::vector<ARindex>& bp,
+                      std::vector<ARindex>& bj, std::vector<T>& bx)
+// Builds the lower block triangle of the block tridiagonal matrix
+// with diagonal blocks D and subdiagonal blocks -C (stored by columns).
+{
+
+  const T D[9] = {  6.0,  1.0,  0.0,  1.0,  6.0,  1.0,  0.0,  1.0,  6.0 };
+  const T C[9] = {  2.0,  0.0,  0.0,  0.5,  2.0,  0.0,  0.0,  0.5,  2.0 };
+
+  bp.assign(1, 0);
+  bj.clear();
+  bx.clear();
+
+  for (int i = 0; i < nnode; i++) {
+    if (i > 0) {
+      bj.push_back(i-1);
+      for (int k = 0; k < 9; k++) bx.push_back(-C[k]);
+    }
+    bj.push_back(i);
+    for (int k = 0; k < 9; k++) bx.push_back(D[k]);
+    bp.push_back((ARindex)bj.size());
+  }
+
+} // BlockChainMatrix.
+
+
+template<class T>
+int Test(T type)
+{
+  int nev = 4; // Number of requested eigenvalues.
+
+  // Creating a symmetric matrix with 100 nodes (n = 300).
+
+  std::vector<ARindex> bp, bj;
+  std::vector<T>       bx;
+
+  BlockChainMatrix(100, bp, bj, bx);
+
+  ARBlockSparseMatrix<T, 3> A(100, bp.data(), bj.data(), bx.data(), 'L');
+
+  // Defining what we need: the four eigenvectors of A with largest magnitude.
+  // A.MultMv is the function that performs the product w <- A.v.
+
+  ARSymStdEig<T, ARBlockSparseMatrix<T, 3> >
+    dprob(A.ncols(), nev, &A, &ARBlockSparseMatrix<T, 3>::MultMv);
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(A, dprob);
+
+  int nconv = dprob.ConvergedEigenvalues();
+
+  return nconv < nev ? EXIT_FAILURE : EXIT_SUCCESS;
+} // Test.
+
+
+int main()
+{
+  int ret = 0;
+
+  // Solving a double precision problem with n = 300.
+
+  ret |= Test((double)0.0);
+
+  // Solving a single precision problem with n = 300.
+
+  ret |= Test((float)0.0);
+
+  return ret;
+
+} // main.
@@ -0,0 +1,95 @@
+/*
+   ARPACK++ v1.2 2/18/2000
+   c++ interface to ARPACK code.
+
+   MODULE SymTRLan.cc.
+   Example program that illustrates how to solve real symmetric
+   standard eigenvalue problems with the native thick-restart Lanczos
+   method (ARTRLanczos) instead of FORTRAN ARPACK, using the
+   ARSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular mode
+      and B*x = x*lambda in shift and invert mode, where A is derived
+      from the central difference discretization of the 2-dimensional
+      Laplacian on the unit square and B from the 1-dimensional
+      Laplacian on [0,1], both with zero Dirichlet boundary conditions.
+      The native method keeps all its state in the problem object, so
+      the two problems are solved at the same time in two threads.
+
+   2) Data structure used to represent matrices A and B:
+
+      When using ARSymStdEig, the user is required to provide a
+      class that contains a member function which computes the
+      the matrix-vector product w = Av. In this example, these classes
+      are called SymMatrixA and SymMatrixB.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      smatrixa.h       The SymMatrixA class definition.
+      smatrixb.h       The SymMatrixB class definition.
+      arssym.h         The ARSymStdEig class definition.
+      symsol.h         The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <thread>
+#include "arssym.h"
+#include "smatrixa.h"
+#include "smatrixb.h"
+#include "symsol.h"
+
+
+int main()
+{
+
+  int nev = 4; // Number of requested eigenvalues.
+  int ret = 0;
+
+  // Creating the matrices.
+
+  SymMatrixA<double> A(10L);      // n = 10*10.
+  SymMatrixB<double> B(100, 0.0); // n = 100, shift = 0.0.
+
+  // Defining what we need: the four eigenvectors of A with smallest
+  // magnitude and the four eigenvectors of B nearest to 0.0.
+
+  ARSymStdEig<double, SymMatrixA<double> >
+    aprob(A.ncols(), nev, &A, &SymMatrixA<double>::MultMv, "SM");
+  ARSymStdEig<double, SymMatrixB<double> >
+    bprob(B.ncols(), nev, &B, &SymMatrixB<double>::MultOPv, 0.0);
+
+  // Using the native thick-restart Lanczos method.
+
+  aprob.SetNativeBackend();
+  bprob.SetNativeBackend();
+
+  // Finding eigenvalues and eigenvectors, one problem in each thread.
+
+  std::thread worker([&]() { bprob.FindEigenvectors(); });
+  aprob.FindEigenvectors();
+  worker.join();
+
+  // Printing solutions.
+
+  Solution(A, aprob);
+  Solution(B, bprob);
+
+  if (aprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+  if (bprob.ConvergedEigenvalues() < nev) ret = EXIT_FAILURE;
+
+  return ret;
+
+} // main.
@@ -0,0 +1,155 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE USymCmp.cc.
+   Example program that illustrates how to reduce the cost of the
+   matrix-vector products of a real symmetric standard eigenvalue
+   problem with CompressMultMv, using the ARluSymStdEig class.
+
+   1) Problem description:
+
+      In this example we try to solve A*x = x*lambda in regular
+      mode, where A is derived from the standard central difference
+      discretization of the 2-dimensional Laplacian on the unit
+      square with zero Dirichlet boundary conditions. MultMv uses
+      a copy of A with the values in single precision, while MultMm
+      still uses the double precision values. Before solving the
+      problem, both products are compared, also for a copy of A
+      that stores both triangles in an ARSparseMatrix.
+
+   2) Data structure used to represent matrix A:
+
+      {nnz, irow, pcol, A}: lower triangular part of matrix A
+                            stored in CSC format.
+
+   3) Included header files:
+
+      File             Contents
+      -----------      -------------------------------------------
+      lsmatrxa.h       SymmetricMatrixA, a function that generates
+                       matrix A in CSC format.
+      arusmat.h        The ARumSymMatrix class definition.
+      arussym.h        The ARluSymStdEig class definition.
+      lsymsol.h        The Solution function.
+
+   4) ARPACK Authors:
+
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "lsmatrxa.h"
+#include "arusmat.h"
+#include "arussym.h"
+#include "lsymsol.h"
+
+
+template<class MATRIX>
+bool CompareProducts(MATRIX& M, int n, double enorm)
+// Returns true if MultMm(2, ...) and MultMv differ at most by
+// enorm*||v|| (plus rounding errors) on two vectors.
+{
+
+  std::vector<double> V(2*n), W(2*n), w(n);
+
+  for (int i = 0; i < n; i++) {
+    V[i]   = std::sin(double(i+1));
+    V[n+i] = std::cos(double(i+1));
+  }
+
+  M.MultMm(2, &V[0], n, &W[0], n);
+
+  for (int r = 0; r < 2; r++) {
+    double vnorm = 0.0, wnorm = 0.0, dnorm = 0.0;
+    M.MultMv(&V[r*n], &w[0]);
+    for (int i = 0; i < n; i++) {
+      vnorm += V[r*n+i]*V[r*n+i];
+      wnorm += W[r*n+i]*W[r*n+i];
+      dnorm += (W[r*n+i]-w[i])*(W[r*n+i]-w[i]);
+    }
+    if (std::sqrt(dnorm) > enorm*std::sqrt(vnorm)+1.0e-12*std::sqrt(wnorm)) {
+      return false;
+    }
+  }
+  return true;
+
+} // CompareProducts.
+
+
+int main()
+{
+
+  // Defining variables;
+
+  int     nx;
+  int     n;          // Dimension of the problem.
+  int     nnz;        // Number of nonzero elements in A.
+  int*    irow;       // pointer to an array that stores the row
+                      // indices of the nonzeros in A.
+  int*    pcol;       // pointer to an array of pointers to the
+                      // beginning of each column of A in vector A.
+  double* A;          // pointer to an array that stores the
+                      // nonzero elements of A.
+  bool    ok = true;
+
+  int nev = 4; // Number of requested eigenvalues.
+
+  // Creating a 100x100 matrix.
+
+  nx  = 10;
+  SymmetricMatrixA(nx, n, nnz, A, irow, pcol);
+  ARumSymMatrix<double> matrix(n, nnz, A, irow, pcol);
+
+  // Compressing the stored triangle, with one and with two threads
+  // (the latter uses a compressed copy of the full matrix).
+
+  double enorm = matrix.CompressMultMv();
+
+  ok = ok && CompareProducts(matrix, n, enorm);
+  matrix.SetThreads(2);
+  ok = ok && CompareProducts(matrix, n, enorm);
+  matrix.SetThreads(1);
+
+  // Doing the same with a full copy of A stored in an ARSparseMatrix.
+
+  ARSparseMatrix<double> L(n, n, pcol, irow, A, nnz, 'L');
+  ARSparseMatrix<double> F(n, n, 2*nnz-n);
+  L.Expand(F);
+
+  ok = ok && CompareProducts(F, n, F.CompressMultMv());
+  ok = ok && CompareProducts(F, n, F.CompressMultMv(true));
+
+  std::cout << std::endl << "MultMm and MultMv products "
+            << (ok ? "agree" : "DIFFER") << std::endl;
+
+  // Defining what we need: the four eigenvectors of A with largest magnitude.
+
+  ARluSymStdEig<double> dprob(nev, matrix);
+
+  // Finding eigenvalues and eigenvectors.
+
+  dprob.FindEigenvectors();
+
+  // Printing solution.
+
+  Solution(matrix, dprob);
+
+  if (dprob.ConvergedEigenvalues() < nev) ok = false;
+
+  delete[] A;
+  delete[] irow;
+  delete[] pcol;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} // main.
+
@@ -26,6 +26,7 @@
 #include "arerror.h"
 #include "blas1c.h"
 #include "lapackc.h"
+#include "arwork.h"
 
 template<class AR_T, class AR_S> class ARbdNonSymPencil;
 
@@ -41,10 +42,11 @@ class ARbdNonSymMatrix: public ARMatrix<ARTYPE> {
   int      ndiagL;
   int      ndiagU;
   int      lda;
-  int      info;
-  int*     ipiv;
+  ARint    info;
+  ARint*   ipiv;
   ARTYPE*  A;
   ARTYPE*  Ainv;
+  ARWorkspace<ARTYPE> wgram;  // Used by MultMtMv and MultMMtv.
 
   void ClearMem(); 
 
@@ -68,6 +70,8 @@ class ARbdNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
   void MultMtMv(ARTYPE* v, ARTYPE* w);
@@ -78,6 +82,9 @@ class ARbdNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
   void DefineMatrix(int np, int ndiagLp, int ndiagUp, ARTYPE* Ap);
 
   ARbdNonSymMatrix(): ARMatrix<ARTYPE>() { factored = false; }
@@ -140,7 +147,7 @@ Copy(const ARbdNonSymMatrix<ARTYPE, ARFLOAT>& other)
   // Copying vectors.
 
   Ainv = new ARTYPE[ this->n*lda];
-  ipiv = new int[ this->n];
+  ipiv = new ARint[ this->n];
 
   copy( this->n*lda, other.Ainv, 1, Ainv, 1);
   for (int i=0; i< this->n; i++) ipiv[i] = other.ipiv[i];
@@ -185,7 +192,7 @@ inline void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::CreateStructure()
 
   ClearMem();
   Ainv = new ARTYPE[lda* this->n];
-  ipiv = new int[ this->n];
+  ipiv = new ARint[ this->n];
 
 } // CreateStructure.
 
@@ -293,6 +300,48 @@ void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  int     i, j, r, first, last;
+  ARTYPE  zero = (ARTYPE)0;
+  ARTYPE  t;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARbdNonSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V. Each band column is read once and
+  // applied to all k vectors.
+
+  for (r=0; r<k; r++) {
+    for (i=0; i<this->m; i++) W[i+(size_t)r*ldw] = zero;
+  }
+
+  for (j=0; j<this->n; j++) {
+
+    // col[i] is the entry (i,j) of A (band storage used by gbmv).
+
+    const ARTYPE* col = &A[(size_t)j*(ndiagL+ndiagU+1)+ndiagU-j];
+
+    first = (j > ndiagU) ? j-ndiagU : 0;
+    last  = (j+ndiagL < this->m-1) ? j+ndiagL : this->m-1;
+
+    for (r=0; r<k; r++) {
+      ARTYPE* w = &W[(size_t)r*ldw];
+      t = V[j+(size_t)r*ldv];
+      for (i=first; i<=last; i++) w[i] += col[i]*t;
+    }
+
+  }
+
+} // MultMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
@@ -321,13 +370,11 @@ template<class ARTYPE, class ARFLOAT>
 void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[ this->m];
+  ARTYPE* t = wgram.Get(this->m);
 
   MultMv(v,t);
   MultMtv(t,w);
 
-  delete[] t;
-
 } // MultMtMv.
 
 
@@ -335,13 +382,11 @@ template<class ARTYPE, class ARFLOAT>
 void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[ this->n];
+  ARTYPE* t = wgram.Get(this->n);
 
   MultMtv(v,t);
   MultMv(t,w);
 
-  delete[] t;
-
 } // MultMMtv.
 
 
@@ -381,6 +426,37 @@ void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                                  ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARbdNonSymMatrix::MultInvMm");
+  }
+
+  // Overwritting W with V.
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+
+  // Solving A.W = V (or AsI.W = V).
+
+  gbtrs("N", this->n, ndiagL, ndiagU, k, Ainv, lda, ipiv, W, ldw, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARbdNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, int ndiagLp, int ndiagUp, ARTYPE* Ap)
@@ -98,6 +98,7 @@ inline void ARluCompStdEig<ARFLOAT>::SetRegularMode()
   ARStdEig<ARFLOAT, arcomplex<ARFLOAT>, 
            ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT> >::
     SetRegularMode(this->objOP,&ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -111,6 +112,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -127,6 +129,7 @@ ARluCompStdEig(int nevp, ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A,
                    &ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -143,6 +146,7 @@ ARluCompStdEig(int nevp, ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
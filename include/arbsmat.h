@@ -5,6 +5,12 @@
    MODULE ARBSMat.h.
    Arpack++ class ARbdSymMatrix definition.
 
+   A - sigma*I is factored with the band Cholesky routine pbtrf, in
+   a copy of the symmetric band (nsdiag+1 rows). If it is not positive
+   definite, the band is expanded to general band storage (3*nsdiag+1
+   rows) and factored with gbtrf, since LAPACK has no symmetric
+   indefinite band factorization.
+
    ARPACK Authors
       Richard Lehoucq
       Danny Sorensen
@@ -20,10 +26,13 @@
 #ifndef ARBSMAT_H
 #define ARBSMAT_H
 
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include "arch.h"
 #include "armat.h"
 #include "arerror.h"
+#include "arwork.h"
 #include "blas1c.h"
 #include "lapackc.h"
 
@@ -38,22 +47,52 @@ class ARbdSymMatrix: public ARMatrix<ARTYPE> {
 
   bool     factored;
   char     uplo;
+  char     factor;      // 'C' (pbtrf) or 'G' (gbtrf).
   int      nsdiag;
   int      lda;
-  int      info;
-  int*     ipiv;
+  ARint    info;
+  ARint*   ipiv;
   ARTYPE*  A;
   ARTYPE*  Ainv;
 
+  // A - sigma*I is not positive definite for sigma >= indefShift, so
+  // pbtrf is not tried for those shifts.
+  bool     indefKnown;
+  ARTYPE   indefShift;
+
+  ARTYPE   shift;       // Shift of the current factorization.
+
+  ARWorkspace<ARTYPE> work;  // Band used by Inertia.
+
   void ClearMem(); 
 
   virtual void Copy(const ARbdSymMatrix& other);
 
+  void StoreBand(ARTYPE alpha, ARTYPE* dst, int kd, char uplod, bool add);
+  // Sets the symmetric band dst (kd >= nsdiag superdiagonals or
+  // subdiagonals, leading dimension kd+1, uplod triangle) to alpha*A,
+  // or adds alpha*A to it if add is true.
+
   void ExpandA();
 
   void SubtractAsI(ARTYPE sigma);
 
-  void CreateStructure();
+  void CreateStructure(bool chol = false);
+
+  template<class FILL>
+  void Factor(ARTYPE sigma, FILL fill);
+  // Factors the matrix written to Ainv by fill(chol), which is
+  // A - sigma*I (or A - sigma*B for ARbdSymPencil) in symmetric band
+  // storage if chol is true and in general band storage otherwise.
+
+  void Solve(int k, ARTYPE* W, int ldw);
+  // Overwrites the k columns of W with the solution of Ainv*X = W.
+
+  template<class FILL>
+  void BandInertia(FILL fill, int& neg, int& zero, int& pos);
+  // Inertia of the symmetric band written by fill(band) to a work
+  // array (lower triangle, nsdiag subdiagonals, leading dimension
+  // nsdiag+1), from an L*D*L' factorization without pivoting.
 
   void ThrowError();
   
@@ -61,17 +100,43 @@ class ARbdSymMatrix: public ARMatrix<ARTYPE> {
 
   bool IsFactored() { return factored; }
 
+  char Factorization() { return factor; }
+  // 'C' (band Cholesky) or 'G' (general band LU).
+
   void FactorA();
 
   void FactorAsI(ARTYPE sigma);
 
+  void Inertia(int& neg, int& zero, int& pos);
+  // Number of negative, zero and positive eigenvalues of the factored
+  // matrix (A or A - sigma*I). It is known from pbtrf when A - sigma*I
+  // is positive definite. Otherwise, since the LU factors of gbtrf do
+  // not give it, an L*D*L' factorization without pivoting of the band
+  // is computed (O(n*nsdiag^2) operations, n*(nsdiag+1) entries).
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Factors A - sigma*I and returns the number of eigenvalues of A
+  // smaller than sigma.
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
   void DefineMatrix(int np, int nsdiagp, ARTYPE* Ap, char uplop = 'L');
 
-  ARbdSymMatrix(): ARMatrix<ARTYPE>() { factored = false; }
+  ARbdSymMatrix(): ARMatrix<ARTYPE>()
+  {
+    factored   = false;
+    factor     = 'C';
+    indefKnown = false;
+    Ainv       = NULL;
+    ipiv       = NULL;
+  }
   // Short constructor that does nothing.
 
   ARbdSymMatrix(int np, int nsdiagp, ARTYPE* Ap, char uplop = 'L');
@@ -97,12 +162,11 @@ template<class ARTYPE>
 inline void ARbdSymMatrix<ARTYPE>::ClearMem()
 { 
 
-  if (factored) {
-    delete[] Ainv;
-    delete[] ipiv; 
-    Ainv = NULL;
-    ipiv = NULL;
-  }
+  delete[] Ainv;
+  delete[] ipiv; 
+  Ainv     = NULL;
+  ipiv     = NULL;
+  factored = false;
 
 } // ClearMem.
 
@@ -119,10 +183,15 @@ Copy(const ARbdSymMatrix<ARTYPE>& other)
   this->defined   = other.defined;
   factored  = other.factored;
   uplo      = other.uplo;
+  factor    = other.factor;
   nsdiag    = other.nsdiag;
   lda       = other.lda;
   info      = other.info;
   A         = other.A;
+  Ainv      = NULL;
+  ipiv      = NULL;
+  indefKnown = false;
+  shift     = other.shift;
 
   // Returning from here if "other" was not factored.
 
@@ -130,15 +199,47 @@ Copy(const ARbdSymMatrix<ARTYPE>& other)
 
   // Copying vectors.
 
-  Ainv = new ARTYPE[this->n*lda];
-  ipiv = new int[this->n];
+  size_t size = (size_t)this->n*((factor == 'C') ? nsdiag+1 : lda);
+
+  Ainv = new ARTYPE[size];
+  for (size_t i=0; i<size; i++) Ainv[i] = other.Ainv[i];
 
-  copy(this->n*lda, other.Ainv, 1, Ainv, 1);
-  for (int i=0; i<this->n; i++) ipiv[i] = other.ipiv[i];
+  if (other.ipiv) {
+    ipiv = new ARint[this->n];
+    for (int i=0; i<this->n; i++) ipiv[i] = other.ipiv[i];
+  }
 
 } // Copy.
 
 
+template<class ARTYPE>
+void ARbdSymMatrix<ARTYPE>::
+StoreBand(ARTYPE alpha, ARTYPE* dst, int kd, char uplod, bool add)
+{
+
+  int    d;
+  int    ld = kd+1;
+  size_t i, size = (size_t)ld*this->n;
+
+  if (!add) {
+    for (i=0; i<size; i++) dst[i] = (ARTYPE)0;
+  }
+
+  // Diagonal d holds the entries (j+d,j) of the lower triangle, which
+  // are the entries (j,j+d) of the upper one, j = 0, ..., n-d-1.
+
+  for (d=0; d<=nsdiag; d++) {
+
+    const ARTYPE* src = (uplo == 'L') ? &A[d] : &A[nsdiag-d+d*(nsdiag+1)];
+    ARTYPE*       out = (uplod == 'L') ? &dst[d] : &dst[kd-d+d*ld];
+
+    axpy(this->n-d, alpha, src, nsdiag+1, out, ld);
+
+  }
+
+} // StoreBand.
+
+
 template<class ARTYPE>
 void ARbdSymMatrix<ARTYPE>::ExpandA()
 {
@@ -194,16 +295,127 @@ void ARbdSymMatrix<ARTYPE>::SubtractAsI(ARTYPE sigma)
 
 
 template<class ARTYPE>
-inline void ARbdSymMatrix<ARTYPE>::CreateStructure()
+inline void ARbdSymMatrix<ARTYPE>::CreateStructure(bool chol)
 {
 
+  // The symmetric band needs nsdiag+1 rows. The general band needs
+  // 3*nsdiag+1 rows and the pivots.
+
   ClearMem();
-  Ainv = new ARTYPE[lda*this->n];
-  ipiv = new int[this->n];
+  factor = chol ? 'C' : 'G';
+  Ainv   = new ARTYPE[(size_t)this->n*(chol ? nsdiag+1 : lda)];
+  if (!chol) ipiv = new ARint[this->n];
 
 } // CreateStructure.
 
 
+template<class ARTYPE>
+template<class FILL>
+void ARbdSymMatrix<ARTYPE>::Factor(ARTYPE sigma, FILL fill)
+{
+
+  shift = sigma;
+
+  // Trying a band Cholesky factorization first, unless a smaller
+  // shift already gave an indefinite matrix.
+
+  if (!indefKnown || (sigma < indefShift)) {
+
+    CreateStructure(true);
+    fill(true);
+    pbtrf(&uplo, this->n, nsdiag, Ainv, nsdiag+1, info);
+
+    if (info == 0) {
+      factored = true;
+      return;
+    }
+    if (info > 0) {
+      indefKnown = true;
+      indefShift = sigma;
+    }
+
+  }
+
+  // LU decomposition of the expanded band (the symmetric band is
+  // released first).
+
+  CreateStructure(false);
+  fill(false);
+  gbtrf(this->n, this->n, nsdiag, nsdiag, Ainv, lda, ipiv, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+  factored = true;
+
+} // Factor.
+
+
+template<class ARTYPE>
+inline void ARbdSymMatrix<ARTYPE>::Solve(int k, ARTYPE* W, int ldw)
+{
+
+  if (factor == 'C') {
+    pbtrs(&uplo, this->n, nsdiag, k, Ainv, nsdiag+1, W, ldw, info);
+  }
+  else {
+    gbtrs("N", this->n, nsdiag, nsdiag, k, Ainv, lda, ipiv, W, ldw, info);
+  }
+
+} // Solve.
+
+
+template<class ARTYPE>
+template<class FILL>
+void ARbdSymMatrix<ARTYPE>::BandInertia(FILL fill, int& neg, int& zero,
+                                        int& pos)
+{
+
+  int     i, j, k, last, n = this->n;
+  int     ld   = nsdiag+1;
+  size_t  size = (size_t)ld*n;
+  ARTYPE  d, t, pivmin;
+  ARTYPE* band = work.Get(size);
+
+  fill(band);
+
+  // As in the bisection methods, pivots smaller than pivmin are
+  // replaced by -pivmin, so an eigenvalue equal to the shift (to
+  // working precision) is counted as negative.
+
+  pivmin = (ARTYPE)0;
+  for (size_t p=0; p<size; p++) {
+    if (std::abs(band[p]) > pivmin) pivmin = std::abs(band[p]);
+  }
+  pivmin *= std::numeric_limits<ARTYPE>::epsilon();
+  if (pivmin == (ARTYPE)0) pivmin = std::numeric_limits<ARTYPE>::min();
+
+  neg = zero = pos = 0;
+
+  // Entry (i,j), i >= j, is band[i-j+j*ld]. Column j of L is used to
+  // update the trailing part of the band, which keeps its width.
+
+  for (j=0; j<n; j++) {
+
+    ARTYPE* cj = &band[(size_t)j*ld];
+
+    d = cj[0];
+    if (std::abs(d) < pivmin) d = -pivmin;
+    if (d < (ARTYPE)0) neg++; else pos++;
+
+    last = (j+nsdiag < n-1) ? j+nsdiag : n-1;
+    for (i=j+1; i<=last; i++) {
+      ARTYPE* ci = &band[(size_t)i*ld];
+      t = cj[i-j]/d;
+      for (k=i; k<=last; k++) ci[k-i] -= cj[k-j]*t;
+    }
+
+  }
+
+} // BandInertia.
+
+
 template<class ARTYPE>
 inline void ARbdSymMatrix<ARTYPE>::ThrowError()
 {
@@ -230,56 +442,86 @@ void ARbdSymMatrix<ARTYPE>::FactorA()
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARbdSymMatrix::FactorA");
   }
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // Copying A to Ainv and decomposing it.
 
-  CreateStructure();
+  Factor((ARTYPE)0, [this](bool chol) {
+    if (chol) StoreBand((ARTYPE)1, Ainv, nsdiag, uplo, false);
+    else ExpandA();
+  });
 
-  // Copying A to Ainv;
+} // FactorA.
 
-  ExpandA();
 
-  // Decomposing A.
+template<class ARTYPE>
+void ARbdSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
+{
 
-  gbtrf(this->n, this->n, nsdiag, nsdiag, Ainv, lda, ipiv, info);
+  // Quitting the function if A was not defined.
 
-  // Handling errors.
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARbdSymMatrix::FactorAsI");
+  }
 
-  ThrowError();
+  // Subtracting sigma*I from A and decomposing AsI.
 
-  factored = true;
+  Factor(sigma, [this, sigma](bool chol) {
+    if (chol) {
+      int d = (uplo == 'L') ? 0 : nsdiag;
+      StoreBand((ARTYPE)1, Ainv, nsdiag, uplo, false);
+      for (size_t i=d; i<(size_t)(nsdiag+1)*this->n; i+=nsdiag+1) {
+        Ainv[i] -= sigma;
+      }
+    }
+    else {
+      SubtractAsI(sigma);
+    }
+  });
 
-} // FactorA.
+} // FactorAsI.
 
 
 template<class ARTYPE>
-void ARbdSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
+void ARbdSymMatrix<ARTYPE>::Inertia(int& neg, int& zero, int& pos)
 {
 
-  // Quitting the function if A was not defined.
+  // Quitting the function if A (or AsI) was not factored.
 
-  if (!this->IsDefined()) {
-    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARbdSymMatrix::FactorAsI");
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARbdSymMatrix::Inertia");
   }
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // A band Cholesky factorization exists only for positive definite
+  // matrices.
 
-  CreateStructure();
+  if (factor == 'C') {
+    neg = zero = 0;
+    pos = this->n;
+    return;
+  }
 
-  // Subtracting sigma*I from A.
+  BandInertia([this](ARTYPE* band) {
+    StoreBand((ARTYPE)1, band, nsdiag, 'L', false);
+    for (size_t i=0; i<(size_t)(nsdiag+1)*this->n; i+=nsdiag+1) {
+      band[i] -= shift;
+    }
+  }, neg, zero, pos);
 
-  SubtractAsI(sigma);
+} // Inertia.
 
-  // Decomposing AsI.
 
-  gbtrf(this->n, this->n, nsdiag, nsdiag, Ainv, lda, ipiv, info);
+template<class ARTYPE>
+int ARbdSymMatrix<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
+{
 
-  // Handling errors.
+  int neg, zero, pos;
 
-  ThrowError();
+  FactorAsI(sigma);
+  Inertia(neg, zero, pos);
 
-  factored = true;
+  return neg;
 
-} // FactorAsI.
+} // CountEigenvaluesBelow.
 
 
 template<class ARTYPE>
@@ -302,6 +544,63 @@ void ARbdSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE>
+void ARbdSymMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv,
+                                   ARTYPE* W, int ldw)
+{
+
+  int     i, j, r, first, last;
+  ARTYPE  zero = (ARTYPE)0;
+  ARTYPE  t, s;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARbdSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V. Each band column (nsdiag+1 entries) is
+  // read once and applied to all k vectors.
+
+  for (r=0; r<k; r++) {
+    for (i=0; i<this->n; i++) W[i+(size_t)r*ldw] = zero;
+  }
+
+  for (j=0; j<this->n; j++) {
+
+    const ARTYPE* col;
+
+    if (uplo == 'L') {
+      col   = &A[(size_t)j*(nsdiag+1)-j];
+      first = j;
+      last  = (j+nsdiag < this->n-1) ? j+nsdiag : this->n-1;
+    }
+    else {
+      col   = &A[(size_t)j*(nsdiag+1)+nsdiag-j];
+      first = (j > nsdiag) ? j-nsdiag : 0;
+      last  = j;
+    }
+
+    // col[i] is the entry (i,j) of the stored triangle.
+
+    for (r=0; r<k; r++) {
+      const ARTYPE* v = &V[(size_t)r*ldv];
+      ARTYPE*       w = &W[(size_t)r*ldw];
+      t = v[j];
+      s = zero;
+      for (i=first; i<=last; i++) {
+        if (i == j) continue;
+        w[i] += col[i]*t;
+        s    += col[i]*v[i];
+      }
+      w[j] += col[j]*t + s;
+    }
+
+  }
+
+} // MultMm.
+
+
 template<class ARTYPE>
 void ARbdSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 {
@@ -319,7 +618,7 @@ void ARbdSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 
   // Solving A.w = v (or AsI.w = v).
 
-  gbtrs("N", this->n, nsdiag, nsdiag, 1, Ainv, lda, ipiv, w, this->m, info);
+  Solve(1, w, this->n);
 
   // Handling errors.
 
@@ -328,11 +627,46 @@ void ARbdSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARbdSymMatrix<ARTYPE>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                      ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARbdSymMatrix::MultInvMm");
+  }
+
+  // Overwritting W with V.
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+
+  // Solving A.W = V (or AsI.W = V).
+
+  Solve(k, W, ldw);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvMm.
+
+
 template<class ARTYPE>
 inline void ARbdSymMatrix<ARTYPE>::
 DefineMatrix(int np, int nsdiagp, ARTYPE* Ap, char uplop)
 {
 
+  // Discarding the previous factorization.
+
+  ClearMem();
+
   // Defining member variables.
 
   this->m         = np;
@@ -342,9 +676,8 @@ DefineMatrix(int np, int nsdiagp, ARTYPE* Ap, char uplop)
   uplo      = uplop;
   A         = Ap;
   this->defined   = true;
-  Ainv      = NULL;
-  ipiv      = NULL;
   info      = 0; 
+  indefKnown = false;
 
 } // DefineMatrix.
 
@@ -356,6 +689,9 @@ ARbdSymMatrix(int np, int nsdiagp,
 {
 
   factored = false;
+  factor   = 'C';
+  Ainv     = NULL;
+  ipiv     = NULL;
   DefineMatrix(np, nsdiagp, Ap, uplop);
 
 } // Long constructor.
@@ -99,6 +99,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARbdNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetRegularMode( this->objOP, &ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -110,6 +111,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARbdNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap,  this->objOP, 
                        &ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -126,6 +128,7 @@ ARluNonSymStdEig(int nevp, ARbdNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -141,6 +144,7 @@ ARluNonSymStdEig(int nevp, ARbdNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARbdNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
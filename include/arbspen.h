@@ -48,6 +48,14 @@ class ARbdSymPencil
 
   void FactorAsB(ARTYPE sigma);
 
+  void Inertia(int& neg, int& zero, int& pos);
+  // Number of negative, zero and positive eigenvalues of A - sigma*B
+  // (see ARbdSymMatrix::Inertia).
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Factors A - sigma*B and returns the number of eigenvalues of the
+  // pencil smaller than sigma. B must be positive definite.
+
   void MultAv(ARTYPE* v, ARTYPE* w) { A->MultMv(v,w); }
 
   void MultBv(ARTYPE* v, ARTYPE* w) { B->MultMv(v,w); }
@@ -56,6 +64,11 @@ class ARbdSymPencil
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w) {  AsB.MultInvv(v,w); }
 
+  void MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+  {
+    AsB.MultInvMm(k, V, ldv, W, ldw);
+  }
+
   void DefineMatrices(ARbdSymMatrix<ARTYPE>& Ap, ARbdSymMatrix<ARTYPE>& Bp);
 
   ARbdSymPencil() { AsB.factored = false; }
@@ -226,30 +239,67 @@ void ARbdSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
 
   // Defining matrix AsB.
 
-  if (!AsB.IsDefined()) {
+  if (!AsB.IsDefined() || (AsB.nsdiag != max(A->nsdiag, B->nsdiag))) {
     AsB.DefineMatrix(A->ncols(), max(A->nsdiag, B->nsdiag), A->A);
   }
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // Subtracting sigma*B from A, storing the result on AsB and
+  // decomposing it (in symmetric band storage if it is positive
+  // definite).
 
-  AsB.CreateStructure(); 
+  AsB.Factor(sigma, [this, sigma](bool chol) {
+    if (chol) {
+      A->StoreBand((ARTYPE)1, AsB.Ainv, AsB.nsdiag, AsB.uplo, false);
+      B->StoreBand(-sigma, AsB.Ainv, AsB.nsdiag, AsB.uplo, true);
+    }
+    else {
+      SubtractAsB(sigma);
+    }
+  });
 
-  // Subtracting sigma*B from A and storing the result on AsB.
+} // FactorAsB (ARTYPE shift).
 
-  SubtractAsB(sigma);
 
-  // Decomposing AsB.
+template<class ARTYPE>
+void ARbdSymPencil<ARTYPE>::Inertia(int& neg, int& zero, int& pos)
+{
 
-  gbtrf(AsB.n, AsB.n, AsB.nsdiag, AsB.nsdiag, 
-        AsB.Ainv, AsB.lda, AsB.ipiv, AsB.info);
+  ARTYPE sigma = AsB.shift;
 
-  // Handling errors.
+  // Quitting the function if AsB was not factored.
 
-  AsB.ThrowError();
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARbdSymPencil::Inertia");
+  }
 
-  AsB.factored = true;
+  // AsB is a copy of A if sigma = 0.
 
-} // FactorAsB (ARTYPE shift).
+  if ((sigma == (ARTYPE)0) || (AsB.factor == 'C')) {
+    AsB.Inertia(neg, zero, pos);
+    return;
+  }
+
+  AsB.BandInertia([this, sigma](ARTYPE* band) {
+    A->StoreBand((ARTYPE)1, band, AsB.nsdiag, 'L', false);
+    B->StoreBand(-sigma, band, AsB.nsdiag, 'L', true);
+  }, neg, zero, pos);
+
+} // Inertia.
+
+
+template<class ARTYPE>
+int ARbdSymPencil<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
+{
+
+  int neg, zero, pos;
+
+  FactorAsB(sigma);
+  Inertia(neg, zero, pos);
+
+  return neg;
+
+} // CountEigenvaluesBelow.
 
 
 template<class ARTYPE>
@@ -0,0 +1,373 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARBSpMat.h.
+   Arpack++ class ARBlockSparseMatrix definition.
+   Sparse matrix made of dense BS x BS blocks, stored in block
+   compressed row (BCSR) format. BS is a compile-time constant, so
+   the products with each block are fully unrolled by the compiler.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARBSPMAT_H
+#define ARBSPMAT_H
+
+#include <cstddef>
+#include <vector>
+#include "arch.h"
+#include "armat.h"
+#include "arerror.h"
+#include "arspmat.h"
+
+
+template<class ARTYPE, int BS>
+class ARBlockSparseMatrix: public ARMatrix<ARTYPE> {
+
+  static_assert(BS > 0, "ARBlockSparseMatrix: the block size must be positive");
+
+ protected:
+
+  int      mb, nb;  // Number of block rows and block columns.
+  ARindex* bp;      // Block row pointers (size mb+1).
+  ARindex* bj;      // Block column indices, sorted inside each block row.
+  ARTYPE*  bx;      // Blocks (BS*BS values each, stored by columns).
+  char     uplo;    // 'L' ('U'): symmetric (hermitian) matrix, only the
+                    // lower (upper) block triangle is stored.
+
+ public:
+
+  static const int BlockSize = BS;
+
+  int nbrows() { return mb; }
+
+  int nbcols() { return nb; }
+
+  ARindex nblocks() { return bp[mb]; }
+
+  bool IsSymmetric() { return uplo == 'L' || uplo == 'U'; }
+
+  bool DataOK();
+
+  void MultMv(ARTYPE* v, ARTYPE* w);
+
+  void MultMtv(ARTYPE* v, ARTYPE* w);
+  // w = A'*v (not conjugated). For symmetric matrices, same as MultMv.
+
+  ARindex CSCNonZeros();
+  // Number of entries written by ConvertToCSC.
+
+  void ConvertToCSC(ARindex* pcol, ARindex* irow, ARTYPE* a);
+  // Writes the matrix in compressed column format, so it can be
+  // passed to ARchSymMatrix, ARumSymMatrix, ARluSymMatrix or the
+  // nonsymmetric classes (e.g. to use the shift and invert mode).
+  // pcol must have room for ncols()+1 entries, irow and a for
+  // CSCNonZeros() entries. For symmetric matrices, only the uplo
+  // triangle is written. All entries of the blocks are kept, even
+  // if they are zero.
+
+  void DefineMatrix(int mbp, int nbp, ARindex* bpp, ARindex* bjp,
+                    ARTYPE* bxp, char uplop = '*', bool check = true);
+  // The matrix has mbp x nbp blocks. Block p, p = bpp[i], ...,
+  // bpp[i+1]-1, is in block row i and block column bjp[p], and its
+  // entries are bxp[p*BS*BS], ..., bxp[(p+1)*BS*BS-1], stored by
+  // columns. If uplop is 'L' or 'U', the matrix is symmetric (or
+  // hermitian) and only the blocks of that triangle are given; the
+  // diagonal blocks must be stored in full. The arrays are not
+  // copied, so they must not be freed while the matrix is in use.
+
+  ARBlockSparseMatrix(): ARMatrix<ARTYPE>()
+  {
+    mb = nb = 0;
+    bp = bj = nullptr;
+    bx = nullptr;
+    uplo = '*';
+  }
+  // Short constructor that does nothing.
+
+  ARBlockSparseMatrix(int mbp, int nbp, ARindex* bpp, ARindex* bjp,
+                      ARTYPE* bxp, char uplop = '*');
+  // Long constructor.
+
+  ARBlockSparseMatrix(int nbp, ARindex* bpp, ARindex* bjp,
+                      ARTYPE* bxp, char uplop = '*');
+  // Long constructor (square matrix).
+
+}; // class ARBlockSparseMatrix.
+
+
+// ------------------------------------------------------------------------ //
+// ARBlockSparseMatrix member functions definition.                         //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE, int BS>
+bool ARBlockSparseMatrix<ARTYPE, BS>::DataOK()
+{
+
+  int     i;
+  ARindex p;
+
+  if (bp[0] != 0) return false;
+  if (IsSymmetric() && (mb != nb)) return false;
+
+  for (i = 0; i < mb; i++) {
+    if (bp[i+1] < bp[i]) return false;
+    for (p = bp[i]; p < bp[i+1]; p++) {
+      if ((bj[p] < 0) || (bj[p] >= nb)) return false;
+      if ((p > bp[i]) && (bj[p] <= bj[p-1])) return false;
+      if ((uplo == 'L') && (bj[p] > i)) return false;
+      if ((uplo == 'U') && (bj[p] < i)) return false;
+    }
+  }
+
+  return true;
+
+} // DataOK.
+
+
+template<class ARTYPE, int BS>
+void ARBlockSparseMatrix<ARTYPE, BS>::MultMv(ARTYPE* v, ARTYPE* w)
+{
+
+  int     i, j, r, c;
+  ARindex p;
+  ARTYPE  t[BS];
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARBlockSparseMatrix::MultMv");
+  }
+
+  // Determining w = M.v.
+
+  for (i = 0; i < this->m; i++) w[i] = (ARTYPE)0;
+
+  bool sym = IsSymmetric();
+
+  for (i = 0; i < mb; i++) {
+
+    const ARTYPE* vi = &v[(size_t)i*BS];
+
+    for (r = 0; r < BS; r++) t[r] = (ARTYPE)0;
+
+    for (p = bp[i]; p < bp[i+1]; p++) {
+
+      j = (int)bj[p];
+
+      const ARTYPE* b  = &bx[(size_t)p*BS*BS];
+      const ARTYPE* vj = &v[(size_t)j*BS];
+
+      // Block row i: t += B*v_j.
+
+      for (c = 0; c < BS; c++) {
+        ARTYPE s = vj[c];
+        for (r = 0; r < BS; r++) t[r] += b[c*BS+r]*s;
+      }
+
+      // Mirrored block of a symmetric matrix: w_j += B'*v_i.
+
+      if (sym && (j != i)) {
+        ARTYPE* wj = &w[(size_t)j*BS];
+        for (c = 0; c < BS; c++) {
+          ARTYPE s = (ARTYPE)0;
+          for (r = 0; r < BS; r++) s += spmat_conj(b[c*BS+r])*vi[r];
+          wj[c] += s;
+        }
+      }
+
+    }
+
+    for (r = 0; r < BS; r++) w[(size_t)i*BS+r] += t[r];
+
+  }
+
+} // MultMv.
+
+
+template<class ARTYPE, int BS>
+void ARBlockSparseMatrix<ARTYPE, BS>::MultMtv(ARTYPE* v, ARTYPE* w)
+{
+
+  int     i, j, r, c;
+  ARindex p;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARBlockSparseMatrix::MultMtv");
+  }
+
+  if (IsSymmetric()) {
+    MultMv(v, w);
+    return;
+  }
+
+  // Determining w = M'.v.
+
+  for (j = 0; j < this->n; j++) w[j] = (ARTYPE)0;
+
+  for (i = 0; i < mb; i++) {
+
+    const ARTYPE* vi = &v[(size_t)i*BS];
+
+    for (p = bp[i]; p < bp[i+1]; p++) {
+      const ARTYPE* b  = &bx[(size_t)p*BS*BS];
+      ARTYPE*       wj = &w[(size_t)bj[p]*BS];
+      for (c = 0; c < BS; c++) {
+        ARTYPE s = (ARTYPE)0;
+        for (r = 0; r < BS; r++) s += b[c*BS+r]*vi[r];
+        wj[c] += s;
+      }
+    }
+
+  }
+
+} // MultMtv.
+
+
+template<class ARTYPE, int BS>
+ARindex ARBlockSparseMatrix<ARTYPE, BS>::CSCNonZeros()
+{
+
+  ARindex nnz = (ARindex)BS*BS*bp[mb];
+
+  // Diagonal blocks of a symmetric matrix contribute one triangle only.
+
+  if (IsSymmetric()) {
+    for (int i = 0; i < mb; i++) {
+      for (ARindex p = bp[i]; p < bp[i+1]; p++) {
+        if (bj[p] == i) nnz -= (ARindex)BS*(BS-1)/2;
+      }
+    }
+  }
+
+  return nnz;
+
+} // CSCNonZeros.
+
+
+template<class ARTYPE, int BS>
+void ARBlockSparseMatrix<ARTYPE, BS>::
+ConvertToCSC(ARindex* pcol, ARindex* irow, ARTYPE* a)
+{
+
+  int     i, j, r, c;
+  ARindex p;
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARBlockSparseMatrix::ConvertToCSC");
+  }
+
+  // Entry (r,c) of the block in block row i and block column j is
+  // kept unless it lies outside the uplo triangle.
+
+  auto keep = [this](int i, int j, int r, int c) {
+    if (i != j) return true;
+    if (uplo == 'L') return r >= c;
+    if (uplo == 'U') return r <= c;
+    return true;
+  };
+
+  // Counting the entries in each column.
+
+  for (j = 0; j <= this->n; j++) pcol[j] = 0;
+
+  for (i = 0; i < mb; i++) {
+    for (p = bp[i]; p < bp[i+1]; p++) {
+      j = (int)bj[p];
+      for (c = 0; c < BS; c++) {
+        for (r = 0; r < BS; r++) {
+          if (keep(i, j, r, c)) pcol[(size_t)j*BS+c+1]++;
+        }
+      }
+    }
+  }
+
+  for (j = 0; j < this->n; j++) pcol[j+1] += pcol[j];
+
+  // Copying the entries. Block rows are visited in increasing order,
+  // so the row indices come out sorted inside each column.
+
+  std::vector<ARindex> next(pcol, pcol + this->n);
+
+  for (i = 0; i < mb; i++) {
+    for (p = bp[i]; p < bp[i+1]; p++) {
+      j = (int)bj[p];
+      const ARTYPE* b = &bx[(size_t)p*BS*BS];
+      for (r = 0; r < BS; r++) {
+        for (c = 0; c < BS; c++) {
+          if (keep(i, j, r, c)) {
+            ARindex k = next[(size_t)j*BS+c]++;
+            irow[k] = (ARindex)i*BS+r;
+            a[k]    = b[c*BS+r];
+          }
+        }
+      }
+    }
+  }
+
+} // ConvertToCSC.
+
+
+template<class ARTYPE, int BS>
+inline void ARBlockSparseMatrix<ARTYPE, BS>::
+DefineMatrix(int mbp, int nbp, ARindex* bpp, ARindex* bjp, ARTYPE* bxp,
+             char uplop, bool check)
+{
+
+  this->m = mbp*BS;
+  this->n = nbp*BS;
+  mb      = mbp;
+  nb      = nbp;
+  bp      = bpp;
+  bj      = bjp;
+  bx      = bxp;
+  uplo    = uplop;
+
+  // Checking data.
+
+  if (check && !DataOK()) {
+    throw ArpackError(ArpackError::INCONSISTENT_DATA,
+                      "ARBlockSparseMatrix::DefineMatrix");
+  }
+
+  this->defined = true;
+
+} // DefineMatrix.
+
+
+template<class ARTYPE, int BS>
+inline ARBlockSparseMatrix<ARTYPE, BS>::
+ARBlockSparseMatrix(int mbp, int nbp, ARindex* bpp, ARindex* bjp,
+                    ARTYPE* bxp, char uplop) : ARMatrix<ARTYPE>(mbp*BS, nbp*BS)
+{
+
+  DefineMatrix(mbp, nbp, bpp, bjp, bxp, uplop);
+
+} // Long constructor.
+
+
+template<class ARTYPE, int BS>
+inline ARBlockSparseMatrix<ARTYPE, BS>::
+ARBlockSparseMatrix(int nbp, ARindex* bpp, ARindex* bjp,
+                    ARTYPE* bxp, char uplop) : ARMatrix<ARTYPE>(nbp*BS)
+{
+
+  DefineMatrix(nbp, nbp, bpp, bjp, bxp, uplop);
+
+} // Long constructor (square matrix).
+
+
+#endif // ARBSPMAT_H
@@ -99,6 +99,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARbdSymMatrix<ARFLOAT> >::
     SetRegularMode(this->objOP, &ARbdSymMatrix<ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARbdSymMatrix<ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -109,6 +110,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARbdSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARbdSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARbdSymMatrix<ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -123,6 +125,7 @@ ARluSymStdEig(int nevp, ARbdSymMatrix<ARFLOAT>& A,
   this->NoShift();
   this->DefineParameters(A.ncols(), nevp, &A, &ARbdSymMatrix<ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARbdSymMatrix<ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -137,6 +140,7 @@ ARluSymStdEig(int nevp, ARbdSymMatrix<ARFLOAT>& A,
 
   this->DefineParameters(A.ncols(), nevp, &A, &ARbdSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARbdSymMatrix<ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
@@ -79,9 +79,37 @@ extern "C" {
 
 
 // Type conversion.
+// ARint and ARlogical must match the integers used by ARPACK, BLAS and
+// LAPACK. Define ARPACKPP_ILP64 if arpack-ng was built with INTERFACE64
+// (and is linked to ILP64 BLAS and LAPACK libraries).
+// ARindex is the type of the row indices and column pointers of sparse
+// matrices. Define ARPACKPP_INDEX64 to store matrices with more than
+// 2^31 nonzeros (the two options are independent). In this case, the "_dl_" and
+// "_zl_" UMFPACK routines and the "cholmod_l_" routines are used.
 
-typedef int ARint;
-typedef int ARlogical;
+#ifdef ARPACKPP_ILP64
+
+  #include <cstdint>
+  typedef int64_t ARint;
+  typedef int64_t ARlogical;
+
+#else
+
+  typedef int ARint;
+  typedef int ARlogical;
+
+#endif
+
+#ifdef ARPACKPP_INDEX64
+
+  #include <cstdint>
+  typedef int64_t ARindex;
+
+#else
+
+  typedef int ARindex;
+
+#endif
 
 #ifdef __SUNPRO_CC
 
@@ -28,12 +28,18 @@
 #ifndef ARCSMAT_H
 #define ARCSMAT_H
 
+#include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 #include "arch.h"
 #include "armat.h"
+#include "arspmat.h"
+#include "arsymmv.h"
 #include "arhbmat.h"
 #include "arerror.h"
+#include "arwork.h"
 #include "cholmodc.h"
 
 template<class ARTYPE> class ARchSymPencil;
@@ -47,13 +53,32 @@ class ARchSymMatrix: public ARMatrix<ARTYPE> {
 
   bool    factored;
   char    uplo;
-  int     nnz;
-  int*    irow;
-  int*    pcol;
+  ARTYPE  shift;   // Shift of the last factorization (0 for FactorA).
+  ARindex  nnz;
+  ARindex* irow;
+  ARindex* pcol;
   ARTYPE* a;
   cholmod_common c ;
-  cholmod_sparse *A ; 
-  cholmod_factor *L ; 
+  cholmod_sparse *A = nullptr;
+
+  // The factor is shared with the copies of this matrix, which only
+  // read it. A shared factor is not changed by FactorA or FactorAsI
+  // (see CholmodFactorize), so it is always consistent.
+  std::shared_ptr<CholmodFactor> L;
+
+  // The ordering and symbolic analysis kept in L are valid for the
+  // pattern of A, which changes only in DefineMatrix. FactorA and
+  // FactorAsI (and ARchSymPencil) reuse them, so only the numeric
+  // factorization is redone when the shift changes.
+  long pattern = 0;
+
+  // Reordered copy of the matrix (see DefineMatrix).
+  ARSparseMatrix<ARTYPE>* Ar = nullptr;
+
+  // Position in Ar of each entry of the array given to DefineMatrix
+  // (used by UpdateValues).
+  std::vector<ARindex> amap;
+
    
   bool DataOK();
 
@@ -61,37 +86,85 @@ class ARchSymMatrix: public ARMatrix<ARTYPE> {
 
   void ClearMem();
 
+  void MultMvStored(ARTYPE* v, ARTYPE* w);
+
  public:
 
-  int nzeros() { return nnz; }
+  ARindex nzeros() { return nnz; }
 
   bool IsFactored() { return factored; }
 
+  bool IsAnalyzed() { return L != nullptr; }
+  // True if the symbolic analysis of the current pattern is available.
+
   void FactorA();
 
   void FactorAsI(ARTYPE sigma);
 
+  void Inertia(int& neg, int& zero, int& pos);
+  // Number of negative, zero and positive eigenvalues of the factored
+  // matrix (A or A - sigma*I), read from the D of its LDL' factor. If
+  // CHOLMOD chose a supernodal (LL') factor, the matrix is positive
+  // definite. Indefinite matrices are given a simplicial LDL' factor.
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Factors A - sigma*I and returns the number of eigenvalues of A
+  // smaller than sigma.
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
-  void MultInvv(ARTYPE* v, ARTYPE* w);
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
 
-  void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
-                    int* pcolp, char uplop = 'L', bool check = true);
+  void Solve(const ARTYPE* v, ARTYPE* w) const;
+  // Solves A*w = v (or AsI*w = v). The factor is only read, and the
+  // work arrays are those of the calling thread, so several threads
+  // may solve at the same time with this matrix or with its copies.
 
-  ARchSymMatrix(): ARMatrix<ARTYPE>(), factored(false) { cholmod_start(&c); }
+  void Solve(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw) const;
+  // Same as above for the k columns of V at once.
+
+  void MultInvv(ARTYPE* v, ARTYPE* w) { Solve(v, w); }
+
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+  { Solve(k, V, ldv, W, ldw); }
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
+  bool IsReordered() { return Ar != nullptr; }
+
+  const int* Permutation() { return Ar ? Ar->Permutation() : nullptr; }
+  // Ordering used to store the matrix (see DefineMatrix), or null.
+
+  void UpdateValues(const ARTYPE* newvals);
+  // Replaces the nnz values of A by newvals, given in the order of the
+  // array passed to DefineMatrix (which may also be that array, after
+  // it was changed in place). The pattern must not change. Its
+  // ordering and symbolic analysis are kept, and if A (or A-sigma*I)
+  // was factored, only the numeric factorization is redone, with the
+  // same shift, so an eigenvalue problem defined with this matrix can
+  // be solved again at once.
+
+  void DefineMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp,
+                    ARindex* pcolp, char uplop = 'L', bool check = true,
+                    bool reorder = false);
+  // If reorder is true, a reverse Cuthill-McKee ordered copy of the
+  // matrix is used by MultMv, MultMm and the factorization. These
+  // functions still take and return vectors in the original ordering.
+
+  ARchSymMatrix(): ARMatrix<ARTYPE>(), factored(false) { CHOLMODNAME(start)(&c); }
   // Short constructor that does nothing.
 
-  ARchSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
-                int* pcolp, char uplop = 'L');
+  ARchSymMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp,
+                ARindex* pcolp, char uplop = 'L');
   // Long constructor.
 
   ARchSymMatrix(const std::string& name);
   // Long constructor (Harwell-Boeing file).
 
-  ARchSymMatrix(const ARchSymMatrix& other) { cholmod_start(&c); Copy(other); }
-  // Copy constructor.
+  ARchSymMatrix(const ARchSymMatrix& other) { CHOLMODNAME(start)(&c); Copy(other); }
+  // Copy constructor. The copy shares the factorization of other
+  // (no cholmod_copy_factor), until one of them is factored again.
 
-  virtual ~ARchSymMatrix() { ClearMem(); cholmod_finish(&c); }
+  virtual ~ARchSymMatrix() { ClearMem(); CHOLMODNAME(finish)(&c); }
   // Destructor.
 
   ARchSymMatrix& operator=(const ARchSymMatrix& other);
@@ -108,7 +181,7 @@ template<class ARTYPE>
 bool ARchSymMatrix<ARTYPE>::DataOK()
 {
 
-  return cholmod_check_sparse(A, &c) == 1 /* TRUE */;
+  return CHOLMODNAME(check_sparse)(A, &c) == 1 /* TRUE */;
 
 } // DataOK.
 
@@ -117,15 +190,19 @@ template<class ARTYPE>
 void ARchSymMatrix<ARTYPE>::ClearMem()
 {
 
-  if (factored) {
-    cholmod_free_factor (&L, &c) ;
-  }
+  L.reset();
+  factored = false;
   if (this->defined) {
-    //cholmod_free_sparse (&A, &c);
+    //CHOLMODNAME(free_sparse)(&A, &c);
 
     free(A); // don't delete data in A as it came from external
     A = nullptr;
   }
+  if (Ar) {
+    delete Ar;
+    Ar = nullptr;
+  }
+  amap.clear();
 
 } // ClearMem.
 
@@ -144,18 +221,28 @@ inline void ARchSymMatrix<ARTYPE>::Copy(const ARchSymMatrix<ARTYPE>& other)
 
   this->n = other.n;
   factored  = other.factored;
+  shift     = other.shift;
   uplo = other.uplo;
   nnz  = other.nnz;
   irow = other.irow;
   pcol = other.pcol;
   a = other.a;
   //c = other.c;
+
+  if (other.Ar) {
+    Ar   = new ARSparseMatrix<ARTYPE>(*other.Ar);
+    a    = Ar->values();
+    irow = Ar->irow();
+    pcol = Ar->pcol();
+    amap = other.amap;
+  }
    
-  A = cholmod_copy_sparse(other.A, &c);
+  A = CholmodCreateSparse(this->n, this->n, nnz, a, irow, pcol, uplo);
+  pattern = other.pattern;
+
+  // Sharing the analysis and factorization of other.
 
-  if (L) cholmod_free_factor(&L, &c);
-  if (factored)
-    L = cholmod_copy_factor(other.L, &c);
+  L = other.L;
 
 } // Copy.
 
@@ -171,16 +258,14 @@ void ARchSymMatrix<ARTYPE>::FactorA()
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARchSymMatrix::FactorA");
   }
 
-  // Deleting previous versions of L.
-  if (factored) {
-    cholmod_free_factor (&L, &c) ;
-  }
-  
-  L = cholmod_analyze (A, &c) ;
-  info = cholmod_factorize (A, L, &c) ;  
+  // Analyzing the pattern of A, unless this was already done, and
+  // factorizing A (L is overwritten if it was already factored).
+  double zero[2] = { 0.0, 0.0 };
+  info = CholmodFactorize(A, zero, L, &c);
   
 
   factored = (info != 0);
+  shift    = (ARTYPE)0;
   
   if (c.status != CHOLMOD_OK)
   {
@@ -218,17 +303,14 @@ void ARchSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARchSymMatrix::FactorAsI");
   }
 
-  // Deleting previous versions of L.
-  if (factored) {
-    cholmod_free_factor (&L, &c);
-  }  
-
-  // Factorizing A-sigma*I
+  // Analyzing the pattern of A, unless this was already done (the
+  // pattern of A-sigma*I is the same for all shifts), and factorizing
+  // A-sigma*I.
   double sigma2[2] = { -sigma, 0.0 };
-  L = cholmod_analyze (A, &c);
-  int info = cholmod_factorize_p (A, sigma2, nullptr, 0, L, &c);
+  int info = CholmodFactorize(A, sigma2, L, &c);
 
   factored = (info != 0);
+  shift    = sigma;
   
   if (c.status != CHOLMOD_OK)
   {
@@ -241,11 +323,39 @@ void ARchSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
 } // FactorAsI.
 
 
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::Inertia(int& neg, int& zero, int& pos)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARchSymMatrix::Inertia");
+  }
+
+  CholmodInertia<ARTYPE>(L->L, neg, zero, pos);
+
+} // Inertia.
+
+
+template<class ARTYPE>
+int ARchSymMatrix<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
+{
+
+  int neg, zero, pos;
+
+  FactorAsI(sigma);
+  Inertia(neg, zero, pos);
+
+  return neg;
+
+} // CountEigenvaluesBelow.
+
+
 template<class ARTYPE>
 void ARchSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
-  int    i, j, k;
-  ARTYPE t;
 
   // Quitting the function if A was not defined.
 
@@ -255,75 +365,161 @@ void ARchSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 
   // Determining w = M.v.
 
-  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+  if (Ar) {
+    const int* perm = Ar->Permutation();
+    ARTYPE* pv = CholmodLocalWork<ARTYPE>().pwork.Get(2*(size_t)this->n);
+    ARTYPE* pw = pv + this->n;
+    PermuteVector(this->n, perm, v, pv);
+    MultMvStored(pv, pw);
+    UnpermuteVector(this->n, perm, pw, w);
+  }
+  else {
+    MultMvStored(v, w);
+  }
 
-  if (uplo == 'U') {
+} // MultMv.
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i+1];
-      if ((k!=pcol[i])&&(irow[k-1]==i)) {
-        w[i] += t*a[k-1];
-        k--;
-      }
-      for (j=pcol[i]; j<k; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
 
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::MultMvStored(ARTYPE* v, ARTYPE* w)
+{
+
+  SymCSCMultMv(this->n, pcol, irow, a, (uplo == 'U') ? 'U' : 'L', v, w);
+
+} // MultMvStored.
+
+
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv,
+                                   ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARchSymMatrix::MultMm");
   }
-  else {
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i];
-      if ((k!=pcol[i+1])&&(irow[k]==i)) {
-        w[i] += t*a[k];
-        k++;
-      }
-      for (j=k; j<pcol[i+1]; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
+  // Determining W = M.V.
+
+  if (Ar) {
+    int n = this->n;
+    const int* perm = Ar->Permutation();
+    ARTYPE* pv = CholmodLocalWork<ARTYPE>().pwork.Get(2*(size_t)n*k);
+    ARTYPE* pw = pv + (size_t)n*k;
+    for (int r = 0; r < k; r++) {
+      PermuteVector(n, perm, &V[(size_t)r*ldv], &pv[(size_t)r*n]);
     }
+    SymCSCMultMm(n, pcol, irow, a, uplo, k, pv, n, pw, n);
+    for (int r = 0; r < k; r++) {
+      UnpermuteVector(n, perm, &pw[(size_t)r*n], &W[(size_t)r*ldw]);
+    }
+  }
+  else {
+    SymCSCMultMm(this->n, pcol, irow, a, uplo, k, V, ldv, W, ldw);
+  }
+
+} // MultMm.
+
 
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::Solve(const ARTYPE* v, ARTYPE* w) const
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!factored) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARchSymMatrix::Solve");
   }
 
-} // MultMv.
+  // Solving A.w = v (or AsI.w = v) with the work arrays of this thread.
+
+  CholmodThreadWork<ARTYPE>& tw = CholmodLocalWork<ARTYPE>();
+
+  const int* perm = Ar ? Ar->Permutation() : nullptr;
+  ARTYPE*    pv   = const_cast<ARTYPE*>(v);
+  ARTYPE*    pw   = w;
+
+  if (perm) {
+    pv = tw.pwork.Get(2*(size_t)this->n);
+    pw = pv + this->n;
+    PermuteVector(this->n, perm, v, pv);
+  }
+
+  if (!CholmodSolve(L->L, this->n, pv, pw, tw.work, &tw.c)) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "ARchSymMatrix::Solve");
+  }
+
+  if (perm) UnpermuteVector(this->n, perm, pw, w);
+
+} // Solve.
 
 
 template<class ARTYPE>
-void ARchSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
+void ARchSymMatrix<ARTYPE>::Solve(int k, const ARTYPE* V, int ldv,
+                                  ARTYPE* W, int ldw) const
 {
+
   // Quitting the function if A (or AsI) was not factored.
 
-  if (!IsFactored()) {
+  if (!factored) {
     throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
-                      "ARchSymMatrix::MultInvv");
+                      "ARchSymMatrix::Solve");
   }
 
-  // Solving A.w = v (or AsI.w = v).
-  
-  //create b from v (data is not copied!!)
-  cholmod_dense *b = CholmodCreateDense(this->n, 1, v);
+  // Solving A.W = V (or AsI.W = V) with the work arrays of this thread.
 
-  cholmod_dense *x = cholmod_solve (CHOLMOD_A, L, b, &c) ;
+  CholmodThreadWork<ARTYPE>& tw = CholmodLocalWork<ARTYPE>();
 
-  CholmodGetDenseData(x, this->n, w);
+  int        n    = this->n;
+  const int* perm = Ar ? Ar->Permutation() : nullptr;
+  bool       ok;
+
+  if (perm) {
+    ARTYPE* pv = tw.pwork.Get(2*(size_t)n*k);
+    ARTYPE* pw = pv + (size_t)n*k;
+    for (int r = 0; r < k; r++) {
+      PermuteVector(n, perm, &V[(size_t)r*ldv], &pv[(size_t)r*n]);
+    }
+    ok = CholmodSolve(L->L, n, k, pv, n, pw, n, tw.work, &tw.c);
+    if (ok) {
+      for (int r = 0; r < k; r++) {
+        UnpermuteVector(n, perm, &pw[(size_t)r*n], &W[(size_t)r*ldw]);
+      }
+    }
+  }
+  else {
+    ok = CholmodSolve(L->L, n, k, V, ldv, W, ldw, tw.work, &tw.c);
+  }
 
-  free(b);
-  cholmod_free_dense(&x, &c);
+  if (!ok) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "ARchSymMatrix::Solve");
+  }
 
-} // MultInvv.
+} // Solve (k vectors).
 
 
 template<class ARTYPE>
 inline void ARchSymMatrix<ARTYPE>::
-DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
-             char uplop, bool check)
+DefineMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
+             char uplop, bool check, bool reorder)
 {
 
+  if (Ar) {
+    delete Ar;
+    Ar = nullptr;
+  }
+  amap.clear();
+
+  // The pattern changes, so the symbolic analysis is discarded.
+
+  L.reset();
+  if (A) free(A);
+  factored = false;
+  shift    = (ARTYPE)0;
+  pattern  = CholmodNewPattern();
+
   this->m   = np;
   this->n   = np;
   nnz       = nnzp;
@@ -344,15 +540,77 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
                       "ARchSymMatrix::DefineMatrix");
   }
 
+  // Replacing A by a permuted copy (the user arrays are not changed).
+
+  if (reorder) {
+    Ar = new ARSparseMatrix<ARTYPE>(np, np, pcol, irow, a, nnz, uplo, false);
+    Ar->Reorder();
+
+    a    = Ar->values();
+    irow = Ar->irow();
+    pcol = Ar->pcol();
+
+    free(A);
+    A = CholmodCreateSparse(this->n, this->n, nnz, a, irow, pcol, uplo);
+
+    // Finding the position of each entry of ap in the permuted copy.
+    // Entries that left the stored triangle were mirrored by Permute.
+
+    const int* perm = Ar->Permutation();
+    std::vector<int> iperm(np);
+    for (int i = 0; i < np; i++) iperm[perm[i]] = i;
+
+    amap.resize(nnz);
+    for (int j = 0; j < np; j++) {
+      for (ARindex p = pcolp[j]; p < pcolp[j+1]; p++) {
+        int r   = iperm[irowp[p]];
+        int col = iperm[j];
+        if (((uplo == 'L') && (r < col)) || ((uplo == 'U') && (r > col))) {
+          std::swap(r, col);
+        }
+        amap[p] = std::lower_bound(irow+pcol[col], irow+pcol[col+1],
+                                   (ARindex)r) - irow;
+      }
+    }
+  }
+
 } // DefineMatrix.
 
 
+template<class ARTYPE>
+void ARchSymMatrix<ARTYPE>::UpdateValues(const ARTYPE* newvals)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARchSymMatrix::UpdateValues");
+  }
+
+  // Storing the new values (in the permuted copy, if there is one).
+
+  if (Ar) {
+    for (ARindex p = 0; p < nnz; p++) a[amap[p]] = newvals[p];
+  }
+  else if (newvals != a) {
+    std::copy(newvals, newvals+nnz, a);
+  }
+
+  // Redoing the numeric factorization. The analysis kept in L is
+  // valid because the pattern did not change.
+
+  if (factored) FactorAsI(shift);
+
+} // UpdateValues.
+
+
 template<class ARTYPE>
 inline ARchSymMatrix<ARTYPE>::
-ARchSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
-              int* pcolp, char uplop) : ARMatrix<ARTYPE>(np)
+ARchSymMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp,
+              ARindex* pcolp, char uplop) : ARMatrix<ARTYPE>(np)
 {
-  cholmod_start (&c) ;
+  CHOLMODNAME(start)(&c) ;
 
   factored = false;
   DefineMatrix(np, nnzp, ap, irowp, pcolp, uplop, true);
@@ -364,11 +622,11 @@ template<class ARTYPE>
 ARchSymMatrix<ARTYPE>::
 ARchSymMatrix(const std::string& file)
 {
-  cholmod_start (&c) ;
+  CHOLMODNAME(start)(&c) ;
 
   factored = false;
 
-  ARhbMatrix<int, ARTYPE> mat;
+  ARhbMatrix<ARindex, ARTYPE> mat;
 
   try {
     mat.Define(file, false);
@@ -37,10 +37,17 @@ class ARchSymPencil
 
   ARchSymMatrix<ARTYPE>* A;
   ARchSymMatrix<ARTYPE>* B;
-  cholmod_factor *LAsB ; 
+  std::shared_ptr<CholmodFactor> LAsB;  // Shared with the copies.
   bool    factoredAsB;
   cholmod_common c ;
 
+  // Patterns of A and B (and whether sigma was zero, in which case
+  // A - sigma*B is A itself) for which LAsB holds the symbolic
+  // analysis. It is reused while they do not change.
+  long    patternA = 0;
+  long    patternB = 0;
+  bool    zeroAsB  = false;
+
   virtual void Copy(const ARchSymPencil& other);
 
  public:
@@ -49,6 +56,14 @@ class ARchSymPencil
 
   void FactorAsB(ARTYPE sigma);
 
+  void Inertia(int& neg, int& zero, int& pos);
+  // Number of negative, zero and positive eigenvalues of A - sigma*B
+  // (see ARchSymMatrix::Inertia).
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Factors A - sigma*B and returns the number of eigenvalues of the
+  // pencil smaller than sigma. B must be positive definite.
+
   void MultAv(ARTYPE* v, ARTYPE* w) { A->MultMv(v,w); }
 
   void MultBv(ARTYPE* v, ARTYPE* w) { B->MultMv(v,w); }
@@ -56,19 +71,24 @@ class ARchSymPencil
   void MultInvBAv(ARTYPE* v, ARTYPE* w);
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w);
+  // Solves (A-sigma*B)*w = v with the work arrays of the calling
+  // thread, so several threads may use the same factorization.
+
+  void MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves (A-sigma*B)*W = V for the k columns of V at once.
 
   void DefineMatrices(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp);
 
-  ARchSymPencil() : factoredAsB(false), A(nullptr), B(nullptr), LAsB(nullptr) { cholmod_start(&c); }
+  ARchSymPencil() : A(nullptr), B(nullptr), factoredAsB(false) { CHOLMODNAME(start)(&c); }
   // Short constructor that does nothing.
 
   ARchSymPencil(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp);
   // Long constructor.
 
-  ARchSymPencil(const ARchSymPencil& other) { cholmod_start (&c) ; Copy(other); }
-  // Copy constructor.
+  ARchSymPencil(const ARchSymPencil& other) { CHOLMODNAME(start)(&c) ; Copy(other); }
+  // Copy constructor. The copy shares the factorization of other.
 
-  virtual ~ARchSymPencil() {  if (LAsB) cholmod_free_factor(&LAsB, &c);  cholmod_finish (&c) ;}
+  virtual ~ARchSymPencil() { LAsB.reset(); CHOLMODNAME(finish)(&c); }
   // Destructor.
 
   ARchSymPencil& operator=(const ARchSymPencil& other);
@@ -84,12 +104,13 @@ class ARchSymPencil
 template<class ARTYPE>
 inline void ARchSymPencil<ARTYPE>::Copy(const ARchSymPencil<ARTYPE>& other)
 {
-  if (LAsB) cholmod_free_factor(&LAsB, &c);
   A        = other.A;
   B        = other.B;
   factoredAsB = other.factoredAsB;
-  if (factoredAsB)
-    LAsB = cholmod_copy_factor(other.LAsB, &c);
+  patternA    = other.patternA;
+  patternB    = other.patternB;
+  zeroAsB     = other.zeroAsB;
+  LAsB        = other.LAsB;
 
 } // Copy.
 
@@ -105,14 +126,28 @@ void ARchSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
                       "ARchSymPencil::FactorAsB");
   }
 
-  if (LAsB) cholmod_free_factor(&LAsB, &c);
+  // Discarding the symbolic analysis if the pattern has changed.
+
+  bool zero = (sigma == (ARTYPE)0);
+
+  if (LAsB && ((patternA != A->pattern) || (patternB != B->pattern) ||
+               (zeroAsB != zero))) {
+    LAsB.reset();
+  }
 
   cholmod_sparse* AsB;
 
   AsB = CholmodAdd(A->A, -sigma, B->A, &c);
-    
-  LAsB = cholmod_analyze (AsB, &c);
-  int info = cholmod_factorize (AsB, LAsB, &c);  
+
+  if (!LAsB) {
+    patternA = A->pattern;
+    patternB = B->pattern;
+    zeroAsB  = zero;
+  }
+
+  factoredAsB = false;
+  double beta[2] = { 0.0, 0.0 };
+  int info = CholmodFactorize(AsB, beta, LAsB, &c);
 
   factoredAsB = (info != 0);  
   if (c.status != CHOLMOD_OK) {
@@ -124,12 +159,42 @@ void ARchSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   }
 
   if (A->A != AsB) {
-    cholmod_free_sparse(&AsB, &c);
+    CHOLMODNAME(free_sparse)(&AsB, &c);
   }
 
 } // FactorAsB (ARTYPE shift).
 
 
+template<class ARTYPE>
+void ARchSymPencil<ARTYPE>::Inertia(int& neg, int& zero, int& pos)
+{
+
+  // Quitting the function if AsB was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARchSymPencil::Inertia");
+  }
+
+  CholmodInertia<ARTYPE>(LAsB->L, neg, zero, pos);
+
+} // Inertia.
+
+
+template<class ARTYPE>
+int ARchSymPencil<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
+{
+
+  int neg, zero, pos;
+
+  FactorAsB(sigma);
+  Inertia(neg, zero, pos);
+
+  return neg;
+
+} // CountEigenvaluesBelow.
+
+
 template<class ARTYPE>
 void ARchSymPencil<ARTYPE>::MultInvBAv(ARTYPE* v, ARTYPE* w)
 {
@@ -150,20 +215,37 @@ void ARchSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
                       "ARchSymPencil::MultInvAsBv");
   }
 
-  // Solving A.w = v (or AsI.w = v).
-  
-  //create b from v (data is not copied!!)
-  cholmod_dense * b = CholmodCreateDense(A->n, 1, v);
+  // Solving (A-sigma*B).w = v with the work arrays of this thread.
 
-  cholmod_dense *x = cholmod_solve (CHOLMOD_A, LAsB, b, &c);
+  CholmodThreadWork<ARTYPE>& tw = CholmodLocalWork<ARTYPE>();
 
-  CholmodGetDenseData(x, A->n, w);
-
-  free(b);
-  cholmod_free_dense(&x, &c);
+  if (!CholmodSolve(LAsB->L, A->n, v, w, tw.work, &tw.c)) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARchSymPencil::MultInvAsBv");
+  }
 
 } // MultInvAsBv
 
+template<class ARTYPE>
+void ARchSymPencil<ARTYPE>::
+MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARchSymPencil::MultInvAsBm");
+  }
+
+  // Solving (A-sigma*B).W = V with the work arrays of this thread.
+
+  CholmodThreadWork<ARTYPE>& tw = CholmodLocalWork<ARTYPE>();
+
+  if (!CholmodSolve(LAsB->L, A->n, k, V, ldv, W, ldw, tw.work, &tw.c)) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARchSymPencil::MultInvAsBm");
+  }
+
+} // MultInvAsBm
+
 template<class ARTYPE>
 inline void ARchSymPencil<ARTYPE>::
 DefineMatrices(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp)
@@ -177,6 +259,14 @@ DefineMatrices(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp)
                       "ARchSymPencil::DefineMatrices");
   }
 
+  // A - sigma*B is built from the stored arrays, so both matrices
+  // must keep the original ordering.
+
+  if (A->IsReordered() || B->IsReordered()) {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED,
+                      "ARchSymPencil::DefineMatrices");
+  }
+
 } // DefineMatrices.
 
 
@@ -184,8 +274,8 @@ template<class ARTYPE>
 inline ARchSymPencil<ARTYPE>::
 ARchSymPencil(ARchSymMatrix<ARTYPE>& Ap, ARchSymMatrix<ARTYPE>& Bp)
 {
-  cholmod_start (&c);
-  LAsB = nullptr; 
+  CHOLMODNAME(start)(&c);
+  factoredAsB = false;
   DefineMatrices(Ap, Bp);
 
 } // Long constructor.
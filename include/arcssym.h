@@ -106,6 +106,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARchSymMatrix<ARFLOAT> >::
     SetRegularMode(this->objOP, &ARchSymMatrix<ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARchSymMatrix<ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -116,6 +117,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARchSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARchSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARchSymMatrix<ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -130,6 +132,7 @@ ARluSymStdEig(int nevp, ARchSymMatrix<ARFLOAT>& A,
   this->NoShift();
   this->DefineParameters(A.ncols(), nevp, &A, &ARchSymMatrix<ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARchSymMatrix<ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -144,6 +147,7 @@ ARluSymStdEig(int nevp, ARchSymMatrix<ARFLOAT>& A,
 
   this->DefineParameters(A.ncols(), nevp, &A, &ARchSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARchSymMatrix<ARFLOAT>::MultInvMm);
   this->ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
@@ -28,6 +28,7 @@
 #include "blas1c.h"
 #include "lapackc.h"
 #include "ardfmat.h"
+#include "arwork.h"
 
 template<class AR_T, class AR_S> class ARdsNonSymPencil;
 
@@ -40,11 +41,13 @@ class ARdsNonSymMatrix: public ARMatrix<ARTYPE> {
  protected:
 
   bool                factored;
-  int                 info;
-  int*                ipiv;
+  ARint               info;
+  ARint*              ipiv;
   ARTYPE*             A;
   ARTYPE*             Ainv;
   ARdfMatrix<ARTYPE>  mat;
+  ARWorkspace<ARTYPE> wprod;  // Used by MultMv and MultMtv.
+  ARWorkspace<ARTYPE> wgram;  // Used by MultMtMv and MultMMtv.
 
   void ClearMem(); 
 
@@ -64,6 +67,8 @@ class ARdsNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
   void MultMtMv(ARTYPE* v, ARTYPE* w);
@@ -74,6 +79,9 @@ class ARdsNonSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
   void DefineMatrix(int np, ARTYPE* Ap);
 
   void DefineMatrix(int mp, int np, ARTYPE* Ap);
@@ -147,7 +155,7 @@ Copy(const ARdsNonSymMatrix<ARTYPE, ARFLOAT>& other)
   // Copying vectors.
 
   Ainv = new ARTYPE[this->m*this->n];
-  ipiv = new int[this->n];
+  ipiv = new ARint[this->n];
 
   copy(this->m*this->n, other.Ainv, 1, Ainv, 1);
   for (int i=0; i<this->n; i++) ipiv[i] = other.ipiv[i];
@@ -161,7 +169,7 @@ inline void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::CreateStructure()
 
   ClearMem();
   Ainv = new ARTYPE[this->m*this->n];
-  ipiv = new int[this->n];
+  ipiv = new ARint[this->n];
 
 } // CreateStructure.
 
@@ -305,7 +313,7 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
       // Matrix is "fat".
 
       mat.Rewind();
-      t = new ARTYPE[mat.ColsInMemory()];
+      t = wprod.Get(this->m);
       for (i=0; i<this->m; i++) w[i] = zero;
       for (i=0; i<mat.NBlocks(); i++) {
         mat.ReadBlock();
@@ -313,7 +321,6 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
              this->m, &v[mat.FirstIndex()], 1, zero, t, 1);
         axpy(this->m, one, t, 1, w, 1); 
       }
-      delete[] t;
 
     }
 
@@ -327,6 +334,36 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  ARTYPE  one;
+  ARTYPE  zero;
+
+  one  = (ARTYPE)0 + 1.0;
+  zero = (ARTYPE)0;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsNonSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V. Matrices stored in files are
+  // handled one vector at a time by the default version.
+
+  if (mat.IsOutOfCore()) {
+    ARMatrix<ARTYPE>::MultMm(k, V, ldv, W, ldw);
+  }
+  else {
+    gemm("N", "N", this->m, k, this->n, one, A, this->m, V, ldv, zero, W, ldw);
+  }
+
+} // MultMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
@@ -366,15 +403,14 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
       // Matrix is "tall".
 
       mat.Rewind();
-      t = new ARTYPE[mat.ColsInMemory()];
-      for (i=0; i<this->m; i++) w[i] = zero;
+      t = wprod.Get(this->n);
+      for (i=0; i<this->n; i++) w[i] = zero;
       for (i=0; i<mat.NBlocks(); i++) {
         mat.ReadBlock();
         gemv("T", mat.RowsInMemory(), this->n, one, mat.Entries(), 
              mat.RowsInMemory(), &v[mat.FirstIndex()], 1, zero, t, 1);
-        axpy(mat.RowsInMemory(), one, t, 1, w, 1); 
+        axpy(this->n, one, t, 1, w, 1); 
       }
-      delete[] t;
 
     }
 
@@ -405,8 +441,8 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 
     // Special code for "tall" matrices.
 
-    t = new ARTYPE[mat.BlockSize()];
-    s = new ARTYPE[this->n];
+    t = wgram.Get((size_t)mat.BlockSize()+this->n);
+    s = t + mat.BlockSize();
 
     mat.Rewind();
     for (i=0; i<this->n; i++) w[i] = zero;
@@ -420,19 +456,14 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 
     }
 
-    delete[] t;
-    delete[] s;
-
   }
   else {
 
-    t = new ARTYPE[this->m];
+    t = wgram.Get(this->m);
 
     MultMv(v,t);
     MultMtv(t,w);
 
-    delete[] t;
-
   }
 
 
@@ -455,8 +486,8 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 
     // Special code for "fat" matrices.
 
-    t = new ARTYPE[mat.BlockSize()];
-    s = new ARTYPE[this->m];
+    t = wgram.Get((size_t)mat.BlockSize()+this->m);
+    s = t + mat.BlockSize();
 
     mat.Rewind();
     for (i=0; i<this->m; i++) w[i] = zero;
@@ -470,19 +501,14 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 
     }
 
-    delete[] t;
-    delete[] s;
-
   }
   else {
 
-    t = new ARTYPE[this->n];
+    t = wgram.Get(this->n);
 
     MultMtv(v,t);
     MultMv(t,w);
 
-    delete[] t;
-
   }
 
 } // MultMMtv.
@@ -524,6 +550,37 @@ void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                                  ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARdsNonSymMatrix::MultInvMm");
+  }
+
+  // Overwritting W with V.
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+
+  // Solving A.W = V (or AsI.W = V).
+
+  getrs("N", this->n, k, Ainv, this->m, ipiv, W, ldw, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARdsNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, ARTYPE* Ap)
@@ -22,6 +22,7 @@
 #include "blas1c.h"
 #include "lapackc.h"
 #include "ardnsmat.h"
+#include "arwork.h"
 
 
 template<class ARTYPE, class ARFLOAT>
@@ -36,6 +37,7 @@ class ARdsNonSymPencil
   ARdsNonSymMatrix<ARTYPE, ARFLOAT>  AsB;
 #ifdef ARCOMP_H
   ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> AsBc;
+  ARWorkspace<arcomplex<ARFLOAT> > wcomp;  // Used by MultInvAsBv.
 #endif
 
   virtual void Copy(const ARdsNonSymPencil& other);
@@ -66,6 +68,15 @@ class ARdsNonSymPencil
 
   void MultInvAsBv(ARFLOAT* v, ARFLOAT* w);
 
+#ifdef ARCOMP_H
+  void MultInvAsBm(int k, const arcomplex<ARFLOAT>* V, int ldv,
+                   arcomplex<ARFLOAT>* W, int ldw);
+#endif
+
+  void MultInvAsBm(int k, const ARFLOAT* V, int ldv, ARFLOAT* W, int ldw);
+  // Solves (A-sigma*B)*W = V for the k columns of V. With a complex
+  // shift, W is the real (or imaginary) part of the solution.
+
   void DefineMatrices(ARdsNonSymMatrix<ARTYPE, ARFLOAT>& Ap, 
                       ARdsNonSymMatrix<ARTYPE, ARFLOAT>& Bp);
 
@@ -119,6 +130,8 @@ void ARdsNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
                       "ARdsNonSymPencil::FactorAsB");
   }
 
+  part = 'N';   // shift is real.
+
   // Quitting the function if A and B are not square.
 
   if ((A->nrows() != A->ncols()) || (B->nrows() != B->ncols())) {
@@ -256,8 +269,8 @@ void ARdsNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
     int              i;
     arcomplex<ARFLOAT> *tv, *tw;
 
-    tv = new arcomplex<ARFLOAT>[AsBc.ncols()];
-    tw = new arcomplex<ARFLOAT>[AsBc.ncols()];
+    tv = wcomp.Get(2*(size_t)AsBc.ncols());
+    tw = tv + AsBc.ncols();
 
     for (i=0; i!=AsBc.ncols(); i++) tv[i] = arcomplex<ARFLOAT>(v[i], 0.0);
 
@@ -270,9 +283,6 @@ void ARdsNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
       for (i=0; i!=AsBc.ncols(); i++) w[i] = real(tw[i]);
     }
 
-    delete[] tv;
-    delete[] tw;
-
 #endif // ARCOMP_H.
 
   }
@@ -280,6 +290,66 @@ void ARdsNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
 } // MultInvAsBv (ARFLOAT).
 
 
+#ifdef ARCOMP_H
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymPencil<ARTYPE, ARFLOAT>::
+MultInvAsBm(int k, const arcomplex<ARFLOAT>* V, int ldv,
+            arcomplex<ARFLOAT>* W, int ldw)
+{
+
+  AsB.MultInvMm(k, (const ARTYPE*)V, ldv, (ARTYPE*)W, ldw);
+
+} // MultInvAsBm (arcomplex<ARFLOAT>).
+#endif // ARCOMP_H.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARdsNonSymPencil<ARTYPE, ARFLOAT>::
+MultInvAsBm(int k, const ARFLOAT* V, int ldv, ARFLOAT* W, int ldw)
+{
+
+  if (part == 'N') {    // shift is real.
+
+    AsB.MultInvMm(k, (const ARTYPE*)V, ldv, (ARTYPE*)W, ldw);
+
+  }
+  else {                // shift is complex.
+
+#ifdef ARCOMP_H
+
+    int                i, r;
+    int                n = AsBc.ncols();
+    arcomplex<ARFLOAT> *tv, *tw;
+
+    tv = wcomp.Get(2*(size_t)n*k);
+    tw = tv + (size_t)n*k;
+
+    for (r=0; r!=k; r++) {
+      for (i=0; i!=n; i++) {
+        tv[(size_t)r*n+i] = arcomplex<ARFLOAT>(V[(size_t)r*ldv+i], 0.0);
+      }
+    }
+
+    AsBc.MultInvMm(k, tv, n, tw, n);
+
+    for (r=0; r!=k; r++) {
+      ARFLOAT*                  w = &W[(size_t)r*ldw];
+      const arcomplex<ARFLOAT>* t = &tw[(size_t)r*n];
+      if (part=='I') {
+        for (i=0; i!=n; i++) w[i] = imag(t[i]);
+      }
+      else {
+        for (i=0; i!=n; i++) w[i] = real(t[i]);
+      }
+    }
+
+#endif // ARCOMP_H.
+
+  }
+
+} // MultInvAsBm (ARFLOAT).
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARdsNonSymPencil<ARTYPE, ARFLOAT>::
 DefineMatrices(ARdsNonSymMatrix<ARTYPE, ARFLOAT>& Ap, 
@@ -303,6 +373,7 @@ ARdsNonSymPencil(ARdsNonSymMatrix<ARTYPE, ARFLOAT>& Ap,
                  ARdsNonSymMatrix<ARTYPE, ARFLOAT>& Bp)
 {
 
+  part = 'N';
   DefineMatrices(Ap, Bp);
 
 } // Long constructor.
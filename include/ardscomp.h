@@ -99,6 +99,7 @@ inline void ARluCompStdEig<ARFLOAT>::SetRegularMode()
            ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetRegularMode(this->objOP, 
                    &ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -112,6 +113,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARdsNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -128,6 +130,7 @@ ARluCompStdEig(int nevp, ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A,
                    &ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -144,6 +147,7 @@ ARluCompStdEig(int nevp, ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
@@ -5,6 +5,15 @@
    MODULE ARDSMat.h.
    Arpack++ class ARdsSymMatrix definition.
 
+   The matrix may be given in LAPACK packed storage (the default) or
+   in full storage (an n x n array of which only the uplo triangle is
+   used). A - sigma*I is factored either in packed storage (sptrf) or
+   in full storage with the blocked routines potrf (when A - sigma*I is
+   positive definite) and sytrf, which are much faster for large n and
+   can use a threaded BLAS. By default the full storage factorization
+   is used if the matrix is given in full storage or if n is large and
+   the n x n array fits in the available memory (see SetFactorStorage).
+
    ARPACK Authors
       Richard Lehoucq
       Danny Sorensen
@@ -21,13 +30,37 @@
 #define ARDSMAT_H
 
 #include <cstddef>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
 
 #include "arch.h"
 #include "armat.h"
 #include "arerror.h"
+#include "arwork.h"
 #include "blas1c.h"
 #include "lapackc.h"
 
+
+/* ARdsAvailableMemory */
+
+inline double ARdsAvailableMemory()
+// Physical memory available to the process, in bytes, or 0 if unknown.
+{
+#if defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGESIZE)
+  long pages = sysconf(_SC_AVPHYS_PAGES);
+  long size  = sysconf(_SC_PAGESIZE);
+  if ((pages > 0) && (size > 0)) return (double)pages*(double)size;
+#elif defined(_SC_PHYS_PAGES) && defined(_SC_PAGESIZE)
+  long pages = sysconf(_SC_PHYS_PAGES);
+  long size  = sysconf(_SC_PAGESIZE);
+  if ((pages > 0) && (size > 0)) return (double)pages*(double)size/2.0;
+#endif
+  return 0.0;
+
+} // ARdsAvailableMemory.
+
+
 template<class ARTYPE> class ARdsSymPencil;
 
 template<class ARTYPE>
@@ -39,39 +72,107 @@ class ARdsSymMatrix: public ARMatrix<ARTYPE> {
 
   bool     factored;
   char     uplo;
-  int      info;
-  int*     ipiv;
+  char     storage;     // 'P' (packed) or 'F' (full): storage of A.
+  char     mode;        // 'A', 'P' or 'F' (see SetFactorStorage).
+  char     factor;      // 'P' (sptrf), 'L' (sytrf) or 'C' (potrf).
+  ARint    info;
+  ARint*   ipiv;
   ARTYPE*  A;
   ARTYPE*  Ainv;
 
+  // A - sigma*I is not positive definite for sigma >= indefShift, so
+  // potrf is not tried for those shifts.
+  bool     indefKnown;
+  ARTYPE   indefShift;
+
+  ARWorkspace<ARTYPE> work;  // Work array of sytrf.
+
+  static size_t Position(int n, bool full, char uplop, int i, int j);
+  // Position of entry (i,j), which must be in the uplop triangle, in
+  // a packed or full n x n array.
+
   void ClearMem(); 
 
   virtual void Copy(const ARdsSymMatrix& other);
 
+  void Store(ARTYPE alpha, ARTYPE* dst, bool full, char uplod, bool add);
+  // Sets the uplod triangle of dst (packed or full storage) to
+  // alpha*A, or adds alpha*A to it if add is true.
+
   void SubtractAsI(ARTYPE sigma);
 
+  bool FullFactor();
+  // True if A - sigma*I is to be factored in full storage.
+
   void CreateStructure();
 
+  template<class FILL>
+  void Factor(ARTYPE sigma, FILL fill);
+  // Factors the matrix written to Ainv by fill(Ainv, full), which
+  // is A - sigma*I (or A - sigma*B for ARdsSymPencil).
+
   void ThrowError();
+
+  void Solve(int k, ARTYPE* W, int ldw);
+  // Overwrites the k columns of W with the solution of Ainv*X = W.
   
  public:
 
+  static const int FullMinSize = 256;
+  // Smallest n for which the full storage factorization is chosen
+  // automatically when A is given in packed storage.
+
   bool IsFactored() { return factored; }
 
+  char Factorization() { return factor; }
+  // 'P' (packed LDL'), 'L' (full storage LDL') or 'C' (Cholesky).
+
+  void SetFactorStorage(char modep);
+  // Storage used by FactorA and FactorAsI: 'P' (packed, sptrf), 'F'
+  // (full, potrf or sytrf) or 'A' (automatic, the default). The full
+  // storage factorization needs n*n entries instead of n*(n+1)/2.
+
   void FactorA();
 
   void FactorAsI(ARTYPE sigma);
 
+  void Inertia(int& neg, int& zero, int& pos);
+  // Number of negative, zero and positive eigenvalues of the factored
+  // matrix (A or A - sigma*I), read from the diagonal blocks of its
+  // factorization (Sylvester's law of inertia).
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Factors A - sigma*I and returns the number of eigenvalues of A
+  // smaller than sigma.
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
-  void MultInvv(ARTYPE* v, ARTYPE* w);
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
 
-  void DefineMatrix(int np, ARTYPE* Ap, char uplop = 'L');
+  void MultInvv(ARTYPE* v, ARTYPE* w);
 
-  ARdsSymMatrix(): ARMatrix<ARTYPE>() { factored = false; }
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
+  void DefineMatrix(int np, ARTYPE* Ap, char uplop = 'L',
+                    char storagep = 'P');
+  // If storagep is 'F', Ap is an n x n array (stored by columns) of
+  // which only the uplop triangle is used. Otherwise, Ap holds the
+  // uplop triangle in LAPACK packed storage.
+
+  ARdsSymMatrix(): ARMatrix<ARTYPE>()
+  {
+    factored   = false;
+    storage    = 'P';
+    mode       = 'A';
+    factor     = 'P';
+    indefKnown = false;
+    Ainv       = NULL;
+    ipiv       = NULL;
+  }
   // Short constructor that does nothing.
 
-  ARdsSymMatrix(int np, ARTYPE* Ap, char uplop = 'L');
+  ARdsSymMatrix(int np, ARTYPE* Ap, char uplop = 'L', char storagep = 'P');
   // Long constructor.
 
   ARdsSymMatrix(const ARdsSymMatrix& other) { Copy(other); }
@@ -90,16 +191,27 @@ class ARdsSymMatrix: public ARMatrix<ARTYPE> {
 // ------------------------------------------------------------------------ //
 
 
+template<class ARTYPE>
+inline size_t ARdsSymMatrix<ARTYPE>::
+Position(int n, bool full, char uplop, int i, int j)
+{
+
+  if (full) return (size_t)i+(size_t)j*n;
+  if (uplop == 'L') return (size_t)j*n-((size_t)j*(j-1))/2+(i-j);
+  return (size_t)i+((size_t)j*(j+1))/2;
+
+} // Position.
+
+
 template<class ARTYPE>
 inline void ARdsSymMatrix<ARTYPE>::ClearMem()
 { 
 
-  if (factored) {
-    delete[] Ainv;
-    delete[] ipiv; 
-    Ainv = NULL;
-    ipiv = NULL;
-  }
+  delete[] Ainv;
+  delete[] ipiv; 
+  Ainv     = NULL;
+  ipiv     = NULL;
+  factored = false;
 
 } // ClearMem.
 
@@ -116,8 +228,14 @@ Copy(const ARdsSymMatrix<ARTYPE>& other)
   this->defined   = other.defined;
   factored  = other.factored;
   uplo      = other.uplo;
+  storage   = other.storage;
+  mode      = other.mode;
+  factor    = other.factor;
   info      = other.info;
   A         = other.A;
+  Ainv      = NULL;
+  ipiv      = NULL;
+  indefKnown = false;
 
   // Returning from here if "other" was not factored.
 
@@ -125,48 +243,180 @@ Copy(const ARdsSymMatrix<ARTYPE>& other)
 
   // Copying vectors.
 
-  Ainv = new ARTYPE[(this->n*this->n+this->n)/2];
-  ipiv = new int[this->n];
+  size_t size = (factor == 'P') ? ((size_t)this->n*this->n+this->n)/2
+                                : (size_t)this->n*this->n;
+
+  Ainv = new ARTYPE[size];
+  ipiv = new ARint[this->n];
 
-  copy((this->n*this->n+this->n)/2, other.Ainv, 1, Ainv, 1);
+  for (size_t i=0; i<size; i++) Ainv[i] = other.Ainv[i];
   for (int i=0; i<this->n; i++) ipiv[i] = other.ipiv[i];
 
 } // Copy.
 
 
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::
+Store(ARTYPE alpha, ARTYPE* dst, bool full, char uplod, bool add)
+{
+
+  int    i, j, first, last;
+  int    n    = this->n;
+  bool   same = (uplod == uplo);
+
+  for (j=0; j<n; j++) {
+
+    if (uplod == 'L') { first = j; last = n; } else { first = 0; last = j+1; }
+
+    ARTYPE* d = &dst[Position(n, full, uplod, first, j)];
+
+    if (same) {
+
+      // Column j of the triangle is contiguous in both arrays.
+
+      const ARTYPE* a = &A[Position(n, storage == 'F', uplo, first, j)];
+      if (add) {
+        axpy(last-first, alpha, a, 1, d, 1);
+      }
+      else if (alpha == (ARTYPE)1) {
+        copy(last-first, a, 1, d, 1);
+      }
+      else {
+        for (i=0; i<last-first; i++) d[i] = alpha*a[i];
+      }
+
+    }
+    else {
+
+      // Column j of the uplod triangle is row j of the uplo triangle.
+
+      for (i=first; i<last; i++) {
+        ARTYPE a = alpha*A[Position(n, storage == 'F', uplo, j, i)];
+        if (add) d[i-first] += a; else d[i-first] = a;
+      }
+
+    }
+
+  }
+
+} // Store.
+
+
 template<class ARTYPE>
 void ARdsSymMatrix<ARTYPE>::SubtractAsI(ARTYPE sigma)
 {
 
-  int i,j;
+  bool full = (factor != 'P');
 
   // Copying A to Ainv.
 
-  ::copy((this->n*this->n+this->n)/2 ,A, 1, Ainv, 1);
+  Store((ARTYPE)1, Ainv, full, uplo, false);
 
   // Subtracting sigma from diagonal elements.
 
-  if (uplo=='L') {
-    for (i=0, j=0; i<this->n; j+=(this->n-(i++))) Ainv[j] -= sigma;
-  }
-  else {
-    for (i=0, j=0; i<this->n; j+=(++i)) Ainv[j] -= sigma;
+  for (int i=0; i<this->n; i++) {
+    Ainv[Position(this->n, full, uplo, i, i)] -= sigma;
   }
 
 } // SubtractAsI.
 
 
+template<class ARTYPE>
+bool ARdsSymMatrix<ARTYPE>::FullFactor()
+{
+
+  if (mode != 'A') return (mode == 'F');
+
+  // Automatic choice. A given in full storage is factored in full
+  // storage. Otherwise, the n x n array must fit in half of the
+  // available memory (if it is known).
+
+  if (storage == 'F') return true;
+  if (this->n < FullMinSize) return false;
+
+  double avail = ARdsAvailableMemory();
+  double need  = (double)this->n*(double)this->n*sizeof(ARTYPE);
+
+  return (avail == 0.0) || (2.0*need <= avail);
+
+} // FullFactor.
+
+
 template<class ARTYPE>
 inline void ARdsSymMatrix<ARTYPE>::CreateStructure()
 {
 
+  bool full = FullFactor();
+
   ClearMem();
-  Ainv = new ARTYPE[(this->n*this->n+this->n)/2];
-  ipiv = new int[this->n];
+  factor = full ? 'L' : 'P';
+  Ainv   = new ARTYPE[full ? (size_t)this->n*this->n
+                           : ((size_t)this->n*this->n+this->n)/2];
+  ipiv   = new ARint[this->n];
 
 } // CreateStructure.
 
 
+template<class ARTYPE>
+template<class FILL>
+void ARdsSymMatrix<ARTYPE>::Factor(ARTYPE sigma, FILL fill)
+{
+
+  // Reserving memory for some vectors used in matrix decomposition.
+
+  CreateStructure();
+
+  if (factor == 'P') {
+
+    fill(Ainv, false);
+    sptrf(&uplo, this->n, Ainv, ipiv, info);
+
+  }
+  else {
+
+    // Trying a Cholesky factorization first, unless a smaller shift
+    // already gave an indefinite matrix. potrf stops at the first
+    // nonpositive pivot.
+
+    if (!indefKnown || (sigma < indefShift)) {
+
+      fill(Ainv, true);
+      potrf(&uplo, this->n, Ainv, this->n, info);
+
+      if (info == 0) {
+        factor   = 'C';
+        factored = true;
+        return;
+      }
+      if (info > 0) {
+        indefKnown = true;
+        indefShift = sigma;
+      }
+
+    }
+
+    // LDL' decomposition with Bunch-Kaufman pivoting.
+
+    ARint  lwork = -1;
+    ARTYPE wsize;
+
+    fill(Ainv, true);
+    sytrf(&uplo, this->n, Ainv, this->n, ipiv, &wsize, lwork, info);
+    lwork = (ARint)wsize;
+    if (lwork < 1) lwork = 1;
+    sytrf(&uplo, this->n, Ainv, this->n, ipiv, work.Get(lwork), lwork, info);
+
+  }
+
+  // Handling errors.
+
+  ThrowError();
+
+  factored = true;
+
+} // Factor.
+
+
 template<class ARTYPE>
 inline void ARdsSymMatrix<ARTYPE>::ThrowError()
 {
@@ -184,32 +434,50 @@ inline void ARdsSymMatrix<ARTYPE>::ThrowError()
 
 
 template<class ARTYPE>
-void ARdsSymMatrix<ARTYPE>::FactorA()
+inline void ARdsSymMatrix<ARTYPE>::Solve(int k, ARTYPE* W, int ldw)
 {
 
-  // Quitting the function if A was not defined.
-
-  if (!this->IsDefined()) {
-    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsSymMatrix::FactorA");
+  if (factor == 'C') {
+    potrs(&uplo, this->n, k, Ainv, this->n, W, ldw, info);
+  }
+  else if (factor == 'L') {
+    sytrs(&uplo, this->n, k, Ainv, this->n, ipiv, W, ldw, info);
+  }
+  else {
+    sptrs(&uplo, this->n, k, Ainv, ipiv, W, ldw, info);
   }
 
-  // Reserving memory for some vectors used in matrix decomposition.
+} // Solve.
 
-  CreateStructure();
 
-  // Copying A to Ainv;
+template<class ARTYPE>
+inline void ARdsSymMatrix<ARTYPE>::SetFactorStorage(char modep)
+{
 
-  ::copy((this->n*this->n+this->n)/2 ,A, 1, Ainv, 1);
+  if ((modep != 'A') && (modep != 'P') && (modep != 'F')) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARdsSymMatrix::SetFactorStorage");
+  }
+  mode = modep;
 
-  // Decomposing A.
+} // SetFactorStorage.
 
-  sptrf(&uplo, this->n, Ainv, ipiv, info);
 
-  // Handling errors.
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::FactorA()
+{
 
-  ThrowError();
+  // Quitting the function if A was not defined.
 
-  factored = true;
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsSymMatrix::FactorA");
+  }
+
+  // Copying A to Ainv and decomposing it.
+
+  Factor((ARTYPE)0, [this](ARTYPE* dst, bool full) {
+    Store((ARTYPE)1, dst, full, uplo, false);
+  });
 
 } // FactorA.
 
@@ -224,34 +492,95 @@ void ARdsSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsSymMatrix::FactorAsI");
   }
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // Subtracting sigma*I from A and decomposing AsI.
 
-  CreateStructure();
+  Factor(sigma, [this, sigma](ARTYPE*, bool) { SubtractAsI(sigma); });
 
-  // Subtracting sigma*I from A.
+} // FactorAsI.
 
-  SubtractAsI(sigma);
 
-  // Decomposing AsI.
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::Inertia(int& neg, int& zero, int& pos)
+{
 
-  sptrf(&uplo, this->n, Ainv, ipiv, info);
+  int  i, n = this->n;
+  bool full = (factor == 'L');
 
-  // Handling errors.
+  // Quitting the function if A (or AsI) was not factored.
 
-  ThrowError();
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARdsSymMatrix::Inertia");
+  }
 
-  factored = true;
+  neg = zero = pos = 0;
 
-} // FactorAsI.
+  // A Cholesky factorization exists only for positive definite matrices.
+
+  if (factor == 'C') {
+    pos = n;
+    return;
+  }
+
+  // D is made of 1x1 blocks and of 2x2 blocks, whose two rows have
+  // negative (and equal) entries in ipiv.
+
+  for (i = 0; i < n; i++) {
+
+    ARTYPE a = Ainv[Position(n, full, uplo, i, i)];
+
+    if ((ipiv[i] > 0) || (i == n-1)) {
+      if (a < (ARTYPE)0) neg++;
+      else if (a > (ARTYPE)0) pos++;
+      else zero++;
+      continue;
+    }
+
+    ARTYPE b   = (uplo == 'L') ? Ainv[Position(n, full, uplo, i+1, i)]
+                               : Ainv[Position(n, full, uplo, i, i+1)];
+    ARTYPE c   = Ainv[Position(n, full, uplo, i+1, i+1)];
+    ARTYPE det = a*c-b*b;
+
+    if (det < (ARTYPE)0) {          // One eigenvalue of each sign.
+      neg++;
+      pos++;
+    }
+    else if (det > (ARTYPE)0) {     // Two eigenvalues with the sign of a.
+      if (a < (ARTYPE)0) neg += 2; else pos += 2;
+    }
+    else {                          // One zero eigenvalue.
+      zero++;
+      if (a+c < (ARTYPE)0) neg++;
+      else if (a+c > (ARTYPE)0) pos++;
+      else zero++;
+    }
+    i++;
+
+  }
+
+} // Inertia.
 
 
 template<class ARTYPE>
-void ARdsSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
+int ARdsSymMatrix<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
 {
 
-  int     i, j;
+  int neg, zero, pos;
+
+  FactorAsI(sigma);
+  Inertia(neg, zero, pos);
+
+  return neg;
+
+} // CountEigenvaluesBelow.
+
+
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
+{
 
   ARTYPE  zero = (ARTYPE)0;
+  ARTYPE  one  = (ARTYPE)1;
 
   // Quitting the function if A was not defined.
 
@@ -259,29 +588,74 @@ void ARdsSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsSymMatrix::MultMv");
   }
 
-  // Determining w = M.v (unfortunately, the BLAS does not 
-  // have a routine that works with packed matrices).
+  // Determining w = M.v.
 
-  for (i=0; i<this->n; i++) w[i] = zero;
+  if (storage == 'F') {
+    symv(&uplo, this->n, one, A, this->n, v, 1, zero, w, 1);
+  }
+  else {
+    spmv(&uplo, this->n, one, A, v, 1, zero, w, 1);
+  }
+
+} // MultMv.
+
+
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv,
+                                   ARTYPE* W, int ldw)
+{
+
+  int     i, j, r;
+
+  ARTYPE  zero = (ARTYPE)0;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARdsSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V.
+
+  if (storage == 'F') {
+    symm("L", &uplo, this->n, k, (ARTYPE)1, A, this->n, V, ldv,
+         zero, W, ldw);
+    return;
+  }
+
+  // Each packed column of A is used for all k vectors while it is
+  // still in cache.
+
+  for (r=0; r<k; r++) {
+    for (i=0; i<this->n; i++) W[i+(size_t)r*ldw] = zero;
+  }
 
   if (uplo=='L') {
- 
+
     for (i=0, j=0; i<this->n; j+=(this->n-(i++))) {
-      w[i] += dot(this->n-i, &A[j], 1, &v[i], 1);
-      axpy(this->n-i-1, v[i], &A[j+1], 1, &w[i+1], 1);
+      for (r=0; r<k; r++) {
+        const ARTYPE* v = &V[(size_t)r*ldv];
+        ARTYPE*       w = &W[(size_t)r*ldw];
+        w[i] += dot(this->n-i, &A[j], 1, &v[i], 1);
+        axpy(this->n-i-1, v[i], &A[j+1], 1, &w[i+1], 1);
+      }
     }
- 
-  }  
+
+  }
   else { // uplo = 'U'
 
     for (i=0, j=0; i<this->n; j+=(++i)) {
-      w[i] += dot(i+1, &A[j], 1, v, 1);
-      axpy(i, v[i], &A[j], 1, w, 1);
+      for (r=0; r<k; r++) {
+        const ARTYPE* v = &V[(size_t)r*ldv];
+        ARTYPE*       w = &W[(size_t)r*ldw];
+        w[i] += dot(i+1, &A[j], 1, v, 1);
+        axpy(i, v[i], &A[j], 1, w, 1);
+      }
     }
-   
+
   }
 
-} // MultMv.
+} // MultMm.
 
 
 template<class ARTYPE>
@@ -301,7 +675,7 @@ void ARdsSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 
   // Solving A.w = v (or AsI.w = v).
 
-  sptrs(&uplo, this->n, 1, Ainv, ipiv, w, this->n, info);
+  Solve(1, w, this->n);
 
   // Handling errors.
 
@@ -310,32 +684,72 @@ void ARdsSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARdsSymMatrix<ARTYPE>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                      ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARdsSymMatrix::MultInvMm");
+  }
+
+  // Overwritting W with V.
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+
+  // Solving A.W = V (or AsI.W = V).
+
+  Solve(k, W, ldw);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvMm.
+
+
 template<class ARTYPE>
 inline void ARdsSymMatrix<ARTYPE>::
-DefineMatrix(int np, ARTYPE* Ap, char uplop)
+DefineMatrix(int np, ARTYPE* Ap, char uplop, char storagep)
 {
 
+  // Discarding the previous factorization.
+
+  ClearMem();
+
   // Defining member variables.
 
   this->m         = np;
   this->n         = np;
   uplo      = uplop;
+  storage   = (storagep == 'F') ? 'F' : 'P';
   A         = Ap;
   this->defined   = true;
-  Ainv      = NULL;
-  ipiv      = NULL;
   info      = 0; 
+  indefKnown = false;
 
 } // DefineMatrix.
 
 
 template<class ARTYPE>
 inline ARdsSymMatrix<ARTYPE>::
-ARdsSymMatrix(int np, ARTYPE* Ap, char uplop) : ARMatrix<ARTYPE>(np)
+ARdsSymMatrix(int np, ARTYPE* Ap, char uplop, char storagep)
+  : ARMatrix<ARTYPE>(np)
 {
 
   factored = false;
-  DefineMatrix(np, Ap, uplop);
+  mode     = 'A';
+  factor   = 'P';
+  Ainv     = NULL;
+  ipiv     = NULL;
+  DefineMatrix(np, Ap, uplop, storagep);
 
 } // Long constructor.
 
@@ -99,6 +99,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARdsNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetRegularMode(this->objOP, &ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -110,6 +111,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARdsNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, 
                        &ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -126,6 +128,7 @@ ARluNonSymStdEig(int nevp, ARdsNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -141,6 +144,7 @@ ARluNonSymStdEig(int nevp, ARdsNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARdsNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
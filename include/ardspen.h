@@ -36,7 +36,7 @@ class ARdsSymPencil
 
   virtual void Copy(const ARdsSymPencil& other);
 
-  void SubtractAsB(ARTYPE sigma);
+  void SubtractAsB(ARTYPE sigma, ARTYPE* dst, bool full);
 
  public:
 
@@ -44,6 +44,13 @@ class ARdsSymPencil
 
   void FactorAsB(ARTYPE sigma);
 
+  void Inertia(int& neg, int& zero, int& pos) { AsB.Inertia(neg, zero, pos); }
+  // Number of negative, zero and positive eigenvalues of A - sigma*B.
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Factors A - sigma*B and returns the number of eigenvalues of the
+  // pencil smaller than sigma. B must be positive definite.
+
   void MultAv(ARTYPE* v, ARTYPE* w) { A->MultMv(v,w); }
 
   void MultBv(ARTYPE* v, ARTYPE* w) { B->MultMv(v,w); }
@@ -52,6 +59,11 @@ class ARdsSymPencil
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w) {  AsB.MultInvv(v,w); }
 
+  void MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+  {
+    AsB.MultInvMm(k, V, ldv, W, ldw);
+  }
+
   void DefineMatrices(ARdsSymMatrix<ARTYPE>& Ap, ARdsSymMatrix<ARTYPE>& Bp);
 
   ARdsSymPencil() { AsB.factored = false; }
@@ -88,15 +100,13 @@ inline void ARdsSymPencil<ARTYPE>::Copy(const ARdsSymPencil<ARTYPE>& other)
 
 
 template<class ARTYPE>
-void ARdsSymPencil<ARTYPE>::SubtractAsB(ARTYPE sigma)
+void ARdsSymPencil<ARTYPE>::
+SubtractAsB(ARTYPE sigma, ARTYPE* dst, bool full)
 {
 
-  int sizeA, i, j, k, l;
-
-  // Copying A into AsB.
+  // Copying A into dst (packed or full storage, AsB.uplo triangle).
 
-  sizeA = (A->ncols()*A->ncols()+A->ncols())/2;
-  ::copy(sizeA, A->A, 1, AsB.Ainv, 1);
+  A->Store((ARTYPE)1, dst, full, AsB.uplo, false);
 
   // Returning if sigma == 0.
 
@@ -104,32 +114,8 @@ void ARdsSymPencil<ARTYPE>::SubtractAsB(ARTYPE sigma)
 
   // Subtracting sigma*B.
 
-  if (A->uplo == B->uplo) {
-
-    axpy(sizeA, -sigma, B->A, 1, AsB.Ainv, 1); 
-
-  }
-  else if (A->uplo == 'L') { // B->uplo == 'U'
-
-    j = 0;
-    for (i=0; i<A->n; i++) {
-      for (l=i+1, k=(l*l+l)/2-1; l<=A->n; k+=(l++)) {
-        AsB.Ainv[j++]-=sigma*B->A[k];
-      }
-    }
+  B->Store(-sigma, dst, full, AsB.uplo, true);
 
-  }
-  else { // A->uplo == 'U'  &&  B->uplo == 'L'
-
-    j = 0;
-    for (i=0; i<A->n; i++) {
-      for (l=i+1, k=(l*l+l)/2-1; l<=A->n; k+=(l++)) {
-        AsB.Ainv[k]-=sigma*B->A[j++];
-      }
-    }
-
-  }
-    
 } // SubtractAsB (ARTYPE shift).
 
 
@@ -154,31 +140,35 @@ void ARdsSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
 
   }
 
-  // Defining matrix AsB.
+  // Defining matrix AsB. It is factored in the storage chosen for A.
 
   if (!AsB.IsDefined()) {
-    AsB.DefineMatrix(A->ncols(), A->A, A->uplo);
+    AsB.DefineMatrix(A->ncols(), A->A, A->uplo, A->storage);
   }
+  AsB.mode = A->mode;
 
-  // Reserving memory for some vectors used in matrix decomposition.
-
-  AsB.CreateStructure(); 
+  // Subtracting sigma*B from A, storing the result on AsB and
+  // decomposing it.
 
-  // Subtracting sigma*B from A and storing the result on AsB.
+  AsB.Factor(sigma, [this, sigma](ARTYPE* dst, bool full) {
+    SubtractAsB(sigma, dst, full);
+  });
 
-  SubtractAsB(sigma);
+} // FactorAsB (ARTYPE shift).
 
-  // Decomposing AsB.
 
-  sptrf(&AsB.uplo, AsB.n, AsB.Ainv, AsB.ipiv, AsB.info);
+template<class ARTYPE>
+int ARdsSymPencil<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
+{
 
-  // Handling errors.
+  int neg, zero, pos;
 
-  AsB.ThrowError();
+  FactorAsB(sigma);
+  Inertia(neg, zero, pos);
 
-  AsB.factored = true;
+  return neg;
 
-} // FactorAsB (ARTYPE shift).
+} // CountEigenvaluesBelow.
 
 
 template<class ARTYPE>
@@ -99,6 +99,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARdsSymMatrix<ARFLOAT> >::
     SetRegularMode(this->objOP, &ARdsSymMatrix<ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARdsSymMatrix<ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -109,6 +110,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARdsSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARdsSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARdsSymMatrix<ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -123,6 +125,7 @@ ARluSymStdEig(int nevp, ARdsSymMatrix<ARFLOAT>& A,
   this->NoShift();
   this->DefineParameters(A.ncols(), nevp, &A, &ARdsSymMatrix<ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARdsSymMatrix<ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -137,6 +140,7 @@ ARluSymStdEig(int nevp, ARdsSymMatrix<ARFLOAT>& A,
 
   this->DefineParameters(A.ncols(), nevp, &A, &ARdsSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARdsSymMatrix<ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
@@ -204,8 +204,8 @@ void ARNonSymGenEig<ARFLOAT, ARFOP, ARFB>::RecoverEigenvalues()
 
       // Computing the first eigenvalue of the conjugate pair.
 
-      this->EigValR[j] = (numr*denr+numi*deni) / lapy2(denr, deni);
-      this->EigValI[j] = (numi*denr-numr*deni) / lapy2(denr, deni);
+      this->EigValR[j] = (numr*denr+numi*deni) / (denr*denr+deni*deni);
+      this->EigValI[j] = (numi*denr-numr*deni) / (denr*denr+deni*deni);
 
       // Getting the second eigenvalue of the conjugate pair by taking
       // the conjugate of the first.
@@ -0,0 +1,257 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE argram.h
+   Fused products w = A'*A*v and w = A*A'*v for matrices stored in
+   compressed column format. Used by the MultMtMv and MultMMtv
+   functions of ARluNonSymMatrix and ARumNonSymMatrix (and thus by
+   the SVD examples).
+
+   A*A'*v is the sum of a_j*(a_j'*v) over the columns a_j of A, so
+   it can be computed column by column (a dot product followed by an
+   axpy on the same entries), reading A only once and without a
+   temporary vector. A'*A*v is computed in the same way from a copy
+   of A stored by rows, which is built on the first call.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARGRAM_H
+#define ARGRAM_H
+
+#include <cstddef>
+#include <vector>
+#include "arthread.h"
+
+
+/* ARGramSweep */
+
+template<class ARINT, class ARTYPE>
+inline void ARGramSweep(int first, int last, const ARINT* ptr,
+                        const ARINT* idx, const ARTYPE* val,
+                        const ARTYPE* v, ARTYPE* w)
+// Adds c*(c'*v) to w for the compressed vectors c = first, ...,
+// last-1 (entries ptr[c], ..., ptr[c+1]-1 of idx and val). The
+// second loop reads the entries just loaded by the first one.
+{
+
+  for (int j = first; j < last; j++) {
+
+    ARTYPE s = (ARTYPE)0;
+    ARINT  p;
+
+    for (p = ptr[j]; p < ptr[j+1]; p++) s += val[p]*v[idx[p]];
+    for (p = ptr[j]; p < ptr[j+1]; p++) w[idx[p]] += val[p]*s;
+
+  }
+
+} // ARGramSweep.
+
+
+template<class ARINT, class ARTYPE>
+class ARGramProduct {
+
+ protected:
+
+  int nthreads;
+
+  // A stored by rows (the compressed columns of A').
+
+  std::vector<ARINT>  rp;
+  std::vector<ARINT>  rj;
+  std::vector<ARTYPE> rx;
+
+  // Vectors assigned to each thread, for A'*A*v and A*A'*v,
+  // and entries of w assigned to each thread in the final sum.
+
+  std::vector<int> boundsMtM;
+  std::vector<int> boundsMMt;
+  std::vector<int> boundsSum;
+
+  // Partial results of threads 1, ..., nthreads-1.
+
+  std::vector<ARTYPE> work;
+
+  void BuildRows(int m, int n, const ARINT* ap, const ARINT* ai,
+                 const ARTYPE* ax);
+
+  void Sweep(int nvec, int len, const ARINT* ptr, const ARINT* idx,
+             const ARTYPE* val, std::vector<int>& bounds,
+             const ARTYPE* v, ARTYPE* w);
+
+ public:
+
+  int Threads() const { return nthreads; }
+
+  void SetThreads(int nthreadsp);
+  // Sets the number of threads (0 means all cores). Each thread uses
+  // its own copy of w, and the copies are added in a fixed order, so
+  // the result does not change from run to run.
+
+  void Clear();
+  // Discards the copy of A stored by rows. Must be called whenever
+  // the values or the pattern of A change.
+
+  void MultMtMv(int m, int n, const ARINT* ap, const ARINT* ai,
+                const ARTYPE* ax, const ARTYPE* v, ARTYPE* w);
+  // w = A'*A*v, where A (m x n) is given in CSC format.
+
+  void MultMMtv(int m, int n, const ARINT* ap, const ARINT* ai,
+                const ARTYPE* ax, const ARTYPE* v, ARTYPE* w);
+  // w = A*A'*v, where A (m x n) is given in CSC format.
+
+  ARGramProduct() { nthreads = 1; }
+  // Constructor.
+
+}; // class ARGramProduct.
+
+
+// ------------------------------------------------------------------------ //
+// ARGramProduct member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARINT, class ARTYPE>
+void ARGramProduct<ARINT, ARTYPE>::
+BuildRows(int m, int n, const ARINT* ap, const ARINT* ai, const ARTYPE* ax)
+{
+
+  int   i, j;
+  ARINT p, k;
+
+  rp.assign((size_t)m+1, 0);
+  rj.resize((size_t)ap[n]);
+  rx.resize((size_t)ap[n]);
+
+  // Counting the elements in each row.
+
+  for (p = 0; p < ap[n]; p++) rp[ai[p]+1]++;
+  for (i = 0; i < m; i++) rp[i+1] += rp[i];
+
+  // Transposing.
+
+  std::vector<ARINT> next(rp.begin(), rp.end()-1);
+
+  for (j = 0; j < n; j++) {
+    for (p = ap[j]; p < ap[j+1]; p++) {
+      k = next[ai[p]]++;
+      rj[k] = j;
+      rx[k] = ax[p];
+    }
+  }
+
+  boundsMtM.clear();
+
+} // BuildRows.
+
+
+template<class ARINT, class ARTYPE>
+void ARGramProduct<ARINT, ARTYPE>::
+Sweep(int nvec, int len, const ARINT* ptr, const ARINT* idx,
+      const ARTYPE* val, std::vector<int>& bounds,
+      const ARTYPE* v, ARTYPE* w)
+{
+
+  int i;
+
+  for (i = 0; i < len; i++) w[i] = (ARTYPE)0;
+
+  if (nthreads <= 1) {
+    ARGramSweep(0, nvec, ptr, idx, val, v, w);
+    return;
+  }
+
+  // The blocks of vectors are fixed once, by number of nonzeros.
+
+  if ((int)bounds.size() != nthreads + 1) {
+    bounds.resize(nthreads + 1);
+    ARPartition(nthreads, nvec, ptr, bounds.data());
+  }
+
+  boundsSum.resize(nthreads + 1);
+  ARPartition(nthreads, len, (const ARINT*)nullptr, boundsSum.data());
+
+  work.resize((size_t)(nthreads-1)*len);
+
+  ARTYPE* wk = work.data();
+  int     nt = nthreads;
+
+  // Thread 0 works on w, the other ones on their part of work.
+
+  ARParallelFor(nt, bounds.data(), [=](int t, int first, int last) {
+    ARTYPE* wt = w;
+    if (t > 0) {
+      wt = wk + (size_t)(t-1)*len;
+      for (int r = 0; r < len; r++) wt[r] = (ARTYPE)0;
+    }
+    ARGramSweep(first, last, ptr, idx, val, v, wt);
+  });
+
+  // Adding the partial results.
+
+  ARParallelFor(nt, boundsSum.data(), [=](int, int first, int last) {
+    for (int t = 1; t < nt; t++) {
+      const ARTYPE* wt = wk + (size_t)(t-1)*len;
+      for (int r = first; r < last; r++) w[r] += wt[r];
+    }
+  });
+
+} // Sweep.
+
+
+template<class ARINT, class ARTYPE>
+inline void ARGramProduct<ARINT, ARTYPE>::SetThreads(int nthreadsp)
+{
+
+  nthreads = ARThreadCount(nthreadsp);
+  boundsMtM.clear();
+  boundsMMt.clear();
+
+} // SetThreads.
+
+
+template<class ARINT, class ARTYPE>
+inline void ARGramProduct<ARINT, ARTYPE>::Clear()
+{
+
+  rp.clear();
+  rj.clear();
+  rx.clear();
+  boundsMtM.clear();
+  boundsMMt.clear();
+
+} // Clear.
+
+
+template<class ARINT, class ARTYPE>
+inline void ARGramProduct<ARINT, ARTYPE>::
+MultMtMv(int m, int n, const ARINT* ap, const ARINT* ai,
+         const ARTYPE* ax, const ARTYPE* v, ARTYPE* w)
+{
+
+  if (rp.size() != (size_t)m+1) BuildRows(m, n, ap, ai, ax);
+
+  Sweep(m, n, rp.data(), rj.data(), rx.data(), boundsMtM, v, w);
+
+} // MultMtMv.
+
+
+template<class ARINT, class ARTYPE>
+inline void ARGramProduct<ARINT, ARTYPE>::
+MultMMtv(int m, int n, const ARINT* ap, const ARINT* ai,
+         const ARTYPE* ax, const ARTYPE* v, ARTYPE* w)
+{
+
+  Sweep(n, m, ap, ai, ax, boundsMMt, v, w);
+
+} // MultMMtv.
+
+
+#endif // ARGRAM_H
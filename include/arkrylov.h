@@ -0,0 +1,250 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE arkrylov.h.
+   Arpack++ class ARKrylovBasis definition.
+
+   ARKrylovBasis groups the products with the Krylov basis V that are
+   shared by the native Krylov methods (ARTRLanczos, ARKrylovSchur):
+   one pass of classical Gram-Schmidt of a vector (or of a block of
+   vectors) against some columns of V and the change of basis V <- V*Q
+   done in place. All are BLAS 2 / BLAS 3 products on blocks of rows of
+   V, spread among SetThreads() threads.
+   Partial sums are added in a fixed order, so the results depend only
+   on the number of blocks, not on the timing of the threads.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARKRYLOV_H
+#define ARKRYLOV_H
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include "arch.h"
+#include "blas1c.h"
+#include "arthread.h"
+
+
+template<class ARTYPE>
+class ARKrylovBasis {
+
+ protected:
+
+  static constexpr int  RowBlock = 512;   // Rows of V handled by each gemm.
+  static constexpr long MinWork  = 32768; // Minimum work per thread.
+
+  int   nthreads;   // Threads used in the products with V.
+  ARint n;          // Number of rows of V.
+  ARint m;          // Maximum number of columns of V.
+  ARint nb;         // Maximum number of vectors orthogonalized at once.
+
+  std::vector<ARTYPE> h;      // Gram-Schmidt coefficients.
+  std::vector<ARTYPE> hpart;  // Coefficients computed by each thread.
+  std::vector<ARTYPE> vtmp;   // Row blocks of V*Q computed by each thread.
+  std::vector<int>    bounds; // Row blocks.
+
+  int Parts(ARint ncol, ARint k = 1);
+  // Number of blocks of rows used to multiply ncol columns of V by k
+  // vectors. Also sets bounds.
+
+ public:
+
+  int Threads() const { return nthreads; }
+
+  void SetThreads(int nthreadsp) { nthreads = ARThreadCount(nthreadsp); }
+  // Sets the number of threads (<= 0 means all available cores).
+
+  void Define(ARint np, ARint mp, ARint nbp = 1);
+  // Sets the dimensions of V (n x m) and the maximum number of vectors
+  // orthogonalized at once (nbp), and allocates the work arrays.
+
+  const ARTYPE* Coefficients() const { return &h[0]; }
+  // Coefficients h computed by the last call to Orthogonalize (or
+  // OrthogonalizeBlock, stored as a m x k matrix).
+
+  void Orthogonalize(const ARTYPE* V, ARint ldv, ARint ncol,
+                     const ARTYPE* w, ARTYPE* r);
+  // h <- V(:,0:ncol-1)'*w and r <- r - V(:,0:ncol-1)*h, where ' is the
+  // conjugate transpose and w = B*r.
+
+  void OrthogonalizeBlock(const ARTYPE* V, ARint ldv, ARint ncol,
+                          ARTYPE* W, ARint ldw, ARint k);
+  // h <- V(:,0:ncol-1)'*W and W <- W - V(:,0:ncol-1)*h, where W has k
+  // columns (k <= nb).
+
+  void Rotate(ARTYPE* V, ARint ldv, ARint ncol, const ARTYPE* Q);
+  // V(:,0:ncol-1) <- V(:,0:m-1)*Q in place, with Q stored as a m x ncol
+  // matrix.
+
+  void Multiply(const ARTYPE* V, ARint ldv, ARint ncol, const ARTYPE* Q,
+                ARTYPE* W, ARint ldw);
+  // W(:,0:ncol-1) <- V(:,0:m-1)*Q.
+
+  ARKrylovBasis(): nthreads(1), n(0), m(0), nb(1) { }
+  // Constructor.
+
+}; // class ARKrylovBasis.
+
+
+// ------------------------------------------------------------------------ //
+// ARKrylovBasis member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE>
+inline int ARKrylovBasis<ARTYPE>::Parts(ARint ncol, ARint k)
+{
+
+  long nparts = ((long)n*ncol*k)/MinWork;
+  if (nparts > nthreads) nparts = nthreads;
+  if (nparts > n/RowBlock) nparts = n/RowBlock;
+  if (nparts*m*k > (long)hpart.size()) nparts = (long)hpart.size()/(m*k);
+  if (nparts < 1) nparts = 1;
+
+  bounds.resize(nparts+1);
+  ARPartition((int)nparts, (int)n, (const int*)NULL, &bounds[0]);
+  return (int)nparts;
+
+} // Parts.
+
+
+template<class ARTYPE>
+inline void ARKrylovBasis<ARTYPE>::Define(ARint np, ARint mp, ARint nbp)
+{
+
+  n  = np;
+  m  = mp;
+  nb = nbp;
+  h.resize((size_t)m*nb);
+  hpart.resize((size_t)nthreads*m*nb);
+  vtmp.resize((size_t)nthreads*RowBlock*m);
+
+} // Define.
+
+
+template<class ARTYPE>
+void ARKrylovBasis<ARTYPE>::
+Orthogonalize(const ARTYPE* V, ARint ldv, ARint ncol, const ARTYPE* w,
+              ARTYPE* r)
+{
+
+  int     nparts = Parts(ncol);
+  ARTYPE* hp     = &hpart[0];
+  ARint   mm     = m;
+
+  // Partial products V(rows,0:ncol-1)'*w(rows).
+
+  ARParallelFor(nparts, &bounds[0], [=](int t, int first, int last) {
+    gemv("C", last-first, ncol, ARTYPE(1.0), &V[first], ldv, &w[first], 1,
+         ARTYPE(0.0), &hp[t*mm], 1);
+  });
+
+  // Adding the partial products in a fixed order.
+
+  ARTYPE one(1.0);
+  copy(ncol, &hpart[0], 1, &h[0], 1);
+  for (int t=1; t<nparts; t++) axpy(ncol, one, &hpart[t*m], 1, &h[0], 1);
+
+  // r <- r - V*h.
+
+  const ARTYPE* hc = &h[0];
+  ARParallelFor(nparts, &bounds[0], [=](int, int first, int last) {
+    gemv("N", last-first, ncol, ARTYPE(-1.0), &V[first], ldv, hc, 1,
+         ARTYPE(1.0), &r[first], 1);
+  });
+
+} // Orthogonalize.
+
+
+template<class ARTYPE>
+void ARKrylovBasis<ARTYPE>::
+OrthogonalizeBlock(const ARTYPE* V, ARint ldv, ARint ncol, ARTYPE* W,
+                   ARint ldw, ARint k)
+{
+
+  int     nparts = Parts(ncol, k);
+  ARTYPE* hp     = &hpart[0];
+  ARint   mm     = m;
+
+  // Partial products V(rows,0:ncol-1)'*W(rows,:).
+
+  ARParallelFor(nparts, &bounds[0], [=](int t, int first, int last) {
+    gemm("C", "N", ncol, k, last-first, ARTYPE(1.0), &V[first], ldv,
+         &W[first], ldw, ARTYPE(0.0), &hp[(size_t)t*mm*k], mm);
+  });
+
+  // Adding the partial products in a fixed order.
+
+  ARTYPE one(1.0);
+  for (ARint c=0; c<k; c++) {
+    copy(ncol, &hpart[(size_t)c*m], 1, &h[(size_t)c*m], 1);
+    for (int t=1; t<nparts; t++) {
+      axpy(ncol, one, &hpart[((size_t)t*k+c)*m], 1, &h[(size_t)c*m], 1);
+    }
+  }
+
+  // W <- W - V*h.
+
+  const ARTYPE* hc = &h[0];
+  ARParallelFor(nparts, &bounds[0], [=](int, int first, int last) {
+    gemm("N", "N", last-first, k, ncol, ARTYPE(-1.0), &V[first], ldv, hc,
+         mm, ARTYPE(1.0), &W[first], ldw);
+  });
+
+} // OrthogonalizeBlock.
+
+
+template<class ARTYPE>
+void ARKrylovBasis<ARTYPE>::
+Rotate(ARTYPE* V, ARint ldv, ARint ncol, const ARTYPE* Q)
+{
+
+  int     nparts = Parts(m);
+  ARTYPE* tmp    = &vtmp[0];
+  ARint   mm     = m;
+
+  // Each block of rows of V*Q is computed in tmp and copied back to V,
+  // so the product is done in place.
+
+  ARParallelFor(nparts, &bounds[0], [=](int t, int first, int last) {
+    ARTYPE* tt = &tmp[(size_t)t*RowBlock*mm];
+    for (int i=first; i<last; i+=RowBlock) {
+      ARint nr = std::min(RowBlock, last-i);
+      gemm("N", "N", nr, ncol, mm, ARTYPE(1.0), &V[i], ldv, Q, mm,
+           ARTYPE(0.0), tt, nr);
+      for (ARint c=0; c<ncol; c++) {
+        copy(nr, &tt[(size_t)c*nr], 1, &V[i+(size_t)c*ldv], 1);
+      }
+    }
+  });
+
+} // Rotate.
+
+
+template<class ARTYPE>
+void ARKrylovBasis<ARTYPE>::
+Multiply(const ARTYPE* V, ARint ldv, ARint ncol, const ARTYPE* Q,
+         ARTYPE* W, ARint ldw)
+{
+
+  int   nparts = Parts(m);
+  ARint mm     = m;
+
+  ARParallelFor(nparts, &bounds[0], [=](int, int first, int last) {
+    gemm("N", "N", last-first, ncol, mm, ARTYPE(1.0), &V[first], ldv, Q, mm,
+         ARTYPE(0.0), &W[first], ldw);
+  });
+
+} // Multiply.
+
+
+#endif // ARKRYLOV_H
@@ -0,0 +1,1225 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE arkschur.h.
+   Arpack++ class ARKrylovSchur definition.
+
+   ARKrylovSchur is a native C++ implementation of the Krylov-Schur
+   method (G. W. Stewart) that can be used instead of the FORTRAN
+   subroutines dnaupd/dneupd (snaupd/sneupd) by ARrcNonSymStdEig and
+   instead of znaupd/zneupd (cnaupd/cneupd) by ARrcCompStdEig, and by
+   all the classes derived from them (see SetNativeBackend). ARTYPE is
+   ARFLOAT for real nonsymmetric problems and arcomplex<ARFLOAT> for
+   complex problems. Aupp and Eupp follow the calling sequence of naupp
+   and neupp (or caupp and ceupp): the same reverse communication flag
+   ido, the same pointers ipntr[1], ipntr[2] and ipntr[3] into workd,
+   the same modes and the same output in iparam, resid, V and info, so
+   the drivers and the reverse communication interface work without
+   changes.
+
+   Differences with ARPACK:
+
+   - All the state of the method is kept in the object, so several
+     problems can be solved at the same time in different threads.
+   - The restart is done by reordering the Schur form of the projected
+     matrix (gees and trsen) instead of applying implicit shifts, so
+     the wanted Ritz vectors are kept exactly. As in dnaup2, nev
+     wanted Ritz vectors plus min(nconv, (ncv-nev)/2) more are kept,
+     and complex conjugate pairs are never split. Shifts supplied by
+     the user (ido = 3) are not supported.
+   - The Arnoldi vectors are fully reorthogonalized at every step by
+     classical Gram-Schmidt with one DGKS correction, as in dnaitr,
+     using the threaded block products of ARKrylovBasis.
+   - With a block size iparam[4] = nb > 1 (standard problems only), a
+     block Krylov-Schur method is used: OP is applied to nb vectors at
+     each step (x and y in workd are n x nb arrays) and the whole block
+     is orthogonalized with BLAS 3 products. Only the largest multiple
+     of nb not greater than ncv is used, and it must be at least
+     nev+1+2*nb. resid returns the first vector of the residual block.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARKSCHUR_H
+#define ARKSCHUR_H
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+#include "arch.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "lapackc.h"
+#include "arkrylov.h"
+
+
+// ------------------------------------------------------------------------ //
+// ARksDense: Schur form and eigenvectors of the projected matrix.          //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE>
+class ARksDense {
+// Real version: complex eigenvalues appear in conjugate pairs, and the
+// eigenvector of w[k] = a+ib, b > 0, is stored in two columns, k (real
+// part) and k+1 (imaginary part), as in dneupd.
+
+ protected:
+
+  std::vector<ARTYPE>    wr, wi, work;
+  std::vector<ARint>     iwork;
+  std::vector<ARlogical> bwork;
+
+  void Values(ARint m, arcomplex<ARTYPE> w[])
+  {
+    for (ARint k=0; k<m; k++) w[k] = arcomplex<ARTYPE>(wr[k], wi[k]);
+  }
+
+ public:
+
+  static const bool pairs = true;
+
+  void Define(ARint m)
+  {
+    wr.resize(m);
+    wi.resize(m);
+    work.resize(4*m);
+    iwork.resize(1);
+    bwork.resize(m);
+  }
+
+  ARint Schur(ARint m, ARTYPE S[], ARTYPE Z[], arcomplex<ARTYPE> w[])
+  // S <- Z'*S*Z, quasi-triangular, w <- eigenvalues of S.
+  {
+    ARint sdim, info, lwork = (ARint)work.size();
+    gees("V", m, S, m, sdim, &wr[0], &wi[0], Z, m, &work[0], lwork,
+         &bwork[0], info);
+    Values(m, w);
+    return info;
+  }
+
+  ARint Reorder(ARint m, const ARlogical select[], ARTYPE S[], ARTYPE Z[],
+                arcomplex<ARTYPE> w[], ARint& k)
+  // Moves the k selected eigenvalues to the leading block of S.
+  {
+    ARint info, lwork = (ARint)work.size(), liwork = (ARint)iwork.size();
+    trsen("V", select, m, S, m, Z, m, &wr[0], &wi[0], k, &work[0], lwork,
+          &iwork[0], liwork, info);
+    Values(m, w);
+    return info;
+  }
+
+  ARint Vectors(const char* howmny, ARint k, ARTYPE S[], ARint lds,
+                ARTYPE X[], ARint ldx)
+  // Eigenvectors of S(0:k-1,0:k-1) (multiplied by X if howmny = "B").
+  {
+    ARint info, mout;
+    trevc("R", howmny, k, S, lds, (ARTYPE*)NULL, 1, X, ldx, k, mout,
+          &work[0], info);
+    return info;
+  }
+
+  static ARint Partner(ARint k, const arcomplex<ARTYPE> w[])
+  // Index of the conjugate of w[k] (-1 if w[k] is real).
+  {
+    if (w[k].imag() > (ARTYPE)0.0) return k+1;
+    if (w[k].imag() < (ARTYPE)0.0) return k-1;
+    return -1;
+  }
+
+  static arcomplex<ARTYPE> Entry(const ARTYPE X[], ARint ldx, ARint i,
+                                 ARint k, const arcomplex<ARTYPE> w[])
+  // Element i of the eigenvector of w[k].
+  {
+    size_t c = (size_t)k*ldx+i;
+    if (w[k].imag() > (ARTYPE)0.0) return arcomplex<ARTYPE>(X[c], X[c+ldx]);
+    if (w[k].imag() < (ARTYPE)0.0) return arcomplex<ARTYPE>(X[c-ldx], -X[c]);
+    return arcomplex<ARTYPE>(X[c], (ARTYPE)0.0);
+  }
+
+  static ARTYPE Column(const arcomplex<ARTYPE>& c, const arcomplex<ARTYPE>& wk)
+  // Part of c*x stored in column k, where x is the eigenvector of wk.
+  {
+    return (wk.imag() < (ARTYPE)0.0) ? -c.imag() : c.real();
+  }
+
+}; // class ARksDense.
+
+
+template<class ARFLOAT>
+class ARksDense<arcomplex<ARFLOAT> > {
+// Complex version.
+
+ protected:
+
+  std::vector<arcomplex<ARFLOAT> > work;
+  std::vector<ARFLOAT>             rwork;
+  std::vector<ARlogical>           bwork;
+
+ public:
+
+  static const bool pairs = false;
+
+  void Define(ARint m)
+  {
+    work.resize(2*m);
+    rwork.resize(m);
+    bwork.resize(m);
+  }
+
+  ARint Schur(ARint m, arcomplex<ARFLOAT> S[], arcomplex<ARFLOAT> Z[],
+              arcomplex<ARFLOAT> w[])
+  {
+    ARint sdim, info, lwork = (ARint)work.size();
+    gees("V", m, S, m, sdim, w, Z, m, &work[0], lwork, &rwork[0],
+         &bwork[0], info);
+    return info;
+  }
+
+  ARint Reorder(ARint m, const ARlogical select[], arcomplex<ARFLOAT> S[],
+                arcomplex<ARFLOAT> Z[], arcomplex<ARFLOAT> w[], ARint& k)
+  {
+    ARint info, lwork = (ARint)work.size();
+    trsen("V", select, m, S, m, Z, m, w, k, &work[0], lwork, info);
+    return info;
+  }
+
+  ARint Vectors(const char* howmny, ARint k, arcomplex<ARFLOAT> S[],
+                ARint lds, arcomplex<ARFLOAT> X[], ARint ldx)
+  {
+    ARint info, mout;
+    trevc("R", howmny, k, S, lds, (arcomplex<ARFLOAT>*)NULL, 1, X, ldx, k,
+          mout, &work[0], &rwork[0], info);
+    return info;
+  }
+
+  static ARint Partner(ARint, const arcomplex<ARFLOAT>[]) { return -1; }
+
+  static arcomplex<ARFLOAT> Entry(const arcomplex<ARFLOAT> X[], ARint ldx,
+                                  ARint i, ARint k,
+                                  const arcomplex<ARFLOAT>[])
+  {
+    return X[(size_t)k*ldx+i];
+  }
+
+  static arcomplex<ARFLOAT> Column(const arcomplex<ARFLOAT>& c,
+                                   const arcomplex<ARFLOAT>&)
+  {
+    return c;
+  }
+
+}; // class ARksDense (complex version).
+
+
+// ------------------------------------------------------------------------ //
+// ARKrylovSchur class definition.                                          //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARTYPE>
+class ARKrylovSchur {
+
+ protected:
+
+ // a) Protected variables:
+
+  enum State { START, NEWV, NEWV_OP, NEWV_BX, NEWV_ORTH, STEP, STEP_OP,
+               STEP_BX, STEP_ORTH, STEP_BX2, STEP_NORM, EXTEND, RESTART,
+               BLOCK_NEW, BLOCK_STEP, BLOCK_OP, DONE };
+
+  State   state;      // Where the reverse communication loop stopped.
+  ARint   n;          // Dimension of the problem.
+  ARint   m;          // Number of Arnoldi vectors (ncv).
+  ARint   nb;         // Block size (vectors multiplied by OP at each step).
+  ARint   j;          // Index of the current Arnoldi vector.
+  ARint   nconv;      // Number of converged Ritz values.
+  int     ntry;       // Number of attempts to build a new vector.
+  int     npass;      // Gram-Schmidt passes done on a new vector.
+  bool    dgks;       // Indicates if the DGKS correction was done.
+  bool    genB;       // Indicates if B != I (bmat = 'G').
+  int     iter;       // Number of restarts (Arnoldi iterations).
+  int     nopx;       // Number of OP*x products.
+  int     nbx;        // Number of B*x products.
+  int     nrorth;     // Number of DGKS corrections.
+  ARFLOAT rnorm;      // B-norm of the residual vector.
+  ARFLOAT wnorm;      // B-norm of r before the last orthogonalization.
+  unsigned long long seed; // State of the random number generator.
+
+  std::vector<ARTYPE>  H;     // m x m projected matrix.
+  std::vector<ARTYPE>  S;     // Schur form of H.
+  std::vector<ARTYPE>  Z;     // Schur vectors of H.
+  std::vector<ARTYPE>  Y;     // Eigenvectors of H.
+  std::vector<ARTYPE>  X;     // Eigenvectors of S(0:nconv-1,0:nconv-1).
+  std::vector<ARTYPE>  r;     // Residual vector (n x nb block in block mode).
+  std::vector<ARTYPE>  E;     // Coupling of V to the residual (nb x m).
+  std::vector<ARTYPE>  G;     // E*Y or E*Z (nb x m).
+  std::vector<ARTYPE>  br;    // B*r (only if B != I).
+  std::vector<ARTYPE>  bv;    // B*v(j) (only if B != I).
+  std::vector<ARFLOAT> bound; // Error bounds of the Ritz values.
+  std::vector<int>     idx;   // Ritz values sorted from the most wanted.
+  std::vector<ARlogical>           select; // Ritz values kept by trsen.
+  std::vector<arcomplex<ARFLOAT> > theta;  // Eigenvalues of H.
+  std::vector<arcomplex<ARFLOAT> > lambda; // Eigenvalues computed by Eupp.
+
+  ARKrylovBasis<ARTYPE> basis; // Products with the Arnoldi vectors.
+  ARksDense<ARTYPE>     dense; // Dense eigenvalue problems.
+
+
+ // b) Protected functions:
+
+  ARFLOAT Random();
+  // Returns a random number uniformly distributed in (-1, 1).
+
+  void RandomVector();
+  // Fills r with random numbers.
+
+  const ARTYPE* Br() const { return genB ? &br[0] : &r[0]; }
+  // B*r.
+
+  ARFLOAT BNorm();
+  // sqrt(r'*B*r).
+
+  const ARTYPE* Orthogonalize(const ARTYPE* V, ARint ldv, ARint ncol)
+  {
+    basis.Orthogonalize(V, ldv, ncol, Br(), &r[0]);
+    return basis.Coefficients();
+  }
+  // r <- r - V(:,0:ncol-1)*V(:,0:ncol-1)'*B*r. Returns the coefficients.
+
+  ARint Partner(ARint k) const { return dense.Partner(k, &theta[0]); }
+  // Index of the conjugate of theta[k] (-1 if there is none).
+
+  void Sort(const std::string& which);
+  // Sorts the eigenvalues of H from the most wanted to the least wanted.
+
+  ARint Select(ARint first, ARint count);
+  // Selects Ritz values idx[first], ..., idx[first+count-1] and their
+  // conjugates. Returns the number of Ritz values selected.
+
+  ARint SelectExactly(ARint count);
+  // Selects the count most wanted Ritz values, skipping the conjugate
+  // pairs that do not fit. Returns the number of Ritz values selected.
+
+  void NextVector(ARTYPE* V, ARint ldv);
+  // v(j) <- r/rnorm (and B*v(j) <- B*r/rnorm).
+
+  bool BlockQR(const ARTYPE* V, ARint ldv, ARint ncol, ARTYPE R[]);
+  // Orthonormalizes the nb columns of the residual block r, which are
+  // already orthogonal to V(:,0:ncol-1), and stores the triangular
+  // factor in R (nb x nb). A null column is replaced by a random vector
+  // with no coupling. Returns false if no such vector is found.
+
+  void Finish(ARint& ido, ARTYPE resid[], ARint iparam[], ARint& info);
+  // Stores the output variables and sets ido = 99.
+
+  void Results(bool rvec, char HowMny, ARTYPE Zv[], ARint ldz,
+               arcomplex<ARFLOAT> sigma, bool shifti, ARTYPE V[],
+               ARint ldv, ARint& info);
+  // Common part of both versions of Eupp. Stores the eigenvalues in
+  // lambda.
+
+  void Conjugate(ARTYPE Zv[], ARint ldz);
+  // Swaps the eigenvalues of a complex conjugate pair (and conjugates
+  // its eigenvector, stored in Zv) when the first one has a negative
+  // imaginary part (shift and invert mode changes the sign), so the
+  // eigenvalue with positive imaginary part always comes first.
+
+
+ public:
+
+ // c) Public functions:
+
+  int Threads() const { return basis.Threads(); }
+
+  void SetThreads(int nthreadsp) { basis.SetThreads(nthreadsp); }
+  // Sets the number of threads used to reorthogonalize the Arnoldi
+  // vectors (<= 0 means all available cores).
+
+  void Aupp(ARint& ido, char bmat, ARint np, const std::string& which,
+            ARint nev, ARFLOAT& tol, ARTYPE resid[], ARint ncv,
+            ARTYPE V[], ARint ldv, ARint iparam[], ARint ipntr[],
+            ARTYPE workd[], ARint& info);
+  // Reverse communication interface of the Krylov-Schur method, with
+  // the same parameters as naupp and caupp (except workl and rwork).
+
+  void Eupp(bool rvec, char HowMny, ARFLOAT dr[], ARFLOAT di[], ARTYPE Zv[],
+            ARint ldz, ARFLOAT sigmar, ARFLOAT sigmai, char bmat, ARint np,
+            const std::string& which, ARint nev, ARFLOAT tol,
+            ARTYPE resid[], ARint ncv, ARTYPE V[], ARint ldv,
+            ARint iparam[], ARint ipntr[], ARTYPE workd[], ARint& info);
+  // Computes the converged Ritz values (real parts in dr, imaginary
+  // parts in di) and, if rvec is true, the Ritz vectors or the Schur
+  // vectors, with the same parameters as neupp (except workv and
+  // workl). As in dneupd, the eigenvalues are recovered only in shift
+  // and invert mode with a real shift.
+
+  void Eupp(bool rvec, char HowMny, arcomplex<ARFLOAT> d[], ARTYPE Zv[],
+            ARint ldz, arcomplex<ARFLOAT> sigma, char bmat, ARint np,
+            const std::string& which, ARint nev, ARFLOAT tol,
+            ARTYPE resid[], ARint ncv, ARTYPE V[], ARint ldv,
+            ARint iparam[], ARint ipntr[], ARTYPE workd[], ARint& info);
+  // Same as above, with the parameters of ceupp.
+
+  ARKrylovSchur(): state(START), n(0), m(0), nb(1), j(0), nconv(0), ntry(0),
+                   npass(0), dgks(false), genB(false), iter(0), nopx(0),
+                   nbx(0), nrorth(0), seed(0x2545F4914F6CDD1DULL) { }
+  // Constructor.
+
+}; // class ARKrylovSchur.
+
+
+// ------------------------------------------------------------------------ //
+// ARKrylovSchur member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARTYPE>
+inline ARFLOAT ARKrylovSchur<ARFLOAT, ARTYPE>::Random()
+{
+
+  seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+  return ARFLOAT(2.0*(double)(seed >> 11)/9007199254740992.0 - 1.0);
+
+} // Random.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline void ARKrylovSchur<ARFLOAT, ARTYPE>::RandomVector()
+{
+
+  for (ARint i=0; i<n; i++) r[i] = ARTYPE(Random());
+
+} // RandomVector.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline ARFLOAT ARKrylovSchur<ARFLOAT, ARTYPE>::BNorm()
+{
+
+  ARTYPE s;
+
+  gemv("C", n, 1, ARTYPE(1.0), &r[0], n, Br(), 1, ARTYPE(0.0), &s, 1);
+  return std::sqrt(std::abs(s));
+
+} // BNorm.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::Sort(const std::string& which)
+{
+
+  const arcomplex<ARFLOAT>* t = &theta[0];
+  const bool                p = dense.pairs;
+
+  // Ordering key of each Ritz value. As in dngets, LI and SI refer to
+  // the absolute value of the imaginary part in the real case.
+
+  std::vector<ARFLOAT> key(m);
+  for (ARint i=0; i<m; i++) {
+    if ((which == "LM") || (which == "SM")) key[i] = std::abs(t[i]);
+    else if (which[1] == 'R') key[i] = t[i].real();
+    else key[i] = p ? std::abs(t[i].imag()) : t[i].imag();
+  }
+
+  idx.resize(m);
+  for (int i=0; i<m; i++) idx[i] = i;
+
+  const ARFLOAT* kp = &key[0];
+  if (which[0] == 'L') {
+    std::stable_sort(idx.begin(), idx.end(), [kp](int a, int b) {
+      return kp[a] > kp[b];
+    });
+  }
+  else {
+    std::stable_sort(idx.begin(), idx.end(), [kp](int a, int b) {
+      return kp[a] < kp[b];
+    });
+  }
+
+} // Sort.
+
+
+template<class ARFLOAT, class ARTYPE>
+ARint ARKrylovSchur<ARFLOAT, ARTYPE>::Select(ARint first, ARint count)
+{
+
+  ARint nsel = 0;
+
+  std::fill(select.begin(), select.end(), (ARlogical)0);
+  for (ARint i=first; (i<m) && (nsel<count); i++) {
+    int k = idx[i];
+    if (select[k]) continue;
+    select[k] = 1;
+    nsel++;
+    ARint c = Partner(k);
+    if (c >= 0) {
+      select[c] = 1;
+      nsel++;
+    }
+  }
+  return nsel;
+
+} // Select.
+
+
+template<class ARFLOAT, class ARTYPE>
+ARint ARKrylovSchur<ARFLOAT, ARTYPE>::SelectExactly(ARint count)
+{
+
+  ARint nsel = 0;
+
+  std::fill(select.begin(), select.end(), (ARlogical)0);
+  for (ARint i=0; (i<m) && (nsel<count); i++) {
+    int   k = idx[i];
+    ARint c = Partner(k);
+    if (select[k] || (nsel+((c >= 0) ? 2 : 1) > count)) continue;
+    select[k] = 1;
+    nsel++;
+    if (c >= 0) {
+      select[c] = 1;
+      nsel++;
+    }
+  }
+  return nsel;
+
+} // SelectExactly.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline void ARKrylovSchur<ARFLOAT, ARTYPE>::NextVector(ARTYPE* V, ARint ldv)
+{
+
+  ARTYPE s = ARTYPE((ARFLOAT)1.0/rnorm);
+
+  scal(n, s, &r[0], 1);
+  copy(n, &r[0], 1, &V[(size_t)j*ldv], 1);
+  if (genB) {
+    scal(n, s, &br[0], 1);
+    copy(n, &br[0], 1, &bv[0], 1);
+  }
+
+} // NextVector.
+
+
+template<class ARFLOAT, class ARTYPE>
+bool ARKrylovSchur<ARFLOAT, ARTYPE>::
+BlockQR(const ARTYPE* V, ARint ldv, ARint ncol, ARTYPE R[])
+{
+
+  std::fill(R, R+(size_t)nb*nb, ARTYPE(0.0));
+
+  for (ARint c=0; c<nb; c++) {
+
+    ARTYPE* rc = &r[(size_t)c*n];
+    ARTYPE* hc = &R[(size_t)c*nb];
+    ARFLOAT s0 = nrm2(n, rc, 1);
+    ARFLOAT s1 = s0;
+
+    // Gram-Schmidt against the previous columns of the block, with one
+    // DGKS correction.
+
+    if ((c > 0) && (s0 > (ARFLOAT)0.0)) {
+      basis.Orthogonalize(&r[0], n, c, rc, rc);
+      copy(c, basis.Coefficients(), 1, hc, 1);
+      s1 = nrm2(n, rc, 1);
+      if (s1 <= (ARFLOAT)0.717*s0) {
+        nrorth++;
+        basis.Orthogonalize(&r[0], n, c, rc, rc);
+        axpy(c, ARTYPE(1.0), basis.Coefficients(), 1, hc, 1);
+        ARFLOAT s2 = nrm2(n, rc, 1);
+        s1 = (s2 <= (ARFLOAT)0.717*s1) ? (ARFLOAT)0.0 : s2;
+      }
+    }
+
+    // Replacing a null column by a new direction.
+
+    if (s1 == (ARFLOAT)0.0) {
+      std::fill(hc, hc+nb, ARTYPE(0.0));
+      for (ntry=0; s1 == (ARFLOAT)0.0; ntry++) {
+        if (ntry >= 3) return false;
+        for (ARint i=0; i<n; i++) rc[i] = ARTYPE(Random());
+        for (int pass=0; pass<2; pass++) {
+          if (ncol > 0) basis.Orthogonalize(V, ldv, ncol, rc, rc);
+          if (c > 0) basis.Orthogonalize(&r[0], n, c, rc, rc);
+        }
+        s1 = nrm2(n, rc, 1);
+      }
+    }
+    else {
+      hc[c] = ARTYPE(s1);
+    }
+    ARTYPE s = ARTYPE((ARFLOAT)1.0/s1);
+    scal(n, s, rc, 1);
+
+  }
+  return true;
+
+} // BlockQR.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::
+Finish(ARint& ido, ARTYPE resid[], ARint iparam[], ARint& info)
+{
+
+  if (info >= 0) copy(n, &r[0], 1, resid, 1);  // Residual vector.
+
+  iparam[3]  = iter;
+  iparam[5]  = nconv;
+  iparam[9]  = nopx;
+  iparam[10] = nbx;
+  iparam[11] = nrorth;
+  ido        = 99;
+  state      = DONE;
+
+} // Finish.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::
+Aupp(ARint& ido, char bmat, ARint np, const std::string& which, ARint nev,
+     ARFLOAT& tol, ARTYPE resid[], ARint ncv, ARTYPE V[], ARint ldv,
+     ARint iparam[], ARint ipntr[], ARTYPE workd[], ARint& info)
+{
+
+  const ARFLOAT eps   = std::numeric_limits<ARFLOAT>::epsilon();
+  const ARFLOAT eps23 = std::pow(eps, (ARFLOAT)2.0/(ARFLOAT)3.0);
+
+  ARTYPE* v = &V[1];         // V and workd are 1-based, as in naupp.
+
+  if (ido == 0) {
+
+    // Checking parameters and allocating memory. In block mode only a
+    // multiple of nb Arnoldi vectors is used.
+
+    nb = std::max(iparam[4], (ARint)1);
+    m  = nb*(ncv/nb);
+
+    if (np <= 0) { info = -1; ido = 99; return; }
+    if (nev <= 0) { info = -2; ido = 99; return; }
+    if ((ncv <= nev+1) || (ncv > np)) { info = -3; ido = 99; return; }
+    if ((nb > 1) && (m < nev+1+2*nb)) { info = -3; ido = 99; return; }
+    if ((iparam[7] < 1) || (iparam[7] > 4)) { info = -10; ido = 99; return; }
+    if ((iparam[7] == 1) && (bmat == 'G')) { info = -11; ido = 99; return; }
+    if ((nb > 1) && (bmat == 'G')) { info = -11; ido = 99; return; }
+
+    n    = np;
+    genB = (bmat == 'G');
+    if (tol <= (ARFLOAT)0.0) tol = eps;
+
+    H.assign((size_t)m*m, ARTYPE(0.0));
+    S.resize((size_t)m*m);
+    Z.resize((size_t)m*m);
+    Y.resize((size_t)m*m);
+    theta.resize(m);
+    bound.resize(m);
+    select.resize(m);
+    r.resize((size_t)n*nb);
+    E.assign((size_t)nb*m, ARTYPE(0.0));
+    G.resize((size_t)nb*m);
+    br.resize(genB ? n : 0);
+    bv.resize(genB ? n : 0);
+    basis.Define(n, m, nb);
+    dense.Define(m);
+
+    j = nconv = 0;
+    iter = nopx = nbx = nrorth = 0;
+    ntry = npass = 0;
+
+    // Starting vector (the first one of the block in block mode).
+
+    if (info == 0) RandomVector();
+    else copy(n, resid, 1, &r[0], 1);
+    for (size_t i=n; i<r.size(); i++) r[i] = ARTYPE(Random());
+    info  = 0;
+    state = (nb == 1) ? NEWV : BLOCK_NEW;
+
+  }
+
+  ipntr[1] = 1;
+  ipntr[2] = nb*n+1;
+  ipntr[3] = 2*nb*n+1;
+
+  ARTYPE* x = &workd[ipntr[1]];
+  ARTYPE* y = &workd[ipntr[2]];
+  ARTYPE* z = &workd[ipntr[3]];
+
+  for (;;) {
+
+    switch (state) {
+
+    case NEWV:
+
+      // Building v(j) from r. If B != I, r is first replaced by OP*B*r
+      // (to force the vector into the range of OP), as in dgetv0.
+
+      npass = 0;
+      if (genB) {
+        copy(n, &r[0], 1, x, 1);
+        state = NEWV_OP;
+        ido   = -1;
+        return;
+      }
+      state = NEWV_ORTH;
+      break;
+
+    case NEWV_OP:
+
+      copy(n, y, 1, &r[0], 1);
+      nopx++;
+      copy(n, &r[0], 1, x, 1);
+      state = NEWV_BX;
+      ido   = 2;
+      return;
+
+    case NEWV_BX:
+
+      copy(n, y, 1, &br[0], 1);
+      nbx++;
+      state = NEWV_ORTH;
+      break;
+
+    case NEWV_ORTH:
+
+      // Two passes of Gram-Schmidt against v(0), ..., v(j-1).
+
+      if ((j > 0) && (npass < 2)) {
+        Orthogonalize(v, ldv, j);
+        npass++;
+        if (genB) {
+          copy(n, &r[0], 1, x, 1);
+          state = NEWV_BX;
+          ido   = 2;
+          return;
+        }
+        break;
+      }
+
+      rnorm = BNorm();
+
+      if (rnorm == (ARFLOAT)0.0) {
+        if (j == 0) {                       // Null starting vector.
+          info = -9;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        if (++ntry >= 3) {                  // No new direction found.
+          info = -9999;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        RandomVector();
+        state = NEWV;
+        break;
+      }
+
+      // v(j) is not coupled to the previous vectors.
+
+      NextVector(v, ldv);
+      for (ARint c=0; c<j; c++) H[(size_t)c*m+j] = ARTYPE(0.0);
+      ntry  = 0;
+      state = STEP;
+      break;
+
+    case STEP:
+
+      // Requesting OP*v(j). B*v(j) is also available when B != I.
+
+      copy(n, &v[(size_t)j*ldv], 1, x, 1);
+      if (genB) copy(n, &bv[0], 1, z, 1);
+      state = STEP_OP;
+      ido   = 1;
+      return;
+
+    case STEP_OP:
+
+      copy(n, y, 1, &r[0], 1);
+      nopx++;
+      if (genB) {
+        copy(n, &r[0], 1, x, 1);
+        state = STEP_BX;
+        ido   = 2;
+        return;
+      }
+      state = STEP_ORTH;
+      break;
+
+    case STEP_BX:
+
+      copy(n, y, 1, &br[0], 1);
+      nbx++;
+      state = STEP_ORTH;
+      break;
+
+    case STEP_ORTH:
+
+      // r <- r - V(:,0:j)*V(:,0:j)'*B*r. The coefficients form column
+      // j of H.
+
+      wnorm = BNorm();
+      dgks  = false;
+      copy(j+1, Orthogonalize(v, ldv, j+1), 1, &H[(size_t)j*m], 1);
+      if (genB) {
+        copy(n, &r[0], 1, x, 1);
+        state = STEP_BX2;
+        ido   = 2;
+        return;
+      }
+      state = STEP_NORM;
+      break;
+
+    case STEP_BX2:
+
+      copy(n, y, 1, &br[0], 1);
+      nbx++;
+      state = STEP_NORM;
+      break;
+
+    case STEP_NORM:
+
+      // DGKS test: one more pass of Gram-Schmidt if the norm of r was
+      // reduced too much. If this is not enough, r is set to zero.
+
+      rnorm = BNorm();
+      if (!dgks) {
+        if (rnorm > (ARFLOAT)0.717*wnorm) {
+          state = EXTEND;
+          break;
+        }
+        nrorth++;
+        dgks  = true;
+        wnorm = rnorm;
+        axpy(j+1, ARTYPE(1.0), Orthogonalize(v, ldv, j+1), 1,
+             &H[(size_t)j*m], 1);
+        if (genB) {
+          copy(n, &r[0], 1, x, 1);
+          state = STEP_BX2;
+          ido   = 2;
+          return;
+        }
+        break;
+      }
+      if (rnorm <= (ARFLOAT)0.717*wnorm) {
+        rnorm = (ARFLOAT)0.0;
+        std::fill(r.begin(), r.end(), ARTYPE(0.0));
+        std::fill(br.begin(), br.end(), ARTYPE(0.0));
+      }
+      state = EXTEND;
+      break;
+
+    case EXTEND:
+
+      j++;
+      if (j == m) {
+        state = RESTART;
+        break;
+      }
+      if (rnorm == (ARFLOAT)0.0) {          // Invariant subspace found.
+        RandomVector();
+        ntry  = 0;
+        state = NEWV;
+        break;
+      }
+      NextVector(v, ldv);
+      H[(size_t)(j-1)*m+j] = ARTYPE(rnorm);
+      state = STEP;
+      break;
+
+    case RESTART:
+
+      {
+        // Schur form and eigenvectors of H. The error bound of each
+        // Ritz value is ||E*y||/||y||, where E is the coupling of V to
+        // the residual (rnorm*e(m-1)' when nb = 1).
+
+        iter++;
+        std::copy(H.begin(), H.end(), S.begin());
+        if (dense.Schur(m, &S[0], &Z[0], &theta[0]) != 0) {
+          info = -8;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        std::copy(Z.begin(), Z.end(), Y.begin());
+        if (dense.Vectors("B", m, &S[0], m, &Y[0], m) != 0) {
+          info = -8;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        if (nb == 1) {
+          std::fill(E.begin(), E.end(), ARTYPE(0.0));
+          E[m-1] = ARTYPE(rnorm);
+        }
+        gemm("N", "N", nb, m, m, ARTYPE(1.0), &E[0], nb, &Y[0], m,
+             ARTYPE(0.0), &G[0], nb);
+        for (ARint k=0; k<m; k++) {
+          ARint   c   = Partner(k);
+          ARFLOAT ynr = nrm2(m, &Y[(size_t)k*m], 1);
+          ARFLOAT gnr = nrm2(nb, &G[(size_t)k*nb], 1);
+          if (c >= 0) {
+            ynr = lapy2(ynr, nrm2(m, &Y[(size_t)c*m], 1));
+            gnr = lapy2(gnr, nrm2(nb, &G[(size_t)c*nb], 1));
+          }
+          bound[k] = gnr/ynr;
+        }
+        Sort(which);
+
+        // Convergence test (as in dnconv). A conjugate pair split by
+        // the nev-th wanted value is entirely wanted.
+
+        ARint nwant = nev;
+        ARint last  = Partner(idx[nev-1]);
+        if ((last >= 0) && (std::find(idx.begin(), idx.begin()+nev, last) ==
+                            idx.begin()+nev)) nwant++;
+
+        nconv = 0;
+        for (ARint i=0; i<nwant; i++) {
+          int k = idx[i];
+          if (bound[k] <= tol*std::max(eps23, std::abs(theta[k]))) nconv++;
+        }
+
+        if ((nconv >= nev) || (iter >= iparam[3])) {
+
+          // Moving the converged Ritz values to the leading block of S.
+
+          std::fill(select.begin(), select.end(), (ARlogical)0);
+          for (ARint i=0; i<nwant; i++) {
+            int k = idx[i];
+            if (bound[k] <= tol*std::max(eps23, std::abs(theta[k]))) {
+              select[k] = 1;
+            }
+          }
+          if ((nconv > 0) &&
+              (dense.Reorder(m, &select[0], &S[0], &Z[0], &theta[0], nconv) != 0)) {
+            info = -8;
+            Finish(ido, resid, iparam, info);
+            return;
+          }
+          info = (nconv >= nev) ? 0 : 1;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+
+        // Keeping nev wanted Ritz vectors plus a few more, as in dnaup2.
+        // There must be room for at least one new vector.
+
+        ARint kept = nwant + std::min(nconv, (m-nwant)/2);
+        if ((kept == 1) && (m >= 6)) kept = m/2;
+        else if ((kept == 1) && (m > 3)) kept = 2;
+
+        ARint nsel;
+        if (nb == 1) {
+          nsel = Select(0, kept);
+          while (nsel >= m) nsel = Select(0, --kept);
+        }
+        else {
+
+          // In block mode the new blocks must fill V exactly.
+
+          ARint target = m - nb*((m-kept+nb-1)/nb);
+          if (target < nwant) target += nb;
+          nsel = SelectExactly(kept = target);
+          if ((nsel != kept) && (target+nb <= m-nb)) {
+            nsel = SelectExactly(kept = target+nb);
+          }
+          if ((nsel != kept) && (target-nb > 0)) {
+            nsel = SelectExactly(kept = target-nb);
+          }
+          if (nsel != kept) nsel = 0;
+        }
+        if ((nsel == 0) ||
+            (dense.Reorder(m, &select[0], &S[0], &Z[0], &theta[0], nsel) != 0)) {
+          info = -9999;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        basis.Rotate(v, ldv, nsel, &Z[0]);
+
+        // New projected matrix: the leading block of S plus one row with
+        // the coupling of the Schur vectors kept to the residual, E*Z (nb
+        // rows in block mode, added by BLOCK_STEP).
+
+        gemm("N", "N", nb, nsel, m, ARTYPE(1.0), &E[0], nb, &Z[0], m,
+             ARTYPE(0.0), &G[0], nb);
+        std::fill(H.begin(), H.end(), ARTYPE(0.0));
+        std::fill(E.begin(), E.end(), ARTYPE(0.0));
+        for (ARint c=0; c<nsel; c++) {
+          copy(nsel, &S[(size_t)c*m], 1, &H[(size_t)c*m], 1);
+          copy(nb, &G[(size_t)c*nb], 1, &E[(size_t)c*nb], 1);
+          if (nb == 1) H[(size_t)c*m+nsel] = G[c];
+        }
+
+        j = nsel;
+        if (nb > 1) {
+          state = BLOCK_STEP;
+          break;
+        }
+        if (rnorm == (ARFLOAT)0.0) {        // Invariant subspace found.
+          RandomVector();
+          ntry  = 0;
+          state = NEWV;
+          break;
+        }
+        NextVector(v, ldv);
+        state = STEP;
+      }
+      break;
+
+    case BLOCK_NEW:
+
+      // Starting block, orthonormalized.
+
+      if (!BlockQR(v, ldv, 0, &E[0])) {
+        info = -9;
+        Finish(ido, resid, iparam, info);
+        return;
+      }
+      std::fill(E.begin(), E.end(), ARTYPE(0.0));
+      state = BLOCK_STEP;
+      break;
+
+    case BLOCK_STEP:
+
+      // The residual block becomes v(j), ..., v(j+nb-1), its coupling to
+      // the previous vectors is moved from E to H, and OP*V(:,j:j+nb-1)
+      // is requested.
+
+      for (ARint c=0; c<nb; c++) {
+        copy(n, &r[(size_t)c*n], 1, &v[(size_t)(j+c)*ldv], 1);
+        copy(n, &r[(size_t)c*n], 1, &x[(size_t)c*n], 1);
+        for (ARint i=0; i<j; i++) H[(size_t)i*m+j+c] = E[(size_t)i*nb+c];
+      }
+      state = BLOCK_OP;
+      ido   = 1;
+      return;
+
+    case BLOCK_OP:
+
+      {
+        // r <- r - V(:,0:j+nb-1)*V(:,0:j+nb-1)'*r, with one more pass if
+        // the norm of a column was reduced too much (DGKS). A column that
+        // is still reduced too much is set to zero. The coefficients form
+        // columns j, ..., j+nb-1 of H.
+
+        std::vector<ARFLOAT> wn(nb), rn(nb);
+        ARint                k = j+nb;
+        bool                 again = false;
+
+        copy(n*nb, y, 1, &r[0], 1);
+        nopx += nb;
+        for (ARint c=0; c<nb; c++) wn[c] = nrm2(n, &r[(size_t)c*n], 1);
+
+        basis.OrthogonalizeBlock(v, ldv, k, &r[0], n, nb);
+        for (ARint c=0; c<nb; c++) {
+          copy(k, &basis.Coefficients()[(size_t)c*m], 1, &H[(size_t)(j+c)*m], 1);
+          rn[c] = nrm2(n, &r[(size_t)c*n], 1);
+          if (rn[c] <= (ARFLOAT)0.717*wn[c]) again = true;
+        }
+
+        if (again) {
+          nrorth++;
+          basis.OrthogonalizeBlock(v, ldv, k, &r[0], n, nb);
+          for (ARint c=0; c<nb; c++) {
+            axpy(k, ARTYPE(1.0), &basis.Coefficients()[(size_t)c*m], 1,
+                 &H[(size_t)(j+c)*m], 1);
+            ARTYPE* rc = &r[(size_t)c*n];
+            if ((rn[c] <= (ARFLOAT)0.717*wn[c]) &&
+                (nrm2(n, rc, 1) <= (ARFLOAT)0.717*rn[c])) {
+              std::fill(rc, rc+n, ARTYPE(0.0));
+            }
+          }
+        }
+
+        // New residual block and its coupling, E(:,j:j+nb-1).
+
+        j = k;
+        std::fill(E.begin(), E.end(), ARTYPE(0.0));
+        if (!BlockQR(v, ldv, j, &E[(size_t)(j-nb)*nb])) {
+          info = -9999;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        state = (j == m) ? RESTART : BLOCK_STEP;
+      }
+      break;
+
+    case DONE:
+    default:
+
+      ido = 99;
+      return;
+
+    }
+  }
+
+} // Aupp.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::
+Results(bool rvec, char HowMny, ARTYPE Zv[], ARint ldz,
+        arcomplex<ARFLOAT> sigma, bool shifti, ARTYPE V[], ARint ldv,
+        ARint& info)
+{
+
+  if ((state != DONE) || (nconv == 0)) {
+    info = -14;
+    return;
+  }
+
+  // Ritz values, in the order of the leading block of S. In shift and
+  // invert mode, lambda = sigma + 1/theta.
+
+  lambda.resize(nconv);
+  for (ARint k=0; k<nconv; k++) {
+    lambda[k] = shifti ? sigma + (ARFLOAT)1.0/theta[k] : theta[k];
+  }
+
+  info = 0;
+  if (!rvec) {
+    Conjugate(NULL, 0);
+    return;
+  }
+
+  ARTYPE* v = &V[1];
+
+  if (HowMny != 'A') {                      // Schur vectors only.
+    basis.Rotate(v, ldv, nconv, &Z[0]);
+    Conjugate(NULL, 0);
+    return;
+  }
+
+  // Eigenvectors of H: Y = Z*X, where X are the eigenvectors of the
+  // leading block of S.
+
+  X.resize((size_t)nconv*nconv);
+  if (dense.Vectors("A", nconv, &S[0], m, &X[0], nconv) != 0) {
+    info = -9;
+    return;
+  }
+  gemm("N", "N", m, nconv, nconv, ARTYPE(1.0), &Z[0], m, &X[0], nconv,
+       ARTYPE(0.0), &Y[0], m);
+
+  // Ritz vectors V*Y, stored in Zv. If Zv is not V, the Schur vectors
+  // V*Z are stored in V, as dneupd does.
+
+  if ((Zv == NULL) || (Zv == v)) {
+    Zv  = v;
+    ldz = ldv;
+    basis.Rotate(v, ldv, nconv, &Y[0]);
+  }
+  else {
+    basis.Multiply(v, ldv, nconv, &Y[0], Zv, ldz);
+    basis.Rotate(v, ldv, nconv, &Z[0]);
+  }
+
+  // In shift and invert mode each vector is corrected with the residual
+  // (x <- x + (s/theta)*r, where s is the last component of the
+  // eigenvector of H), as in dneupd.
+
+  if (shifti && (nb == 1)) {
+    for (ARint k=0; k<nconv; k++) {
+      arcomplex<ARFLOAT> s = dense.Entry(&Y[0], m, m-1, k, &theta[0])/theta[k];
+      axpy(n, ARTYPE(dense.Column(s, theta[k])), &r[0], 1,
+           &Zv[(size_t)k*ldz], 1);
+    }
+  }
+  else if (shifti) {                        // x <- x + R*E*y/theta.
+    gemm("N", "N", nb, nconv, m, ARTYPE(1.0), &E[0], nb, &Y[0], m,
+         ARTYPE(0.0), &G[0], nb);
+    for (ARint k=0; k<nconv; k++) {
+      for (ARint c=0; c<nb; c++) {
+        arcomplex<ARFLOAT> s = dense.Entry(&G[0], nb, c, k, &theta[0])/theta[k];
+        axpy(n, ARTYPE(dense.Column(s, theta[k])), &r[(size_t)c*n], 1,
+             &Zv[(size_t)k*ldz], 1);
+      }
+    }
+  }
+
+  // Normalizing the vectors (both parts of a complex one together).
+
+  for (ARint k=0; k<nconv; k++) {
+    ARint   c   = Partner(k);
+    ARTYPE* zk  = &Zv[(size_t)k*ldz];
+    ARFLOAT znr = nrm2(n, zk, 1);
+    if (c > k) {
+      znr = lapy2(znr, nrm2(n, zk+ldz, 1));
+      ARTYPE s = ARTYPE((ARFLOAT)1.0/znr);
+      scal(n, s, zk, 1);
+      scal(n, s, zk+ldz, 1);
+      k++;
+    }
+    else {
+      ARTYPE s = ARTYPE((ARFLOAT)1.0/znr);
+      scal(n, s, zk, 1);
+    }
+  }
+
+  Conjugate(Zv, ldz);
+
+} // Results.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::Conjugate(ARTYPE Zv[], ARint ldz)
+{
+
+  ARTYPE minus = ARTYPE(-1.0);
+
+  for (ARint k=0; k+1<nconv; k++) {
+    if ((Partner(k) == k+1) && (lambda[k].imag() < (ARFLOAT)0.0)) {
+      std::swap(lambda[k], lambda[k+1]);
+      if (Zv != NULL) scal(n, minus, &Zv[(size_t)(k+1)*ldz], 1);
+      k++;
+    }
+  }
+
+} // Conjugate.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::
+Eupp(bool rvec, char HowMny, ARFLOAT dr[], ARFLOAT di[], ARTYPE Zv[],
+     ARint ldz, ARFLOAT sigmar, ARFLOAT sigmai, char, ARint,
+     const std::string&, ARint, ARFLOAT, ARTYPE[], ARint, ARTYPE V[],
+     ARint ldv, ARint iparam[], ARint[], ARTYPE[], ARint& info)
+{
+
+  bool shifti = (iparam[7] == 3) && (sigmai == (ARFLOAT)0.0);
+
+  Results(rvec, HowMny, Zv, ldz, arcomplex<ARFLOAT>(sigmar, sigmai), shifti,
+          V, ldv, info);
+  if (info != 0) return;
+  for (ARint k=0; k<nconv; k++) {
+    dr[k] = lambda[k].real();
+    di[k] = lambda[k].imag();
+  }
+
+} // Eupp (real version).
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARKrylovSchur<ARFLOAT, ARTYPE>::
+Eupp(bool rvec, char HowMny, arcomplex<ARFLOAT> d[], ARTYPE Zv[], ARint ldz,
+     arcomplex<ARFLOAT> sigma, char, ARint, const std::string&, ARint,
+     ARFLOAT, ARTYPE[], ARint, ARTYPE V[], ARint ldv, ARint iparam[],
+     ARint[], ARTYPE[], ARint& info)
+{
+
+  Results(rvec, HowMny, Zv, ldz, sigma, (iparam[7] == 3), V, ldv, info);
+  if (info != 0) return;
+  for (ARint k=0; k<nconv; k++) d[k] = lambda[k];
+
+} // Eupp (complex version).
+
+
+#endif // ARKSCHUR_H
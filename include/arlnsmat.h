@@ -24,8 +24,10 @@
 #include <string>
 #include "arch.h"
 #include "armat.h"
+#include "arspmat.h"
 #include "arhbmat.h"
 #include "arerror.h"
+#include "argram.h"
 #include "blas1c.h"
 #include "superluc.h"
 #include "arlspdef.h"
@@ -42,6 +44,8 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
  protected:
 
   bool        factored;
+  bool        factoredAsI;  // True if AsI (not A) was factored last.
+  ARTYPE      shift;        // Shift of the last factorization of AsI.
   int         order;
   int         nnz;
   int*        irow;
@@ -55,6 +59,10 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
   SuperMatrix U;
   ARhbMatrix<int, ARTYPE> mat;
   SuperLUStat_t stat;
+  ARluRefactor  refac;  // Reuses the ordering when only sigma changes.
+
+  // Fused products A'*A*v and A*A'*v (used by MultMtMv and MultMMtv).
+  ARGramProduct<int, ARTYPE> gram;
 
   bool DataOK();
 
@@ -70,22 +78,47 @@ class ARluNonSymMatrix: public ARMatrix<ARTYPE> {
 
   bool IsFactored() { return factored; }
 
+  int Threads() const { return gram.Threads(); }
+
+  void SetThreads(int nthreadsp) { gram.SetThreads(nthreadsp); }
+  // Sets the number of threads used by MultMtMv and MultMMtv
+  // (0 means all cores).
+
   void FactorA();
 
   void FactorAsI(ARTYPE sigma);
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
   void MultMtMv(ARTYPE* v, ARTYPE* w);
+  // w = A'*A*v, in a single pass over A and without temporary
+  // vectors. A copy of A stored by rows (nzeros() extra entries)
+  // is built on the first call, so the values of A must not be
+  // changed afterwards unless DefineMatrix is called again.
 
   void MultMMtv(ARTYPE* v, ARTYPE* w);
+  // w = A*A'*v, in a single pass over A.
 
   void Mult0MMt0v(ARTYPE* v, ARTYPE* w);
 
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V with one
+  // call to gstrs.
+
+  void UpdateValues(const ARTYPE* newvals);
+  // Replaces the nnz values of A by newvals, given in the order of the
+  // array passed to DefineMatrix (which may also be that array, after
+  // it was changed in place). The pattern must not change. If A (or
+  // A-sigma*I) was factored, it is factored again with the same shift,
+  // reusing the column ordering, the elimination tree and the row
+  // permutation of the last factorization.
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp,
                     int* pcolp, double thresholdp = 0.1,
                     int orderp = 1, bool check = true); // Square matrix.
@@ -161,6 +194,7 @@ Copy(const ARluNonSymMatrix<ARTYPE, ARFLOAT>& other)
 
   this->defined   = other.defined;
   factored  = other.factored;
+  gram.SetThreads(other.gram.Threads());
 
   // Returning from here if "other" was not initialized.
 
@@ -199,7 +233,9 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::ClearMem()
     Destroy_SuperNode_Matrix(&L);
     Destroy_CompCol_Matrix(&U);
     StatFree(&stat);
+    factored = false;
   }
+  refac.Clear();
   if (this->defined) {
     Destroy_SuperMatrix_Store(&A); // delete A.Store;
     delete[] permc;
@@ -278,8 +314,6 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
   // Defining local variables.
 
   int         info;
-  int*        etree;
-  SuperMatrix AC;
 
   // Quitting the function if A was not defined.
 
@@ -294,18 +328,8 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
                       "ARluNonSymMatrix::FactorA");
   }
 
-  // Deleting previous versions of L and U.
-  
-  if (factored) {
-    Destroy_SuperNode_Matrix(&L);
-    Destroy_CompCol_Matrix(&U);
-    StatFree(&stat);
-  }
-
   // Setting default values for gstrf parameters.
 
-  int    panel_size = sp_ienv(1);
-  int    relax      = sp_ienv(2);
   superlu_options_t options;
 
   /* Set the default input options:
@@ -323,39 +347,15 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
   set_default_options(&options);
   options.DiagPivotThresh = threshold;
 
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
-
-  // Defining LUStat.
-
-  //StatInit(panel_size, relax);
-  StatInit(&stat);
-
-  // Defining the column permutation of matrix A
-  // (using minimum degree ordering on A'*A).
-
-  get_perm_c(order, &A, permc);
+  // Decomposing A. If A has the pattern of the matrix factored
+  // last, the column ordering, the elimination tree and the row
+  // permutation of that factorization are reused.
 
-  // Permuting columns of A and
-  // creating the elimination tree of A'*A.
+  info = refac.Factor(&options, &A, order, permc, permr, &L, &U,
+                      &stat, factored);
 
-//  sp_preorder("N", &A, permc, etree, &AC);
-  sp_preorder(&options, &A, permc, etree, &AC);
-
-  // Decomposing A.
-
-//  gstrf("N",&AC, threshold, drop_tol, relax, panel_size, etree,
-//        NULL, 0, permr, permc, &L, &U, &info);
-  gstrf(&options,&AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
-
-  // Deleting AC and etree.
-
-  Destroy_CompCol_Permuted(&AC);
-  delete[] etree;
-
-  factored = (info == 0);
+  factored    = (info == 0);
+  factoredAsI = false;
 
   // Handling errors.
 
@@ -396,27 +396,15 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   // Defining local variables.
 
   int         info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     asi;
   SuperMatrix AsI;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   AsIstore;
 
-  // Deleting previous versions of L and U.
-  
-  if (factored) {
-    Destroy_SuperNode_Matrix(&L);
-    Destroy_CompCol_Matrix(&U);
-    StatFree(&stat);
-  }
-
   // Setting default values for gstrf parameters.
 
-  int    panel_size = sp_ienv(1);
-  int    relax      = sp_ienv(2);
   superlu_options_t options;
 
   /* Set the default input options:
@@ -447,40 +435,20 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   AsIstore = (NCformat*)AsI.Store;
   SubtractAsI(sigma, *Astore, *AsIstore);
 
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
-
-  // Defining LUStat.
-
-  //StatInit(panel_size, relax);
-  StatInit(&stat);
-
-  // Defining the column permutation of matrix AsI
-  // (using minimum degree ordering on AsI'*AsI).
-
-  get_perm_c(order, &AsI, permc);
-
-  // Permuting columns of AsI and
-  // creating the elimination tree of AsI'*AsI.
-
-  //sp_preorder("N", &AsI, permc, etree, &AC);
-  sp_preorder(&options, &AsI, permc, etree, &AC);
+  // Decomposing AsI. If AsI has the pattern of the matrix factored
+  // last, the column ordering, the elimination tree and the row
+  // permutation of that factorization are reused.
 
-  // Decomposing AsI.
+  info = refac.Factor(&options, &AsI, order, permc, permr, &L, &U,
+                      &stat, factored);
 
-//  gstrf("N",&AC, threshold, drop_tol, relax, panel_size, etree,
-//        NULL, 0, permr, permc, &L, &U, &info);
-  gstrf(&options,&AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
+  // Deleting AsI.
 
-  // Deleting AC, AsI and etree.
-
-  Destroy_CompCol_Permuted(&AC);
   Destroy_CompCol_Matrix(&AsI);
-  delete[] etree;
 
-  factored = (info == 0);
+  factored    = (info == 0);
+  factoredAsI = true;
+  shift       = sigma;
 
   // Handling errors.
 
@@ -527,6 +495,24 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluNonSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V.
+
+  CSCMultMm(this->m, this->n, pcol, irow, a, k, V, ldv, W, ldw);
+
+} // MultMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
@@ -557,12 +543,15 @@ template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[this->m];
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluNonSymMatrix::MultMtMv");
+  }
 
-  MultMv(v,t);
-  MultMtv(t,w);
+  // Determining w = M'.M.v.
 
-  delete[] t;
+  gram.MultMtMv(this->m, this->n, pcol, irow, a, v, w);
 
 } // MultMtMv.
 
@@ -571,12 +560,15 @@ template<class ARTYPE, class ARFLOAT>
 void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[this->n];
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluNonSymMatrix::MultMMtv");
+  }
 
-  MultMtv(v,t);
-  MultMv(t,w);
+  // Determining w = M.M'.v.
 
-  delete[] t;
+  gram.MultMMtv(this->m, this->n, pcol, irow, a, v, w);
 
 } // MultMMtv.
 
@@ -602,22 +594,52 @@ void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
                       "ARluNonSymMatrix::MultInvv");
   }
 
-  // Solving A.w = v (or AsI.w = v).
+  // Solving A.w = v (or AsI.w = v). L and U are only read, so several
+  // threads may solve at the same time (each one with its own stat).
 
   int         info;
   SuperMatrix B;
+  DNformat    Bstore;
 
   if (&v != &w) copy(this->n, v, 1, w, 1);
-  Create_Dense_Matrix(&B, this->n, 1, w, this->n, SLU_DN, SLU_GE);
+  Define_Dense_Matrix(&B, &Bstore, this->n, 1, w, this->n);
 //  gstrs("N", &L, &U, permr, permc, &B, &info);
-  StatInit(&stat);
   trans_t trans = NOTRANS;
-  gstrs(trans, &L, &U, permc, permr, &B, &stat, &info);
-  Destroy_SuperMatrix_Store(&B); // delete B.Store;
+  gstrs(trans, &L, &U, permc, permr, &B, ARluLocalStat(), &info);
 
 } // MultInvv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                                  ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluNonSymMatrix::MultInvMm");
+  }
+
+  // Solving A.W = V (or AsI.W = V) for all columns in a single call.
+
+  int         info;
+  SuperMatrix B;
+  DNformat    Bstore;
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+  Define_Dense_Matrix(&B, &Bstore, this->n, k, W, ldw);
+  trans_t trans = NOTRANS;
+  gstrs(trans, &L, &U, permc, permr, &B, ARluLocalStat(), &info);
+
+} // MultInvMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARluNonSymMatrix<ARTYPE, ARFLOAT>::
 DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
@@ -633,6 +655,7 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
   pcol[this->n]   = nnz;
   threshold = thresholdp;
   order     = orderp;
+  gram.Clear();
 
   // Checking data.
 
@@ -641,8 +664,9 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
                       "ARluSymMatrix::DefineMatrix");
   }
 
-  // Creating SuperMatrix A.
+  // Creating SuperMatrix A (its pattern may not be the one factored last).
 
+  refac.Clear();
   Create_CompCol_Matrix(&A, this->n, this->n, nnz, a, irow, pcol, SLU_NC, SLU_GE);
 
   // Reserving memory for vectors used in matrix decomposition.
@@ -667,6 +691,7 @@ DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp, bool
   irow    = irowp;
   pcol    = pcolp;
   pcol[this->n] = nnz;
+  gram.Clear();
 
   // Checking data.
 
@@ -675,8 +700,9 @@ DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp, bool
                       "ARluSymMatrix::DefineMatrix");
   }
 
-  // Creating SuperMatrix A.
+  // Creating SuperMatrix A (its pattern may not be the one factored last).
 
+  refac.Clear();
   Create_CompCol_Matrix(&A, this->n, this->n, nnz, a, irow, pcol, SLU_NC, SLU_GE);
 
   permc   = NULL;
@@ -687,13 +713,46 @@ DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp, bool
 } // DefineMatrix (rectangular).
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymMatrix<ARTYPE, ARFLOAT>::UpdateValues(const ARTYPE* newvals)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARluNonSymMatrix::UpdateValues");
+  }
+
+  // Storing the new values (A.Store points to a). The copy of A
+  // stored by rows is rebuilt by the next call to MultMtMv.
+
+  copy(nnz, newvals, 1, a, 1);
+  gram.Clear();
+
+  // Redoing the numeric factorization. The pattern is the same, so
+  // refac reuses the ordering of the last one.
+
+  if (factored) {
+    if (factoredAsI) {
+      FactorAsI(shift);
+    }
+    else {
+      FactorA();
+    }
+  }
+
+} // UpdateValues.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline ARluNonSymMatrix<ARTYPE, ARFLOAT>::ARluNonSymMatrix(): ARMatrix<ARTYPE>()
 { 
 
-  factored = false;  
-  permc    = NULL;
-  permr    = NULL;
+  factored    = false;
+  factoredAsI = false;
+  permc       = NULL;
+  permr       = NULL;
 
 } // Short constructor.
 
@@ -26,6 +26,7 @@
 #include "arlspdef.h"
 #include "arlutil.h"
 #include "arlnsmat.h"
+#include "arwork.h"
 
 
 template<class ARTYPE, class ARFLOAT>
@@ -42,7 +43,12 @@ class ARluNonSymPencil
   ARluNonSymMatrix<ARTYPE, ARFLOAT>* B;
   SuperMatrix                        L;
   SuperMatrix                        U;
-  SuperLUStat_t stat;
+  SuperLUStat_t                      stat;
+  ARluRefactor                       refac;  // Reuses the ordering across shifts.
+
+#ifdef ARCOMP_H
+  ARWorkspace<arcomplex<ARFLOAT> > wcomp;  // Used by MultInvAsBv.
+#endif
 
   virtual void Copy(const ARluNonSymPencil& other);
 
@@ -87,6 +93,16 @@ class ARluNonSymPencil
 
   void MultInvAsBv(ARFLOAT* v, ARFLOAT* w);
 
+#ifdef ARCOMP_H
+  void MultInvAsBm(int k, const arcomplex<ARFLOAT>* V, int ldv,
+                   arcomplex<ARFLOAT>* W, int ldw);
+#endif
+
+  void MultInvAsBm(int k, const ARFLOAT* V, int ldv, ARFLOAT* W, int ldw);
+  // Solves (A-sigma*B)*W = V for the k columns of V with one call to
+  // gstrs. With a complex shift, W is the real (or imaginary) part of
+  // the solution.
+
   void DefineMatrices(ARluNonSymMatrix<ARTYPE, ARFLOAT>& Ap, 
                       ARluNonSymMatrix<ARTYPE, ARFLOAT>& Bp);
 
@@ -149,7 +165,9 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::ClearMem()
     delete[] permr;
     permc = NULL;
     permr = NULL;
+    factored = false;
   }
+  refac.Clear();
 
 } // ClearMem.
 
@@ -355,6 +373,8 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
                       "ARluNonSymPencil::FactorAsB");
   }
 
+  part = 'N';   // shift is real.
+
   // Quitting the function if A and B are not square.
 
   if ((A->nrows() != A->ncols()) || (B->nrows() != B->ncols())) {
@@ -365,24 +385,16 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
   // Defining local variables.
 
   int         nnzi, info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     asb;
   SuperMatrix AsB;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   Bstore;
   NCformat*   AsBstore;
 
-  // Deleting old versions of L, U, perm_r and perm_c.
-
-  ClearMem();
-
   // Setting default values for gstrf parameters.
 
-  int   panel_size      = sp_ienv(1);
-  int   relax           = sp_ienv(2);
   superlu_options_t options;
   /* Set the default input options:
   options.Fact = DOFACT;
@@ -418,41 +430,21 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
   AsBstore = (NCformat*)AsB.Store;
   SubtractAsB(A->ncols(), sigma, *Astore, *Bstore, *AsBstore);
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // Reserving memory for the permutations.
 
-  etree = new int[A->ncols()];
   if (permc == NULL) permc = new int[A->ncols()];
   if (permr == NULL) permr = new int[A->ncols()];
 
-  // Defining LUStat.
+  // Decomposing AsB. If AsB has the pattern of the matrix factored
+  // for the previous shift, the column ordering, the elimination tree
+  // and the row permutation of that factorization are reused.
 
-//  StatInit(panel_size, relax);
-    SuperLUStat_t stat;
-    StatInit(&stat);
+  info = refac.Factor(&options, &AsB, A->order, permc, permr, &L, &U,
+                      &stat, factored);
 
-  // Defining the column permutation of matrix AsB
-  // (using minimum degree ordering on AsB'*AsB).
+  // Deleting AsB.
 
-  get_perm_c(A->order, &AsB, permc);
-
-  // Permuting columns of AsB and
-  // creating the elimination tree of AsB'*AsB.
-
-//  sp_preorder("N", &AsB, permc, etree, &AC);
-  sp_preorder(&options, &AsB, permc, etree, &AC);
-
-  // Decomposing AsB.
-
-//  gstrf("N",&AC, A->threshold, drop_tol, relax, panel_size, etree,
-//        NULL, 0, permr, permc, &L, &U, &info);
-  gstrf(&options, &AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
-
-  // Deleting AC, AsB and etree.
-
-  Destroy_CompCol_Permuted(&AC);
   Destroy_CompCol_Matrix(&AsB);
-  delete[] etree;
 
   factored = (info == 0);
 
@@ -497,24 +489,16 @@ FactorAsB(ARFLOAT sigmaR, ARFLOAT sigmaI, char partp)
   // Defining local variables.
 
   int                 nnzi, info;
-  int*                etree;
   int*                irowi;
   int*                pcoli;
   arcomplex<ARFLOAT>* asb;
   SuperMatrix         AsB;
-  SuperMatrix         AC;
   NCformat*           Astore;
   NCformat*           Bstore;
   NCformat*           AsBstore;
 
-  // Deleting old versions of L, U, perm_r and perm_c.
-
-  ClearMem();
-
   // Setting default values for gstrf parameters.
 
-  int   panel_size      = sp_ienv(1);
-  int   relax           = sp_ienv(2);
   superlu_options_t options;
   /* Set the default input options:
   options.Fact = DOFACT;
@@ -552,41 +536,21 @@ FactorAsB(ARFLOAT sigmaR, ARFLOAT sigmaI, char partp)
   AsBstore = (NCformat*)AsB.Store;
   SubtractAsB(A->ncols(), sigmaR, sigmaI, *Astore, *Bstore, *AsBstore);
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // Reserving memory for the permutations.
 
-  etree = new int[A->ncols()];
   if (permc == NULL) permc = new int[A->ncols()];
   if (permr == NULL) permr = new int[A->ncols()];
 
-  // Defining LUStat.
-
-//  StatInit(panel_size, relax);
-  SuperLUStat_t stat;
-  StatInit(&stat);
-
-  // Defining the column permutation of matrix AsB
-  // (using minimum degree ordering on AsB'*AsB).
-
-  get_perm_c(A->order, &AsB, permc);
+  // Decomposing AsB. If AsB has the pattern of the matrix factored
+  // for the previous shift, the column ordering, the elimination tree
+  // and the row permutation of that factorization are reused.
 
-  // Permuting columns of AsB and
-  // creating the elimination tree of AsB'*AsB.
+  info = refac.Factor(&options, &AsB, A->order, permc, permr, &L, &U,
+                      &stat, factored);
 
-  //sp_preorder("N", &AsB, permc, etree, &AC);
-  sp_preorder(&options, &AsB, permc, etree, &AC);
+  // Deleting AsB.
 
-  // Decomposing AsB.
-
-//  gstrf("N",&AC, A->threshold, drop_tol, relax, panel_size, etree, NULL,
-//        0, permr, permc, &L, &U, &info);
-  gstrf(&options, &AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
-
-  // Deleting AC, AsB and etree.
-
-  Destroy_CompCol_Permuted(&AC);
   Destroy_CompCol_Matrix(&AsB);
-  delete[] etree;
 
   factored = (info == 0);
 
@@ -639,17 +603,15 @@ MultInvAsBv(arcomplex<ARFLOAT>* v, arcomplex<ARFLOAT>* w)
 
   int         info;
   SuperMatrix RHS;
+  DNformat    RHSstore;
 
   copy(A->nrows(), v, 1, w, 1);
-  Create_Dense_Matrix(&RHS, A->nrows(), 1, w, A->nrows(), SLU_DN, SLU_GE);
+  Define_Dense_Matrix(&RHS, &RHSstore, A->nrows(), 1, w, A->nrows());
 //  gstrs("N", &L, &U, permr, permc, &RHS, &info);
   trans_t trans = NOTRANS;
-  StatInit(&stat);
 
   gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
 
-  Destroy_SuperMatrix_Store(&RHS); // delete RHS.Store;
-
 } // MultInvAsBv (arcomplex<ARFLOAT>).
 
 #endif
@@ -670,14 +632,14 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
 
   int         info;
   SuperMatrix RHS;
+  DNformat    RHSstore;
 
   if (part == 'N') {    // shift is real.
 
     copy(A->nrows(), v, 1, w, 1);
-    Create_Dense_Matrix(&RHS, A->nrows(), 1, w, A->nrows(), SLU_DN, SLU_GE);
+    Define_Dense_Matrix(&RHS, &RHSstore, A->nrows(), 1, w, A->nrows());
     //gstrs("N", &L, &U, permr, permc, &RHS, &info);
     trans_t trans = NOTRANS;
-    StatInit(&stat);
     gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
 
   }
@@ -686,13 +648,12 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
 #ifdef ARCOMP_H
 
     int                i;
-    arcomplex<ARFLOAT> *tv = new arcomplex<ARFLOAT>[A->ncols()];
+    arcomplex<ARFLOAT> *tv = wcomp.Get(A->ncols());
 
     for (i=0; i!=A->ncols(); i++) tv[i] = arcomplex<ARFLOAT>(v[i],0.0);
-    Create_Dense_Matrix(&RHS, A->ncols(), 1, tv, A->ncols(), SLU_DN, SLU_GE);
+    Define_Dense_Matrix(&RHS, &RHSstore, A->ncols(), 1, tv, A->ncols());
     //gstrs("N", &L, &U, permr, permc, &RHS, &info);
     trans_t trans = NOTRANS;
-    StatInit(&stat);
     gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
 
 
@@ -703,15 +664,111 @@ void ARluNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
       for (i=0; i!=A->ncols(); i++) w[i] = real(tv[i]);
     }
 
-    delete[] tv;
+#endif
+
+  }
+
+} // MultInvAsBv (ARFLOAT).
+
+
+#ifdef ARCOMP_H
+
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymPencil<ARTYPE, ARFLOAT>::
+MultInvAsBm(int k, const arcomplex<ARFLOAT>* V, int ldv,
+            arcomplex<ARFLOAT>* W, int ldw)
+{
+
+  // Quitting the function if AsB was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluNonSymPencil::MultInvAsBm");
+  }
+
+  // Solving AsB.W = V.
+
+  int         info;
+  SuperMatrix RHS;
+  DNformat    RHSstore;
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(A->nrows(), &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+  Define_Dense_Matrix(&RHS, &RHSstore, A->nrows(), k, W, ldw);
+  trans_t trans = NOTRANS;
+
+  gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
+
+} // MultInvAsBm (arcomplex<ARFLOAT>).
 
 #endif
 
+
+template<class ARTYPE, class ARFLOAT>
+void ARluNonSymPencil<ARTYPE, ARFLOAT>::
+MultInvAsBm(int k, const ARFLOAT* V, int ldv, ARFLOAT* W, int ldw)
+{
+
+  // Quitting the function if AsB was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluNonSymPencil::MultInvAsBm");
   }
 
-  Destroy_SuperMatrix_Store(&RHS); // delete RHS.Store;
+  // Solving AsB.W = V.
 
-} // MultInvAsBv (ARFLOAT).
+  int         info, r;
+  int         n = A->ncols();
+  SuperMatrix RHS;
+  DNformat    RHSstore;
+  trans_t     trans = NOTRANS;
+
+  if (part == 'N') {    // shift is real.
+
+    if (V != W) {
+      for (r = 0; r < k; r++) {
+        copy(n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+      }
+    }
+    Define_Dense_Matrix(&RHS, &RHSstore, n, k, W, ldw);
+    gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
+
+  }
+  else {                // shift is complex.
+
+#ifdef ARCOMP_H
+
+    int                i;
+    arcomplex<ARFLOAT> *tv = wcomp.Get((size_t)n*k);
+
+    for (r=0; r!=k; r++) {
+      for (i=0; i!=n; i++) {
+        tv[(size_t)r*n+i] = arcomplex<ARFLOAT>(V[(size_t)r*ldv+i],0.0);
+      }
+    }
+    Define_Dense_Matrix(&RHS, &RHSstore, n, k, tv, n);
+    gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
+
+    for (r=0; r!=k; r++) {
+      ARFLOAT*                  w = &W[(size_t)r*ldw];
+      const arcomplex<ARFLOAT>* t = &tv[(size_t)r*n];
+      if (part=='I') {
+        for (i=0; i!=n; i++) w[i] = imag(t[i]);
+      }
+      else {
+        for (i=0; i!=n; i++) w[i] = real(t[i]);
+      }
+    }
+
+#endif
+
+  }
+
+} // MultInvAsBm (ARFLOAT).
 
 
 template<class ARTYPE, class ARFLOAT>
@@ -724,6 +781,7 @@ DefineMatrices(ARluNonSymMatrix<ARTYPE, ARFLOAT>& Ap,
   B     = &Bp;
   permc = NULL;
   permr = NULL;
+  refac.Clear();
 
   if ((A->n != B->n)||(A->m != B->m)) {
     throw ArpackError(ArpackError::INCOMPATIBLE_SIZES,
@@ -751,6 +809,7 @@ ARluNonSymPencil(ARluNonSymMatrix<ARTYPE, ARFLOAT>& Ap,
                  ARluNonSymMatrix<ARTYPE, ARFLOAT>& Bp)
 {
 
+  part = 'N';
   factored = false;
   DefineMatrices(Ap, Bp);
 
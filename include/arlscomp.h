@@ -121,6 +121,7 @@ inline void ARluCompStdEig<ARFLOAT>::SetRegularMode()
            ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetRegularMode(this->objOP, 
                    &ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -134,6 +135,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARluNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARluNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -150,6 +152,7 @@ ARluCompStdEig(int nevp, ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A,
                    &ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -166,6 +169,7 @@ ARluCompStdEig(int nevp, ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A,
                    &ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARluNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
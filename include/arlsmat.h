@@ -24,6 +24,8 @@
 #include <string>
 #include "arch.h"
 #include "armat.h"
+#include "arspmat.h"
+#include "arsymmv.h"
 #include "arhbmat.h"
 #include "arerror.h"
 #include "blas1c.h"
@@ -55,6 +57,7 @@ class ARluSymMatrix: public ARMatrix<ARTYPE> {
   SuperMatrix U;
   ARhbMatrix<int, ARTYPE> mat;
   SuperLUStat_t stat;
+  ARluRefactor  refac;  // Reuses the ordering when only sigma changes.
 
   bool DataOK();
 
@@ -76,8 +79,14 @@ class ARluSymMatrix: public ARMatrix<ARTYPE> {
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V with one
+  // call to gstrs.
+
   void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
                     char uplop = 'L', double thresholdp = 0.1,
                     int orderp = 2, bool check = true);
@@ -184,7 +193,9 @@ void ARluSymMatrix<ARTYPE>::ClearMem()
     Destroy_SuperNode_Matrix(&L);
     Destroy_CompCol_Matrix(&U);
     StatFree(&stat);
+    factored = false;
   }
+  refac.Clear();
   if (this->defined) {
     Destroy_SuperMatrix_Store(&A); // delete A.Store;
     delete[] permc;
@@ -351,27 +362,15 @@ void ARluSymMatrix<ARTYPE>::FactorA()
   // Defining local variables.
 
   int         info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     aexp;
   SuperMatrix Aexp;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   Aexpstore;
 
-  // Deleting previous versions of L and U.
-  
-  if (factored) {
-    Destroy_SuperNode_Matrix(&L);
-    Destroy_CompCol_Matrix(&U);
-    StatFree(&stat);
-  }
-
   // Setting default values for gstrf parameters.
 
-  int    panel_size = sp_ienv(1);
-  int    relax      = sp_ienv(2);
   superlu_options_t options;
 
   /* Set the default input options:
@@ -407,37 +406,16 @@ void ARluSymMatrix<ARTYPE>::FactorA()
   Aexpstore = (NCformat*)Aexp.Store;
   ExpandA(*Astore, *Aexpstore);
 
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
+  // Decomposing Aexp. If Aexp has the pattern of the matrix factored
+  // last, the column ordering, the elimination tree and the row
+  // permutation of that factorization are reused.
 
-  // Defining LUStat.
+  info = refac.Factor(&options, &Aexp, order, permc, permr, &L, &U,
+                      &stat, factored);
 
-  //StatInit(panel_size, relax);
-  StatInit(&stat);
+  // Deleting Aexp.
 
-  // Defining the column permutation of matrix A
-  // (using minimum degree ordering).
-
-  get_perm_c(order, &Aexp, permc);
-
-  // Permuting columns of A and creating the elimination tree.
-
-  //sp_preorder("N", &Aexp, permc, etree, &AC);
-  sp_preorder(&options, &Aexp, permc, etree, &AC);
-
-  // Decomposing A.
-
-//  gstrf("N",&AC, threshold, drop_tol, relax, panel_size, etree,
-//        NULL, 0, permr, permc, &L, &U, &info);
-  gstrf(&options,&AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
-
-  // Deleting AC, Aexp and etree.
-
-  Destroy_CompCol_Permuted(&AC);
   Destroy_CompCol_Matrix(&Aexp);
-  delete[] etree;
 
   factored = (info == 0);
 
@@ -472,27 +450,15 @@ void ARluSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
   // Defining local variables.
 
   int         info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     asi;
   SuperMatrix AsI;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   AsIstore;
 
-  // Deleting previous versions of L and U.
-  
-  if (factored) {
-    Destroy_SuperNode_Matrix(&L);
-    Destroy_CompCol_Matrix(&U);
-    StatFree(&stat);
-  }
-
   // Setting default values for gstrf parameters.
 
-  int    panel_size = sp_ienv(1);
-  int    relax      = sp_ienv(2);
   superlu_options_t options;
 
   /* Set the default input options:
@@ -528,36 +494,16 @@ void ARluSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
   AsIstore = (NCformat*)AsI.Store;
   ExpandA(*Astore, *AsIstore, sigma);
 
-  // Reserving memory for etree (used in matrix decomposition).
-
-  etree = new int[this->n];
-
-  // Defining LUStat.
-
-  //StatInit(panel_size, relax);
-  StatInit(&stat);
-
-  // Defining the column permutation of matrix AsI
-  // (using minimum degree ordering).
-
-  get_perm_c(order, &AsI, permc);
+  // Decomposing AsI. If AsI has the pattern of the matrix factored
+  // last, the column ordering, the elimination tree and the row
+  // permutation of that factorization are reused.
 
-  // Permuting columns of AsI and creating the elimination tree.
+  info = refac.Factor(&options, &AsI, order, permc, permr, &L, &U,
+                      &stat, factored);
 
-  sp_preorder(&options, &AsI, permc, etree, &AC);
+  // Deleting AsI.
 
-  // Decomposing AsI.
-
-//  gstrf("N",&AC, threshold, drop_tol, relax, panel_size, etree,
-//        NULL, 0, permr, permc, &L, &U, &info);
-  gstrf(&options,&AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
-
-  // Deleting AC, AsI and etree.
-
-  Destroy_CompCol_Permuted(&AC);
   Destroy_CompCol_Matrix(&AsI);
-  delete[] etree;
 
   factored = (info == 0);
 
@@ -583,9 +529,6 @@ template<class ARTYPE>
 void ARluSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
 
-  int    i, j, k;
-  ARTYPE t;
-
   // Quitting the function if A was not defined.
 
   if (!this->IsDefined()) {
@@ -594,42 +537,27 @@ void ARluSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 
   // Determining w = M.v.
 
-  for (i=0; i!=this->m; i++) w[i]=(ARTYPE)0;
+  SymCSCMultMv(this->n, pcol, irow, a, (uplo == 'U') ? 'U' : 'L', v, w);
 
-  if (uplo == 'U') {
+} // MultMv.
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i+1];
-      if ((k!=pcol[i])&&(irow[k-1]==i)) {
-        w[i] += t*a[k-1];
-        k--;
-      }
-      for (j=pcol[i]; j<k; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
 
-  }
-  else {
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv,
+                                   ARTYPE* W, int ldw)
+{
 
-    for (i=0; i!=this->n; i++) {
-      t = v[i];
-      k = pcol[i];
-      if ((k!=pcol[i+1])&&(irow[k]==i)) {
-        w[i] += t*a[k];
-        k++;
-      }
-      for (j=k; j<pcol[i+1]; j++) {
-        w[irow[j]] += t*a[j];
-        w[i] += v[irow[j]]*a[j];
-      }
-    }
+  // Quitting the function if A was not defined.
 
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARluSymMatrix::MultMm");
   }
 
-} // MultMv.
+  // Determining W = M.V.
+
+  SymCSCMultMm(this->n, pcol, irow, a, uplo, k, V, ldv, W, ldw);
+
+} // MultMm.
 
 
 template<class ARTYPE>
@@ -647,18 +575,47 @@ void ARluSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 
   int         info;
   SuperMatrix B;
+  DNformat    Bstore;
 
   if (&v != &w) copy(this->n, v, 1, w, 1);
-  Create_Dense_Matrix(&B, this->n, 1, w, this->n, SLU_DN, SLU_GE);
+  Define_Dense_Matrix(&B, &Bstore, this->n, 1, w, this->n);
 //  gstrs("N", &L, &U, permr, permc, &B, &info);
-  StatInit(&stat);
   trans_t trans = NOTRANS;
   gstrs(trans, &L, &U, permc, permr, &B, &stat, &info);
-  Destroy_SuperMatrix_Store(&B); // delete B.Store;
 
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARluSymMatrix<ARTYPE>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                      ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluSymMatrix::MultInvMm");
+  }
+
+  // Solving A.W = V (or AsI.W = V) for all columns in a single call.
+
+  int         info;
+  SuperMatrix B;
+  DNformat    Bstore;
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+  Define_Dense_Matrix(&B, &Bstore, this->n, k, W, ldw);
+  trans_t trans = NOTRANS;
+  gstrs(trans, &L, &U, permc, permr, &B, &stat, &info);
+
+} // MultInvMm.
+
+
 template<class ARTYPE>
 inline void ARluSymMatrix<ARTYPE>::
 DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
@@ -683,8 +640,9 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
                       "ARluSymMatrix::DefineMatrix");
   }
 
-  // Creating SuperMatrix A.
+  // Creating SuperMatrix A (its pattern may not be the one factored last).
 
+  refac.Clear();
   Create_CompCol_Matrix(&A, this->n, this->n, nnz, a, irow, pcol, SLU_NC, SLU_GE);
 
   // Reserving memory for vectors used in matrix decomposition.
@@ -118,6 +118,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARluNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetRegularMode(this->objOP, &ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -129,6 +130,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARluNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, 
                        &ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -145,6 +147,7 @@ ARluNonSymStdEig(int nevp, ARluNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -160,6 +163,7 @@ ARluNonSymStdEig(int nevp, ARluNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARluNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
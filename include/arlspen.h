@@ -43,7 +43,8 @@ class ARluSymPencil
   ARluSymMatrix<ARTYPE>* B;
   SuperMatrix            L;
   SuperMatrix            U;
-  SuperLUStat_t stat;
+  SuperLUStat_t          stat;
+  ARluRefactor           refac;  // Reuses the ordering across shifts.
 
   virtual void Copy(const ARluSymPencil& other);
 
@@ -71,6 +72,9 @@ class ARluSymPencil
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves AsB*W = V for the k columns of V with one call to gstrs.
+
   void DefineMatrices(ARluSymMatrix<ARTYPE>& Ap, ARluSymMatrix<ARTYPE>& Bp);
 
   ARluSymPencil();
@@ -132,7 +136,9 @@ void ARluSymPencil<ARTYPE>::ClearMem()
     delete[] permr;
     permc = NULL;
     permr = NULL;
+    factored = false;
   }
+  refac.Clear();
 
 } // ClearMem.
 
@@ -469,24 +475,16 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   // Defining local variables.
 
   int         nnzi, info;
-  int*        etree;
   int*        irowi;
   int*        pcoli;
   ARTYPE*     asb;
   SuperMatrix AsB;
-  SuperMatrix AC;
   NCformat*   Astore;
   NCformat*   Bstore;
   NCformat*   AsBstore;
 
-  // Deleting old versions of L, U, perm_r and perm_c.
-
-  ClearMem();
-
   // Setting default values for gstrf parameters.
 
-  int  panel_size = sp_ienv(1);
-  int  relax      = sp_ienv(2);
   superlu_options_t options;
   /* Set the default input options:
   options.Fact = DOFACT;
@@ -526,40 +524,21 @@ void ARluSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
   AsBstore = (NCformat*)AsB.Store;
   SubtractAsB(A->ncols(), sigma, *Astore, *Bstore, *AsBstore);
 
-  // Reserving memory for some vectors used in matrix decomposition.
+  // Reserving memory for the permutations.
 
-  etree = new int[A->ncols()];
   if (permc == NULL) permc = new int[A->ncols()];
   if (permr == NULL) permr = new int[A->ncols()];
 
-  // Defining LUStat.
-
-//  StatInit(panel_size, relax);
-    SuperLUStat_t stat;
-    StatInit(&stat);
-
-  // Defining the column permutation of matrix AsB
-  // (using minimum degree ordering on AsB'*AsB).
-
-  get_perm_c(A->order, &AsB, permc);
-
-  // Permuting columns of AsB and
-  // creating the elimination tree of AsB'*AsB.
-
-  sp_preorder(&options, &AsB, permc, etree, &AC);
+  // Decomposing AsB. If AsB has the pattern of the matrix factored
+  // for the previous shift, the column ordering, the elimination tree
+  // and the row permutation of that factorization are reused.
 
-  // Decomposing AsB.
+  info = refac.Factor(&options, &AsB, A->order, permc, permr, &L, &U,
+                      &stat, factored);
 
-//  gstrf("N",&AC, A->threshold, drop_tol, relax, panel_size, etree,
-//        NULL, 0, permr, permc, &L, &U, &info);
-  gstrf(&options, &AC, relax, panel_size, etree,
-        NULL, 0, permc, permr, &L, &U, &stat, &info);
+  // Deleting AsB.
 
-  // Deleting AC, AsB and etree.
-
-  Destroy_CompCol_Permuted(&AC);
   Destroy_CompCol_Matrix(&AsB);
-  delete[] etree;
 
   factored = (info == 0);
 
@@ -607,20 +586,49 @@ void ARluSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
 
   int         info;
   SuperMatrix RHS;
+  DNformat    RHSstore;
 
   copy(A->nrows(), v, 1, w, 1);
-  Create_Dense_Matrix(&RHS, A->nrows(), 1, w, A->nrows(), SLU_DN, SLU_GE);
+  Define_Dense_Matrix(&RHS, &RHSstore, A->nrows(), 1, w, A->nrows());
 //  gstrs("N", &L, &U, permr, permc, &RHS, &info);
   trans_t trans = NOTRANS;
-  StatInit(&stat);
 
   gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
 
-  Destroy_SuperMatrix_Store(&RHS); // delete RHS.Store;
-
 } // MultInvAsBv.
 
 
+template<class ARTYPE>
+void ARluSymPencil<ARTYPE>::
+MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if AsB was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARluSymPencil::MultInvAsBm");
+  }
+
+  // Solving AsB.W = V.
+
+  int         info;
+  SuperMatrix RHS;
+  DNformat    RHSstore;
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(A->nrows(), &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+  Define_Dense_Matrix(&RHS, &RHSstore, A->nrows(), k, W, ldw);
+  trans_t trans = NOTRANS;
+
+  gstrs(trans, &L, &U, permc, permr, &RHS, &stat, &info);
+
+} // MultInvAsBm.
+
+
 template<class ARTYPE>
 inline void ARluSymPencil<ARTYPE>::
 DefineMatrices(ARluSymMatrix<ARTYPE>& Ap, ARluSymMatrix<ARTYPE>& Bp)
@@ -630,6 +638,7 @@ DefineMatrices(ARluSymMatrix<ARTYPE>& Ap, ARluSymMatrix<ARTYPE>& Bp)
   B     = &Bp;
   permc = NULL;
   permr = NULL;
+  refac.Clear();
 
   if ((A->n != B->n)||(A->m != B->m)) {
     throw ArpackError(ArpackError::INCOMPATIBLE_SIZES,
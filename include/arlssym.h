@@ -119,6 +119,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARluSymMatrix<ARFLOAT> >::
     SetRegularMode(this->objOP, &ARluSymMatrix<ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARluSymMatrix<ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -129,6 +130,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARluSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARluSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARluSymMatrix<ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -143,6 +145,7 @@ ARluSymStdEig(int nevp, ARluSymMatrix<ARFLOAT>& A,
   this->NoShift();
   this->DefineParameters(A.ncols(), nevp, &A, &ARluSymMatrix<ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARluSymMatrix<ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -157,6 +160,7 @@ ARluSymStdEig(int nevp, ARluSymMatrix<ARFLOAT>& A,
 
   this->DefineParameters(A.ncols(), nevp, &A, &ARluSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARluSymMatrix<ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
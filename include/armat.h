@@ -17,6 +17,8 @@
 #ifndef ARMAT_H
 #define ARMAT_H
 
+#include <cstddef>
+
 template<class ARTYPE>
 class ARMatrix {
 
@@ -50,6 +52,17 @@ class ARMatrix {
   virtual void MultMv(ARTYPE* v, ARTYPE* w) = 0;
   // Matrix-vector product: w = A*v.
 
+  virtual void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+  // Matrix-matrix product: W = A*V, where V (ncols x k) and W (nrows x k)
+  // are stored by columns with leading dimensions ldv and ldw. This
+  // default version calls MultMv once per column; derived classes
+  // override it to read the matrix only once for all k vectors.
+  {
+    for (int r = 0; r < k; r++) {
+      MultMv(const_cast<ARTYPE*>(&V[(size_t)r*ldv]), &W[(size_t)r*ldw]);
+    }
+  } // MultMm.
+
 }; // ARMatrix.
 
 #endif // ARMAT_H
@@ -0,0 +1,234 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARPEig.h.
+   Arpack++ class ARParStdEig definition.
+   Derived from ARrcStdEig, this class holds the MPI communicator
+   and the range of rows stored by each process, and is the base
+   class of the distributed (PARPACK) eigenvalue problems
+   ARParSymStdEig and ARParNonSymStdEig.
+
+   In these problems each process stores rows first to last-1 of
+   every vector. GetN, GetVector, PutVector, Eigenvector, RawEigenvector
+   and the residual vector all refer to the local rows, while nev and
+   ncv are related to the dimension of the whole problem (GetGlobalN).
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARPEIG_H
+#define ARPEIG_H
+
+#include <mpi.h>
+#include "arch.h"
+#include "arerror.h"
+#include "arrseig.h"
+
+// ARParStdEig class definition.
+
+template<class ARFLOAT, class ARTYPE>
+class ARParStdEig: public virtual ARrcStdEig<ARFLOAT, ARTYPE> {
+
+ protected:
+
+ // a) Protected variables:
+
+  MPI_Comm comm;     // Communicator shared by all processes.
+  ARindex  first;    // First row stored by this process.
+  ARindex  last;     // Last row (plus one) stored by this process.
+  ARindex  nglobal;  // Dimension of the whole problem.
+
+
+ // b) Protected functions:
+
+ // b.1) Functions that check user defined parameters.
+
+  int CheckN(int np);
+  // Checks that np is the number of local rows and that the whole
+  // problem has at least two rows.
+
+  int CheckNev(int nevp);
+  // Does range checking on nev (0 < nev < GetGlobalN()).
+
+  int CheckNcv(int ncvp);
+  // Forces ncv to conform to its ranges (nev < ncv <= GetGlobalN()).
+
+
+ // b.2) Functions that set internal variables.
+
+  virtual void Copy(const ARParStdEig& other);
+  // Makes a deep copy of "other" over "this" object.
+  // Old values are not deleted (this function is to be used
+  // by the copy constructor and the assignment operator only).
+
+
+ public:
+
+ // c) Public functions:
+
+ // c.1) Function that stores the data distribution.
+
+  void DefineComm(MPI_Comm commp, ARindex firstp, ARindex lastp);
+  // Sets the communicator and the rows stored by this process. This is
+  // a collective operation: the ranges given by all processes must
+  // cover rows 0 to GetGlobalN()-1 in rank order.
+
+
+ // c.2) Functions that provide access to internal variables' values.
+
+  MPI_Comm GetComm() const { return comm; }
+  // Returns the communicator.
+
+  ARindex FirstRow() const { return first; }
+  // Returns the index of the first row stored by this process.
+
+  ARindex LastRow() const { return last; }
+  // Returns the index of the last row (plus one) stored by this process.
+
+  ARindex GetGlobalN() const { return nglobal; }
+  // Returns the dimension of the whole problem.
+
+
+ // c.3) Functions that allow changes in problem parameters.
+
+  void ChangeBlockSize(int nbp);
+  // PARPACK handles one vector at a time, so nbp must be 1.
+
+
+ // c.4) Constructors and destructor.
+
+  ARParStdEig(): comm(MPI_COMM_NULL), first(0), last(0), nglobal(0) { }
+  // Short constructor.
+
+  virtual ~ARParStdEig() { }
+  // Destructor.
+
+}; // class ARParStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARParStdEig member functions definition.                                 //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARTYPE>
+inline void ARParStdEig<ARFLOAT, ARTYPE>::
+Copy(const ARParStdEig<ARFLOAT, ARTYPE>& other)
+{
+
+  ARrcStdEig<ARFLOAT, ARTYPE>::Copy(other);
+  comm    = other.comm;
+  first   = other.first;
+  last    = other.last;
+  nglobal = other.nglobal;
+
+} // Copy.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline int ARParStdEig<ARFLOAT, ARTYPE>::CheckN(int np)
+{
+
+  if (comm == MPI_COMM_NULL) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "CheckN");
+  }
+  if ((np < 1) || (np != (last-first))) {
+    throw ArpackError(ArpackError::INCOMPATIBLE_SIZES, "CheckN");
+  }
+  if (nglobal < 2) {
+    throw ArpackError(ArpackError::N_SMALLER_THAN_2);
+  }
+  return np;
+
+} // CheckN.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline int ARParStdEig<ARFLOAT, ARTYPE>::CheckNev(int nevp)
+{
+
+  if ((nevp<1)||(nevp>=nglobal)) {
+    throw ArpackError(ArpackError::NEV_OUT_OF_BOUNDS);
+  }
+  return nevp;
+
+} // CheckNev.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline int ARParStdEig<ARFLOAT, ARTYPE>::CheckNcv(int ncvp)
+{
+
+  // Adjusting ncv if ncv <= nev or ncv > nglobal.
+
+  int nev = this->nev;
+
+  if (ncvp < nev+1) {
+    if (ncvp) ArpackError::Set(ArpackError::NCV_OUT_OF_BOUNDS);
+    return ((2*nev+1)>nglobal)?(int)nglobal:(2*nev+1);
+  }
+  else if (ncvp > nglobal) {
+    ArpackError::Set(ArpackError::NCV_OUT_OF_BOUNDS);
+    return (int)nglobal;
+  }
+  else {
+    return ncvp;
+  }
+
+} // CheckNcv.
+
+
+template<class ARFLOAT, class ARTYPE>
+void ARParStdEig<ARFLOAT, ARTYPE>::
+DefineComm(MPI_Comm commp, ARindex firstp, ARindex lastp)
+{
+
+  long long nloc, offset, total;
+  int       rank, ok;
+
+  // Finding the dimension of the problem and the position of the
+  // local rows in the rank order.
+
+  nloc   = (long long)(lastp-firstp);
+  offset = 0;
+  MPI_Comm_rank(commp, &rank);
+  MPI_Allreduce(&nloc, &total, 1, MPI_LONG_LONG, MPI_SUM, commp);
+  MPI_Exscan(&nloc, &offset, 1, MPI_LONG_LONG, MPI_SUM, commp);
+  if (rank == 0) offset = 0;
+
+  // All processes must agree on the validity of the distribution.
+
+  ok = ((nloc >= 1) && (offset == (long long)firstp)) ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, commp);
+  if (!ok) {
+    throw ArpackError(ArpackError::INCONSISTENT_DATA, "DefineComm");
+  }
+
+  comm    = commp;
+  first   = firstp;
+  last    = lastp;
+  nglobal = (ARindex)total;
+
+} // DefineComm.
+
+
+template<class ARFLOAT, class ARTYPE>
+inline void ARParStdEig<ARFLOAT, ARTYPE>::ChangeBlockSize(int nbp)
+{
+
+  if (nbp != 1) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "ChangeBlockSize");
+  }
+
+} // ChangeBlockSize.
+
+
+#endif // ARPEIG_H
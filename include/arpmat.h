@@ -0,0 +1,312 @@
+#ifndef ARPMAT_H
+#define ARPMAT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <mpi.h>
+#include "arch.h"
+#include "armat.h"
+#include "arerror.h"
+
+/**
+ * @brief MPI datatype that matches a C++ type (used by ARParMatrix).
+ */
+template<typename ARTYPE> struct ARMPIType;
+template<> struct ARMPIType<int> { static MPI_Datatype get() { return MPI_INT; } };
+template<> struct ARMPIType<int64_t> { static MPI_Datatype get() { return MPI_INT64_T; } };
+template<> struct ARMPIType<float> { static MPI_Datatype get() { return MPI_FLOAT; } };
+template<> struct ARMPIType<double> { static MPI_Datatype get() { return MPI_DOUBLE; } };
+template<> struct ARMPIType<arcomplex<float>> { static MPI_Datatype get() { return MPI_CXX_FLOAT_COMPLEX; } };
+template<> struct ARMPIType<arcomplex<double>> { static MPI_Datatype get() { return MPI_CXX_DOUBLE_COMPLEX; } };
+
+/**
+ * @brief A square sparse matrix distributed by rows among the processes of
+ *        a MPI communicator, for use with ARParSymStdEig and
+ *        ARParNonSymStdEig.
+ *
+ * Each process stores a contiguous range of rows [first, last) in
+ * compressed row storage, with global column indices. Vectors are
+ * distributed in the same way, so MultMv(v, w) takes and returns the local
+ * rows of v and w. The entries of v owned by other processes ("ghost"
+ * entries) are exchanged with point-to-point messages, only between
+ * processes that share nonzeros, and the product with the local columns is
+ * computed while those messages are in transit.
+ */
+template<typename ARTYPE>
+class ARParMatrix : public ARMatrix<ARTYPE> {
+
+protected:
+
+    static constexpr int Tag = 7317; // tag of the halo exchange messages
+
+    MPI_Comm comm;     // communicator shared by all processes
+    ARindex  first;    // first row stored by this process
+    ARindex  nglobal;  // number of rows (and columns) of the whole matrix
+
+    std::vector<ARindex> Lp; // row pointers of the local columns
+    std::vector<int>     Lj; // local column indices (relative to first)
+    std::vector<ARTYPE>  Lx; // values of the local columns
+    std::vector<ARindex> Gp; // row pointers of the ghost columns
+    std::vector<int>     Gj; // positions of the ghost columns in ghost
+    std::vector<ARTYPE>  Gx; // values of the ghost columns
+
+    std::vector<int>     sendRank;  // processes that need entries of v
+    std::vector<int>     sendStart; // their first position in sendIdx
+    std::vector<int>     sendIdx;   // local rows sent to those processes
+    std::vector<int>     recvRank;  // processes that own ghost entries
+    std::vector<int>     recvStart; // their first position in ghost
+    std::vector<ARindex> ghostCol;  // global index of each ghost entry
+
+    std::vector<ARTYPE>      sendBuf;  // entries of v being sent
+    std::vector<ARTYPE>      ghost;    // ghost entries of v
+    std::vector<MPI_Request> requests; // pending halo exchange messages
+
+public:
+
+    /**
+     * @brief Returns the communicator.
+     */
+    MPI_Comm GetComm() const { return comm; }
+
+    /**
+     * @brief Returns the index of the first row stored by this process.
+     */
+    ARindex FirstRow() const { return first; }
+
+    /**
+     * @brief Returns the index of the last row (plus one) stored by this
+     *        process.
+     */
+    ARindex LastRow() const { return first + this->m; }
+
+    /**
+     * @brief Returns the number of rows of the whole matrix.
+     */
+    ARindex GlobalSize() const { return nglobal; }
+
+    /**
+     * @brief Returns the number of entries of v received from other
+     *        processes by each product.
+     */
+    int GhostSize() const { return (int)ghostCol.size(); }
+
+    /**
+     * @brief Returns the number of processes this process exchanges
+     *        entries of v with.
+     */
+    int Neighbours() const { return (int)std::max(sendRank.size(), recvRank.size()); }
+
+    /**
+     * @brief Stores the local rows of the matrix and sets up the halo
+     *        exchange. This is a collective operation.
+     *
+     * @param commp  Communicator shared by all processes
+     * @param firstp First row stored by this process
+     * @param lastp  Last row (plus one) stored by this process. The ranges
+     *               of all processes must cover rows 0 to n-1 in rank order.
+     * @param rowptr Row pointers of the local rows (size lastp-firstp+1)
+     * @param colind Global column indices of the nonzeros
+     * @param values Values of the nonzeros
+     *
+     * @remarks The arrays are copied. Ghost entries are numbered in
+     *          increasing global order, so the messages received from each
+     *          process are contiguous.
+     */
+    void Define(MPI_Comm commp, ARindex firstp, ARindex lastp,
+                const ARindex* rowptr, const ARindex* colind, const ARTYPE* values);
+
+    /**
+     * @brief Performs the matrix-vector product w = A*v, where v and w hold
+     *        the local rows of the distributed vectors. This is a collective
+     *        operation.
+     */
+    void MultMv(ARTYPE* v, ARTYPE* w);
+
+    ARParMatrix(): ARMatrix<ARTYPE>(0), comm(MPI_COMM_NULL), first(0), nglobal(0) { }
+    // Short constructor.
+
+    ARParMatrix(MPI_Comm commp, ARindex firstp, ARindex lastp,
+                const ARindex* rowptr, const ARindex* colind, const ARTYPE* values)
+        : ARMatrix<ARTYPE>(0)
+    {
+        Define(commp, firstp, lastp, rowptr, colind, values);
+    }
+    // Long constructor.
+
+};
+
+// ------------------------------------------------------------------------ //
+// ARParMatrix member functions definition.                                 //
+// ------------------------------------------------------------------------ //
+
+template<typename ARTYPE>
+void ARParMatrix<ARTYPE>::Define(MPI_Comm commp, ARindex firstp, ARindex lastp,
+                                 const ARindex* rowptr, const ARindex* colind,
+                                 const ARTYPE* values)
+{
+    MPI_Datatype itype = ARMPIType<ARindex>::get();
+    int nprocs, ok;
+    int nloc = (int)(lastp - firstp);
+
+    MPI_Comm_size(commp, &nprocs);
+
+    // Row ranges of all processes. Every process sees the same ranges, so
+    // they all accept or reject the distribution together.
+
+    ARindex range[2] = { firstp, lastp };
+    std::vector<ARindex> ranges(2 * nprocs);
+    MPI_Allgather(range, 2, itype, &ranges[0], 2, itype, commp);
+
+    std::vector<ARindex> starts(nprocs + 1);
+    ok = (ranges[0] == 0) ? 1 : 0;
+    for (int q = 0; q < nprocs; q++) {
+        if (ranges[2 * q + 1] < ranges[2 * q]) ok = 0;
+        if (q > 0 && ranges[2 * q] != ranges[2 * q - 1]) ok = 0;
+        starts[q] = ranges[2 * q];
+    }
+    starts[nprocs] = ranges[2 * nprocs - 1];
+    if (!ok) {
+        throw ArpackError(ArpackError::INCONSISTENT_DATA, "ARParMatrix::Define");
+    }
+
+    comm    = commp;
+    first   = firstp;
+    nglobal = starts[nprocs];
+
+    // Global indices of the ghost columns, in increasing order.
+
+    ARindex nnz = rowptr[nloc] - rowptr[0];
+    const ARindex* cols = &colind[rowptr[0]];
+    const ARTYPE*  vals = &values[rowptr[0]];
+
+    ok = 1;
+    ghostCol.clear();
+    for (ARindex k = 0; k < nnz; k++) {
+        if (cols[k] < 0 || cols[k] >= nglobal) ok = 0;
+        else if (cols[k] < firstp || cols[k] >= lastp) ghostCol.push_back(cols[k]);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+    if (!ok) {
+        throw ArpackError(ArpackError::INCONSISTENT_DATA, "ARParMatrix::Define");
+    }
+    std::sort(ghostCol.begin(), ghostCol.end());
+    ghostCol.erase(std::unique(ghostCol.begin(), ghostCol.end()), ghostCol.end());
+
+    // Number of ghost entries owned by each process, and number of local
+    // entries each process needs from this one.
+
+    std::vector<int> nrecv(nprocs, 0), nsend(nprocs);
+    for (ARindex g : ghostCol) {
+        int q = (int)(std::upper_bound(starts.begin(), starts.end(), g) - starts.begin()) - 1;
+        nrecv[q]++;
+    }
+    MPI_Alltoall(&nrecv[0], 1, MPI_INT, &nsend[0], 1, MPI_INT, comm);
+
+    std::vector<int> rdispl(nprocs + 1, 0), sdispl(nprocs + 1, 0);
+    for (int q = 0; q < nprocs; q++) {
+        rdispl[q + 1] = rdispl[q] + nrecv[q];
+        sdispl[q + 1] = sdispl[q] + nsend[q];
+    }
+
+    // Sending the global indices of the ghost entries to their owners.
+
+    std::vector<ARindex> needed(sdispl[nprocs] + 1);
+    MPI_Alltoallv(ghostCol.data(), &nrecv[0], &rdispl[0], itype,
+                  &needed[0], &nsend[0], &sdispl[0], itype, comm);
+
+    sendIdx.resize(sdispl[nprocs]);
+    for (int i = 0; i < sdispl[nprocs]; i++) sendIdx[i] = (int)(needed[i] - firstp);
+
+    sendRank.clear();
+    sendStart.assign(1, 0);
+    recvRank.clear();
+    recvStart.assign(1, 0);
+    for (int q = 0; q < nprocs; q++) {
+        if (nsend[q] > 0) {
+            sendRank.push_back(q);
+            sendStart.push_back(sdispl[q + 1]);
+        }
+        if (nrecv[q] > 0) {
+            recvRank.push_back(q);
+            recvStart.push_back(rdispl[q + 1]);
+        }
+    }
+
+    // Splitting the local rows into local and ghost columns.
+
+    Lp.assign(nloc + 1, 0);
+    Gp.assign(nloc + 1, 0);
+    Lj.clear(); Lx.clear();
+    Gj.clear(); Gx.clear();
+    for (int i = 0; i < nloc; i++) {
+        for (ARindex k = rowptr[i] - rowptr[0]; k < rowptr[i + 1] - rowptr[0]; k++) {
+            if (cols[k] >= firstp && cols[k] < lastp) {
+                Lj.push_back((int)(cols[k] - firstp));
+                Lx.push_back(vals[k]);
+            }
+            else {
+                Gj.push_back((int)(std::lower_bound(ghostCol.begin(), ghostCol.end(), cols[k])
+                                   - ghostCol.begin()));
+                Gx.push_back(vals[k]);
+            }
+        }
+        Lp[i + 1] = (ARindex)Lj.size();
+        Gp[i + 1] = (ARindex)Gj.size();
+    }
+
+    sendBuf.resize(sendIdx.size());
+    ghost.resize(ghostCol.size());
+    requests.resize(sendRank.size() + recvRank.size());
+
+    this->m = nloc;
+    this->n = nloc;
+    this->defined = true;
+}
+
+template<typename ARTYPE>
+void ARParMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
+{
+    if (!this->defined) {
+        throw ArpackError(ArpackError::DATA_UNDEFINED, "ARParMatrix::MultMv");
+    }
+
+    MPI_Datatype type = ARMPIType<ARTYPE>::get();
+    int nr = (int)recvRank.size();
+    int ns = (int)sendRank.size();
+
+    // Posting the receives of the ghost entries of v.
+
+    for (int r = 0; r < nr; r++) {
+        MPI_Irecv(&ghost[recvStart[r]], recvStart[r + 1] - recvStart[r], type,
+                  recvRank[r], Tag, comm, &requests[r]);
+    }
+
+    // Sending the entries of v needed by other processes.
+
+    for (size_t i = 0; i < sendIdx.size(); i++) sendBuf[i] = v[sendIdx[i]];
+    for (int s = 0; s < ns; s++) {
+        MPI_Isend(&sendBuf[sendStart[s]], sendStart[s + 1] - sendStart[s], type,
+                  sendRank[s], Tag, comm, &requests[nr + s]);
+    }
+
+    // Local columns, while the messages are in transit.
+
+    for (int i = 0; i < this->m; i++) {
+        ARTYPE sum = ARTYPE(0);
+        for (ARindex k = Lp[i]; k < Lp[i + 1]; k++) sum += Lx[k] * v[Lj[k]];
+        w[i] = sum;
+    }
+
+    MPI_Waitall(nr + ns, requests.data(), MPI_STATUSES_IGNORE);
+
+    // Ghost columns.
+
+    for (int i = 0; i < this->m; i++) {
+        ARTYPE sum = ARTYPE(0);
+        for (ARindex k = Gp[i]; k < Gp[i + 1]; k++) sum += Gx[k] * ghost[Gj[k]];
+        w[i] += sum;
+    }
+}
+
+#endif // ARPMAT_H
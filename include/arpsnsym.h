@@ -0,0 +1,199 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARPSNSym.h.
+   Arpack++ class ARParNonSymStdEig definition.
+   This class solves real nonsymmetric standard eigenvalue problems
+   distributed among the processes of a MPI communicator, using the
+   PARPACK subroutines psnaupd/pdnaupd and psneupd/pdneupd through
+   the reverse communication interface of ARrcNonSymStdEig.
+
+   Each process stores a contiguous range of rows of all vectors.
+   GetVector and PutVector point to the local rows of x and y, and
+   the user is required to compute the local rows of y = OP*x (see
+   ARParMatrix in arpmat.h). The eigenvectors returned are also the
+   local rows of the eigenvectors of the whole problem.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARPSNSYM_H
+#define ARPSNSYM_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "arerror.h"
+#include "arrsnsym.h"
+#include "arpeig.h"
+#include "parpackc.h"
+
+
+template<class ARFLOAT>
+class ARParNonSymStdEig:
+  public virtual ARrcNonSymStdEig<ARFLOAT>,
+  public virtual ARParStdEig<ARFLOAT, ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  void Aupp();
+  // Interface to PARPACK subroutines PSNAUPD and PDNAUPD.
+
+  void Eupp();
+  // Interface to PARPACK subroutines PSNEUPD and PDNEUPD.
+
+  int CheckNev(int nevp);
+  // Does range checking on nev (1 < nev < GetGlobalN()-1).
+
+
+ public:
+
+ // b) Public functions:
+
+ // b.1) Functions that select the eigensolver.
+
+  void SetNativeBackend(bool nativep = true, int nthreadsp = 1);
+  // The native Krylov-Schur method does not handle distributed
+  // vectors, so nativep must be false.
+
+
+ // b.2) Constructors and destructor.
+
+  ARParNonSymStdEig() { }
+  // Short constructor.
+
+  ARParNonSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+                 const std::string& whichp = "LM", int ncvp = 0,
+                 ARFLOAT tolp = 0.0, int maxitp = 0, ARFLOAT* residp = NULL,
+                 bool ishiftp = true);
+  // Long constructor (regular mode). This process stores rows firstp
+  // to lastp-1 of all vectors (and of residp, if given).
+
+  ARParNonSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+                 ARFLOAT sigmap, const std::string& whichp = "LM",
+                 int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+                 ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARParNonSymStdEig(const ARParNonSymStdEig& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARParNonSymStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARParNonSymStdEig& operator=(const ARParNonSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARParNonSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARParNonSymStdEig member functions definition.                              //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT>
+inline void ARParNonSymStdEig<ARFLOAT>::Aupp()
+{
+
+  pnaupp(this->comm, this->ido, this->bmat, this->n, this->which, this->nev, this->tol,
+         this->resid, this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd,
+         this->workl, this->lworkl, this->info);
+
+} // Aupp.
+
+
+template<class ARFLOAT>
+inline void ARParNonSymStdEig<ARFLOAT>::Eupp()
+{
+
+  pneupp(this->comm, this->rvec, this->HowMny, this->EigValR, this->EigValI, this->EigVec,
+         this->n, this->sigmaR, this->sigmaI, this->workv, this->bmat, this->n, this->which,
+         this->nev, this->tol, this->resid, this->ncv, this->V, this->n, this->iparam,
+         this->ipntr, this->workd, this->workl, this->lworkl, this->info);
+
+} // Eupp.
+
+
+template<class ARFLOAT>
+inline int ARParNonSymStdEig<ARFLOAT>::CheckNev(int nevp)
+{
+
+  if ((nevp<=1)||(nevp>=(this->nglobal-1))) { // 1 < nev < nglobal-1.
+    throw ArpackError(ArpackError::NEV_OUT_OF_BOUNDS);
+  }
+  return nevp;
+
+} // CheckNev.
+
+
+template<class ARFLOAT>
+inline void ARParNonSymStdEig<ARFLOAT>::
+SetNativeBackend(bool nativep, int)
+{
+
+  if (nativep) {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "SetNativeBackend");
+  }
+
+} // SetNativeBackend.
+
+
+template<class ARFLOAT>
+inline ARParNonSymStdEig<ARFLOAT>::
+ARParNonSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+               const std::string& whichp, int ncvp, ARFLOAT tolp, int maxitp,
+               ARFLOAT* residp, bool ishiftp)
+{
+
+  this->DefineComm(commp, firstp, lastp);
+  this->NoShift();
+  this->DefineParameters((int)(lastp-firstp), nevp, whichp, ncvp, tolp, maxitp,
+                         residp, ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT>
+inline ARParNonSymStdEig<ARFLOAT>::
+ARParNonSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+               ARFLOAT sigmap, const std::string& whichp, int ncvp,
+               ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
+{
+
+  this->DefineComm(commp, firstp, lastp);
+  this->ChangeShift(sigmap);
+  this->DefineParameters((int)(lastp-firstp), nevp, whichp, ncvp, tolp, maxitp,
+                         residp, ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT>
+ARParNonSymStdEig<ARFLOAT>& ARParNonSymStdEig<ARFLOAT>::
+operator=(const ARParNonSymStdEig<ARFLOAT>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARPSNSYM_H
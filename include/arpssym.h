@@ -0,0 +1,184 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARPSSym.h.
+   Arpack++ class ARParSymStdEig definition.
+   This class solves real symmetric standard eigenvalue problems
+   distributed among the processes of a MPI communicator, using the
+   PARPACK subroutines pssaupd/pdsaupd and psseupd/pdseupd through
+   the reverse communication interface of ARrcSymStdEig.
+
+   Each process stores a contiguous range of rows of all vectors.
+   GetVector and PutVector point to the local rows of x and y, and
+   the user is required to compute the local rows of y = OP*x (see
+   ARParMatrix in arpmat.h). The eigenvectors returned are also the
+   local rows of the eigenvectors of the whole problem.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARPSSYM_H
+#define ARPSSYM_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "arerror.h"
+#include "arrssym.h"
+#include "arpeig.h"
+#include "parpackc.h"
+
+
+template<class ARFLOAT>
+class ARParSymStdEig:
+  public virtual ARrcSymStdEig<ARFLOAT>,
+  public virtual ARParStdEig<ARFLOAT, ARFLOAT> {
+
+ protected:
+
+ // a) Protected functions:
+
+  void Aupp();
+  // Interface to PARPACK subroutines PSSAUPD and PDSAUPD.
+
+  void Eupp();
+  // Interface to PARPACK subroutines PSSEUPD and PDSEUPD.
+
+
+ public:
+
+ // b) Public functions:
+
+ // b.1) Functions that select the eigensolver.
+
+  void SetNativeBackend(bool nativep = true, int nthreadsp = 1);
+  // The native thick-restart Lanczos method does not handle distributed
+  // vectors, so nativep must be false.
+
+
+ // b.2) Constructors and destructor.
+
+  ARParSymStdEig() { }
+  // Short constructor.
+
+  ARParSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+                 const std::string& whichp = "LM", int ncvp = 0,
+                 ARFLOAT tolp = 0.0, int maxitp = 0, ARFLOAT* residp = NULL,
+                 bool ishiftp = true);
+  // Long constructor (regular mode). This process stores rows firstp
+  // to lastp-1 of all vectors (and of residp, if given).
+
+  ARParSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+                 ARFLOAT sigmap, const std::string& whichp = "LM",
+                 int ncvp = 0, ARFLOAT tolp = 0.0, int maxitp = 0,
+                 ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARParSymStdEig(const ARParSymStdEig& other) { this->Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARParSymStdEig() { }
+  // Destructor.
+
+ // c) Operators.
+
+  ARParSymStdEig& operator=(const ARParSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARParSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARParSymStdEig member functions definition.                              //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT>
+inline void ARParSymStdEig<ARFLOAT>::Aupp()
+{
+
+  psaupp(this->comm, this->ido, this->bmat, this->n, this->which, this->nev, this->tol,
+         this->resid, this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd,
+         this->workl, this->lworkl, this->info);
+
+} // Aupp.
+
+
+template<class ARFLOAT>
+inline void ARParSymStdEig<ARFLOAT>::Eupp()
+{
+
+  pseupp(this->comm, this->rvec, this->HowMny, this->EigValR, this->EigVec, this->n,
+         this->sigmaR, this->bmat, this->n, this->which, this->nev, this->tol, this->resid,
+         this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd, this->workl,
+         this->lworkl, this->info);
+
+} // Eupp.
+
+
+template<class ARFLOAT>
+inline void ARParSymStdEig<ARFLOAT>::
+SetNativeBackend(bool nativep, int)
+{
+
+  if (nativep) {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED, "SetNativeBackend");
+  }
+
+} // SetNativeBackend.
+
+
+template<class ARFLOAT>
+inline ARParSymStdEig<ARFLOAT>::
+ARParSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+               const std::string& whichp, int ncvp, ARFLOAT tolp, int maxitp,
+               ARFLOAT* residp, bool ishiftp)
+{
+
+  this->DefineComm(commp, firstp, lastp);
+  this->NoShift();
+  this->DefineParameters((int)(lastp-firstp), nevp, whichp, ncvp, tolp, maxitp,
+                         residp, ishiftp);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT>
+inline ARParSymStdEig<ARFLOAT>::
+ARParSymStdEig(MPI_Comm commp, ARindex firstp, ARindex lastp, int nevp,
+               ARFLOAT sigmap, const std::string& whichp, int ncvp,
+               ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
+{
+
+  this->DefineComm(commp, firstp, lastp);
+  this->ChangeShift(sigmap);
+  this->DefineParameters((int)(lastp-firstp), nevp, whichp, ncvp, tolp, maxitp,
+                         residp, ishiftp);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT>
+ARParSymStdEig<ARFLOAT>& ARParSymStdEig<ARFLOAT>::
+operator=(const ARParSymStdEig<ARFLOAT>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    this->Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARPSSYM_H
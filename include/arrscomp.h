@@ -25,33 +25,50 @@
 #include "arrseig.h"
 #include "caupp.h"
 #include "ceupp.h"
+#include "arkschur.h"
 
 template<class ARFLOAT>
 class ARrcCompStdEig: virtual public ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> > {
 
  protected:
 
- // a) Protected functions:
+ // a) Protected variables:
 
- // a.1) Memory control functions.
+  bool native; // Indicates if the native Krylov-Schur method is used
+               // instead of ARPACK.
+
+  ARKrylovSchur<ARFLOAT, arcomplex<ARFLOAT> > schur;
+  // Native Krylov-Schur method.
+
+
+ // b) Protected functions:
+
+ // b.1) Memory control functions.
 
   void WorkspaceAllocate();
   // Allocates workspace for complex problems.
 
+  void CopyBackend(const ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >& other);
+  // Copies native and the state of the Krylov-Schur method.
 
- // a.2) Functions that handle original FORTRAN ARPACK code.
+
+ // b.2) Functions that handle original FORTRAN ARPACK code.
 
   void Aupp();
-  // Interface to FORTRAN subroutines CNAUPD and ZNAUPD.
+  // Interface to FORTRAN subroutines CNAUPD and ZNAUPD
+  // (or to ARKrylovSchur::Aupp if native is true or
+  // GetBlockSize() > 1).
 
   void Eupp();
-  // Interface to FORTRAN subroutines CNEUPD and ZNEUPD.
+  // Interface to FORTRAN subroutines CNEUPD and ZNEUPD
+  // (or to ARKrylovSchur::Eupp if native is true or
+  // GetBlockSize() > 1).
 
  public:
 
- // b) Public functions:
+ // c) Public functions:
 
- // b.1) Trace functions.
+ // c.1) Trace functions.
 
   void Trace(const int digit = -5, const int getv0 = 0, const int aupd = 1,
              const int aup2 = 0,  const int aitr = 0,  const int eigt = 0,
@@ -62,7 +79,7 @@ class ARrcCompStdEig: virtual public ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> > {
   // Turns on trace mode. 
 
 
- // b.2) Functions that perform all calculations in one step.
+ // c.2) Functions that perform all calculations in one step.
 
   int Eigenvalues(arcomplex<ARFLOAT>* &EigValp, bool ivec = false,
                   bool ischur = false);
@@ -76,7 +93,7 @@ class ARrcCompStdEig: virtual public ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> > {
   // Calculates Schur vectors if requested.
 
 
- // b.3) Functions that return elements of vectors and matrices.
+ // c.3) Functions that return elements of vectors and matrices.
 
   arcomplex<ARFLOAT> Eigenvalue(int i);
   // Provides i-eth eigenvalue.
@@ -85,7 +102,7 @@ class ARrcCompStdEig: virtual public ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> > {
   // Provides element j of the i-eth eigenvector.
 
 
- // b.4) Functions that use STL vector class.
+ // c.4) Functions that use STL vector class.
 
 #ifdef STL_VECTOR_H
 
@@ -100,9 +117,21 @@ class ARrcCompStdEig: virtual public ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> > {
 #endif // #ifdef STL_VECTOR_H.
 
 
- // b.5) Constructors and destructor.
+ // c.5) Functions that select the eigensolver.
+
+  void SetNativeBackend(bool nativep = true, int nthreadsp = 1);
+  // Uses the native C++ Krylov-Schur method (arkschur.h) instead of
+  // FORTRAN ARPACK if nativep is true. nthreadsp threads (all available
+  // cores if nthreadsp <= 0) are used to reorthogonalize the Arnoldi
+  // vectors. The Arnoldi process is restarted.
+
+  bool NativeBackend() const { return native; }
+  // Indicates if the native Krylov-Schur method is used.
+
 
-  ARrcCompStdEig() { }
+ // c.6) Constructors and destructor.
+
+  ARrcCompStdEig(): native(false) { }
   // Short constructor.
 
   ARrcCompStdEig(int np, int nevp, const std::string& whichp = "LM",
@@ -116,13 +145,13 @@ class ARrcCompStdEig: virtual public ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> > {
                  bool ishiftp = true);
   // Long constructor (shift and invert mode).
 
-  ARrcCompStdEig(const ARrcCompStdEig& other) { Copy(other); }
+  ARrcCompStdEig(const ARrcCompStdEig& other): native(false) { this->Copy(other); }
   // Copy constructor.
 
   virtual ~ARrcCompStdEig() { }
   // Destructor.
 
- // c) Operators.
+ // d) Operators.
 
   ARrcCompStdEig& operator=(const ARrcCompStdEig& other);
   // Assignment operator.
@@ -149,10 +178,31 @@ inline void ARrcCompStdEig<ARFLOAT>::WorkspaceAllocate()
 } // WorkspaceAllocate.
 
 
+template<class ARFLOAT>
+inline void ARrcCompStdEig<ARFLOAT>::
+CopyBackend(const ARrcStdEig<ARFLOAT, arcomplex<ARFLOAT> >& other)
+{
+
+  const ARrcCompStdEig* comp = dynamic_cast<const ARrcCompStdEig*>(&other);
+
+  if (comp != NULL) {
+    native = comp->native;
+    schur  = comp->schur;
+  }
+
+} // CopyBackend.
+
+
 template<class ARFLOAT>
 inline void ARrcCompStdEig<ARFLOAT>::Aupp()
 {
 
+  if (native || (this->nb > 1)) {
+    schur.Aupp(this->ido, this->bmat, this->n, this->which, this->nev, this->tol, this->resid,
+               this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd, this->info);
+    return;
+  }
+
   caupp(this->ido, this->bmat, this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V, this->n,
         this->iparam, this->ipntr, this->workd, this->workl, this->lworkl, this->rwork, this->info);
 
@@ -163,6 +213,13 @@ template<class ARFLOAT>
 inline void ARrcCompStdEig<ARFLOAT>::Eupp()
 {
 
+  if (native || (this->nb > 1)) {
+    schur.Eupp(this->rvec, this->HowMny, this->EigValR, this->EigVec, this->n, this->sigmaR,
+               this->bmat, this->n, this->which, this->nev, this->tol, this->resid, this->ncv,
+               this->V, this->n, this->iparam, this->ipntr, this->workd, this->info);
+    return;
+  }
+
   ceupp(this->rvec, this->HowMny, this->EigValR, this->EigVec, this->n, this->sigmaR, this->workv,
         this->bmat, this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V, this->n, this->iparam,
         this->ipntr, this->workd, this->workl, this->lworkl, this->rwork, this->info);
@@ -170,6 +227,18 @@ inline void ARrcCompStdEig<ARFLOAT>::Eupp()
 } // Eupp.
 
 
+template<class ARFLOAT>
+inline void ARrcCompStdEig<ARFLOAT>::
+SetNativeBackend(bool nativep, int nthreadsp)
+{
+
+  native = nativep;
+  schur.SetThreads(nthreadsp);
+  this->Restart();
+
+} // SetNativeBackend.
+
+
 template<class ARFLOAT>
 int ARrcCompStdEig<ARFLOAT>::
 Eigenvalues(arcomplex<ARFLOAT>* &EigValp, bool ivec, bool ischur)
@@ -229,7 +298,7 @@ EigenValVectors(arcomplex<ARFLOAT>* &EigVecp, arcomplex<ARFLOAT>* &EigValp,
       this->newVal = false;
     }  
     try {
-      if (EigVecp == NULL) EigVecp = new arcomplex<ARFLOAT>[this->ValSize()*this->n];
+      if (EigVecp == NULL) EigVecp = new arcomplex<ARFLOAT>[(size_t)this->ValSize()*this->n];
       if (EigValp == NULL) EigValp = new arcomplex<ARFLOAT>[this->ValSize()];
     }
     catch (ArpackError) { return 0; }
@@ -276,7 +345,7 @@ Eigenvector(int i, int j)
   else if ((i>=this->nconv)||(i<0)||(j>=this->n)||(j<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR, "Eigenvector(i,j)");
   }
-  return this->EigVec[i*this->n+j];
+  return this->EigVec[(size_t)i*this->n+j];
 
 } // Eigenvector(i,j).
 
@@ -320,7 +389,7 @@ StlEigenvector(int i)
     throw ArpackError(ArpackError::RANGE_ERROR, "StlEigenvector(i)");
   }
   try {
-    Vec = new vector<arcomplex<ARFLOAT> >(&EigVec[i*n], &EigVec[(i+1)*n]);
+    Vec = new vector<arcomplex<ARFLOAT> >(&EigVec[(size_t)i*n], &EigVec[(size_t)(i+1)*n]);
   }
   catch (ArpackError) { return NULL; }
   return Vec;
@@ -334,7 +403,7 @@ template<class ARFLOAT>
 inline ARrcCompStdEig<ARFLOAT>::
 ARrcCompStdEig(int np, int nevp, const std::string& whichp, int ncvp, ARFLOAT tolp,
                int maxitp, arcomplex<ARFLOAT>* residp, bool ishiftp)
-
+  : native(false)
 {
 
   this->NoShift();
@@ -348,7 +417,7 @@ inline ARrcCompStdEig<ARFLOAT>::
 ARrcCompStdEig(int np, int nevp, arcomplex<ARFLOAT> sigmap,
                const std::string& whichp, int ncvp, ARFLOAT tolp, int maxitp,
                arcomplex<ARFLOAT>* residp, bool ishiftp)
-
+  : native(false)
 {
 
   this->ChangeShift(sigmap);
@@ -364,7 +433,7 @@ operator=(const ARrcCompStdEig<ARFLOAT>& other)
 
   if (this != &other) { // Stroustrup suggestion.
     this->ClearMem();
-    Copy(other);
+    this->Copy(other);
   }
   return *this;
 
@@ -39,9 +39,10 @@ class ARrcStdEig {
 
  // a.1) User defined parameters.
 
-  int     n;          // Dimension of the eigenproblem.
-  int     nev;        // Number of eigenvalues to be computed. 0 < nev < n-1.
-  int     ncv;        // Number of Arnoldi vectors generated at each iteration.
+  ARint   n;          // Dimension of the eigenproblem.
+  ARint   nev;        // Number of eigenvalues to be computed. 0 < nev < n-1.
+  ARint   ncv;        // Number of Arnoldi vectors generated at each iteration.
+  ARint   nb;         // Number of vectors multiplied by OP at each step.
   int     maxit;      // Maximum number of Arnoldi update iterations allowed.
   std::string   which;      // Specify which of the Ritz values of OP to compute.
   ARFLOAT tol;        // Stopping criterion (relative accuracy of Ritz values).
@@ -55,6 +56,8 @@ class ARrcStdEig {
   bool    rvec;       // Indicates if eigenvectors/Schur vectors were
                       // requested (or only eigenvalues will be determined).
   bool    newRes;     // Indicates if a new "resid" vector was created.
+  bool    StartOK;    // Indicates if "resid" holds a starting vector set
+                      // by RestartFromEigenvectors that was not used yet.
   bool    newVal;     // Indicates if a new "EigValR" vector was created.
   bool    newVec;     // Indicates if a new "EigVec" vector was created.
   bool    PrepareOK;  // Indicates if internal variables were correctly set.
@@ -68,15 +71,15 @@ class ARrcStdEig {
                       // generalized ('G") eigenproblem.
   char    HowMny;     // Indicates if eigenvectors ('A') or Schur vectors ('P')
                       // were requested (not referenced if rvec = false).
-  int     ido;        // Original ARPACK reverse communication flag.
-  int     info;       // Original ARPACK error flag.
+  ARint   ido;        // Original ARPACK reverse communication flag.
+  ARint   info;       // Original ARPACK error flag.
   int     mode;       // Indicates the type of the eigenproblem (regular,
                       // shift and invert, etc).
-  int     lworkl;     // Dimension of array workl.
-  int     lworkv;     // Dimension of array workv.
-  int     lrwork;     // Dimension of array rwork.
-  int     iparam[12]; // Vector that handles original ARPACK parameters.
-  int     ipntr[15];  // Vector that handles original ARPACK pointers.
+  ARint   lworkl;     // Dimension of array workl.
+  ARint   lworkv;     // Dimension of array workv.
+  ARint   lrwork;     // Dimension of array rwork.
+  ARint   iparam[12]; // Vector that handles original ARPACK parameters.
+  ARint   ipntr[15];  // Vector that handles original ARPACK pointers.
   ARFLOAT *rwork;     // Original ARPACK internal vector.
   ARTYPE  *workl;     // Original ARPACK internal vector.
   ARTYPE  *workd;     // Original ARPACK internal vector.
@@ -86,7 +89,7 @@ class ARrcStdEig {
 
  // a.3) Pure output variables.
 
-  int     nconv;      // Number of "converged" Ritz values.
+  ARint   nconv;      // Number of "converged" Ritz values.
   ARFLOAT *EigValI;   // Imaginary part of eigenvalues (nonsymmetric problems).
   ARTYPE  *EigValR;   // Eigenvalues (real part only if problem is nonsymmetric).
   ARTYPE  *EigVec;    // Eigenvectors.
@@ -149,15 +152,17 @@ class ARrcStdEig {
 
  // b.3) Functions that check user defined parameters.
 
-  int CheckN(int np);
-  // Does range checking on ncv.
+  virtual int CheckN(int np);
+  // Does range checking on n.
+  // Redefined in ARParStdEig.
 
-  int CheckNcv(int ncvp);
+  virtual int CheckNcv(int ncvp);
   // Forces ncv to conform to its ranges.
+  // Redefined in ARParStdEig.
 
   virtual int CheckNev(int nevp);
   // Does range checking on nev.
-  // Redefined in ARrcNonSymStdEig.
+  // Redefined in ARrcNonSymStdEig and ARParStdEig.
 
   int CheckMaxit(int maxitp);
   // Forces maxit to be greater than zero.
@@ -179,6 +184,10 @@ class ARrcStdEig {
   // Old values are not deleted (this function is to be used
   // by the copy constructor and the assignment operator only).
 
+  virtual void CopyBackend(const ARrcStdEig&) { }
+  // Copies the state of the native eigensolver, if any (called by Copy).
+  // Redefined in ARrcSymStdEig.
+
  public:
 
  // c) Public functions:
@@ -233,6 +242,9 @@ class ARrcStdEig {
   int GetNcv() { return ncv; }
   // Returns the number of Arnoldi vectors generated at each iteration..
 
+  int GetBlockSize() { return nb; }
+  // Returns the number of vectors multiplied by OP at each step.
+
   const std::string& GetWhich() { return which; }
   // Returns "which".
 
@@ -260,6 +272,16 @@ class ARrcStdEig {
   virtual void ChangeNcv(int ncvp);
   // Changes the number of Arnoldi vectors generated at each iteration..
 
+  void ChangeBlockSize(int nbp);
+  // Changes the number of vectors multiplied by OP at each step. With
+  // nbp > 1 a block Krylov method is used, which finds eigenvalues of
+  // multiplicity up to nbp at once and lets OP be applied to a block of
+  // vectors (see GetIdo). FORTRAN ARPACK only works with nbp = 1, so
+  // the native eigensolver (see SetNativeBackend) is always used in
+  // block mode, which is only available for standard problems. ncv is
+  // increased, if needed, to leave room for nev Ritz vectors and two
+  // blocks.
+
   virtual void ChangeWhich(const std::string& whichp);
   // Changes "which".
 
@@ -274,6 +296,16 @@ class ARrcStdEig {
   void InvertAutoShift();
   // Inverts "AutoShift".
 
+  void RestartFromEigenvectors();
+  // Restarts the problem using the sum of the eigenvectors (or Schur
+  // vectors) found by the last call to FindEigenvectors (or
+  // FindSchurVectors) as the starting vector. This is useful when the
+  // matrix was changed only a little (see UpdateValues in the sparse
+  // matrix classes), since the new eigenvectors are close to the old
+  // ones and far fewer iterations are needed than from a random vector.
+  // The vector is kept if the shift, tolerance or maxit are changed
+  // before the next run, but ChangeNev and ChangeNcv discard it.
+
   virtual void SetRegularMode() { NoShift(); }
   // Turns problem to regular mode.
 
@@ -308,6 +340,8 @@ class ARrcStdEig {
   //           vector x, and PutVector() indicates where to store y.
   //           When solving generalized problems, a pointer to the product
   //           B*x is also available by using GetProd().
+  //           In block mode (GetBlockSize() = nb > 1), x and y are blocks
+  //           of nb vectors, stored one after the other (n x nb arrays).
   // ido =  2: compute y = B*x, where GetVector() gives a pointer to the
   //           vector x, and PutVector() indicates where to store y.
   // ido =  3: compute shifts, where PutVector() indicates where to store them.
@@ -455,7 +489,7 @@ template<class ARFLOAT, class ARTYPE>
 inline void ARrcStdEig<ARFLOAT, ARTYPE>::ClearFirst()
 {
 
-  PrepareOK = newVal = newVec = newRes = false;
+  PrepareOK = newVal = newVec = newRes = StartOK = false;
 
 } // ClearFirst.
 
@@ -492,6 +526,7 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::ClearMem()
   if (newRes) {
     delete[] resid;
     newRes = false;
+    StartOK = false;
     resid = NULL;   // Salwen. Mar 3, 2000.
   }
 
@@ -533,7 +568,7 @@ inline void ARrcStdEig<ARFLOAT, ARTYPE>::VecAllocate(bool newV)
 
   if (EigVec == NULL) {
     if (newV) {                       // Creating a new array EigVec.
-      EigVec = new ARTYPE[ValSize()*n];
+      EigVec = new ARTYPE[(size_t)ValSize()*n];
       newVec = true;
     }
     else {                            // Using V to store EigVec.
@@ -685,8 +720,9 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::Restart()
   ido  =0;                  // First call to AUPP.
   iparam[1]=(int)AutoShift; // Shift strategy used.
   iparam[3]=maxit;          // Maximum number of Arnoldi iterations allowed.
-  iparam[4]=1;              // Blocksize must be 1.
-  info =(int)(!newRes);     // Starting vector used.
+  iparam[4]=nb;             // Blocksize (only the native eigensolvers
+                            // accept nb > 1).
+  info =(int)(!newRes || StartOK); // Starting vector used.
   ClearBasis();
 
 } // Restart.
@@ -711,8 +747,8 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::Prepare()
 
     // Setting dimensions of working arrays.
 
-    workd    = new ARTYPE[3*n+1];
-    V        = new ARTYPE[n*ncv+1];
+    workd    = new ARTYPE[(size_t)3*nb*n+1];
+    V        = new ARTYPE[(size_t)n*ncv+1];
     WorkspaceAllocate();
 
   }
@@ -743,6 +779,7 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   n         = other.n;
   nev       = other.nev;
   ncv       = other.ncv;
+  nb        = other.nb;
   maxit     = other.maxit;
   which     = other.which;
   tol       = other.tol;
@@ -750,6 +787,7 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   sigmaR    = other.sigmaR;
   rvec      = other.rvec;
   newRes    = other.newRes;
+  StartOK   = other.StartOK;
   newVal    = other.newVal;
   newVec    = other.newVec;
   PrepareOK = other.PrepareOK;
@@ -776,11 +814,11 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
 
   // Copying dynamic variables.
 
-  workd     = new ARTYPE[3*n+1];       // workd.
-  copy(3*n+1,other.workd,1,workd,1);
+  workd     = new ARTYPE[(size_t)3*nb*n+1];  // workd.
+  copy((size_t)3*nb*n+1,other.workd,1,workd,1);
 
-  V         = new ARTYPE[n*ncv+1];     // V.
-  copy(n*ncv+1,other.V,1,V,1);
+  V         = new ARTYPE[(size_t)n*ncv+1];     // V.
+  copy((size_t)n*ncv+1,other.V,1,V,1);
 
   if (newRes) {                        // resid.
     resid   = new ARTYPE[n];
@@ -791,8 +829,8 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   }
 
   if (newVec) {                        // EigVec.
-    EigVec  = new ARTYPE[ValSize()*n];
-    copy(ValSize()*n,other.EigVec,1,EigVec,1);
+    EigVec  = new ARTYPE[(size_t)ValSize()*n];
+    copy((size_t)ValSize()*n,other.EigVec,1,EigVec,1);
   }
   else if (other.EigVec == (&other.V[1])) {
     EigVec  = &V[1];
@@ -822,6 +860,8 @@ void ARrcStdEig<ARFLOAT,ARTYPE>::Copy(const ARrcStdEig<ARFLOAT,ARTYPE>& other)
   if (lworkv) copy(lworkv+1,other.workv,1,workv,1);
   if (lrwork) copy(lrwork+1,other.rwork,1,rwork,1);
 
+  CopyBackend(other);                // Native eigensolver.
+
 } // Copy.
 
 
@@ -918,6 +958,28 @@ inline void ARrcStdEig<ARFLOAT, ARTYPE>::ChangeNcv(int ncvp)
 } // ChangeNcv.
 
 
+template<class ARFLOAT, class ARTYPE>
+void ARrcStdEig<ARFLOAT, ARTYPE>::ChangeBlockSize(int nbp)
+{
+
+  if ((nbp < 1) || (nbp > n) || ((nbp > 1) && (bmat == 'G'))) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "ChangeBlockSize");
+  }
+  nb = nbp;
+
+  // Room for nev (+1) Ritz vectors and two blocks, with a multiple of nb
+  // vectors.
+
+  if (nb > 1) {
+    int ncvmin = nb*((nev+nb)/nb+2);
+    if (ncv < ncvmin) ncv = (ncvmin > n) ? n : ncvmin;
+  }
+  if (PrepareOK) Prepare();
+  else Restart();
+
+} // ChangeBlockSize.
+
+
 template<class ARFLOAT, class ARTYPE>
 void ARrcStdEig<ARFLOAT, ARTYPE>::ChangeWhich(const std::string& whichp)
 {
@@ -965,6 +1027,53 @@ void ARrcStdEig<ARFLOAT, ARTYPE>::InvertAutoShift()
 } // InvertAutoShift.
 
 
+template<class ARFLOAT, class ARTYPE>
+void ARrcStdEig<ARFLOAT, ARTYPE>::RestartFromEigenvectors()
+{
+
+  ARTYPE* vec;
+
+  // Finding the vectors computed by the last run.
+
+  if (VectorsOK) {
+    vec = EigVec;
+  }
+  else if (SchurOK) {
+    vec = &V[1];
+  }
+  else {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK,
+                      "RestartFromEigenvectors");
+  }
+
+  if (nconv < 1) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK,
+                      "RestartFromEigenvectors");
+  }
+
+  // Adding them up in resid. A starting vector supplied by the user
+  // is not overwritten.
+
+  if (!newRes) {
+    resid  = new ARTYPE[n];
+    newRes = true;
+  }
+
+  copy(n, vec, 1, resid, 1);
+  for (int j = 1; j < nconv; j++) {
+    axpy(n, (ARTYPE)1, &vec[(size_t)j*n], 1, resid, 1);
+  }
+
+  // Restarting, with resid as the starting vector. StartOK keeps it
+  // through the calls to Restart made before the first step (by
+  // FindEigenvectors, ChangeShift, etc.).
+
+  StartOK = true;
+  Restart();
+
+} // RestartFromEigenvectors.
+
+
 template<class ARFLOAT, class ARTYPE>
 ARTYPE* ARrcStdEig<ARFLOAT, ARTYPE>::GetVector()
 {
@@ -1026,9 +1135,11 @@ int ARrcStdEig<ARFLOAT, ARTYPE>::TakeStep()
   }
   else if (!BasisOK) {
 
-    // Taking a step if the Arnoldi basis is not available.
+    // Taking a step if the Arnoldi basis is not available. The vector
+    // set by RestartFromEigenvectors is only used by the first step.
 
     Aupp();
+    StartOK = false;
 
     // Checking if convergence was obtained.
 
@@ -1162,10 +1273,10 @@ Eigenvectors(ARTYPE* &EigVecp, bool ischur)
     }
     else {                               // Copying eigenvectors.
       if (EigVecp == NULL) {
-        try { EigVecp = new ARTYPE[ValSize()*n]; }
+        try { EigVecp = new ARTYPE[(size_t)ValSize()*n]; }
         catch (ArpackError) { return 0; }
       }
-      copy(ValSize()*n,EigVec,1,EigVecp,1);
+      copy((size_t)ValSize()*n,EigVec,1,EigVecp,1);
     }
   }
   else {                                // Eigenvectors are not available.
@@ -1174,7 +1285,7 @@ Eigenvectors(ARTYPE* &EigVecp, bool ischur)
       newVec = false;
     }
     if (EigVecp == NULL) {
-      try { EigVecp = new ARTYPE[ValSize()*n]; }
+      try { EigVecp = new ARTYPE[(size_t)ValSize()*n]; }
       catch (ArpackError) { return 0; }
     }
     EigVec = EigVecp;
@@ -1198,7 +1309,7 @@ inline ARTYPE ARrcStdEig<ARFLOAT, ARTYPE>::ArnoldiBasisVector(int i, int j)
   else if ((i>=ncv)||(i<0)||(j>=n)||(j<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR,"ArnoldiBasisVector(i,j)");
   }
-  return V[i*n+j+1];
+  return V[(size_t)i*n+j+1];
 
 } // ArnoldiBasisVector(i,j).
 
@@ -1215,7 +1326,7 @@ inline ARTYPE ARrcStdEig<ARFLOAT, ARTYPE>::SchurVector(int i, int j)
   else if ((i>=nconv)||(i<0)||(j>=n)||(j<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR, "SchurVector(i,j)");
   }
-  return V[i*n+j+1];
+  return V[(size_t)i*n+j+1];
 
 } // SchurVector(i,j).
 
@@ -1263,7 +1374,7 @@ inline ARTYPE* ARrcStdEig<ARFLOAT, ARTYPE>::RawArnoldiBasisVector(int i)
   else if ((i>=ncv)||(i<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR,"RawArnoldiBasisVector(i)");
   }
-  return &V[i*n+1];
+  return &V[(size_t)i*n+1];
 
 } // RawArnoldiBasisVector(i).
 
@@ -1304,7 +1415,7 @@ inline ARTYPE* ARrcStdEig<ARFLOAT, ARTYPE>::RawEigenvector(int i)
   else if ((i>=ValSize())||(i<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR, "RawEigenvector(i)");
   }
-  return &EigVec[i*n];
+  return &EigVec[(size_t)i*n];
 
 } // RawEigenvector(i).
 
@@ -1333,7 +1444,7 @@ inline ARTYPE* ARrcStdEig<ARFLOAT, ARTYPE>::RawSchurVector(int i)
   else if ((i>=nev)||(i<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR, "RawSchurVector(i)");
   }
-  return &V[i*n+1];
+  return &V[(size_t)i*n+1];
 
 } // RawSchurVector(i).
 
@@ -1364,7 +1475,7 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlArnoldiBasisVectors()
     nconv = FindArnoldiBasis();
   }
   try {
-    StlBasis = new vector<ARTYPE>(&V[1], &V[n*ncv+1]);
+    StlBasis = new vector<ARTYPE>(&V[1], &V[(size_t)n*ncv+1]);
   }
   catch (ArpackError) { return NULL; }
   return StlBasis;
@@ -1387,7 +1498,7 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT,ARTYPE>::StlArnoldiBasisVector(int i)
     throw ArpackError(ArpackError::RANGE_ERROR,"StlArnoldiBasisVector(i)");
   }
   try {
-    StlBasis = new vector<ARTYPE>(&V[i*n+1], &V[(i+1)*n+1]);
+    StlBasis = new vector<ARTYPE>(&V[(size_t)i*n+1], &V[(size_t)(i+1)*n+1]);
   }
   catch (ArpackError) { return NULL; }
   return StlBasis;
@@ -1404,7 +1515,7 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT,ARTYPE>::StlEigenvectors(bool ischur)
   vector<ARTYPE>* StlEigVec;
   ARTYPE*         VecPtr;
 
-  try { StlEigVec = new vector<ARTYPE>(ValSize()*n); }
+  try { StlEigVec = new vector<ARTYPE>((size_t)ValSize()*n); }
   catch (ArpackError) { return NULL; }
   VecPtr = StlEigVec->begin();
   nconv  = Eigenvectors(VecPtr, ischur);
@@ -1423,7 +1534,7 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlSchurVectors()
     nconv = FindSchurVectors();
   } 
   try {
-    StlSchurVec = new vector<ARTYPE>(&V[1], &V[nev*n+1]);
+    StlSchurVec = new vector<ARTYPE>(&V[1], &V[(size_t)nev*n+1]);
   }
   catch (ArpackError) { return NULL; }
   return StlSchurVec;
@@ -1446,7 +1557,7 @@ inline vector<ARTYPE>* ARrcStdEig<ARFLOAT, ARTYPE>::StlSchurVector(int i)
     throw ArpackError(ArpackError::RANGE_ERROR, "StlSchurVector(i)");
   }
   try {
-    StlSchurVec = new vector<ARTYPE>(&V[i*n+1], &V[(i+1)*n+1]);
+    StlSchurVec = new vector<ARTYPE>(&V[(size_t)i*n+1], &V[(size_t)(i+1)*n+1]);
   }
   catch (ArpackError) { return NULL; }
   return StlSchurVec;
@@ -1490,6 +1601,7 @@ inline ARrcStdEig<ARFLOAT, ARTYPE>::ARrcStdEig()
   EigValI = NULL;
   EigVec  = NULL;
   bmat    = 'I';   // This is a standard problem.
+  nb      = 1;     // One vector at a time.
   ClearFirst();
   NoShift();
   NoTrace();
@@ -25,6 +25,7 @@
 #include "arrseig.h"
 #include "naupp.h"
 #include "neupp.h"
+#include "arkschur.h"
 
 
 template<class ARFLOAT>
@@ -32,9 +33,17 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
 
  protected:
 
- // a) Protected functions:
+ // a) Protected variables:
 
- // a.1) Memory control functions.
+  bool                            native; // Indicates if the native
+                                          // Krylov-Schur method is used
+                                          // instead of ARPACK.
+  ARKrylovSchur<ARFLOAT, ARFLOAT> schur;  // Native Krylov-Schur method.
+
+
+ // b) Protected functions:
+
+ // b.1) Memory control functions.
 
   int ValSize() { return this->nev+1; }
   // Provides the size of array EigVal.
@@ -45,23 +54,30 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   void WorkspaceAllocate();
   // Allocates workspace for nonsymmetric problems.
 
+  void CopyBackend(const ARrcStdEig<ARFLOAT, ARFLOAT>& other);
+  // Copies native and the state of the Krylov-Schur method.
+
 
- // a.2) Functions that handle original FORTRAN ARPACK code.
+ // b.2) Functions that handle original FORTRAN ARPACK code.
 
   void Aupp();
-  // Interface to FORTRAN subroutines SNAUPD and DNAUPD.
+  // Interface to FORTRAN subroutines SNAUPD and DNAUPD
+  // (or to ARKrylovSchur::Aupp if native is true or
+  // GetBlockSize() > 1).
 
   void Eupp();
-  // Interface to FORTRAN subroutines SNEUPD and DNEUPD.
+  // Interface to FORTRAN subroutines SNEUPD and DNEUPD
+  // (or to ARKrylovSchur::Eupp if native is true or
+  // GetBlockSize() > 1).
 
 
- // a.3) Functions that check user defined parameters.
+ // b.3) Functions that check user defined parameters.
 
   int CheckNev(int nevp);
   // Does Range checking on nev.
 
 
- // a.4) Auxiliary functions required when using STL vector class.
+ // b.4) Auxiliary functions required when using STL vector class.
 
   bool ConjEigVec(int i);
   // Indicates if EigVec[i] is the second eigenvector in 
@@ -92,9 +108,9 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
 
  public:
 
- // b) Public functions:
+ // c) Public functions:
 
- // b.1) Trace functions.
+ // c.1) Trace functions.
 
   void Trace(const int digit = -5, const int getv0 = 0, const int aupd = 1,
              const int aup2 = 0,  const int aitr = 0,  const int eigt = 0,
@@ -105,14 +121,14 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // Turns on trace mode. 
 
 
- // b.2) Functions that permit step by step execution of ARPACK.
+ // c.2) Functions that permit step by step execution of ARPACK.
 
   ARFLOAT* GetVectorImag();
   // When ido = 3, this function indicates where the imaginary part
   // of the eigenvalues of the current Hessenberg matrix are located.
 
 
- // b.3) Functions that perform all calculations in one step.
+ // c.3) Functions that perform all calculations in one step.
 
   int Eigenvalues(ARFLOAT* &EigValRp, ARFLOAT* &EigValIp,
                   bool ivec = false, bool ischur = false);
@@ -127,7 +143,7 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // EigValIp. Calculates Schur vectors if requested.
 
 
- // b.4) Functions that return elements of vectors and matrices.
+ // c.4) Functions that return elements of vectors and matrices.
 
 #ifdef ARCOMP_H
   arcomplex<ARFLOAT> Eigenvalue(int i);
@@ -152,13 +168,13 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // Provides the imaginary part of element j of the i-eth eigenvector.
 
 
- // b.5) Functions that provide raw access to internal vectors and matrices.
+ // c.5) Functions that provide raw access to internal vectors and matrices.
 
   ARFLOAT* RawEigenvaluesImag();
   // Provides raw access to the imaginary part of eigenvalues.
 
 
- // b.6) Functions that use STL vector class.
+ // c.6) Functions that use STL vector class.
 
 #ifdef STL_VECTOR_H
 
@@ -189,9 +205,21 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
 #endif // STL_VECTOR_H.
 
 
- // b.7) Constructors and destructor.
+ // c.7) Functions that select the eigensolver.
+
+  void SetNativeBackend(bool nativep = true, int nthreadsp = 1);
+  // Uses the native C++ Krylov-Schur method (arkschur.h) instead of
+  // FORTRAN ARPACK if nativep is true. nthreadsp threads (all available
+  // cores if nthreadsp <= 0) are used to reorthogonalize the Arnoldi
+  // vectors. The Arnoldi process is restarted.
+
+  bool NativeBackend() const { return native; }
+  // Indicates if the native Krylov-Schur method is used.
+
 
-  ARrcNonSymStdEig() { }
+ // c.8) Constructors and destructor.
+
+  ARrcNonSymStdEig(): native(false) { }
   // Short constructor.
 
   ARrcNonSymStdEig(int np, int nevp, const std::string& whichp = "LM", int ncvp = 0,
@@ -204,13 +232,13 @@ class ARrcNonSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
                    ARFLOAT* residp = NULL, bool ishiftp = true);
   // Long constructor (shift and invert mode).
 
-  ARrcNonSymStdEig(const ARrcNonSymStdEig& other) { Copy(other); }
+  ARrcNonSymStdEig(const ARrcNonSymStdEig& other): native(false) { this->Copy(other); }
   // Copy constructor.
 
   virtual ~ARrcNonSymStdEig() { }
   // Destructor.
 
- // c) Operators.
+ // d) Operators.
 
   ARrcNonSymStdEig& operator=(const ARrcNonSymStdEig& other);
   // Assignment operator.
@@ -249,10 +277,31 @@ inline void ARrcNonSymStdEig<ARFLOAT>::WorkspaceAllocate()
 } // WorkspaceAllocate.
 
 
+template<class ARFLOAT>
+inline void ARrcNonSymStdEig<ARFLOAT>::
+CopyBackend(const ARrcStdEig<ARFLOAT, ARFLOAT>& other)
+{
+
+  const ARrcNonSymStdEig* nsym = dynamic_cast<const ARrcNonSymStdEig*>(&other);
+
+  if (nsym != NULL) {
+    native = nsym->native;
+    schur  = nsym->schur;
+  }
+
+} // CopyBackend.
+
+
 template<class ARFLOAT>
 inline void ARrcNonSymStdEig<ARFLOAT>::Aupp()
 {
 
+  if (native || (this->nb > 1)) {
+    schur.Aupp(this->ido, this->bmat, this->n, this->which, this->nev, this->tol, this->resid,
+               this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd, this->info);
+    return;
+  }
+
   naupp(this->ido,this-> bmat, this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V, this->n,
         this->iparam, this->ipntr, this->workd, this->workl, this->lworkl, this->info);
 
@@ -263,6 +312,14 @@ template<class ARFLOAT>
 inline void ARrcNonSymStdEig<ARFLOAT>::Eupp()
 {
 
+  if (native || (this->nb > 1)) {
+    schur.Eupp(this->rvec, this->HowMny, this->EigValR, this->EigValI, this->EigVec, this->n,
+               this->sigmaR, this->sigmaI, this->bmat, this->n, this->which, this->nev, this->tol,
+               this->resid, this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd,
+               this->info);
+    return;
+  }
+
   neupp(this->rvec, this->HowMny, this->EigValR, this->EigValI, this->EigVec, this->n, this->sigmaR,
         this->sigmaI, this->workv, this->bmat, this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V,
         this->n, this->iparam, this->ipntr, this->workd, this->workl, this->lworkl, this->info);
@@ -270,6 +327,18 @@ inline void ARrcNonSymStdEig<ARFLOAT>::Eupp()
 } // Eupp.
 
 
+template<class ARFLOAT>
+inline void ARrcNonSymStdEig<ARFLOAT>::
+SetNativeBackend(bool nativep, int nthreadsp)
+{
+
+  native = nativep;
+  schur.SetThreads(nthreadsp);
+  this->Restart();
+
+} // SetNativeBackend.
+
+
 template<class ARFLOAT>
 inline int ARrcNonSymStdEig<ARFLOAT>::CheckNev(int nevp)
 {
@@ -476,7 +545,7 @@ EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValRp,
       this->newVal = false;
     }
     try {
-      if (EigVecp  == NULL) EigVecp  = new ARFLOAT[ValSize()*this->n];
+      if (EigVecp  == NULL) EigVecp  = new ARFLOAT[(size_t)ValSize()*this->n];
       if (EigValRp == NULL) EigValRp = new ARFLOAT[ValSize()];
       if (EigValIp == NULL) EigValIp = new ARFLOAT[ValSize()];
     }
@@ -562,14 +631,14 @@ Eigenvector(int i, int j)
     throw ArpackError(ArpackError::RANGE_ERROR, "Eigenvector(i,j)");
   }
   if (this->EigValI[i]==(ARFLOAT)0.0) {   // Real eigenvalue.
-    return arcomplex<ARFLOAT>(this->EigVec[i*this->n+j],(ARFLOAT)0.0);
+    return arcomplex<ARFLOAT>(this->EigVec[(size_t)i*this->n+j],(ARFLOAT)0.0);
   }
   else {                            // Complex eigenvalue.
     if (this->EigValI[i]>(ARFLOAT)0.0) {  // with positive imaginary part.
-      return arcomplex<ARFLOAT>(this->EigVec[i*this->n+j], this->EigVec[(i+1)*this->n+j]);
+      return arcomplex<ARFLOAT>(this->EigVec[(size_t)i*this->n+j], this->EigVec[(size_t)(i+1)*this->n+j]);
     }
     else {                          // with negative imaginary part.
-      return arcomplex<ARFLOAT>(this->EigVec[(i-1)*this->n+j], -this->EigVec[i*this->n+j]);
+      return arcomplex<ARFLOAT>(this->EigVec[(size_t)(i-1)*this->n+j], -this->EigVec[(size_t)i*this->n+j]);
     }
   }
 
@@ -589,7 +658,7 @@ inline ARFLOAT ARrcNonSymStdEig<ARFLOAT>::EigenvectorReal(int i, int j)
   else if ((i>=this->nconv)||(i<0)||(j>=this->n)||(j<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR, "EigenvectorReal(i,j)");
   }
-  return this->EigVec[i*this->n+j];
+  return this->EigVec[(size_t)i*this->n+j];
 
 } // EigenvectorReal(i,j).
 
@@ -611,10 +680,10 @@ inline ARFLOAT ARrcNonSymStdEig<ARFLOAT>::EigenvectorImag(int i, int j)
   }
   else {                            // Complex eigenvalue.
     if (this->EigValI[i]>(ARFLOAT)0.0) {  // with positive imaginary part.
-      return this->EigVec[(i+1)*this->n+j];
+      return this->EigVec[(size_t)(i+1)*this->n+j];
     }
     else {                          // with negative imaginary part.
-      return -this->EigVec[i*this->n+j];
+      return -this->EigVec[(size_t)i*this->n+j];
     }
   }
 
@@ -729,13 +798,13 @@ StlEigenvector(int i)
     throw ArpackError(ArpackError::RANGE_ERROR, "StlEigenvector(i)");
   }
   if (EigValI[i] == (ARFLOAT)0.0) { // Real eigenvector.
-    return GenComplex(n, &EigVec[i*n]);
+    return GenComplex(n, &EigVec[(size_t)i*n]);
   }
   else if (!ConjEigVec(i)) {      // First eigenvector in a conjugate pair.
-    return GenComplex(n, &EigVec[i*n], &EigVec[(i+1)*n]);
+    return GenComplex(n, &EigVec[(size_t)i*n], &EigVec[(size_t)(i+1)*n]);
   }
   else {                          // Second eigenvector in a conjugate pair.
-    return GenComplex(n, &EigVec[(i-1)*n], &EigVec[i*n], true);
+    return GenComplex(n, &EigVec[(size_t)(i-1)*n], &EigVec[(size_t)i*n], true);
   }
 
 } // StlEigenvector(i).
@@ -758,14 +827,14 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorReal(int i)
   }
   if (!ConjEigVec(i)) { // Real eigenvector or first in a conj. pair.
     try {
-      Vec = new vector<ARFLOAT>(&EigVec[i*n], &EigVec[(i+1)*n]);
+      Vec = new vector<ARFLOAT>(&EigVec[(size_t)i*n], &EigVec[(size_t)(i+1)*n]);
     }
     catch (ArpackError) { return NULL; }
     return Vec;
   }
   else {                // Second eigenvector in a conjugate pair.
     try {
-      Vec = new vector<ARFLOAT>(&EigVec[(i-1)*n], &EigVec[i*n]);
+      Vec = new vector<ARFLOAT>(&EigVec[(size_t)(i-1)*n], &EigVec[(size_t)i*n]);
     }
     catch (ArpackError) { return NULL; }
     return Vec;
@@ -797,14 +866,14 @@ inline vector<ARFLOAT>* ARrcNonSymStdEig<ARFLOAT>::StlEigenvectorImag(int i)
   }
   else if (!ConjEigVec(i)) {      // First eigenvector in a conjugate pair.
     try {
-      Vec = new vector<ARFLOAT>(&EigVec[(i+1)*n], &EigVec[(i+2)*n]);
+      Vec = new vector<ARFLOAT>(&EigVec[(size_t)(i+1)*n], &EigVec[(size_t)(i+2)*n]);
     }
     catch (ArpackError) { return NULL; }
     return Vec;
   }
   else {                          // Second eigenvector in a conjugate pair.
     try {
-      Vec = new vector<ARFLOAT>(&EigVec[i*n], &EigVec[(i+1)*n]);
+      Vec = new vector<ARFLOAT>(&EigVec[(size_t)i*n], &EigVec[(size_t)(i+1)*n]);
     }
     catch (ArpackError) { return NULL; }
     for (ARFLOAT* s = Vec->begin(); s != Vec->end(); s++) *s = -(*s);
@@ -820,7 +889,7 @@ template<class ARFLOAT>
 inline ARrcNonSymStdEig<ARFLOAT>::
 ARrcNonSymStdEig(int np, int nevp, const std::string& whichp, int ncvp,
                  ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
-
+  : native(false)
 {
 
   this->NoShift();
@@ -833,7 +902,7 @@ template<class ARFLOAT>
 inline ARrcNonSymStdEig<ARFLOAT>::
 ARrcNonSymStdEig(int np, int nevp, ARFLOAT sigmap, const std::string& whichp, int ncvp,
                  ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
-
+  : native(false)
 {
 
   this->ChangeShift(sigmap);
@@ -849,7 +918,7 @@ operator=(const ARrcNonSymStdEig<ARFLOAT>& other)
 
   if (this != &other) { // Stroustrup suggestion.
     this->ClearMem();
-    Copy(other);
+    this->Copy(other);
   }
   return *this;
 
@@ -25,6 +25,7 @@
 #include "arrseig.h"
 #include "saupp.h"
 #include "seupp.h"
+#include "artrlan.h"
 
 
 template<class ARFLOAT>
@@ -32,24 +33,38 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
 
  protected:
 
- // a) Protected functions:
+ // a) Protected variables:
 
- // a.1) Memory control functions.
+  bool                 native;  // Indicates if the native thick-restart
+                                // Lanczos method is used instead of ARPACK.
+  ARTRLanczos<ARFLOAT> lanczos; // Native thick-restart Lanczos method.
+
+
+ // b) Protected functions:
+
+ // b.1) Memory control functions.
 
   void WorkspaceAllocate();
   // Allocates workspace for symmetric problems.
 
+  void CopyBackend(const ARrcStdEig<ARFLOAT, ARFLOAT>& other);
+  // Copies native and the state of the Lanczos method.
+
 
- // a.2) Functions that handle original FORTRAN ARPACK code.
+ // b.2) Functions that handle original FORTRAN ARPACK code.
 
   void Aupp();
-  // Interface to FORTRAN subroutines SSAUPD and DSAUPD.
+  // Interface to FORTRAN subroutines SSAUPD and DSAUPD
+  // (or to ARTRLanczos::Aupp if native is true or
+  // GetBlockSize() > 1).
 
   void Eupp();
-  // Interface to FORTRAN subroutines SSEUPD and DSEUPD.
+  // Interface to FORTRAN subroutines SSEUPD and DSEUPD
+  // (or to ARTRLanczos::Eupp if native is true or
+  // GetBlockSize() > 1).
 
 
- // a.3) Functions that check user defined parameters.
+ // b.3) Functions that check user defined parameters.
 
   std::string CheckWhich(const std::string& whichp);
   // Determines if the value of variable "which" is valid.
@@ -57,9 +72,9 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
 
  public:
 
- // b) Public functions:
+ // c) Public functions:
 
- // b.1) Trace functions.
+ // c.1) Trace functions.
 
   void Trace(const int digit = -5, const int getv0 = 0, const int aupd = 1,
              const int aup2 = 0,  const int aitr = 0,  const int eigt = 0,
@@ -70,7 +85,7 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // Turns on trace mode. 
 
 
- // b.2) Functions that permit step by step execution of ARPACK.
+ // c.2) Functions that permit step by step execution of ARPACK.
 
   ARFLOAT* PutVector();
   // When ido = -1, 1 or 2 and the user must perform a product in the form
@@ -78,7 +93,7 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // function indicates where to store the shifts.
 
 
- // b.3) Functions that perform all calculations in one step.
+ // c.3) Functions that perform all calculations in one step.
 
   int FindSchurVectors() {
     throw ArpackError(ArpackError::SCHUR_UNDEFINED, "FindSchurVectors");
@@ -97,7 +112,7 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // Calculates Schur vectors if requested.
 
 
- // b.4) Functions that return elements of vectors and matrices.
+ // c.4) Functions that return elements of vectors and matrices.
 
   ARFLOAT Eigenvalue(int i);
   // Provides i-eth eigenvalue.
@@ -106,7 +121,7 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
   // Provides element j of the i-eth eigenvector.
 
 
- // b.5) Functions that use STL vector class.
+ // c.5) Functions that use STL vector class.
 
 #ifdef STL_VECTOR_H
 
@@ -120,9 +135,21 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
 #endif // #ifdef STL_VECTOR_H.
 
 
- // b.6) Constructors and destructor.
+ // c.6) Functions that select the eigensolver.
+
+  void SetNativeBackend(bool nativep = true, int nthreadsp = 1);
+  // Uses the native C++ thick-restart Lanczos method (artrlan.h)
+  // instead of FORTRAN ARPACK if nativep is true. nthreadsp threads
+  // (all available cores if nthreadsp <= 0) are used to reorthogonalize
+  // the Lanczos vectors. The Lanczos process is restarted.
+
+  bool NativeBackend() const { return native; }
+  // Indicates if the native thick-restart Lanczos method is used.
+
 
-  ARrcSymStdEig() { }
+ // c.7) Constructors and destructor.
+
+  ARrcSymStdEig(): native(false) { }
   // Short constructor.
 
   ARrcSymStdEig(int np, int nevp, const std::string& whichp = "LM", int ncvp = 0,
@@ -135,13 +162,13 @@ class ARrcSymStdEig: public virtual ARrcStdEig<ARFLOAT, ARFLOAT> {
                 ARFLOAT* residp = NULL, bool ishiftp = true);
   // Long constructor (shift and invert mode).
 
-  ARrcSymStdEig(const ARrcSymStdEig& other) { Copy(other); }
+  ARrcSymStdEig(const ARrcSymStdEig& other): native(false) { this->Copy(other); }
   // Copy constructor.
 
   virtual ~ARrcSymStdEig() { }
   // Destructor.
 
- // c) Operators.
+ // d) Operators.
 
   ARrcSymStdEig& operator=(const ARrcSymStdEig& other);
   // Assignment operator.
@@ -166,10 +193,31 @@ inline void ARrcSymStdEig<ARFLOAT>::WorkspaceAllocate()
 } // WorkspaceAllocate.
 
 
+template<class ARFLOAT>
+inline void ARrcSymStdEig<ARFLOAT>::
+CopyBackend(const ARrcStdEig<ARFLOAT, ARFLOAT>& other)
+{
+
+  const ARrcSymStdEig* sym = dynamic_cast<const ARrcSymStdEig*>(&other);
+
+  if (sym != NULL) {
+    native  = sym->native;
+    lanczos = sym->lanczos;
+  }
+
+} // CopyBackend.
+
+
 template<class ARFLOAT>
 inline void ARrcSymStdEig<ARFLOAT>::Aupp()
 {
 
+  if (native || (this->nb > 1)) {
+    lanczos.Aupp(this->ido, this->bmat, this->n, this->which, this->nev, this->tol, this->resid,
+                 this->ncv, this->V, this->n, this->iparam, this->ipntr, this->workd, this->info);
+    return;
+  }
+
   saupp(this->ido, this->bmat, this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V, this->n,
         this->iparam, this->ipntr, this->workd, this->workl, this->lworkl, this->info);
 
@@ -180,6 +228,13 @@ template<class ARFLOAT>
 inline void ARrcSymStdEig<ARFLOAT>::Eupp()
 {
 
+  if (native || (this->nb > 1)) {
+    lanczos.Eupp(this->rvec, this->HowMny, this->EigValR, this->EigVec, this->n, this->sigmaR, this->bmat,
+                 this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V, this->n,
+                 this->iparam, this->ipntr, this->workd, this->info);
+    return;
+  }
+
   seupp(this->rvec, this->HowMny, this->EigValR, this->EigVec, this->n, this->sigmaR, this->bmat,
         this->n, this->which, this->nev, this->tol, this->resid, this->ncv, this->V, this->n, this->iparam,
         this->ipntr, this->workd, this->workl, this->lworkl, this->info);
@@ -187,6 +242,18 @@ inline void ARrcSymStdEig<ARFLOAT>::Eupp()
 } // Eupp.
 
 
+template<class ARFLOAT>
+inline void ARrcSymStdEig<ARFLOAT>::
+SetNativeBackend(bool nativep, int nthreadsp)
+{
+
+  native = nativep;
+  lanczos.SetThreads(nthreadsp);
+  this->Restart();
+
+} // SetNativeBackend.
+
+
 template<class ARFLOAT>
 std::string ARrcSymStdEig<ARFLOAT>::CheckWhich(const std::string& whichp)
 {
@@ -276,7 +343,7 @@ EigenValVectors(ARFLOAT* &EigVecp, ARFLOAT* &EigValp, bool ischur)
   }
   else {                           // Eigenvalues and vectors are not available.
     try {
-      if (EigVecp == NULL) EigVecp = new ARFLOAT[this->ValSize()*this->n];
+      if (EigVecp == NULL) EigVecp = new ARFLOAT[(size_t)this->ValSize()*this->n];
       if (EigValp == NULL) EigValp = new ARFLOAT[this->ValSize()];
     }
     catch (ArpackError) { return 0; }
@@ -328,7 +395,7 @@ inline ARFLOAT ARrcSymStdEig<ARFLOAT>::Eigenvector(int i, int j)
   else if ((i>=this->nconv)||(i<0)||(j>=this->n)||(j<0)) {
     throw ArpackError(ArpackError::RANGE_ERROR, "Eigenvector(i,j)");
   }
-  return this->EigVec[i*this->n+j];
+  return this->EigVec[(size_t)i*this->n+j];
 
 } // Eigenvector(i,j).
 
@@ -369,7 +436,7 @@ inline vector<ARFLOAT>* ARrcSymStdEig<ARFLOAT>::StlEigenvector(int i)
     throw ArpackError(ArpackError::RANGE_ERROR, "StlEigenvector(i)");
   }
   try {
-    Vec = new vector<ARFLOAT>(&EigVec[i*n], &EigVec[(i+1)*n]);
+    Vec = new vector<ARFLOAT>(&EigVec[(size_t)i*n], &EigVec[(size_t)(i+1)*n]);
   }
   catch (ArpackError) { return NULL; }
   return Vec;
@@ -383,7 +450,7 @@ template<class ARFLOAT>
 inline ARrcSymStdEig<ARFLOAT>::
 ARrcSymStdEig(int np, int nevp, const std::string& whichp, int ncvp,
               ARFLOAT tolp, int maxitp, ARFLOAT* residp, bool ishiftp)
-
+  : native(false)
 {
 
   this->NoShift();
@@ -397,7 +464,7 @@ inline ARrcSymStdEig<ARFLOAT>::
 ARrcSymStdEig(int np, int nevp, ARFLOAT sigmap, const std::string& whichp,
               int ncvp, ARFLOAT tolp, int maxitp, ARFLOAT* residp,
               bool ishiftp)
-
+  : native(false)
 {
 
   this->ChangeShift(sigmap);
@@ -413,7 +480,7 @@ operator=(const ARrcSymStdEig<ARFLOAT>& other)
 
   if (this != &other) { // Stroustrup suggestion.
     this->ClearMem();
-    Copy(other);
+    this->Copy(other);
   }
   return *this;
 
@@ -34,6 +34,7 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
  // a) Notation.
 
   typedef void (ARFOP::* TypeOPx)(ARTYPE[], ARTYPE[]);
+  typedef void (ARFOP::* TypeOPm)(int, const ARTYPE*, int, ARTYPE*, int);
 
 
  protected:
@@ -42,6 +43,8 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
 
   ARFOP   *objOP;     // Object that has MultOPx as a member function.
   TypeOPx MultOPx;    // Function that evaluates the product OP*x.
+  TypeOPm MultOPm;    // Function that evaluates OP*X for a block of
+                      // vectors (block mode only, may be NULL).
 
  // c) Protected functions.
 
@@ -68,6 +71,14 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
 
   void ChangeMultOPx(ARFOP* objOPp, TypeOPx MultOPxp);
   // Changes the matrix-vector function that performs OP*x.
+  // Also clears the function defined by ChangeMultOPm.
+
+  void ChangeMultOPm(TypeOPm MultOPmp);
+  // Defines the function that performs OP*X for a block of k vectors,
+  // (objOP->*MultOPmp)(k, X, ldx, Y, ldy), as the MultMm and MultInvMm
+  // functions of the matrix classes do. It is used in block mode (see
+  // ChangeBlockSize). If it is not defined, MultOPx is called once for
+  // each vector of the block.
 
   virtual void SetRegularMode(ARFOP* objOPp, TypeOPx MultOPxp);
   // Turns problem to regular mode.
@@ -93,10 +104,10 @@ class ARStdEig: virtual public ARrcStdEig<ARFLOAT, ARTYPE> {
 
  // d.5) Constructor and destructor.
 
-  ARStdEig() { }
+  ARStdEig(): MultOPm(NULL) { }
   // Constructor that does nothing but calling base class constructor.
 
-  ARStdEig(const ARStdEig& other) { Copy(other); }
+  ARStdEig(const ARStdEig& other): MultOPm(NULL) { Copy(other); }
   // Copy constructor.
 
   virtual ~ARStdEig() { }
@@ -123,6 +134,7 @@ Copy(const ARStdEig<ARFLOAT, ARTYPE, ARFOP>& other)
   ARrcStdEig<ARFLOAT, ARTYPE>::Copy(other);
   objOP   = other.objOP;
   MultOPx = other.MultOPx;
+  MultOPm = other.MultOPm;
 
 } // Copy.
 
@@ -141,6 +153,7 @@ DefineParameters(int np, int nevp, ARFOP* objOPp,
                                                 maxitp, residp, ishiftp);
   objOP     = objOPp;
   MultOPx   = MultOPxp;
+  MultOPm   = NULL;
 
 } // DefineParameters.
 
@@ -152,11 +165,21 @@ ChangeMultOPx(ARFOP* objOPp, void (ARFOP::* MultOPxp)(ARTYPE[], ARTYPE[]))
 
   objOP   = objOPp;
   MultOPx = MultOPxp;
+  MultOPm = NULL;
   this->Restart();
 
 } // ChangeMultOPx.
 
 
+template<class ARFLOAT, class ARTYPE, class ARFOP>
+inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::ChangeMultOPm(TypeOPm MultOPmp)
+{
+
+  MultOPm = MultOPmp;
+
+} // ChangeMultOPm.
+
+
 template<class ARFLOAT, class ARTYPE, class ARFOP>
 inline void ARStdEig<ARFLOAT, ARTYPE, ARFOP>::
 SetRegularMode(ARFOP* objOPp, void (ARFOP::* MultOPxp)(ARTYPE[], ARTYPE[]))
@@ -207,9 +230,23 @@ int ARStdEig<ARFLOAT, ARTYPE, ARFOP>::FindArnoldiBasis()
 
     if ((this->ido == -1) || (this->ido == 1)) {
 
-      // Performing Matrix vector multiplication: y <- OP*x.
-
-      (objOP->*MultOPx)(&this->workd[this->ipntr[1]],&this->workd[this->ipntr[2]]);
+      // Performing Matrix vector multiplication: y <- OP*x (a block of
+      // nb vectors in block mode).
+
+      ARTYPE* x = &this->workd[this->ipntr[1]];
+      ARTYPE* y = &this->workd[this->ipntr[2]];
+
+      if (this->nb == 1) {
+        (objOP->*MultOPx)(x, y);
+      }
+      else if (MultOPm != NULL) {
+        (objOP->*MultOPm)(this->nb, x, this->n, y, this->n);
+      }
+      else {
+        for (int k=0; k<this->nb; k++) {
+          (objOP->*MultOPx)(&x[(size_t)k*this->n], &y[(size_t)k*this->n]);
+        }
+      }
 
     }
 
@@ -2,30 +2,116 @@
 #ifndef ARSPMAT_H
 #define ARSPMAT_H
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <cstring>
+#include <numeric>
 #include <string>
+#include <vector>
 #include "arch.h"
 #include "armat.h"
 #include "arerror.h"
+#include "arthread.h"
+
+/**
+ * @brief Type used to hold the values of a sparse matrix in reduced
+ *        precision (see ARSparseMatrix::CompressMultMv).
+ */
+template<typename ARTYPE> struct ARReducedType { typedef ARTYPE type; };
+template<> struct ARReducedType<double> { typedef float type; };
+template<> struct ARReducedType<arcomplex<double>> { typedef arcomplex<float> type; };
 
 /**
  * @brief A sparse matrix represented in compressed column storage.
+ *
+ * MultMv may also use a CSR or SELL-C-sigma copy of the matrix. The
+ * format is chosen by OptimizeMultMv, which benchmarks the kernels on
+ * the matrix itself. Since that costs a few products and the memory of
+ * a copy, it is only done at definition time if requested (see the fmt
+ * argument of the constructor that takes the CSC arrays).
  */
 template<typename ARTYPE>
 class ARSparseMatrix : public ARMatrix<ARTYPE> {
 
+public:
+
+    /**
+     * @brief Storage formats that can be used by MultMv.
+     */
+    enum StorageFormat {
+        CSC  = 0,  // compressed column storage (always available)
+        CSR  = 1,  // compressed row storage copy
+        SELL = 2,  // sliced ELLPACK copy (SELL-C-sigma)
+        CSRF = 3,  // CSR copy with values in reduced precision
+        CSRF16 = 4, // CSRF with 16 bit column increments
+        AUTO = -1  // benchmark CSC, CSR and SELL and keep the fastest
+    };
+
+    /**
+     * @brief Slice height C of the SELL-C-sigma format.
+     */
+    static constexpr int SellC = 8;
+
 protected:
 
-    int*    Ap;    // column pointers
-    int*    Ai;    // row indices
-    ARTYPE* Ax;    // values
-    int*    Di;    // diagonal indices (allocated as needed)
-    int     nzmax; // currently allocated space for non-zeros in Ai and Ax
+    typedef typename ARReducedType<ARTYPE>::type ARREDUCED;
+
+    ARindex* Ap;    // column pointers
+    ARindex* Ai;    // row indices
+    ARTYPE*  Ax;    // values
+    ARindex* Di;    // diagonal indices (allocated as needed)
+    ARindex  nzmax; // currently allocated space for non-zeros in Ai and Ax
     char    uplo;  // symmetric matrix given as upper 'U' or lower 'L'
     bool    owner; // if true, Ap, Ai and Ax were allocated by this class.
 
+    int     format   = CSC;     // format currently used by MultMv
+    int     nthreads = 1;       // number of threads used by MultMv (CSR and SELL only)
+    ARindex* Rp      = nullptr; // CSR row pointers
+    ARindex* Rj      = nullptr; // CSR column indices
+    ARTYPE* Rx       = nullptr; // CSR values
+    ARindex* Sp      = nullptr; // SELL slice pointers
+    ARindex* Sj      = nullptr; // SELL column indices (column-major inside each slice)
+    ARTYPE* Sx       = nullptr; // SELL values
+    int*    Sr       = nullptr; // SELL row permutation (sorted position -> row)
+    ARindex* Fp      = nullptr; // CSRF row pointers
+    int*    Fj       = nullptr; // CSRF column indices
+    int*    Fc       = nullptr; // CSRF16 first column of each row
+    unsigned short* Fd = nullptr; // CSRF16 column increments
+    ARREDUCED* Fx    = nullptr; // CSRF values
+    double  Fe       = 0.0;     // Frobenius norm of the rounding error in Fx
+    std::vector<int> bounds;    // rows (CSR) or slices (SELL) assigned to each thread
+    int*    Pm       = nullptr; // reordering (stored row/column -> original index)
+    std::vector<ARTYPE> Pw;     // permuted vectors used by MultMv and MultMm
+
+    template<typename> friend class ARSparseMatrix;
+
     void ClearMem();
 
+    void CopyPermutation(const int* perm);
+
+    bool SameOrdering(const ARSparseMatrix<ARTYPE>& B) const;
+
+    void BuildCSR();
+
+    void BuildSELL(int sigma);
+
+    void BuildCSRF(bool shortIndices);
+
+    void PartitionRows();
+
+    void MultMvCSC(ARTYPE* v, ARTYPE* w);
+
+    void MultMvCSR(ARTYPE* v, ARTYPE* w);
+
+    void MultMvSELL(ARTYPE* v, ARTYPE* w);
+
+    void MultMvCSRF(ARTYPE* v, ARTYPE* w);
+
+    void MultMvStored(ARTYPE* v, ARTYPE* w);
+
+    void MultMmStored(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
     /**
      * @brief Expands a lower triangular sparse matrix.
      *
@@ -35,7 +121,7 @@ protected:
      * @return Returns 0 on success. Otherwise the number of elements exceeds
      *      nzmax and the minimum required value for nzmax is returned.
      */
-    int ExpandL(ARSparseMatrix<ARTYPE>& B, int* work);
+    ARindex ExpandL(ARSparseMatrix<ARTYPE>& B, ARindex* work);
 
     /**
      * @brief Expands an upper triangular sparse matrix.
@@ -46,19 +132,19 @@ protected:
      * @return Returns 0 on success. Otherwise the number of elements exceeds
      *      nzmax and the minimum required value for nzmax is returned.
      */
-    int ExpandU(ARSparseMatrix<ARTYPE>& B, int* work);
+    ARindex ExpandU(ARSparseMatrix<ARTYPE>& B, ARindex* work);
 
 public:
 
     /**
      * @brief Returns the column pointers array (size ncols()).
      */
-    int* pcol() { return Ap; }
+    ARindex* pcol() { return Ap; }
 
     /**
      * @brief Returns the row indices array (size nzeros()).
      */
-    int* irow() { return Ai; }
+    ARindex* irow() { return Ai; }
 
     /**
      * @brief Returns the values array (size nzeros()).
@@ -68,12 +154,12 @@ public:
     /**
      * @brief Returns the number of non-zeros.
      */
-    int nzeros() const { return Ap[this->n]; }
+    ARindex nzeros() const { return Ap[this->n]; }
 
     /**
      * @brief Returns the maximum number of non-zeros.
      */
-    int size() const { return nzmax; }
+    ARindex size() const { return nzmax; }
 
     bool IsUpper() const { return uplo == 'U'; }
     bool IsLower() const { return uplo == 'L'; }
@@ -96,7 +182,7 @@ public:
      *
      * @param B The target matrix B
      */
-    int Expand(ARSparseMatrix<ARTYPE>& B);
+    ARindex Expand(ARSparseMatrix<ARTYPE>& B);
 
     /**
      * @brief Computes the positions of the diagonal elements of a sparse matrix
@@ -125,7 +211,7 @@ public:
      *    as to whether there is enough space appended to the arrays Ax and Ap.
      *    If not sure, allow for n additional elements.
      */
-    int AddDiag(ARTYPE value);
+    ARindex AddDiag(ARTYPE value);
 
     /**
      * @brief Performs the operation C = A + s B.
@@ -136,7 +222,7 @@ public:
      *
      * @return Returns 0 if ok, otherwise the number of elements in C exceeds nzmax
      */
-    int Add(const ARTYPE s, const ARSparseMatrix<ARTYPE>& B, ARSparseMatrix<ARTYPE>& C);
+    ARindex Add(const ARTYPE s, const ARSparseMatrix<ARTYPE>& B, ARSparseMatrix<ARTYPE>& C);
 
     /**
      * @brief Performs the operation C = A + s B (special overload for real-valued, non-symmetric
@@ -149,7 +235,7 @@ public:
      *
      * @return Returns 0 on success, otherwise the number of elements in C exceeds nzmax
      */
-    int Add(const ARTYPE sr, const ARTYPE si, const ARSparseMatrix<ARTYPE>& B, ARSparseMatrix<arcomplex<ARTYPE>>& C);
+    ARindex Add(const ARTYPE sr, const ARTYPE si, const ARSparseMatrix<ARTYPE>& B, ARSparseMatrix<arcomplex<ARTYPE>>& C);
 
     /**
      * @brief Gets the exact number of nonzero elements in A + B.
@@ -161,16 +247,118 @@ public:
      *
      * @return Total number of nonzero elements in A + B
      */
-    int PrepareAdd(const ARSparseMatrix<ARTYPE>& B, int* count, int* work);
+    ARindex PrepareAdd(const ARSparseMatrix<ARTYPE>& B, ARindex* count, ARindex* work);
 
+    /**
+     * @brief Performs the matrix-vector product w = A*v, using the storage
+     *        format selected by OptimizeMultMv (CSC by default).
+     */
     void MultMv(ARTYPE* v, ARTYPE* w);
 
+    /**
+     * @brief Performs the matrix-matrix product W = A*V for k vectors stored
+     *        by columns, reading the matrix only once.
+     */
+    void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
+    /**
+     * @brief Builds an additional CSR or SELL-C-sigma copy of the matrix to
+     *        be used by MultMv. The CSC arrays are not changed.
+     *
+     * @param fmt The format to use. If AUTO, the CSC, CSR and SELL formats
+     *            are timed and the one with the fastest MultMv on this matrix
+     *            is kept. CSRF and CSRF16 change the results slightly, so
+     *            they are only used on request (see CompressMultMv).
+     * @param sigma Sorting window (in rows) used by the SELL format.
+     *
+     * @return The format selected.
+     *
+     * @remarks The additional copy holds the values at the time of the call.
+     *          If the values are changed through values(), call this function
+     *          again (or ClearFormats) before the next product.
+     */
+    int OptimizeMultMv(int fmt = AUTO, int sigma = 32 * SellC);
+
+    /**
+     * @brief Makes MultMv use a CSR copy of the matrix with the values
+     *        rounded to ARReducedType<ARTYPE> (float for double, complex
+     *        float for complex double). Products are still accumulated
+     *        in ARTYPE, so only the matrix entries lose precision.
+     *
+     * @param shortIndices If true, the column indices are also stored as
+     *            16 bit increments (gaps wider than 65535 columns are
+     *            bridged with explicit zeros). Reordering the matrix first
+     *            (see Reorder) keeps those gaps short.
+     *
+     * @return The Frobenius norm of the difference between the matrix
+     *         used by MultMv and the stored one (see PerturbationNorm).
+     *
+     * @remarks This is the same as OptimizeMultMv(CSRF) or
+     *          OptimizeMultMv(CSRF16). MultMm keeps using the CSC arrays.
+     */
+    double CompressMultMv(bool shortIndices = false);
+
+    /**
+     * @brief Returns ||E||_F, where A + E is the matrix actually used by
+     *        MultMv (zero unless the format is CSRF or CSRF16). It bounds
+     *        ||E||_2, hence, by Weyl's theorem, the change in each
+     *        eigenvalue of a symmetric (or hermitian) matrix.
+     */
+    double PerturbationNorm() const { return Fe; }
+
+    /**
+     * @brief Returns the storage format currently used by MultMv.
+     */
+    int MultMvFormat() const { return format; }
+
+    /**
+     * @brief Frees the CSR, SELL and CSRF copies and returns to CSC products.
+     */
+    void ClearFormats();
+
+    /**
+     * @brief Sets the number of threads used by MultMv in CSR and SELL
+     *        format (0 means all available cores).
+     */
+    void SetThreads(int nthreadsp);
+
+    int Threads() const { return nthreads; }
+
+    /**
+     * @brief Replaces the stored arrays by those of the symmetric permutation
+     *        P*A*P', where row and column i of P*A*P' are row and column
+     *        perm[i] of the stored matrix. If only one triangle is stored,
+     *        the same triangle is kept.
+     *
+     * @remarks MultMv and MultMm still compute products with the original
+     *          matrix: vectors are permuted on entry and on exit. The arrays
+     *          returned by pcol(), irow() and values() hold the permuted
+     *          matrix, and Permutation() tells how to map them back. The
+     *          permuted arrays are always owned by this class.
+     */
+    void Permute(const int* perm);
+
+    /**
+     * @brief Permutes the matrix with a reverse Cuthill-McKee ordering of
+     *        its symmetric pattern, reducing its bandwidth (see Permute).
+     */
+    void Reorder();
+
+    /**
+     * @brief Returns the current ordering (Permutation()[i] is the original
+     *        index of stored row/column i), or null if the matrix was never
+     *        permuted.
+     */
+    const int* Permutation() const { return Pm; }
+
+    bool IsReordered() const { return Pm != nullptr; }
+
 
-    ARSparseMatrix(int nrows, int ncols, int nz, char uplo = '*')
+    ARSparseMatrix(int nrows, int ncols, ARindex nz, char uplo = '*')
         : ARMatrix<ARTYPE>(nrows, ncols), nzmax(nz), uplo(uplo), owner(true)
     {
-        Ap = new int[ncols + 1];
-        Ai = new int[nz];
+        Ap = new ARindex[ncols + 1];
+        Ai = new ARindex[nz];
         Ax = new ARTYPE[nz];
 
         // Make sure the CSC arrays are initialized correctly.
@@ -180,7 +368,15 @@ public:
         Di = nullptr;
     }
 
-    ARSparseMatrix(int nrows, int ncols, int* &ap, int* &ai, ARTYPE* &ax, int nzmax = -1, char uplo = '*', bool owner = false)
+    /**
+     * @brief Defines the matrix from arrays in CSC format.
+     *
+     * @param fmt Format passed to OptimizeMultMv once the matrix is
+     *            defined. With AUTO, the MultMv kernels are benchmarked
+     *            on this matrix now and the fastest one is kept. The
+     *            default (CSC) builds no copy.
+     */
+    ARSparseMatrix(int nrows, int ncols, ARindex* &ap, ARindex* &ai, ARTYPE* &ax, ARindex nzmax = -1, char uplo = '*', bool owner = false, int fmt = CSC)
         : ARMatrix<ARTYPE>(nrows, ncols), Ap(ap), Ai(ai), Ax(ax), uplo(uplo), owner(owner)
     {
       if (ap == nullptr)
@@ -191,9 +387,12 @@ public:
       this->nzmax = (nzmax < 0) ? Ap[ncols] : nzmax;
 
       Di = nullptr;
+
+      if (fmt != CSC) OptimizeMultMv(fmt);
     }
 
-    ARSparseMatrix(const ARSparseMatrix<ARTYPE>& other) { Copy(other); }
+    ARSparseMatrix(const ARSparseMatrix<ARTYPE>& other)
+        : ARSparseMatrix(other.m, other.n, other.nzmax, other.uplo) { Copy(other); }
     // Copy constructor.
 
     virtual ~ARSparseMatrix() { ClearMem(); }
@@ -204,6 +403,194 @@ public:
 
 };
 
+/**
+ * @brief Gathers pv[i] = v[perm[i]], i = 0, ..., n-1.
+ */
+template <typename ARTYPE>
+inline void PermuteVector(int n, const int* perm, const ARTYPE* v, ARTYPE* pv)
+{
+    for (int i = 0; i < n; i++) pv[i] = v[perm[i]];
+}
+
+/**
+ * @brief Scatters v[perm[i]] = pv[i], i = 0, ..., n-1 (inverse of PermuteVector).
+ */
+template <typename ARTYPE>
+inline void UnpermuteVector(int n, const int* perm, const ARTYPE* pv, ARTYPE* v)
+{
+    for (int i = 0; i < n; i++) v[perm[i]] = pv[i];
+}
+
+/**
+ * @brief Computes a reverse Cuthill-McKee ordering of the pattern of A + A',
+ *        where A is a square matrix in CSC format (a single triangle of a
+ *        symmetric matrix may be given). On return, perm[k] is the original
+ *        index of row/column k of the reordered matrix.
+ */
+template <typename ARINT>
+inline void RCMOrdering(int n, const ARINT* ap, const ARINT* ai, int* perm)
+{
+    int   i, j;
+    ARINT p, q;
+
+    // Building the adjacency lists of A + A' (diagonal excluded).
+
+    std::vector<ARINT> xadj(n + 1, 0);
+
+    for (j = 0; j < n; j++)
+    {
+        for (p = ap[j]; p < ap[j + 1]; p++)
+        {
+            if (ai[p] != j)
+            {
+                xadj[ai[p] + 1]++;
+                xadj[j + 1]++;
+            }
+        }
+    }
+
+    for (i = 0; i < n; i++) xadj[i + 1] += xadj[i];
+
+    std::vector<int>   adj(xadj[n]);
+    std::vector<ARINT> next(xadj.begin(), xadj.end() - 1);
+
+    for (j = 0; j < n; j++)
+    {
+        for (p = ap[j]; p < ap[j + 1]; p++)
+        {
+            if (ai[p] != j)
+            {
+                adj[next[ai[p]]++] = j;
+                adj[next[j]++] = ai[p];
+            }
+        }
+    }
+
+    // Removing duplicates (entries stored in both triangles).
+
+    std::vector<int> deg(n);
+    std::vector<int> mark(n, -1);
+
+    for (i = 0; i < n; i++)
+    {
+        q = xadj[i];
+        for (p = xadj[i]; p < xadj[i + 1]; p++)
+        {
+            if (mark[adj[p]] != i)
+            {
+                mark[adj[p]] = i;
+                adj[q++] = adj[p];
+            }
+        }
+        deg[i] = q - xadj[i];
+    }
+
+    // Level structure rooted at root. Returns the number of nodes reached,
+    // the start of the last level in queue and the number of levels.
+
+    std::vector<int> queue(n);
+    std::vector<int> stamp(n, -1);
+    int tag = 0;
+
+    auto levels = [&](int root, int& last, int& depth) -> int
+    {
+        int head = 0;
+        int tail = 0;
+
+        tag++;
+        queue[tail++] = root;
+        stamp[root] = tag;
+        depth = 0;
+
+        while (head < tail)
+        {
+            int end = tail;
+            last = head;
+            depth++;
+            for (; head < end; head++)
+            {
+                int u = queue[head];
+                for (ARINT r = xadj[u]; r < xadj[u] + deg[u]; r++)
+                {
+                    if (stamp[adj[r]] != tag)
+                    {
+                        stamp[adj[r]] = tag;
+                        queue[tail++] = adj[r];
+                    }
+                }
+            }
+        }
+
+        return tail;
+    };
+
+    // Components are visited starting from nodes of low degree.
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return deg[a] < deg[b]; });
+
+    std::vector<char> done(n, 0);
+    int count = 0;
+
+    for (int s : order)
+    {
+        if (done[s]) continue;
+
+        // Looking for a pseudo-peripheral root (George and Liu).
+
+        int root = s;
+        int last, depth;
+        int size = levels(root, last, depth);
+
+        for (int it = 0; it < 8; it++)
+        {
+            int cand = queue[last];
+            for (int r = last + 1; r < size; r++)
+            {
+                if (deg[queue[r]] < deg[cand]) cand = queue[r];
+            }
+
+            int last2, depth2;
+            int size2 = levels(cand, last2, depth2);
+            if (depth2 <= depth) break;
+
+            root  = cand;
+            last  = last2;
+            depth = depth2;
+            size  = size2;
+        }
+
+        // Cuthill-McKee numbering of the component.
+
+        int head = count;
+        perm[count++] = root;
+        done[root] = 1;
+
+        while (head < count)
+        {
+            int u = perm[head++];
+            int first = count;
+
+            for (p = xadj[u]; p < xadj[u] + deg[u]; p++)
+            {
+                if (!done[adj[p]])
+                {
+                    done[adj[p]] = 1;
+                    perm[count++] = adj[p];
+                }
+            }
+
+            std::sort(perm + first, perm + count, [&](int a, int b)
+            {
+                return deg[a] < deg[b] || (deg[a] == deg[b] && a < b);
+            });
+        }
+    }
+
+    std::reverse(perm, perm + n);
+}
+
 template<typename ARTYPE>
 inline void ARSparseMatrix<ARTYPE>::ClearMem()
 {
@@ -215,12 +602,61 @@ inline void ARSparseMatrix<ARTYPE>::ClearMem()
     }
 
     if (Di) { delete[] Di; Di = nullptr; }
+    if (Pm) { delete[] Pm; Pm = nullptr; }
+
+    ClearFormats();
+}
+
+template<typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::CopyPermutation(const int* perm)
+{
+    if (perm == Pm) return;
+
+    if (perm)
+    {
+        if (!Pm) Pm = new int[this->n];
+        std::memcpy(Pm, perm, this->n * sizeof(int));
+    }
+    else if (Pm)
+    {
+        delete[] Pm;
+        Pm = nullptr;
+    }
+}
+
+template<typename ARTYPE>
+inline bool ARSparseMatrix<ARTYPE>::SameOrdering(const ARSparseMatrix<ARTYPE>& B) const
+{
+    if (!Pm || !B.Pm) return Pm == B.Pm;
+
+    return std::equal(Pm, Pm + this->n, B.Pm);
+}
+
+template<typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::ClearFormats()
+{
+    if (Rp) { delete[] Rp; Rp = nullptr; }
+    if (Rj) { delete[] Rj; Rj = nullptr; }
+    if (Rx) { delete[] Rx; Rx = nullptr; }
+    if (Sp) { delete[] Sp; Sp = nullptr; }
+    if (Sj) { delete[] Sj; Sj = nullptr; }
+    if (Sx) { delete[] Sx; Sx = nullptr; }
+    if (Sr) { delete[] Sr; Sr = nullptr; }
+    if (Fp) { delete[] Fp; Fp = nullptr; }
+    if (Fj) { delete[] Fj; Fj = nullptr; }
+    if (Fc) { delete[] Fc; Fc = nullptr; }
+    if (Fd) { delete[] Fd; Fd = nullptr; }
+    if (Fx) { delete[] Fx; Fx = nullptr; }
+
+    Fe = 0.0;
+    bounds.clear();
+    format = CSC;
 }
 
 template<typename ARTYPE>
 bool ARSparseMatrix<ARTYPE>::Check() const
 {
-    int i, j, k;
+    ARindex i, j, k;
     
     int m = this->m;
     int n = this->n;
@@ -273,7 +709,7 @@ inline void ARSparseMatrix<ARTYPE>::Copy(const ARSparseMatrix<ARTYPE>& other)
         throw ArpackError(ArpackError::INCOMPATIBLE_SIZES, "ARSparseMatrix::Copy");
     }
 
-    int nnz = other.nzeros();
+    ARindex nnz = other.nzeros();
 
     if (nzmax < nnz)
     {
@@ -282,18 +718,22 @@ inline void ARSparseMatrix<ARTYPE>::Copy(const ARSparseMatrix<ARTYPE>& other)
 
     uplo = other.uplo;
 
-    std::memcpy(Ap, other.Ap, (n + 1) * sizeof(int));
-    std::memcpy(Ai, other.Ai, nnz * sizeof(int));
+    ClearFormats();
+
+    std::memcpy(Ap, other.Ap, (n + 1) * sizeof(ARindex));
+    std::memcpy(Ai, other.Ai, nnz * sizeof(ARindex));
     std::memcpy(Ax, other.Ax, nnz * sizeof(ARTYPE));
 
     if (other.Di)
     {
         if (!Di)
         {
-            Di = new int[n];
+            Di = new ARindex[n];
         }
-        std::memcpy(Di, other.Di, n * sizeof(int));
+        std::memcpy(Di, other.Di, n * sizeof(ARindex));
     }
+
+    CopyPermutation(other.Pm);
 }
 
 template <typename ARTYPE>
@@ -302,14 +742,14 @@ inline int ARSparseMatrix<ARTYPE>::DiagIndices(bool update)
     // The diagonal indices have already been computed.
     if (Di && !update) return -1;
 
-    int j, end;
+    ARindex j, end;
     int count = 0;
 
     int n = this->n;
 
     if (!Di)
     {
-        Di = new int[n];
+        Di = new ARindex[n];
     }
 
     for (int i = 0; i < n; i++)
@@ -337,15 +777,17 @@ inline int ARSparseMatrix<ARTYPE>::DiagIndices(bool update)
 }
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::AddDiag(ARTYPE value)
+inline ARindex ARSparseMatrix<ARTYPE>::AddDiag(ARTYPE value)
 {
-    int i, j, k, k0, start, end;
+    ARindex i, j, k, k0, start, end;
     bool test;
     int n = this->n;
 
     // Ensure diagonal indices are computed.
     DiagIndices();
 
+    ClearFormats();
+
     // Number of missing diagonals.
     int icount = 0;
 
@@ -409,7 +851,7 @@ inline int ARSparseMatrix<ARTYPE>::AddDiag(ARTYPE value)
 }
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::Add(const ARTYPE s, const ARSparseMatrix<ARTYPE> &B,
+inline ARindex ARSparseMatrix<ARTYPE>::Add(const ARTYPE s, const ARSparseMatrix<ARTYPE> &B,
     ARSparseMatrix<ARTYPE>& C)
 {
     if (s == (ARTYPE)0.0)
@@ -418,11 +860,19 @@ inline int ARSparseMatrix<ARTYPE>::Add(const ARTYPE s, const ARSparseMatrix<ARTY
         return 0;
     }
 
-    int i, rowa, rowb, kc, ka, kb, kamax, kbmax, nzmax;
+    ARindex i, rowa, rowb, kc, ka, kb, kamax, kbmax, nzmax;
 
     int nrow = this->m;
     int ncol = this->n;
 
+    if (!SameOrdering(B))
+    {
+        throw ArpackError(ArpackError::INCONSISTENT_DATA, "ARSparseMatrix::Add");
+    }
+
+    C.ClearFormats();
+    C.CopyPermutation(Pm);
+
     auto Bp = B.Ap;
     auto Bi = B.Ai;
     auto Bx = B.Ax;
@@ -481,28 +931,36 @@ inline int ARSparseMatrix<ARTYPE>::Add(const ARTYPE s, const ARSparseMatrix<ARTY
 }
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::Add(const ARTYPE sr, const ARTYPE si,
+inline ARindex ARSparseMatrix<ARTYPE>::Add(const ARTYPE sr, const ARTYPE si,
     const ARSparseMatrix<ARTYPE>& B, ARSparseMatrix<arcomplex<ARTYPE>>& C)
 {
     auto Cp = C.pcol();
     auto Ci = C.irow();
     auto Cx = C.values();
 
+    if (!SameOrdering(B))
+    {
+        throw ArpackError(ArpackError::INCONSISTENT_DATA, "ARSparseMatrix::Add");
+    }
+
+    C.ClearFormats();
+    C.CopyPermutation(Pm);
+
     int nrow = this->m;
     int ncol = this->n;
 
     if (sr == (ARTYPE)0.0 && si == (ARTYPE)0.0)
     {
-        int nnz = nzeros();
+        ARindex nnz = nzeros();
 
-        std::memcpy(Cp, Ap, (ncol + 1) * sizeof(int));
-        std::memcpy(Ci, Ai, nnz * sizeof(int));
-        for (int i = 0; i < nnz; i++) Cx[i] = Ax[i];
+        std::memcpy(Cp, Ap, (ncol + 1) * sizeof(ARindex));
+        std::memcpy(Ci, Ai, nnz * sizeof(ARindex));
+        for (ARindex i = 0; i < nnz; i++) Cx[i] = Ax[i];
 
         return 0;
     }
 
-    int i, rowa, rowb, kc, ka, kb, kamax, kbmax, nzmax;
+    ARindex i, rowa, rowb, kc, ka, kb, kamax, kbmax, nzmax;
 
     auto Bp = B.Ap;
     auto Bi = B.Ai;
@@ -560,9 +1018,9 @@ inline int ARSparseMatrix<ARTYPE>::Add(const ARTYPE sr, const ARTYPE si,
 }
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::PrepareAdd(const ARSparseMatrix<ARTYPE>& B, int *count, int *work)
+inline ARindex ARSparseMatrix<ARTYPE>::PrepareAdd(const ARSparseMatrix<ARTYPE>& B, ARindex *count, ARindex *work)
 {
-    int i, j, k, nz, last, end;
+    ARindex i, j, k, nz, last, end;
 
     auto Bp = B.Ap;
     auto Bi = B.Ai;
@@ -633,9 +1091,6 @@ inline int ARSparseMatrix<ARTYPE>::PrepareAdd(const ARSparseMatrix<ARTYPE>& B, i
 template <typename ARTYPE>
 inline void ARSparseMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
-    int    i, j;
-    ARTYPE t;
-
     // Quitting the function if A was not defined.
 
     if (Ap == nullptr) {
@@ -644,6 +1099,47 @@ inline void ARSparseMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 
     // Determining w = M.v.
 
+    if (Pm)
+    {
+        int n = this->n;
+
+        Pw.resize(2 * (size_t)n);
+        ARTYPE* pv = Pw.data();
+        ARTYPE* pw = pv + n;
+
+        PermuteVector(n, Pm, v, pv);
+        MultMvStored(pv, pw);
+        UnpermuteVector(n, Pm, pw, w);
+    }
+    else
+    {
+        MultMvStored(v, w);
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::MultMvStored(ARTYPE* v, ARTYPE* w)
+{
+    if (format == SELL) {
+        MultMvSELL(v, w);
+    }
+    else if (format == CSRF || format == CSRF16) {
+        MultMvCSRF(v, w);
+    }
+    else if (format == CSR) {
+        MultMvCSR(v, w);
+    }
+    else {
+        MultMvCSC(v, w);
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::MultMvCSC(ARTYPE* v, ARTYPE* w)
+{
+    ARindex i, j;
+    ARTYPE t;
+
     for (i = 0; i != this->m; i++) w[i] = (ARTYPE)0.0;
 
     for (i = 0; i != this->n; i++)
@@ -654,43 +1150,784 @@ inline void ARSparseMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
             w[Ai[j]] += t * Ax[j];
         }
     }
-
 }
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::Expand(ARSparseMatrix<ARTYPE>& B)
+inline void ARSparseMatrix<ARTYPE>::MultMvCSR(ARTYPE* v, ARTYPE* w)
 {
-    int i = 0;
+    ARindex* rp = Rp;
+    ARindex* rj = Rj;
+    ARTYPE*  rx = Rx;
 
-    int* work = new int[this->n + 1];
-
-    if (uplo == 'U')
+    ARParallelFor((int)bounds.size() - 1, bounds.data(), [=](int, int first, int last)
     {
-        i = ExpandU(B, work);
+        for (int i = first; i < last; i++)
+        {
+            ARTYPE t = (ARTYPE)0.0;
+            for (ARindex j = rp[i]; j < rp[i + 1]; j++)
+            {
+                t += rx[j] * v[rj[j]];
+            }
+            w[i] = t;
+        }
+    });
+}
 
-    }
-    else if (uplo == 'L')
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::MultMvSELL(ARTYPE* v, ARTYPE* w)
+{
+    int      m  = this->m;
+    ARindex* sp = Sp;
+    ARindex* sj = Sj;
+    int*     sr = Sr;
+    ARTYPE*  sx = Sx;
+
+    ARParallelFor((int)bounds.size() - 1, bounds.data(), [=](int, int first, int last)
     {
-        i = ExpandL(B, work);
-    }
+        ARTYPE t[SellC];
 
-    // S = symmetric (not used anywhere, but might be useful).
-    B.uplo = 'S';
+        for (int s = first; s < last; s++)
+        {
+            for (int k = 0; k < SellC; k++) t[k] = (ARTYPE)0.0;
 
-    delete[] work;
+            // Entries of a slice are stored column by column, so the
+            // inner loop has unit stride and no dependencies.
 
-    return i;
+            for (ARindex j = sp[s]; j < sp[s + 1]; j += SellC)
+            {
+                for (int k = 0; k < SellC; k++)
+                {
+                    t[k] += sx[j + k] * v[sj[j + k]];
+                }
+            }
+
+            int r0 = s * SellC;
+            int kmax = std::min(SellC, m - r0);
+
+            for (int k = 0; k < kmax; k++) w[sr[r0 + k]] = t[k];
+        }
+    });
 }
 
-/* Helper function to conjugate values in the expanded matrix. */
-template <typename T> inline T spmat_conj(T val) { return val; }
-template <> inline arcomplex<float> spmat_conj(arcomplex<float> val) { return std::conj(val); }
-template <> inline arcomplex<double> spmat_conj(arcomplex<double> val) { return std::conj(val); }
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::MultMvCSRF(ARTYPE* v, ARTYPE* w)
+{
+    ARindex*        fp = Fp;
+    int*            fj = Fj;
+    int*            fc = Fc;
+    unsigned short* fd = Fd;
+    ARREDUCED*      fx = Fx;
+
+    // Values are widened to ARTYPE before the product, so the sums are
+    // computed in full precision.
+
+    ARParallelFor((int)bounds.size() - 1, bounds.data(), [=](int, int first, int last)
+    {
+        for (int i = first; i < last; i++)
+        {
+            ARTYPE t = (ARTYPE)0.0;
+            if (fd)
+            {
+                int c = fc[i];
+                for (ARindex j = fp[i]; j < fp[i + 1]; j++)
+                {
+                    c += fd[j];
+                    t += (ARTYPE)fx[j] * v[c];
+                }
+            }
+            else
+            {
+                for (ARindex j = fp[i]; j < fp[i + 1]; j++)
+                {
+                    t += (ARTYPE)fx[j] * v[fj[j]];
+                }
+            }
+            w[i] = t;
+        }
+    });
+}
+
+/**
+ * @brief Computes W = A*V for a general matrix A in CSC format and k vectors
+ *        stored by columns. Each column of A is read once for all vectors.
+ */
+template <typename ARTYPE, typename ARINT>
+inline void CSCMultMm(int m, int n, const ARINT* ap, const ARINT* ai, const ARTYPE* ax,
+    int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+    ARINT i, j, p;
+    int   r;
+
+    for (r = 0; r < k; r++)
+    {
+        std::fill(W + (size_t)r * ldw, W + (size_t)r * ldw + m, (ARTYPE)0.0);
+    }
+
+    for (j = 0; j < n; j++)
+    {
+        for (p = ap[j]; p < ap[j + 1]; p++)
+        {
+            i = ai[p];
+            ARTYPE a = ax[p];
+            for (r = 0; r < k; r++)
+            {
+                W[i + (size_t)r * ldw] += a * V[j + (size_t)r * ldv];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Computes W = A*V for a symmetric matrix A of which only the lower
+ *        ('L') or upper ('U') triangle is stored in CSC format. For any
+ *        other value of uplo, A is treated as a general matrix.
+ */
+template <typename ARTYPE, typename ARINT>
+inline void SymCSCMultMm(int n, const ARINT* ap, const ARINT* ai, const ARTYPE* ax,
+    char uplo, int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+    ARINT i, j, p;
+    int   r;
+
+    if (uplo != 'L' && uplo != 'U')
+    {
+        CSCMultMm(n, n, ap, ai, ax, k, V, ldv, W, ldw);
+        return;
+    }
+
+    for (r = 0; r < k; r++)
+    {
+        std::fill(W + (size_t)r * ldw, W + (size_t)r * ldw + n, (ARTYPE)0.0);
+    }
+
+    for (j = 0; j < n; j++)
+    {
+        for (p = ap[j]; p < ap[j + 1]; p++)
+        {
+            i = ai[p];
+            ARTYPE a = ax[p];
+            if (i == j)
+            {
+                for (r = 0; r < k; r++)
+                {
+                    W[j + (size_t)r * ldw] += a * V[j + (size_t)r * ldv];
+                }
+            }
+            else
+            {
+                for (r = 0; r < k; r++)
+                {
+                    W[i + (size_t)r * ldw] += a * V[j + (size_t)r * ldv];
+                    W[j + (size_t)r * ldw] += a * V[i + (size_t)r * ldv];
+                }
+            }
+        }
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+    // Quitting the function if A was not defined.
+
+    if (Ap == nullptr) {
+        throw ArpackError(ArpackError::DATA_UNDEFINED, "ARSparseMatrix::MultMm");
+    }
+
+    if (Pm)
+    {
+        int n = this->n;
+
+        Pw.resize(2 * (size_t)n * k);
+        ARTYPE* pv = Pw.data();
+        ARTYPE* pw = pv + (size_t)n * k;
+
+        for (int r = 0; r < k; r++)
+        {
+            PermuteVector(n, Pm, V + (size_t)r * ldv, pv + (size_t)r * n);
+        }
+
+        MultMmStored(k, pv, n, pw, n);
+
+        for (int r = 0; r < k; r++)
+        {
+            UnpermuteVector(n, Pm, pw + (size_t)r * n, W + (size_t)r * ldw);
+        }
+    }
+    else
+    {
+        MultMmStored(k, V, ldv, W, ldw);
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::MultMmStored(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+    // The reduced precision copies (CSRF and CSRF16) are only used by
+    // MultMv, so MultMm reads the CSC arrays for them.
+
+    if (format != CSR && format != SELL)
+    {
+        CSCMultMm(this->m, this->n, Ap, Ai, Ax, k, V, ldv, W, ldw);
+        return;
+    }
+
+    int      m  = this->m;
+    ARindex* rp = Rp;
+    ARindex* rj = Rj;
+    ARTYPE*  rx = Rx;
+    ARindex* sp = Sp;
+    ARindex* sj = Sj;
+    int*     sr = Sr;
+    ARTYPE*  sx = Sx;
+    int      fmt = format;
+
+    ARParallelFor((int)bounds.size() - 1, bounds.data(), [=](int, int first, int last)
+    {
+        if (fmt == CSR)
+        {
+            for (int i = first; i < last; i++)
+            {
+                for (int r = 0; r < k; r++)
+                {
+                    const ARTYPE* v = V + (size_t)r * ldv;
+                    ARTYPE t = (ARTYPE)0.0;
+                    for (ARindex j = rp[i]; j < rp[i + 1]; j++)
+                    {
+                        t += rx[j] * v[rj[j]];
+                    }
+                    W[i + (size_t)r * ldw] = t;
+                }
+            }
+        }
+        else
+        {
+            ARTYPE t[SellC];
+
+            // The slice is small enough to stay in cache for all k vectors.
+
+            for (int s = first; s < last; s++)
+            {
+                int r0 = s * SellC;
+                int kmax = std::min(SellC, m - r0);
+
+                for (int r = 0; r < k; r++)
+                {
+                    const ARTYPE* v = V + (size_t)r * ldv;
+
+                    for (int q = 0; q < SellC; q++) t[q] = (ARTYPE)0.0;
+
+                    for (ARindex j = sp[s]; j < sp[s + 1]; j += SellC)
+                    {
+                        for (int q = 0; q < SellC; q++)
+                        {
+                            t[q] += sx[j + q] * v[sj[j + q]];
+                        }
+                    }
+
+                    for (int q = 0; q < kmax; q++) W[sr[r0 + q] + (size_t)r * ldw] = t[q];
+                }
+            }
+        }
+    });
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::BuildCSR()
+{
+    ARindex i, j, k;
+
+    int m = this->m;
+    int n = this->n;
+    ARindex nnz = nzeros();
+
+    if (Rp) return;
+
+    Rp = new ARindex[m + 1];
+    Rj = new ARindex[nnz];
+    Rx = new ARTYPE[nnz];
+
+    // Counting the elements in each row.
+
+    std::fill(Rp, Rp + m + 1, 0);
+
+    for (j = 0; j < nnz; j++) Rp[Ai[j] + 1]++;
+
+    for (i = 0; i < m; i++) Rp[i + 1] += Rp[i];
+
+    // Transposing (column indices come out sorted).
+
+    std::vector<ARindex> next(Rp, Rp + m);
+
+    for (j = 0; j < n; j++)
+    {
+        for (k = Ap[j]; k < Ap[j + 1]; k++)
+        {
+            i = next[Ai[k]]++;
+            Rj[i] = j;
+            Rx[i] = Ax[k];
+        }
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::BuildCSRF(bool shortIndices)
+{
+    const ARindex maxinc = 65535;
+
+    ARindex i, j, k;
+
+    int m = this->m;
+
+    if (Fp) return;
+
+    // The reduced copy is generated from a temporary CSR copy.
+
+    bool tmp = (Rp == nullptr);
+
+    BuildCSR();
+
+    // Counting the elements in each row. Column increments larger
+    // than maxinc need explicit zeros in between.
+
+    Fp = new ARindex[m + 1];
+    Fp[0] = 0;
+
+    for (i = 0; i < m; i++)
+    {
+        k = Rp[i + 1] - Rp[i];
+        if (shortIndices)
+        {
+            for (j = Rp[i] + 1; j < Rp[i + 1]; j++)
+            {
+                k += (Rj[j] - Rj[j - 1] - 1) / maxinc;
+            }
+        }
+        Fp[i + 1] = Fp[i] + k;
+    }
+
+    Fx = new ARREDUCED[Fp[m]];
+
+    if (shortIndices)
+    {
+        Fc = new int[m];
+        Fd = new unsigned short[Fp[m]];
+    }
+    else
+    {
+        Fj = new int[Fp[m]];
+    }
+
+    // Rounding the values and measuring the perturbation.
+
+    double e2 = 0.0;
+
+    for (i = 0; i < m; i++)
+    {
+        k = Fp[i];
+        if (shortIndices) Fc[i] = (Rp[i] < Rp[i + 1]) ? (int)Rj[Rp[i]] : 0;
+
+        for (j = Rp[i]; j < Rp[i + 1]; j++)
+        {
+            ARREDUCED x = (ARREDUCED)Rx[j];
+
+            if (std::isinf(std::abs((ARTYPE)x)) && !std::isinf(std::abs(Rx[j])))
+            {
+                ClearFormats();
+                throw ArpackError(ArpackError::RANGE_ERROR, "ARSparseMatrix::CompressMultMv");
+            }
+
+            double e = (double)std::abs(Rx[j] - (ARTYPE)x);
+            e2 += e * e;
+
+            if (shortIndices)
+            {
+                ARindex inc = (j == Rp[i]) ? 0 : Rj[j] - Rj[j - 1];
+                for (; inc > maxinc; inc -= maxinc)
+                {
+                    Fd[k] = (unsigned short)maxinc;
+                    Fx[k++] = (ARREDUCED)0;
+                }
+                Fd[k] = (unsigned short)inc;
+            }
+            else
+            {
+                Fj[k] = (int)Rj[j];
+            }
+            Fx[k++] = x;
+        }
+    }
+
+    Fe = std::sqrt(e2);
+
+    if (tmp)
+    {
+        delete[] Rp; Rp = nullptr;
+        delete[] Rj; Rj = nullptr;
+        delete[] Rx; Rx = nullptr;
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::BuildSELL(int sigma)
+{
+    ARindex j;
+    int     i, k, r, s;
+
+    int m = this->m;
+    int nslices = (m + SellC - 1) / SellC;
+
+    if (Sp) return;
+
+    BuildCSR();
+
+    // Sorting rows by decreasing length inside windows of sigma rows,
+    // so rows of similar length share a slice and little padding is used.
+
+    if (sigma < SellC) sigma = SellC;
+
+    Sr = new int[m];
+    std::iota(Sr, Sr + m, 0);
+
+    for (i = 0; i < m; i += sigma)
+    {
+        int last = std::min(i + sigma, m);
+        std::stable_sort(Sr + i, Sr + last, [this](int a, int b)
+        {
+            return (Rp[a + 1] - Rp[a]) > (Rp[b + 1] - Rp[b]);
+        });
+    }
+
+    // Slice widths.
+
+    Sp = new ARindex[nslices + 1];
+    Sp[0] = 0;
+
+    for (s = 0; s < nslices; s++)
+    {
+        ARindex width = 0;
+        for (k = s * SellC; k < std::min((s + 1) * SellC, m); k++)
+        {
+            width = std::max(width, Rp[Sr[k] + 1] - Rp[Sr[k]]);
+        }
+        Sp[s + 1] = Sp[s] + width * SellC;
+    }
+
+    Sj = new ARindex[Sp[nslices]];
+    Sx = new ARTYPE[Sp[nslices]];
+
+    // Filling slices. Padding uses a zero value and repeats the last
+    // column of the row, so no extra cache line of v is touched.
+
+    for (s = 0; s < nslices; s++)
+    {
+        ARindex width = (Sp[s + 1] - Sp[s]) / SellC;
+
+        for (k = 0; k < SellC; k++)
+        {
+            r = s * SellC + k;
+
+            ARindex first = (r < m) ? Rp[Sr[r]] : 0;
+            ARindex len   = (r < m) ? Rp[Sr[r] + 1] - first : 0;
+            ARindex pad   = (len > 0) ? Rj[first + len - 1] : 0;
+
+            for (j = 0; j < width; j++)
+            {
+                ARindex pos = Sp[s] + j * SellC + k;
+                if (j < len)
+                {
+                    Sj[pos] = Rj[first + j];
+                    Sx[pos] = Rx[first + j];
+                }
+                else
+                {
+                    Sj[pos] = pad;
+                    Sx[pos] = (ARTYPE)0.0;
+                }
+            }
+        }
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::PartitionRows()
+{
+    int nparts = std::max(nthreads, 1);
+
+    bounds.resize(nparts + 1);
+
+    if (format == SELL)
+    {
+        ARPartition(nparts, (this->m + SellC - 1) / SellC, Sp, bounds.data());
+    }
+    else if (format == CSR)
+    {
+        ARPartition(nparts, this->m, Rp, bounds.data());
+    }
+    else
+    {
+        ARPartition(nparts, this->m, Fp, bounds.data());
+    }
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::SetThreads(int nthreadsp)
+{
+    nthreads = ARThreadCount(nthreadsp);
+
+    if (format != CSC) PartitionRows();
+}
+
+template <typename ARTYPE>
+inline int ARSparseMatrix<ARTYPE>::OptimizeMultMv(int fmt, int sigma)
+{
+    if (Ap == nullptr) {
+        throw ArpackError(ArpackError::DATA_UNDEFINED, "ARSparseMatrix::OptimizeMultMv");
+    }
+
+    // Discarding copies that may hold old values.
+
+    ClearFormats();
+
+    if (fmt == CSC) return format;
+
+    if (fmt == CSRF || fmt == CSRF16)
+    {
+        BuildCSRF(fmt == CSRF16);
+        format = fmt;
+        PartitionRows();
+        return format;
+    }
+
+    if (fmt == CSR || fmt == AUTO) BuildCSR();
+    if (fmt == SELL || fmt == AUTO) BuildSELL(sigma);
+
+    if (fmt != AUTO)
+    {
+        format = fmt;
+        if (format == SELL)
+        {
+            delete[] Rp; Rp = nullptr;
+            delete[] Rj; Rj = nullptr;
+            delete[] Rx; Rx = nullptr;
+        }
+        PartitionRows();
+        return format;
+    }
+
+    // Timing each kernel on the actual matrix (best of a few runs).
+
+    std::vector<ARTYPE> v(this->n, (ARTYPE)1.0);
+    std::vector<ARTYPE> w(this->m);
+
+    double best = 0.0;
+    int    fastest = CSC;
+
+    for (int f = CSC; f <= SELL; f++)
+    {
+        format = f;
+        if (f != CSC) PartitionRows();
+
+        double t = 0.0;
+
+        for (int rep = 0; rep < 4; rep++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            MultMv(v.data(), w.data());
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            // First run only warms up the caches.
+            if (rep == 1 || (rep > 1 && elapsed.count() < t)) t = elapsed.count();
+        }
+
+        if (f == CSC || t < best)
+        {
+            best = t;
+            fastest = f;
+        }
+    }
+
+    // Keeping only the copy that is actually used.
+
+    format = fastest;
+
+    if (format != CSR)
+    {
+        delete[] Rp; Rp = nullptr;
+        delete[] Rj; Rj = nullptr;
+        delete[] Rx; Rx = nullptr;
+    }
+    if (format != SELL)
+    {
+        delete[] Sp; Sp = nullptr;
+        delete[] Sj; Sj = nullptr;
+        delete[] Sx; Sx = nullptr;
+        delete[] Sr; Sr = nullptr;
+    }
+
+    if (format == CSC) bounds.clear(); else PartitionRows();
+
+    return format;
+}
+
+template <typename ARTYPE>
+inline double ARSparseMatrix<ARTYPE>::CompressMultMv(bool shortIndices)
+{
+    OptimizeMultMv(shortIndices ? CSRF16 : CSRF);
+
+    return Fe;
+}
+
+template <typename ARTYPE>
+inline ARindex ARSparseMatrix<ARTYPE>::Expand(ARSparseMatrix<ARTYPE>& B)
+{
+    ARindex i = 0;
+
+    ARindex* work = new ARindex[this->n + 1];
+
+    B.ClearFormats();
+    B.CopyPermutation(Pm);
+
+    if (uplo == 'U')
+    {
+        i = ExpandU(B, work);
+
+    }
+    else if (uplo == 'L')
+    {
+        i = ExpandL(B, work);
+    }
+
+    // S = symmetric (not used anywhere, but might be useful).
+    B.uplo = 'S';
+
+    delete[] work;
+
+    return i;
+}
+
+/* Helper function to conjugate values in the expanded matrix. */
+template <typename T> inline T spmat_conj(T val) { return val; }
+template <> inline arcomplex<float> spmat_conj(arcomplex<float> val) { return std::conj(val); }
+template <> inline arcomplex<double> spmat_conj(arcomplex<double> val) { return std::conj(val); }
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::Permute(const int* perm)
+{
+    int     i, j;
+    ARindex k, p;
+
+    if (Ap == nullptr) {
+        throw ArpackError(ArpackError::DATA_UNDEFINED, "ARSparseMatrix::Permute");
+    }
+    if (this->m != this->n) {
+        throw ArpackError(ArpackError::NOT_SQUARE_MATRIX, "ARSparseMatrix::Permute");
+    }
+
+    int n = this->n;
+    ARindex nnz = nzeros();
+
+    std::vector<int> iperm(n);
+    for (i = 0; i < n; i++) iperm[perm[i]] = i;
+
+    // New position of each entry. Entries that would leave the stored
+    // triangle are mirrored (and conjugated).
+
+    std::vector<int>  ri(nnz);
+    std::vector<int>  ci(nnz);
+    std::vector<char> flip(nnz, 0);
+
+    for (j = 0; j < n; j++)
+    {
+        for (p = Ap[j]; p < Ap[j + 1]; p++)
+        {
+            int r = iperm[Ai[p]];
+            int c = iperm[j];
+            if ((uplo == 'L' && r < c) || (uplo == 'U' && r > c))
+            {
+                std::swap(r, c);
+                flip[p] = 1;
+            }
+            ri[p] = r;
+            ci[p] = c;
+        }
+    }
+
+    // Sorting the entries by row, so that they come out sorted inside
+    // each column when they are distributed by column.
+
+    std::vector<ARindex> rp(n + 1, 0);
+    std::vector<ARindex> byrow(nnz);
+
+    for (p = 0; p < nnz; p++) rp[ri[p] + 1]++;
+    for (i = 0; i < n; i++) rp[i + 1] += rp[i];
+    for (p = 0; p < nnz; p++) byrow[rp[ri[p]]++] = p;
+
+    ARindex* Bp = new ARindex[n + 1];
+    ARindex* Bi = new ARindex[nzmax];
+    ARTYPE*  Bx = new ARTYPE[nzmax];
+
+    std::fill(Bp, Bp + n + 1, 0);
+    for (p = 0; p < nnz; p++) Bp[ci[p] + 1]++;
+    for (j = 0; j < n; j++) Bp[j + 1] += Bp[j];
+
+    std::vector<ARindex> next(Bp, Bp + n);
+
+    for (k = 0; k < nnz; k++)
+    {
+        p = byrow[k];
+        ARindex q = next[ci[p]]++;
+        Bi[q] = ri[p];
+        Bx[q] = flip[p] ? spmat_conj(Ax[p]) : Ax[p];
+    }
+
+    // Replacing the arrays.
+
+    if (owner)
+    {
+        delete[] Ap;
+        delete[] Ai;
+        delete[] Ax;
+    }
+
+    Ap = Bp;
+    Ai = Bi;
+    Ax = Bx;
+    owner = true;
+
+    if (Di) { delete[] Di; Di = nullptr; }
+
+    ClearFormats();
+
+    // Composing with the previous ordering.
+
+    int* pm = new int[n];
+    for (i = 0; i < n; i++) pm[i] = Pm ? Pm[perm[i]] : perm[i];
+
+    if (Pm) delete[] Pm;
+    Pm = pm;
+}
+
+template <typename ARTYPE>
+inline void ARSparseMatrix<ARTYPE>::Reorder()
+{
+    if (Ap == nullptr) {
+        throw ArpackError(ArpackError::DATA_UNDEFINED, "ARSparseMatrix::Reorder");
+    }
+    if (this->m != this->n) {
+        throw ArpackError(ArpackError::NOT_SQUARE_MATRIX, "ARSparseMatrix::Reorder");
+    }
+
+    std::vector<int> perm(this->n);
+
+    RCMOrdering(this->n, Ap, Ai, perm.data());
+    Permute(perm.data());
+}
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::ExpandL(ARSparseMatrix<ARTYPE>& B, int *work)
+inline ARindex ARSparseMatrix<ARTYPE>::ExpandL(ARSparseMatrix<ARTYPE>& B, ARindex *work)
 {
-    int i, j, k, nnz, ipos, end, nzmax;
+    ARindex i, j, k, nnz, ipos, end, nzmax;
 
     int n = this->n;
 
@@ -775,9 +2012,9 @@ inline int ARSparseMatrix<ARTYPE>::ExpandL(ARSparseMatrix<ARTYPE>& B, int *work)
 }
 
 template <typename ARTYPE>
-inline int ARSparseMatrix<ARTYPE>::ExpandU(ARSparseMatrix<ARTYPE>& B, int *work)
+inline ARindex ARSparseMatrix<ARTYPE>::ExpandU(ARSparseMatrix<ARTYPE>& B, ARindex *work)
 {
-    int i, j, k, nnz, ipos, end, nzmax;
+    ARindex i, j, k, nnz, ipos, end, nzmax;
 
     int n = this->n;
 
@@ -0,0 +1,845 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARSSlice.h.
+   Arpack++ class ARSliceSymGenEig definition.
+
+   ARSliceSymGenEig finds all the eigenvalues of a real symmetric
+   generalized problem A*x = B*x*lambda (B positive definite) that lie
+   in an interval [a, b), and the corresponding eigenvectors, by
+   spectrum slicing:
+
+   - the interval is split into slices that contain about SliceSize()
+     eigenvalues each, using the inertia of A - sigma*B to count the
+     eigenvalues below sigma (ARPENCIL::CountEigenvaluesBelow);
+   - an independent shift and invert problem (ARSymGenEig), with its
+     own factorization of A - sigma*B at the center of the slice, is
+     solved for each slice. The slices are spread among Threads()
+     threads, each thread owning a copy of the pencil;
+   - if a slice yields fewer eigenpairs than the inertia count (as
+     happens with the copies of a multiple eigenvalue), it is solved
+     again with the pairs already found deflated;
+   - the eigenpairs found near the boundary of two slices are compared
+     and the duplicates are removed, so a single list of eigenvalues
+     in ascending order (and their B-orthonormal eigenvectors) is
+     returned.
+
+   ARPENCIL may be ARchSymPencil (arcspen.h), ARbdSymPencil (arbspen.h)
+   or ARdsSymPencil (ardspen.h). The pencils based on UMFPACK and
+   SuperLU do not provide the inertia of A - sigma*B and cannot be used.
+   Copies of the pencil must be able to factor A - sigma*B at different
+   shifts at the same time, which is the case for all of them.
+
+   The FORTRAN ARPACK subroutines keep part of their state in static
+   variables, so the slices are solved one at a time unless the native
+   thick-restart Lanczos method is selected (see SetNativeBackend).
+   Counting the eigenvalues always uses all the threads.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARSSLICE_H
+#define ARSSLICE_H
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "arch.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "arthread.h"
+#include "argsym.h"
+
+
+template<class ARFLOAT, class ARPENCIL>
+class ARSliceSymGenEig {
+
+ protected:
+
+ // a) Protected variables:
+
+  ARPENCIL* pencil;    // Pencil (A, B). Only copied by the solver.
+  int       n;         // Dimension of the problem.
+  ARFLOAT   lower;     // Lower bound of the interval (a).
+  ARFLOAT   upper;     // Upper bound of the interval (b).
+  int       nslice;    // Desired number of eigenvalues per slice.
+  int       nthreads;  // Number of threads (<= 0 means all cores).
+  bool      native;    // Indicates if the native Lanczos method is used.
+  ARFLOAT   tol;       // Stopping criterion (relative accuracy).
+  int       maxit;     // Maximum number of iterations per slice.
+
+  bool      SlicesOK;  // Indicates if the slices were found.
+  bool      VectorsOK; // Indicates if the eigenvectors were found.
+  int       nconv;     // Number of eigenvalues found.
+
+  std::vector<ARFLOAT> bound;  // Slice i is [bound[i], bound[i+1]).
+  std::vector<int>     below;  // Number of eigenvalues below bound[i].
+  std::vector<ARFLOAT> EigVal; // Eigenvalues found (ascending order).
+  std::vector<ARFLOAT> EigVec; // Eigenvectors found (n x nconv).
+
+
+ // b) Protected functions:
+
+  struct Pair {
+    ARFLOAT  value;   // Eigenvalue.
+    ARFLOAT* vector;  // Eigenvector (B-orthonormal).
+    int      slice;   // Slice where the pair was found.
+    bool     inside;  // Indicates if value is inside the slice.
+  };
+
+  class Deflation {
+  // Operator of the shift and invert problem of a slice, with the k
+  // eigenpairs already found removed: w = inv(A-sigma*B)*(I-B*X*X')*v,
+  // where v = B*x. The columns of X are B-orthonormal, so the vectors
+  // of X are mapped to zero and are not found again.
+   public:
+    ARPENCIL*            P;
+    int                  n, k;
+    const ARFLOAT*       X;   // Eigenvectors already found (n x k).
+    const ARFLOAT*       BX;  // B*X.
+    std::vector<ARFLOAT> z;   // Work vector.
+
+    void MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
+    {
+      if (k == 0) {
+        P->MultInvAsBv(v, w);
+        return;
+      }
+      z.assign(v, v+n);
+      for (int j = 0; j < k; j++) {
+        ARFLOAT c = dot(n, &X[(size_t)j*n], 1, v, 1);
+        axpy(n, -c, &BX[(size_t)j*n], 1, &z[0], 1);
+      }
+      P->MultInvAsBv(&z[0], w);
+    }
+
+    void MultBv(ARFLOAT* v, ARFLOAT* w) { P->MultBv(v, w); }
+  };
+
+  ARFLOAT Overlap(int i) const
+  {
+    return (bound[i+1]-bound[i])/ARFLOAT(100);
+  }
+  // Eigenvalues found at most Overlap(i) outside slice i are kept, so
+  // that an eigenvalue computed on the wrong side of a boundary is not
+  // lost. The duplicates are removed by RemoveDuplicates.
+
+  int Count(ARPENCIL& P, ARFLOAT sigma);
+  // Returns the number of eigenvalues below sigma. If sigma is an
+  // eigenvalue, A - sigma*B is singular and a slightly smaller shift
+  // is used, which does not change the result.
+
+  void Factor(ARPENCIL& P, ARFLOAT& sigma);
+  // Factors A - sigma*B, moving sigma slightly if it is an eigenvalue.
+
+  int Bisect(ARPENCIL& P, int target, ARFLOAT& sigma);
+  // Looks for a shift sigma in (lower, upper) such that about target
+  // eigenvalues are below it. Returns that number of eigenvalues.
+
+  void SolveSlice(ARPENCIL& P, int i, std::vector<ARFLOAT>& val,
+                  std::vector<ARFLOAT>& vec);
+  // Solves the shift and invert problem related to slice i and stores
+  // in val and vec the eigenpairs that belong to the slice.
+
+  void RemoveDuplicates(std::vector<Pair>& pairs);
+  // Removes from pairs (sorted by value) the eigenpairs that were found
+  // in two neighbouring slices.
+
+
+ public:
+
+ // c) Public functions:
+
+ // c.1) Functions that allow changes in problem parameters.
+
+  void DefineParameters(int np, ARPENCIL& Pencilp, ARFLOAT lowerp,
+                        ARFLOAT upperp, int nslicep = 100,
+                        int nthreadsp = 0);
+  // Sets the pencil and the interval [lowerp, upperp).
+
+  void ChangeInterval(ARFLOAT lowerp, ARFLOAT upperp);
+  // Changes the interval where the eigenvalues are sought.
+
+  void SetSliceSize(int nslicep);
+  // Changes the desired number of eigenvalues per slice.
+
+  void SetThreads(int nthreadsp);
+  // Changes the number of threads (<= 0 means all available cores).
+
+  void SetNativeBackend(bool nativep = true);
+  // Solves each slice with the native thick-restart Lanczos method
+  // (artrlan.h) instead of FORTRAN ARPACK, so that the slices are
+  // solved at the same time in different threads.
+
+  void ChangeTol(ARFLOAT tolp);
+  // Changes the stopping criterion of each slice.
+
+  void ChangeMaxit(int maxitp);
+  // Changes the maximum number of iterations of each slice.
+
+
+ // c.2) Functions that perform the calculations.
+
+  int FindSlices();
+  // Counts the eigenvalues in the interval and splits it into slices.
+  // Returns the number of slices.
+
+  int FindEigenvectors();
+  // Finds the eigenvalues in the interval and their eigenvectors.
+  // Returns the number of eigenvalues found.
+
+
+ // c.3) Functions that provide access to the results.
+
+  int GetN() const { return n; }
+  // Returns the dimension of the problem.
+
+  int SliceSize() const { return nslice; }
+  // Returns the desired number of eigenvalues per slice.
+
+  int Threads() const { return nthreads; }
+  // Returns the number of threads requested.
+
+  int GetSlices() const { return SlicesOK ? (int)bound.size()-1 : 0; }
+  // Returns the number of slices.
+
+  ARFLOAT SliceBound(int i) const;
+  // Returns the lower bound of slice i (or the upper bound of the
+  // interval if i == GetSlices()).
+
+  int ExpectedEigenvalues() const;
+  // Returns the number of eigenvalues in the interval, as given by the
+  // inertia of A - lower*B and A - upper*B.
+
+  int ConvergedEigenvalues() const { return nconv; }
+  // Returns the number of eigenvalues found. It is smaller than
+  // ExpectedEigenvalues() if some slice did not converge.
+
+  ARFLOAT Eigenvalue(int i) const;
+  // Returns the i-th eigenvalue (in ascending order).
+
+  ARFLOAT Eigenvector(int i, int j) const;
+  // Returns element j of the i-th eigenvector.
+
+  const ARFLOAT* RawEigenvalues() const;
+  // Returns a pointer to the eigenvalues.
+
+  const ARFLOAT* RawEigenvector(int i) const;
+  // Returns a pointer to the i-th eigenvector.
+
+
+ // c.4) Constructors and destructor.
+
+  ARSliceSymGenEig(): pencil(NULL), n(0), lower(0), upper(0), nslice(100),
+                      nthreads(0), native(false), tol(0), maxit(0),
+                      SlicesOK(false), VectorsOK(false), nconv(0) { }
+  // Short constructor.
+
+  ARSliceSymGenEig(int np, ARPENCIL& Pencilp, ARFLOAT lowerp,
+                   ARFLOAT upperp, int nslicep = 100, int nthreadsp = 0);
+  // Long constructor.
+
+  virtual ~ARSliceSymGenEig() { }
+  // Destructor.
+
+}; // class ARSliceSymGenEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARSliceSymGenEig member functions definition.                            //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT, class ARPENCIL>
+int ARSliceSymGenEig<ARFLOAT, ARPENCIL>::Count(ARPENCIL& P, ARFLOAT sigma)
+{
+
+  ARFLOAT step = ARFLOAT(100)*std::numeric_limits<ARFLOAT>::epsilon()*
+                 std::max(std::abs(sigma), ARFLOAT(1));
+
+  for (int i = 0; ; i++, sigma -= step, step *= ARFLOAT(10)) {
+    try {
+      return P.CountEigenvaluesBelow(sigma);
+    }
+    catch (ArpackError&) {
+      if (i == 4) throw;
+    }
+  }
+
+} // Count.
+
+
+template<class ARFLOAT, class ARPENCIL>
+void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::Factor(ARPENCIL& P, ARFLOAT& sigma)
+{
+
+  ARFLOAT step = ARFLOAT(100)*std::numeric_limits<ARFLOAT>::epsilon()*
+                 std::max(std::abs(sigma), ARFLOAT(1));
+
+  for (int i = 0; ; i++, sigma -= step, step *= ARFLOAT(10)) {
+    try {
+      P.FactorAsB(sigma);
+      return;
+    }
+    catch (ArpackError&) {
+      if (i == 4) throw;
+    }
+  }
+
+} // Factor.
+
+
+template<class ARFLOAT, class ARPENCIL>
+int ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+Bisect(ARPENCIL& P, int target, ARFLOAT& sigma)
+{
+
+  ARFLOAT lo, hi, s, gap;
+  int     ns, maxdev, best;
+
+  std::vector<ARFLOAT> tried;
+  std::vector<int>     count;
+
+  lo  = bound.front();
+  hi  = bound.back();
+
+  // The count may be off by nslice/8, so that the bisection does not
+  // go on to separate eigenvalues that are very close to each other.
+  // Eigenvalues closer than gap are not separated at all.
+
+  maxdev = nslice/8;
+  gap    = std::sqrt(std::numeric_limits<ARFLOAT>::epsilon())*(hi-lo);
+
+  while ((hi-lo) > gap) {
+
+    s  = lo + (hi-lo)/ARFLOAT(2);
+    ns = Count(P, s);
+
+    if (std::abs(ns-target) <= maxdev) {
+      sigma = s;
+      return ns;
+    }
+    tried.push_back(s);
+    count.push_back(ns);
+    if (ns < target) lo = s; else hi = s;
+
+  }
+
+  // A cluster of eigenvalues could not be split. A shift close to it
+  // would be a poor slice boundary, so the best of the shifts tried
+  // at least gap away from the cluster is returned, or -1 if there is
+  // none.
+
+  best = -1;
+  for (size_t k = 0; k < tried.size(); k++) {
+    if ((tried[k] > lo) && (tried[k] < hi+gap)) continue;
+    if ((tried[k] < hi) && (tried[k] > lo-gap)) continue;
+    if ((best < 0) ||
+        (std::abs(count[k]-target) < std::abs(count[best]-target))) {
+      best = (int)k;
+    }
+  }
+  if (best < 0) return -1;
+
+  sigma = tried[best];
+  return count[best];
+
+} // Bisect.
+
+
+template<class ARFLOAT, class ARPENCIL>
+void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+SolveSlice(ARPENCIL& P, int i, std::vector<ARFLOAT>& val,
+           std::vector<ARFLOAT>& vec)
+{
+
+  ARFLOAT lo, hi, sigma, delta;
+  int     count, nev, nfound, added, j, k;
+
+  val.clear();
+  vec.clear();
+
+  count = below[i+1]-below[i];
+  if (count == 0) return;
+
+  lo    = bound[i];
+  hi    = bound[i+1];
+  sigma = lo + (hi-lo)/ARFLOAT(2);
+
+  Factor(P, sigma);
+
+  // Eigenvalues too far from the slice are discarded, in case the
+  // problem did not converge.
+
+  delta = Overlap(i);
+  if (i > 0) lo -= delta;
+  if (i < GetSlices()-1) hi += delta;
+
+  // A single Lanczos run may find only some of the copies of a
+  // multiple eigenvalue. While fewer than count eigenpairs were found,
+  // the problem is solved again with the pairs already found deflated
+  // (see Deflation), until a run adds no new pair. A few more
+  // eigenvalues than those missing are requested, so the ones near the
+  // boundaries converge as fast as the others.
+
+  std::vector<ARFLOAT> BX, By(n);
+  Deflation            D;
+
+  D.P = &P;
+  D.n = n;
+
+  do {
+
+    nfound = (int)val.size();
+    nev    = count-nfound;
+    nev    = std::min(nev + std::max(2, nev/10), n-1-nfound);
+    if (nev < 1) break;
+
+    D.k  = nfound;
+    D.X  = vec.data();
+    D.BX = BX.data();
+
+    ARSymGenEig<ARFLOAT, Deflation, Deflation>
+      prob('S', n, nev, &D, &Deflation::MultInvAsBv, &D, &Deflation::MultBv,
+           sigma, "LM", 0, tol, maxit);
+
+    if (native) prob.SetNativeBackend(true, 1);
+
+    prob.FindEigenvectors();
+
+    // Adding the new pairs inside [lo, hi), nearest to sigma first.
+    // Vectors that are not B-orthogonal to a pair already found are
+    // copies of it (the deflation is not exact) and are skipped.
+
+    std::vector<int> idx;
+    for (j = 0; j < prob.ConvergedEigenvalues(); j++) {
+      ARFLOAT lambda = prob.Eigenvalue(j);
+      if ((lambda >= lo) && (lambda < hi)) idx.push_back(j);
+    }
+
+    std::stable_sort(idx.begin(), idx.end(), [&](int x, int y) {
+      return std::abs(prob.Eigenvalue(x)-sigma) <
+             std::abs(prob.Eigenvalue(y)-sigma);
+    });
+
+    added = 0;
+    for (j = 0; j < (int)idx.size(); j++) {
+      ARFLOAT* y = prob.RawEigenvector(idx[j]);
+      P.MultBv(y, &By[0]);
+      for (k = 0; k < (int)val.size(); k++) {
+        if (std::abs(dot(n, &vec[(size_t)k*n], 1, &By[0], 1)) > ARFLOAT(0.5)) {
+          break;
+        }
+      }
+      if (k < (int)val.size()) continue;
+      val.push_back(prob.Eigenvalue(idx[j]));
+      vec.insert(vec.end(), y, y+n);
+      BX.insert(BX.end(), By.begin(), By.end());
+      added++;
+    }
+
+  } while ((added > 0) && ((int)val.size() < count));
+
+  // The count eigenvalues of the slice are the ones closest to sigma,
+  // so they are selected even if some of them were computed slightly
+  // outside of the slice.
+
+  nfound = (int)val.size();
+  if (nfound <= count) return;
+
+  std::vector<int> idx(nfound);
+  for (j = 0; j < nfound; j++) idx[j] = j;
+
+  std::stable_sort(idx.begin(), idx.end(), [&](int x, int y) {
+    return std::abs(val[x]-sigma) < std::abs(val[y]-sigma);
+  });
+
+  std::vector<ARFLOAT> sval(count), svec((size_t)count*n);
+  for (j = 0; j < count; j++) {
+    sval[j] = val[idx[j]];
+    std::copy(&vec[(size_t)idx[j]*n], &vec[(size_t)idx[j]*n]+n,
+              &svec[(size_t)j*n]);
+  }
+  val.swap(sval);
+  vec.swap(svec);
+
+} // SolveSlice.
+
+
+template<class ARFLOAT, class ARPENCIL>
+void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+RemoveDuplicates(std::vector<Pair>& pairs)
+{
+
+  std::vector<Pair>    kept;
+  std::vector<ARFLOAT> Bx(n);
+  size_t               j, k;
+
+  // Two eigenpairs found in different slices are the same if their
+  // eigenvalues are close and their eigenvectors are not B-orthogonal.
+  // The one that was found inside its own slice is kept.
+
+  for (j = 0; j < pairs.size(); j++) {
+
+    bool dup  = false;
+    bool Bxok = false;
+
+    for (k = kept.size(); k-- > 0; ) {
+
+      Pair&   p     = kept[k];
+      ARFLOAT delta = std::max(Overlap(p.slice), Overlap(pairs[j].slice));
+
+      if ((pairs[j].value - p.value) > ARFLOAT(2)*delta) break;
+      if (p.slice == pairs[j].slice) continue;
+
+      if (!Bxok) {
+        pencil->MultBv(pairs[j].vector, &Bx[0]);
+        Bxok = true;
+      }
+      if (std::abs(dot(n, p.vector, 1, &Bx[0], 1)) > ARFLOAT(0.5)) {
+        if (pairs[j].inside && !p.inside) p = pairs[j];
+        dup = true;
+        break;
+      }
+
+    }
+
+    if (!dup) kept.push_back(pairs[j]);
+
+  }
+
+  std::stable_sort(kept.begin(), kept.end(),
+                   [](const Pair& x, const Pair& y) { return x.value < y.value; });
+  pairs.swap(kept);
+
+} // RemoveDuplicates.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+DefineParameters(int np, ARPENCIL& Pencilp, ARFLOAT lowerp, ARFLOAT upperp,
+                 int nslicep, int nthreadsp)
+{
+
+  if (np < 2) {
+    throw ArpackError(ArpackError::N_SMALLER_THAN_2);
+  }
+
+  n        = np;
+  pencil   = &Pencilp;
+  nthreads = nthreadsp;
+  SetSliceSize(nslicep);
+  ChangeInterval(lowerp, upperp);
+
+} // DefineParameters.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+ChangeInterval(ARFLOAT lowerp, ARFLOAT upperp)
+{
+
+  if (!(lowerp < upperp)) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "ChangeInterval");
+  }
+
+  lower     = lowerp;
+  upper     = upperp;
+  SlicesOK  = false;
+  VectorsOK = false;
+  nconv     = 0;
+
+} // ChangeInterval.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::SetSliceSize(int nslicep)
+{
+
+  if (nslicep < 1) {
+    throw ArpackError(ArpackError::PARAMETER_ERROR, "SetSliceSize");
+  }
+
+  nslice    = nslicep;
+  SlicesOK  = false;
+  VectorsOK = false;
+  nconv     = 0;
+
+} // SetSliceSize.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::SetThreads(int nthreadsp)
+{
+
+  nthreads = nthreadsp;
+
+} // SetThreads.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+SetNativeBackend(bool nativep)
+{
+
+  native = nativep;
+
+} // SetNativeBackend.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::ChangeTol(ARFLOAT tolp)
+{
+
+  tol = tolp;
+
+} // ChangeTol.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline void ARSliceSymGenEig<ARFLOAT, ARPENCIL>::ChangeMaxit(int maxitp)
+{
+
+  maxit = maxitp;
+
+} // ChangeMaxit.
+
+
+template<class ARFLOAT, class ARPENCIL>
+int ARSliceSymGenEig<ARFLOAT, ARPENCIL>::FindSlices()
+{
+
+  int m, ns, nt;
+
+  if (pencil == NULL) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "FindSlices");
+  }
+
+  // Counting the eigenvalues below lower and upper.
+
+  nt = std::min(ARThreadCount(nthreads), 2);
+  std::vector<ARPENCIL> P(nt, *pencil);
+
+  bound.assign(2, lower);
+  bound[1] = upper;
+  below.assign(2, 0);
+
+  ARParallelTasks(2, nt, [&](int t, int k) {
+    below[k] = Count(P[t], bound[k]);
+  });
+
+  m = below[1]-below[0];
+  if (m < 0) {
+    throw ArpackError(ArpackError::INCONSISTENT_DATA, "FindSlices");
+  }
+
+  // Looking for the bounds of the slices, which must hold about m/ns
+  // eigenvalues each.
+
+  ns = (m+nslice-1)/nslice;
+
+  if (ns > 1) {
+
+    std::vector<ARFLOAT> sigma(ns-1);
+    std::vector<int>     count(ns-1);
+
+    nt = std::min(ARThreadCount(nthreads), ns-1);
+    P.resize(nt, *pencil);
+
+    ARParallelTasks(ns-1, nt, [&](int t, int k) {
+      int target = below[0] + (int)(((long long)m*(k+1))/ns);
+      count[k] = Bisect(P[t], target, sigma[k]);
+    });
+
+    // Discarding empty slices (if a cluster could not be split).
+
+    bound.resize(1);
+    below.resize(1);
+    for (int k = 0; k < ns-1; k++) {
+      if ((count[k] > below.back()) && (sigma[k] > bound.back())) {
+        bound.push_back(sigma[k]);
+        below.push_back(count[k]);
+      }
+    }
+    bound.push_back(upper);
+    below.push_back(below[0]+m);
+
+  }
+
+  SlicesOK  = true;
+  VectorsOK = false;
+  nconv     = 0;
+
+  return GetSlices();
+
+} // FindSlices.
+
+
+template<class ARFLOAT, class ARPENCIL>
+int ARSliceSymGenEig<ARFLOAT, ARPENCIL>::FindEigenvectors()
+{
+
+  int ns, nt, i;
+
+  if (!SlicesOK) FindSlices();
+
+  // Solving one problem per slice. Each thread factors A - sigma*B
+  // on its own copy of the pencil.
+
+  ns = GetSlices();
+  nt = native ? std::min(ARThreadCount(nthreads), ns) : 1;
+
+  std::vector<ARPENCIL>              P(std::max(nt, 1), *pencil);
+  std::vector<std::vector<ARFLOAT> > val(ns), vec(ns);
+
+  ARParallelTasks(ns, nt, [&](int t, int k) {
+    SolveSlice(P[t], k, val[k], vec[k]);
+  });
+
+  // Merging the slices.
+
+  std::vector<Pair> pairs;
+
+  for (i = 0; i < ns; i++) {
+    for (size_t j = 0; j < val[i].size(); j++) {
+      Pair p;
+      p.value  = val[i][j];
+      p.vector = &vec[i][j*n];
+      p.slice  = i;
+      p.inside = (p.value >= bound[i]) && (p.value < bound[i+1]);
+      pairs.push_back(p);
+    }
+  }
+
+  std::stable_sort(pairs.begin(), pairs.end(),
+                   [](const Pair& x, const Pair& y) { return x.value < y.value; });
+
+  RemoveDuplicates(pairs);
+
+  // Storing the eigenpairs in ascending order.
+
+  nconv = (int)pairs.size();
+  EigVal.resize(nconv);
+  EigVec.resize((size_t)nconv*n);
+
+  for (i = 0; i < nconv; i++) {
+    EigVal[i] = pairs[i].value;
+    std::copy(pairs[i].vector, pairs[i].vector+n, &EigVec[(size_t)i*n]);
+  }
+
+  VectorsOK = true;
+
+  return nconv;
+
+} // FindEigenvectors.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline ARFLOAT ARSliceSymGenEig<ARFLOAT, ARPENCIL>::SliceBound(int i) const
+{
+
+  if (!SlicesOK) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "SliceBound(i)");
+  }
+  else if ((i<0)||(i>GetSlices())) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "SliceBound(i)");
+  }
+  return bound[i];
+
+} // SliceBound(i).
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline int ARSliceSymGenEig<ARFLOAT, ARPENCIL>::ExpectedEigenvalues() const
+{
+
+  if (!SlicesOK) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ExpectedEigenvalues");
+  }
+  return below.back()-below.front();
+
+} // ExpectedEigenvalues.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline ARFLOAT ARSliceSymGenEig<ARFLOAT, ARPENCIL>::Eigenvalue(int i) const
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "Eigenvalue(i)");
+  }
+  else if ((i>=nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "Eigenvalue(i)");
+  }
+  return EigVal[i];
+
+} // Eigenvalue(i).
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline ARFLOAT ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+Eigenvector(int i, int j) const
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "Eigenvector(i,j)");
+  }
+  else if ((i>=nconv)||(i<0)||(j>=n)||(j<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "Eigenvector(i,j)");
+  }
+  return EigVec[(size_t)i*n+j];
+
+} // Eigenvector(i,j).
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline const ARFLOAT* ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+RawEigenvalues() const
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VALUES_NOT_OK, "RawEigenvalues");
+  }
+  return nconv ? &EigVal[0] : NULL;
+
+} // RawEigenvalues.
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline const ARFLOAT* ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+RawEigenvector(int i) const
+{
+
+  if (!VectorsOK) {
+    throw ArpackError(ArpackError::VECTORS_NOT_OK, "RawEigenvector(i)");
+  }
+  else if ((i>=nconv)||(i<0)) {
+    throw ArpackError(ArpackError::RANGE_ERROR, "RawEigenvector(i)");
+  }
+  return &EigVec[(size_t)i*n];
+
+} // RawEigenvector(i).
+
+
+template<class ARFLOAT, class ARPENCIL>
+inline ARSliceSymGenEig<ARFLOAT, ARPENCIL>::
+ARSliceSymGenEig(int np, ARPENCIL& Pencilp, ARFLOAT lowerp, ARFLOAT upperp,
+                 int nslicep, int nthreadsp)
+  : native(false), tol(0), maxit(0)
+{
+
+  DefineParameters(np, Pencilp, lowerp, upperp, nslicep, nthreadsp);
+
+} // Long constructor.
+
+
+#endif // ARSSLICE_H
@@ -0,0 +1,339 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE arsymmv.h
+   Product of a symmetric matrix stored by half in compressed
+   column format and a vector. Used by ARchSymMatrix, ARumSymMatrix
+   and ARluSymMatrix.
+
+   When the compiler targets AVX2 or AVX-512 (e.g. -mavx2 -mfma or
+   -march=native), the float and double versions use gather (and,
+   with AVX-512, scatter) instructions. Otherwise a portable unrolled
+   loop is used.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARSYMMV_H
+#define ARSYMMV_H
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+
+/* SymCSCColumn */
+
+template<class ARINT, class ARVAL, class ARTYPE>
+inline ARTYPE SymCSCColumn(ARINT len, const ARINT* ri, const ARVAL* rx,
+                           ARTYPE t, const ARTYPE* v, ARTYPE* w)
+// Processes the off-diagonal part of one column j of a symmetric
+// matrix: w[ri[q]] += rx[q]*t for q = 0, ..., len-1, and returns
+// the sum of rx[q]*v[ri[q]], which is the contribution of the
+// (mirrored) row j. The row indices must be distinct and differ
+// from j. The values may be stored in a lower precision than v and
+// w (ARVAL), in which case they are widened before each product.
+{
+
+  ARTYPE s0 = (ARTYPE)0, s1 = (ARTYPE)0, s2 = (ARTYPE)0, s3 = (ARTYPE)0;
+  ARINT  q  = 0;
+
+  for (; q + 4 <= len; q += 4) {
+    ARTYPE a0 = (ARTYPE)rx[q],   a1 = (ARTYPE)rx[q+1];
+    ARTYPE a2 = (ARTYPE)rx[q+2], a3 = (ARTYPE)rx[q+3];
+    s0 += a0*v[ri[q]];
+    s1 += a1*v[ri[q+1]];
+    s2 += a2*v[ri[q+2]];
+    s3 += a3*v[ri[q+3]];
+    w[ri[q]]   += a0*t;
+    w[ri[q+1]] += a1*t;
+    w[ri[q+2]] += a2*t;
+    w[ri[q+3]] += a3*t;
+  }
+  for (; q < len; q++) {
+    ARTYPE a = (ARTYPE)rx[q];
+    s0 += a*v[ri[q]];
+    w[ri[q]] += a*t;
+  }
+
+  return (s0 + s1) + (s2 + s3);
+
+} // SymCSCColumn.
+
+
+#if defined(__AVX512F__)
+
+inline double SymCSCColumn(int len, const int* ri, const double* rx,
+                           double t, const double* v, double* w)
+// AVX-512 version. Row indices of a column are distinct, so the
+// scattered update of w has no conflicts.
+{
+
+  __m512d acc = _mm512_setzero_pd();
+  __m512d tv  = _mm512_set1_pd(t);
+  int     q   = 0;
+
+  for (; q + 8 <= len; q += 8) {
+    __m256i idx = _mm256_loadu_si256((const __m256i*)(ri + q));
+    __m512d a   = _mm512_loadu_pd(rx + q);
+    __m512d x   = _mm512_i32gather_pd(idx, v, 8);
+    __m512d y   = _mm512_i32gather_pd(idx, w, 8);
+    acc = _mm512_fmadd_pd(a, x, acc);
+    y   = _mm512_fmadd_pd(a, tv, y);
+    _mm512_i32scatter_pd(w, idx, y, 8);
+  }
+
+  double s = _mm512_reduce_add_pd(acc);
+
+  for (; q < len; q++) {
+    s += rx[q]*v[ri[q]];
+    w[ri[q]] += rx[q]*t;
+  }
+
+  return s;
+
+} // SymCSCColumn (double, AVX-512).
+
+
+inline float SymCSCColumn(int len, const int* ri, const float* rx,
+                          float t, const float* v, float* w)
+// AVX-512 version (single precision).
+{
+
+  __m512 acc = _mm512_setzero_ps();
+  __m512 tv  = _mm512_set1_ps(t);
+  int    q   = 0;
+
+  for (; q + 16 <= len; q += 16) {
+    __m512i idx = _mm512_loadu_si512((const void*)(ri + q));
+    __m512  a   = _mm512_loadu_ps(rx + q);
+    __m512  x   = _mm512_i32gather_ps(idx, v, 4);
+    __m512  y   = _mm512_i32gather_ps(idx, w, 4);
+    acc = _mm512_fmadd_ps(a, x, acc);
+    y   = _mm512_fmadd_ps(a, tv, y);
+    _mm512_i32scatter_ps(w, idx, y, 4);
+  }
+
+  float s = _mm512_reduce_add_ps(acc);
+
+  for (; q < len; q++) {
+    s += rx[q]*v[ri[q]];
+    w[ri[q]] += rx[q]*t;
+  }
+
+  return s;
+
+} // SymCSCColumn (float, AVX-512).
+
+
+inline double SymCSCColumn(int len, const int* ri, const float* rx,
+                           double t, const double* v, double* w)
+// AVX-512 version (values in single precision, sums in double).
+{
+
+  __m512d acc = _mm512_setzero_pd();
+  __m512d tv  = _mm512_set1_pd(t);
+  int     q   = 0;
+
+  for (; q + 8 <= len; q += 8) {
+    __m256i idx = _mm256_loadu_si256((const __m256i*)(ri + q));
+    __m512d a   = _mm512_cvtps_pd(_mm256_loadu_ps(rx + q));
+    __m512d x   = _mm512_i32gather_pd(idx, v, 8);
+    __m512d y   = _mm512_i32gather_pd(idx, w, 8);
+    acc = _mm512_fmadd_pd(a, x, acc);
+    y   = _mm512_fmadd_pd(a, tv, y);
+    _mm512_i32scatter_pd(w, idx, y, 8);
+  }
+
+  double s = _mm512_reduce_add_pd(acc);
+
+  for (; q < len; q++) {
+    s += (double)rx[q]*v[ri[q]];
+    w[ri[q]] += (double)rx[q]*t;
+  }
+
+  return s;
+
+} // SymCSCColumn (mixed, AVX-512).
+
+#elif defined(__AVX2__)
+
+inline double SymCSCColumn(int len, const int* ri, const double* rx,
+                           double t, const double* v, double* w)
+// AVX2 version. The dot product with v uses gathers; AVX2 has no
+// scatter, so w is updated element by element.
+{
+
+  __m256d acc = _mm256_setzero_pd();
+  int     q   = 0;
+
+  for (; q + 4 <= len; q += 4) {
+    __m128i idx = _mm_loadu_si128((const __m128i*)(ri + q));
+    __m256d a   = _mm256_loadu_pd(rx + q);
+    __m256d x   = _mm256_i32gather_pd(v, idx, 8);
+#if defined(__FMA__)
+    acc = _mm256_fmadd_pd(a, x, acc);
+#else
+    acc = _mm256_add_pd(acc, _mm256_mul_pd(a, x));
+#endif
+    w[ri[q]]   += rx[q]*t;
+    w[ri[q+1]] += rx[q+1]*t;
+    w[ri[q+2]] += rx[q+2]*t;
+    w[ri[q+3]] += rx[q+3]*t;
+  }
+
+  __m128d h = _mm_add_pd(_mm256_castpd256_pd128(acc),
+                         _mm256_extractf128_pd(acc, 1));
+  double  s = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+
+  for (; q < len; q++) {
+    s += rx[q]*v[ri[q]];
+    w[ri[q]] += rx[q]*t;
+  }
+
+  return s;
+
+} // SymCSCColumn (double, AVX2).
+
+
+inline float SymCSCColumn(int len, const int* ri, const float* rx,
+                          float t, const float* v, float* w)
+// AVX2 version (single precision).
+{
+
+  __m256 acc = _mm256_setzero_ps();
+  int    q   = 0;
+
+  for (; q + 8 <= len; q += 8) {
+    __m256i idx = _mm256_loadu_si256((const __m256i*)(ri + q));
+    __m256  a   = _mm256_loadu_ps(rx + q);
+    __m256  x   = _mm256_i32gather_ps(v, idx, 4);
+#if defined(__FMA__)
+    acc = _mm256_fmadd_ps(a, x, acc);
+#else
+    acc = _mm256_add_ps(acc, _mm256_mul_ps(a, x));
+#endif
+    for (int k = 0; k < 8; k++) w[ri[q+k]] += rx[q+k]*t;
+  }
+
+  __m128 h = _mm_add_ps(_mm256_castps256_ps128(acc),
+                        _mm256_extractf128_ps(acc, 1));
+  h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+  h = _mm_add_ss(h, _mm_shuffle_ps(h, h, 1));
+  float s = _mm_cvtss_f32(h);
+
+  for (; q < len; q++) {
+    s += rx[q]*v[ri[q]];
+    w[ri[q]] += rx[q]*t;
+  }
+
+  return s;
+
+} // SymCSCColumn (float, AVX2).
+
+
+inline double SymCSCColumn(int len, const int* ri, const float* rx,
+                           double t, const double* v, double* w)
+// AVX2 version (values in single precision, sums in double).
+{
+
+  __m256d acc = _mm256_setzero_pd();
+  int     q   = 0;
+
+  for (; q + 4 <= len; q += 4) {
+    __m128i idx = _mm_loadu_si128((const __m128i*)(ri + q));
+    __m256d a   = _mm256_cvtps_pd(_mm_loadu_ps(rx + q));
+    __m256d x   = _mm256_i32gather_pd(v, idx, 8);
+#if defined(__FMA__)
+    acc = _mm256_fmadd_pd(a, x, acc);
+#else
+    acc = _mm256_add_pd(acc, _mm256_mul_pd(a, x));
+#endif
+    w[ri[q]]   += (double)rx[q]*t;
+    w[ri[q+1]] += (double)rx[q+1]*t;
+    w[ri[q+2]] += (double)rx[q+2]*t;
+    w[ri[q+3]] += (double)rx[q+3]*t;
+  }
+
+  __m128d h = _mm_add_pd(_mm256_castpd256_pd128(acc),
+                         _mm256_extractf128_pd(acc, 1));
+  double  s = _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+
+  for (; q < len; q++) {
+    s += (double)rx[q]*v[ri[q]];
+    w[ri[q]] += (double)rx[q]*t;
+  }
+
+  return s;
+
+} // SymCSCColumn (mixed, AVX2).
+
+#endif
+
+
+/* SymCSCMultMv */
+
+template<class ARINT, class ARVAL, class ARTYPE>
+inline void SymCSCMultMv(int n, const ARINT* ap, const ARINT* ai,
+                         const ARVAL* ax, char uplo,
+                         const ARTYPE* v, ARTYPE* w)
+// Computes w = A*v, where only the lower (uplo = 'L') or upper
+// (uplo = 'U') triangle of the symmetric matrix A is stored in
+// compressed column format (ap, ai, ax). Row indices must be sorted
+// inside each column, so the diagonal entry, if present, is the first
+// ('L') or last ('U') entry of its column. For any other value of
+// uplo, A is treated as a general square matrix. ARINT may be int or
+// a 64-bit integer (the SIMD versions are only used with int indices).
+// ax may hold the values in a lower precision than v and w (see
+// ARumSymMatrix::CompressMultMv); the sums are computed in ARTYPE.
+{
+
+  int   i, j;
+  ARINT p0, p1;
+
+  for (i = 0; i < n; i++) w[i] = (ARTYPE)0;
+
+  if (uplo != 'L' && uplo != 'U') {
+    for (j = 0; j < n; j++) {
+      ARTYPE t = v[j];
+      for (p0 = ap[j]; p0 < ap[j+1]; p0++) w[ai[p0]] += (ARTYPE)ax[p0]*t;
+    }
+    return;
+  }
+
+  for (j = 0; j < n; j++) {
+
+    ARTYPE t = v[j];
+    ARTYPE d = (ARTYPE)0;
+
+    p0 = ap[j];
+    p1 = ap[j+1];
+
+    // Removing the diagonal entry from the column.
+
+    if (p0 < p1) {
+      if (uplo == 'L' && ai[p0] == j) {
+        d = (ARTYPE)ax[p0]*t;
+        p0++;
+      }
+      else if (uplo == 'U' && ai[p1-1] == j) {
+        d = (ARTYPE)ax[p1-1]*t;
+        p1--;
+      }
+    }
+
+    w[j] += d + SymCSCColumn(p1 - p0, &ai[p0], &ax[p0], t, v, w);
+
+  }
+
+} // SymCSCMultMv.
+
+
+#endif // ARSYMMV_H
@@ -0,0 +1,259 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE arthread.h
+   Small helpers used to split loops among threads.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARTHREAD_H
+#define ARTHREAD_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* ARThreadCount */
+
+inline int ARThreadCount(int nthreads)
+// Returns the number of threads that should actually be used when
+// nthreads were requested. A value <= 0 means "all available cores".
+{
+  if (nthreads > 0) return nthreads;
+
+  int ncores = (int)std::thread::hardware_concurrency();
+  return (ncores > 0) ? ncores : 1;
+
+} // ARThreadCount.
+
+
+/* ARPartition */
+
+template<class INTTYPE>
+inline void ARPartition(int nparts, int n, const INTTYPE* ptr, int* bounds)
+// Splits the columns [0, n) of a CSC (or rows of a CSR) matrix with
+// pointer array ptr into nparts contiguous blocks with approximately
+// the same number of nonzeros. Block t spans [bounds[t], bounds[t+1]).
+// bounds must have room for nparts+1 entries. If ptr is null, the
+// blocks are simply chosen to have the same number of columns.
+{
+  bounds[0] = 0;
+
+  for (int t = 1; t < nparts; t++) {
+    if (ptr) {
+      double target = (double)ptr[n] * t / nparts;
+      int j = bounds[t-1];
+      while (j < n && (double)ptr[j] < target) j++;
+      bounds[t] = j;
+    }
+    else {
+      bounds[t] = (int)(((long long)n * t) / nparts);
+    }
+  }
+
+  bounds[nparts] = n;
+
+} // ARPartition.
+
+
+/* ARThreadPool */
+
+class ARThreadPool {
+// A set of worker threads that is created on first use and kept alive
+// until the program ends, so the parallel loops below do not pay for
+// creating and joining threads on every call (e.g. on every MultMv).
+
+ private:
+
+  struct Batch {
+    const std::function<void(int)>* f;       // Function being run.
+    int                             pending; // Calls not finished yet.
+    std::exception_ptr              error;   // First exception thrown.
+  };
+
+  struct Job {
+    Batch* batch;
+    int    k;
+  };
+
+  std::mutex               lock;
+  std::condition_variable  ready;    // Signaled when jobs are queued.
+  std::condition_variable  finished; // Signaled when a batch completes.
+  std::deque<Job>          queue;
+  std::vector<std::thread> workers;
+  bool                     stop;
+
+  void Execute(Job job, std::unique_lock<std::mutex>& guard)
+  // Runs one queued call with the lock released.
+  {
+    guard.unlock();
+    std::exception_ptr error;
+    try {
+      (*job.batch->f)(job.k);
+    }
+    catch (...) {
+      error = std::current_exception();
+    }
+    guard.lock();
+    if (error && !job.batch->error) job.batch->error = error;
+    if (--job.batch->pending == 0) finished.notify_all();
+  } // Execute.
+
+  void Worker()
+  // Main loop of the worker threads.
+  {
+    std::unique_lock<std::mutex> guard(lock);
+    for (;;) {
+      ready.wait(guard, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) return;
+      Job job = queue.front();
+      queue.pop_front();
+      Execute(job, guard);
+    }
+  } // Worker.
+
+  ARThreadPool(): stop(false) { }
+
+ public:
+
+  static ARThreadPool& Instance()
+  // Returns the pool shared by the whole program.
+  {
+    static ARThreadPool pool;
+    return pool;
+  } // Instance.
+
+  void Run(int ntasks, const std::function<void(int)>& f)
+  // Calls f(k) for k = 0, ..., ntasks-1 and waits for all of them.
+  // Call 0 runs on the calling thread, the others are queued for the
+  // workers. The pool grows to ntasks-1 workers if it is smaller. While
+  // waiting, the calling thread also runs the queued calls of its own
+  // batch (never those of other batches, which may be long outer calls),
+  // so Run may be used from inside f. The first exception thrown by f
+  // is rethrown.
+  {
+    if (ntasks <= 1) {
+      if (ntasks == 1) f(0);
+      return;
+    }
+
+    Batch batch;
+    batch.f       = &f;
+    batch.pending = ntasks;
+
+    std::unique_lock<std::mutex> guard(lock);
+    while ((int)workers.size() < ntasks-1) {
+      workers.emplace_back(&ARThreadPool::Worker, this);
+    }
+    for (int k = 1; k < ntasks; k++) queue.push_back(Job{&batch, k});
+    ready.notify_all();
+
+    Execute(Job{&batch, 0}, guard);
+
+    while (batch.pending > 0) {
+      std::deque<Job>::iterator it = queue.begin();
+      while ((it != queue.end()) && (it->batch != &batch)) ++it;
+      if (it != queue.end()) {
+        Job job = *it;
+        queue.erase(it);
+        Execute(job, guard);
+      }
+      else {
+        finished.wait(guard);
+      }
+    }
+    guard.unlock();
+
+    if (batch.error) std::rethrow_exception(batch.error);
+
+  } // Run.
+
+  ~ARThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stop = true;
+    }
+    ready.notify_all();
+    for (auto& w : workers) w.join();
+  } // Destructor.
+
+}; // class ARThreadPool.
+
+
+/* ARParallelFor */
+
+template<class FUNC>
+inline void ARParallelFor(int nparts, const int* bounds, FUNC f)
+// Calls f(t, bounds[t], bounds[t+1]) for t = 0, ..., nparts-1 on the
+// threads of ARThreadPool (call 0 runs on the calling thread). The blocks
+// are fixed by bounds, so results that depend only on the block layout
+// are reproducible from run to run.
+{
+  if (nparts <= 1) {
+    f(0, bounds[0], bounds[1]);
+    return;
+  }
+
+  ARThreadPool::Instance().Run(nparts, [&](int t) {
+    f(t, bounds[t], bounds[t+1]);
+  });
+
+} // ARParallelFor.
+
+
+/* ARParallelTasks */
+
+template<class FUNC>
+inline void ARParallelTasks(int ntasks, int nthreads, FUNC f)
+// Calls f(t, k) for k = 0, ..., ntasks-1 using ARThreadCount(nthreads)
+// threads of ARThreadPool at most (thread 0 is the calling thread). Each thread t takes
+// the next task that was not started yet, so tasks of very different
+// cost are balanced, and t may be used to select per-thread data. If a
+// call throws, no other task is started and the first exception is
+// rethrown once all threads have finished.
+{
+  nthreads = ARThreadCount(nthreads);
+  if (nthreads > ntasks) nthreads = ntasks;
+  if (nthreads < 1) return;
+
+  std::atomic<int>   next(0);
+  std::atomic<bool>  failed(false);
+  std::exception_ptr error;
+  std::mutex         lock;
+
+  auto worker = [&](int t) {
+    int k;
+    while (!failed && ((k = next++) < ntasks)) {
+      try {
+        f(t, k);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!error) error = std::current_exception();
+        failed = true;
+      }
+    }
+  };
+
+  ARThreadPool::Instance().Run(nthreads, worker);
+
+  if (error) std::rethrow_exception(error);
+
+} // ARParallelTasks.
+
+
+#endif // ARTHREAD_H
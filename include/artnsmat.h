@@ -0,0 +1,451 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARTNSMat.h.
+   Arpack++ class ARtdNonSymMatrix definition.
+
+   Tridiagonal matrix, given by its three diagonals. Products with A
+   and A' cost O(n), and A - sigma*I is factored in O(n) with gttrf
+   (L*U with partial pivoting). Only the factors are stored: 4*n
+   values and n pivots.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARTNSMAT_H
+#define ARTNSMAT_H
+
+#include <cstddef>
+#include "arch.h"
+#include "armat.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "lapackc.h"
+#include "arwork.h"
+
+
+template<class ARTYPE, class ARFLOAT>
+class ARtdNonSymMatrix: public ARMatrix<ARTYPE> {
+
+ protected:
+
+  bool     factored;
+  ARint    info;
+  ARint*   ipiv;
+  ARTYPE*  DL;          // Subdiagonal (n-1 entries).
+  ARTYPE*  D;           // Diagonal (n entries).
+  ARTYPE*  DU;          // Superdiagonal (n-1 entries).
+  ARTYPE*  Ainv;        // dl, d, du, du2 computed by gttrf.
+  ARWorkspace<ARTYPE> wgram;  // Used by MultMtMv and MultMMtv.
+
+  void ClearMem();
+
+  virtual void Copy(const ARtdNonSymMatrix& other);
+
+  void Factor(ARTYPE sigma);
+  // Factors A - sigma*I.
+
+  void Mult(const ARTYPE* lower, const ARTYPE* upper,
+            const ARTYPE* v, ARTYPE* w);
+  // w = T*v, where T has the diagonal D and the given sub and
+  // superdiagonals (DL and DU for A, DU and DL for A').
+
+  void ThrowError();
+
+ public:
+
+  bool IsFactored() { return factored; }
+
+  void FactorA();
+
+  void FactorAsI(ARTYPE sigma);
+
+  void MultMv(ARTYPE* v, ARTYPE* w);
+
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
+  void MultMtv(ARTYPE* v, ARTYPE* w);
+
+  void MultMtMv(ARTYPE* v, ARTYPE* w);
+
+  void MultMMtv(ARTYPE* v, ARTYPE* w);
+
+  void Mult0MMt0v(ARTYPE* v, ARTYPE* w);
+
+  void MultInvv(ARTYPE* v, ARTYPE* w);
+
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
+  void DefineMatrix(int np, ARTYPE* DLp, ARTYPE* Dp, ARTYPE* DUp);
+  // DLp, Dp and DUp hold the np-1 subdiagonal, np diagonal and np-1
+  // superdiagonal entries of A. The arrays are not copied.
+
+  ARtdNonSymMatrix(): ARMatrix<ARTYPE>()
+  {
+    factored = false;
+    Ainv     = NULL;
+    ipiv     = NULL;
+  }
+  // Short constructor that does nothing.
+
+  ARtdNonSymMatrix(int np, ARTYPE* DLp, ARTYPE* Dp, ARTYPE* DUp);
+  // Long constructor.
+
+  ARtdNonSymMatrix(const ARtdNonSymMatrix& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARtdNonSymMatrix() { ClearMem(); }
+  // Destructor.
+
+  ARtdNonSymMatrix& operator=(const ARtdNonSymMatrix& other);
+  // Assignment operator.
+
+};
+
+// ------------------------------------------------------------------------ //
+// ARtdNonSymMatrix member functions definition.                            //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE, class ARFLOAT>
+inline void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::ClearMem()
+{
+
+  delete[] Ainv;
+  delete[] ipiv;
+  Ainv     = NULL;
+  ipiv     = NULL;
+  factored = false;
+
+} // ClearMem.
+
+
+template<class ARTYPE, class ARFLOAT>
+inline void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+Copy(const ARtdNonSymMatrix<ARTYPE, ARFLOAT>& other)
+{
+
+  // Copying very fundamental variables and user-defined parameters.
+
+  this->m         = other.m;
+  this->n         = other.n;
+  this->defined   = other.defined;
+  factored  = other.factored;
+  info      = other.info;
+  DL        = other.DL;
+  D         = other.D;
+  DU        = other.DU;
+  Ainv      = NULL;
+  ipiv      = NULL;
+
+  // Returning from here if "other" was not factored.
+
+  if (!factored) return;
+
+  // Copying vectors.
+
+  Ainv = new ARTYPE[(size_t)4*this->n];
+  ipiv = new ARint[this->n];
+
+  for (size_t i=0; i<(size_t)4*this->n; i++) Ainv[i] = other.Ainv[i];
+  for (int i=0; i<this->n; i++) ipiv[i] = other.ipiv[i];
+
+} // Copy.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::Factor(ARTYPE sigma)
+{
+
+  int    i, n = this->n;
+  size_t sn = n;
+
+  // Reserving memory for the factors.
+
+  ClearMem();
+  Ainv = new ARTYPE[4*sn];
+  ipiv = new ARint[n];
+
+  // Copying A - sigma*I to Ainv.
+
+  copy(n-1, DL, 1, Ainv, 1);
+  for (i=0; i<n; i++) Ainv[sn+i] = D[i] - sigma;
+  copy(n-1, DU, 1, &Ainv[2*sn], 1);
+
+  // Decomposing it.
+
+  gttrf(n, Ainv, &Ainv[sn], &Ainv[2*sn], &Ainv[3*sn], ipiv, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+  factored = true;
+
+} // Factor.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+Mult(const ARTYPE* lower, const ARTYPE* upper, const ARTYPE* v, ARTYPE* w)
+{
+
+  int n = this->n;
+
+  if (n == 1) {
+    w[0] = D[0]*v[0];
+    return;
+  }
+
+  w[0] = D[0]*v[0] + upper[0]*v[1];
+  for (int i=1; i<n-1; i++) {
+    w[i] = lower[i-1]*v[i-1] + D[i]*v[i] + upper[i]*v[i+1];
+  }
+  w[n-1] = lower[n-2]*v[n-2] + D[n-1]*v[n-1];
+
+} // Mult.
+
+
+template<class ARTYPE, class ARFLOAT>
+inline void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::ThrowError()
+{
+
+  if (info < 0)  {   // Illegal argument.
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARtdNonSymMatrix::FactorA");
+  }
+  else if (info) {   // Matrix is singular.
+    throw ArpackError(ArpackError::MATRIX_IS_SINGULAR,
+                      "ARtdNonSymMatrix::FactorA");
+  }
+
+} // ThrowError.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARtdNonSymMatrix::FactorA");
+  }
+
+  // Decomposing A.
+
+  Factor((ARTYPE)0);
+
+} // FactorA.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARtdNonSymMatrix::FactorAsI");
+  }
+
+  // Decomposing AsI.
+
+  Factor(sigma);
+
+} // FactorAsI.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARtdNonSymMatrix::MultMv");
+  }
+
+  // Determining w = M.v.
+
+  Mult(DL, DU, v, w);
+
+} // MultMv.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARtdNonSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V one column at a time.
+
+  for (int r=0; r<k; r++) {
+    Mult(DL, DU, &V[(size_t)r*ldv], &W[(size_t)r*ldw]);
+  }
+
+} // MultMm.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARtdNonSymMatrix::MultMtv");
+  }
+
+  // Determining w = M'.v.
+
+  Mult(DU, DL, v, w);
+
+} // MultMtv.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
+{
+
+  ARTYPE* t = wgram.Get(this->m);
+
+  MultMv(v,t);
+  MultMtv(t,w);
+
+} // MultMtMv.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
+{
+
+  ARTYPE* t = wgram.Get(this->n);
+
+  MultMtv(v,t);
+  MultMv(t,w);
+
+} // MultMMtv.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::Mult0MMt0v(ARTYPE* v, ARTYPE* w)
+{
+
+  MultMv(&v[this->m],w);
+  MultMtv(v,&w[this->m]);
+
+} // Mult0MMt0v.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
+{
+
+  MultInvMm(1, v, this->n, w, this->n);
+
+} // MultInvv.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  size_t n = this->n;
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARtdNonSymMatrix::MultInvMm");
+  }
+
+  // Overwritting W with V.
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+
+  // Solving A.W = V (or AsI.W = V).
+
+  gttrs("N", this->n, k, Ainv, &Ainv[n], &Ainv[2*n], &Ainv[3*n],
+        ipiv, W, ldw, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvMm.
+
+
+template<class ARTYPE, class ARFLOAT>
+inline void ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+DefineMatrix(int np, ARTYPE* DLp, ARTYPE* Dp, ARTYPE* DUp)
+{
+
+  // Discarding the previous factorization.
+
+  ClearMem();
+
+  // Defining member variables.
+
+  this->m         = np;
+  this->n         = np;
+  DL        = DLp;
+  D         = Dp;
+  DU        = DUp;
+  this->defined   = true;
+  info      = 0;
+
+} // DefineMatrix.
+
+
+template<class ARTYPE, class ARFLOAT>
+inline ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+ARtdNonSymMatrix(int np, ARTYPE* DLp, ARTYPE* Dp,
+                 ARTYPE* DUp) : ARMatrix<ARTYPE>(np)
+{
+
+  factored = false;
+  Ainv     = NULL;
+  ipiv     = NULL;
+  DefineMatrix(np, DLp, Dp, DUp);
+
+} // Long constructor.
+
+
+template<class ARTYPE, class ARFLOAT>
+ARtdNonSymMatrix<ARTYPE, ARFLOAT>& ARtdNonSymMatrix<ARTYPE, ARFLOAT>::
+operator=(const ARtdNonSymMatrix<ARTYPE, ARFLOAT>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARTNSMAT_H
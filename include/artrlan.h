@@ -0,0 +1,851 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE artrlan.h.
+   Arpack++ class ARTRLanczos definition.
+
+   ARTRLanczos is a native C++ implementation of the thick-restart
+   Lanczos method (K. Wu and H. Simon) that can be used instead of the
+   FORTRAN subroutines dsaupd/dseupd (ssaupd/sseupd) by ARrcSymStdEig
+   and all the classes derived from it (see ARrcSymStdEig::
+   SetNativeBackend). Aupp and Eupp follow the calling sequence of saupp
+   and seupp: the same reverse communication flag ido, the same
+   pointers ipntr[1], ipntr[2] and ipntr[3] into workd, the same modes
+   (iparam[7] = 1, ..., 5) and the same output in iparam, resid, V and
+   info, so the drivers and the reverse communication interface work
+   without changes.
+
+   Differences with ARPACK:
+
+   - All the state of the method is kept in the object, so several
+     problems can be solved at the same time in different threads.
+   - The Lanczos vectors are fully reorthogonalized at every step by
+     classical Gram-Schmidt with one DGKS correction, as in dsaitr,
+     using BLAS 2 products on blocks of rows of V. The blocks are
+     spread among SetThreads() threads. The restart, V <- V*Q, is a
+     BLAS 3 product done in place by blocks of rows.
+   - The restart keeps the wanted Ritz vectors (exact shifts), plus
+     min(nconv, (ncv-nev)/2) more, as dsaup2 does. Shifts supplied by
+     the user (ido = 3) are not supported.
+   - With a block size iparam[4] = nb > 1 (standard problems only), a
+     block Lanczos method is used: OP is applied to nb vectors at each
+     step (x and y in workd are n x nb arrays), the whole block is
+     orthogonalized with BLAS 3 products, and eigenvalues of
+     multiplicity up to nb are found at once. Only the largest multiple
+     of nb not greater than ncv is used, and it must be at least
+     nev+2*nb. resid returns the first vector of the residual block.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARTRLAN_H
+#define ARTRLAN_H
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include "arch.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "lapackc.h"
+#include "arkrylov.h"
+
+
+template<class ARFLOAT>
+class ARTRLanczos {
+
+ protected:
+
+ // a) Protected variables:
+
+  enum State { START, NEWV, NEWV_OP, NEWV_BX, NEWV_ORTH, STEP, STEP_OP,
+               STEP_BX, STEP_ORTH, STEP_BX2, STEP_NORM, EXTEND, RESTART,
+               BLOCK_NEW, BLOCK_STEP, BLOCK_OP, DONE };
+
+  State   state;      // Where the reverse communication loop stopped.
+  ARint   n;          // Dimension of the problem.
+  ARint   m;          // Number of Lanczos vectors (ncv).
+  ARint   nb;         // Block size (vectors multiplied by OP at each step).
+  ARint   j;          // Index of the current Lanczos vector.
+  ARint   kept;       // Number of Ritz vectors kept after a restart.
+  ARint   nconv;      // Number of converged Ritz values.
+  int     ntry;       // Number of attempts to build a new vector.
+  int     npass;      // Gram-Schmidt passes done on a new vector.
+  bool    dgks;       // Indicates if the DGKS correction was done.
+  bool    genB;       // Indicates if B != I (bmat = 'G').
+  int     iter;       // Number of restarts (Lanczos iterations).
+  int     nopx;       // Number of OP*x products.
+  int     nbx;        // Number of B*x products.
+  int     nrorth;     // Number of DGKS corrections.
+  ARFLOAT rnorm;      // B-norm of the residual vector.
+  ARFLOAT wnorm;      // B-norm of r before the last orthogonalization.
+  unsigned long long seed; // State of the random number generator.
+
+  std::vector<ARFLOAT> T;     // m x m projected matrix.
+  std::vector<ARFLOAT> Y;     // Eigenvectors of T.
+  std::vector<ARFLOAT> theta; // Eigenvalues of T (ascending order).
+  std::vector<ARFLOAT> Q;     // Ritz vectors kept (m x kept).
+  std::vector<ARFLOAT> work;  // Workspace used by syev.
+  std::vector<ARFLOAT> r;     // Residual vector (n x nb block in block mode).
+  std::vector<ARFLOAT> E;     // Coupling of V to the residual (nb x m).
+  std::vector<ARFLOAT> G;     // E*Y (nb x m).
+  std::vector<ARFLOAT> br;    // B*r (only if B != I).
+  std::vector<ARFLOAT> bv;    // B*v(j) (only if B != I).
+  std::vector<int>     idx;   // Ritz values sorted from the most wanted.
+  std::vector<int>     conv;  // Converged Ritz values (in idx order).
+
+  ARKrylovBasis<ARFLOAT> basis; // Products with the Lanczos vectors.
+
+
+ // b) Protected functions:
+
+  ARFLOAT Random();
+  // Returns a random number uniformly distributed in (-1, 1).
+
+  void RandomVector();
+  // Fills r with random numbers.
+
+  const ARFLOAT* Br() const { return genB ? &br[0] : &r[0]; }
+  // B*r.
+
+  ARFLOAT Orthogonalize(const ARFLOAT* V, ARint ldv, ARint ncol)
+  {
+    basis.Orthogonalize(V, ldv, ncol, Br(), &r[0]);
+    return basis.Coefficients()[ncol-1];
+  }
+  // r <- r - V(:,0:ncol-1)*V(:,0:ncol-1)'*B*r. Returns the coefficient
+  // of v(ncol-1).
+
+  void RitzVectors(ARFLOAT* V, ARint ldv, ARint ncol)
+  {
+    basis.Rotate(V, ldv, ncol, &Q[0]);
+  }
+  // V(:,0:ncol-1) <- V(:,0:m-1)*Q, with Q stored as a m x ncol matrix.
+
+  void Sort(const std::string& which);
+  // Sorts the eigenvalues of T from the most wanted to the least wanted.
+
+  void NextVector(ARFLOAT* V, ARint ldv);
+  // v(j) <- r/rnorm (and B*v(j) <- B*r/rnorm).
+
+  bool BlockQR(const ARFLOAT* V, ARint ldv, ARint ncol, ARFLOAT R[]);
+  // Orthonormalizes the nb columns of the residual block r, which are
+  // already orthogonal to V(:,0:ncol-1), by Gram-Schmidt with one DGKS
+  // correction. The triangular factor is stored in R (nb x nb). A null
+  // column is replaced by a random vector orthogonal to V and to the
+  // other columns, with no coupling. Returns false if no such vector is
+  // found.
+
+  void Finish(ARint& ido, ARFLOAT resid[], ARint iparam[], ARint& info);
+  // Stores the output variables and sets ido = 99.
+
+
+ public:
+
+ // c) Public functions:
+
+  int Threads() const { return basis.Threads(); }
+
+  void SetThreads(int nthreadsp) { basis.SetThreads(nthreadsp); }
+  // Sets the number of threads used to reorthogonalize the Lanczos
+  // vectors (<= 0 means all available cores).
+
+  void Aupp(ARint& ido, char bmat, ARint np, const std::string& which,
+            ARint nev, ARFLOAT& tol, ARFLOAT resid[], ARint ncv,
+            ARFLOAT V[], ARint ldv, ARint iparam[], ARint ipntr[],
+            ARFLOAT workd[], ARint& info);
+  // Reverse communication interface of the thick-restart Lanczos
+  // method, with the same parameters as saupp (except workl).
+
+  void Eupp(bool rvec, char HowMny, ARFLOAT d[], ARFLOAT Z[], ARint ldz,
+            ARFLOAT sigma, char bmat, ARint np, const std::string& which,
+            ARint nev, ARFLOAT tol, ARFLOAT resid[], ARint ncv,
+            ARFLOAT V[], ARint ldv, ARint iparam[], ARint ipntr[],
+            ARFLOAT workd[], ARint& info);
+  // Computes the converged Ritz values and, if rvec is true, the Ritz
+  // vectors, with the same parameters as seupp (except workl). The
+  // Ritz values are transformed back to the eigenvalues of the original
+  // problem and returned in ascending order.
+
+  ARTRLanczos(): state(START), n(0), m(0), nb(1), j(0), kept(0),
+                 nconv(0), ntry(0), npass(0), dgks(false), genB(false),
+                 iter(0), nopx(0), nbx(0), nrorth(0),
+                 seed(0x2545F4914F6CDD1DULL) { }
+  // Constructor.
+
+}; // class ARTRLanczos.
+
+
+// ------------------------------------------------------------------------ //
+// ARTRLanczos member functions definition.                                 //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT>
+inline ARFLOAT ARTRLanczos<ARFLOAT>::Random()
+{
+
+  seed = seed*6364136223846793005ULL + 1442695040888963407ULL;
+  return ARFLOAT(2.0*(double)(seed >> 11)/9007199254740992.0 - 1.0);
+
+} // Random.
+
+
+template<class ARFLOAT>
+inline void ARTRLanczos<ARFLOAT>::RandomVector()
+{
+
+  for (ARint i=0; i<n; i++) r[i] = Random();
+
+} // RandomVector.
+
+
+template<class ARFLOAT>
+void ARTRLanczos<ARFLOAT>::Sort(const std::string& which)
+{
+
+  idx.resize(m);
+
+  if (which == "BE") {          // Alternating both ends, from the top.
+    int lo = 0, hi = m-1;
+    for (int i=0; i<m; i++) idx[i] = (i%2 == 0) ? hi-- : lo++;
+    return;
+  }
+
+  for (int i=0; i<m; i++) idx[i] = i;
+
+  const ARFLOAT* t = &theta[0];
+  if (which == "LA") {
+    std::reverse(idx.begin(), idx.end());
+  }
+  else if (which == "LM") {
+    std::stable_sort(idx.begin(), idx.end(), [t](int a, int b) {
+      return std::abs(t[a]) > std::abs(t[b]);
+    });
+  }
+  else if (which == "SM") {
+    std::stable_sort(idx.begin(), idx.end(), [t](int a, int b) {
+      return std::abs(t[a]) < std::abs(t[b]);
+    });
+  }
+
+} // Sort.
+
+
+template<class ARFLOAT>
+inline void ARTRLanczos<ARFLOAT>::NextVector(ARFLOAT* V, ARint ldv)
+{
+
+  ARFLOAT s = (ARFLOAT)1.0/rnorm;
+
+  scal(n, s, &r[0], 1);
+  copy(n, &r[0], 1, &V[(size_t)j*ldv], 1);
+  if (genB) {
+    scal(n, s, &br[0], 1);
+    copy(n, &br[0], 1, &bv[0], 1);
+  }
+
+} // NextVector.
+
+
+template<class ARFLOAT>
+bool ARTRLanczos<ARFLOAT>::
+BlockQR(const ARFLOAT* V, ARint ldv, ARint ncol, ARFLOAT R[])
+{
+
+  std::fill(R, R+(size_t)nb*nb, (ARFLOAT)0.0);
+
+  for (ARint c=0; c<nb; c++) {
+
+    ARFLOAT* rc = &r[(size_t)c*n];
+    ARFLOAT* hc = &R[(size_t)c*nb];
+    ARFLOAT  s0 = nrm2(n, rc, 1);
+    ARFLOAT  s1 = s0;
+
+    // Gram-Schmidt against the previous columns of the block.
+
+    if ((c > 0) && (s0 > (ARFLOAT)0.0)) {
+      basis.Orthogonalize(&r[0], n, c, rc, rc);
+      copy(c, basis.Coefficients(), 1, hc, 1);
+      s1 = nrm2(n, rc, 1);
+      if (s1 <= (ARFLOAT)0.717*s0) {
+        nrorth++;
+        basis.Orthogonalize(&r[0], n, c, rc, rc);
+        axpy(c, (ARFLOAT)1.0, basis.Coefficients(), 1, hc, 1);
+        ARFLOAT s2 = nrm2(n, rc, 1);
+        s1 = (s2 <= (ARFLOAT)0.717*s1) ? (ARFLOAT)0.0 : s2;
+      }
+    }
+
+    // Replacing a null column by a new direction.
+
+    if (s1 == (ARFLOAT)0.0) {
+      std::fill(hc, hc+nb, (ARFLOAT)0.0);
+      for (ntry=0; s1 == (ARFLOAT)0.0; ntry++) {
+        if (ntry >= 3) return false;
+        for (ARint i=0; i<n; i++) rc[i] = Random();
+        for (int pass=0; pass<2; pass++) {
+          if (ncol > 0) basis.Orthogonalize(V, ldv, ncol, rc, rc);
+          if (c > 0) basis.Orthogonalize(&r[0], n, c, rc, rc);
+        }
+        s1 = nrm2(n, rc, 1);
+      }
+    }
+    else {
+      hc[c] = s1;
+    }
+    ARFLOAT s = (ARFLOAT)1.0/s1;
+    scal(n, s, rc, 1);
+
+  }
+  return true;
+
+} // BlockQR.
+
+
+template<class ARFLOAT>
+void ARTRLanczos<ARFLOAT>::
+Finish(ARint& ido, ARFLOAT resid[], ARint iparam[], ARint& info)
+{
+
+  if (info >= 0) copy(n, &r[0], 1, resid, 1);  // Residual vector.
+
+  iparam[3]  = iter;
+  iparam[5]  = nconv;
+  iparam[9]  = nopx;
+  iparam[10] = nbx;
+  iparam[11] = nrorth;
+  ido        = 99;
+  state      = DONE;
+
+} // Finish.
+
+
+template<class ARFLOAT>
+void ARTRLanczos<ARFLOAT>::
+Aupp(ARint& ido, char bmat, ARint np, const std::string& which, ARint nev,
+     ARFLOAT& tol, ARFLOAT resid[], ARint ncv, ARFLOAT V[], ARint ldv,
+     ARint iparam[], ARint ipntr[], ARFLOAT workd[], ARint& info)
+{
+
+  const ARFLOAT eps   = std::numeric_limits<ARFLOAT>::epsilon();
+  const ARFLOAT eps23 = std::pow(eps, (ARFLOAT)2.0/(ARFLOAT)3.0);
+
+  ARFLOAT* v = &V[1];        // V and workd are 1-based, as in saupp.
+
+  if (ido == 0) {
+
+    // Checking parameters and allocating memory. In block mode only a
+    // multiple of nb Lanczos vectors is used.
+
+    nb = std::max(iparam[4], (ARint)1);
+    m  = nb*(ncv/nb);
+
+    if (np <= 0) { info = -1; ido = 99; return; }
+    if (nev <= 0) { info = -2; ido = 99; return; }
+    if ((ncv <= nev) || (ncv > np)) { info = -3; ido = 99; return; }
+    if ((nb > 1) && (m < nev+2*nb)) { info = -3; ido = 99; return; }
+    if ((iparam[7] < 1) || (iparam[7] > 5)) { info = -10; ido = 99; return; }
+    if ((iparam[7] == 1) && (bmat == 'G')) { info = -11; ido = 99; return; }
+    if ((nb > 1) && (bmat == 'G')) { info = -11; ido = 99; return; }
+
+    n    = np;
+    genB = (bmat == 'G');
+    if (tol <= (ARFLOAT)0.0) tol = eps;
+
+    T.assign((size_t)m*m, (ARFLOAT)0.0);
+    Y.resize((size_t)m*m);
+    Q.resize((size_t)m*m);
+    theta.resize(m);
+    work.resize(3*m);
+    r.resize((size_t)n*nb);
+    E.assign((size_t)nb*m, (ARFLOAT)0.0);
+    G.resize((size_t)nb*m);
+    br.resize(genB ? n : 0);
+    bv.resize(genB ? n : 0);
+    basis.Define(n, m, nb);
+
+    j = kept = nconv = 0;
+    iter = nopx = nbx = nrorth = 0;
+    ntry = npass = 0;
+
+    // Starting vector (the first one of the block in block mode).
+
+    if (info == 0) RandomVector();
+    else copy(n, resid, 1, &r[0], 1);
+    for (ARint i=n; i<(ARint)r.size(); i++) r[i] = Random();
+    info  = 0;
+    state = (nb == 1) ? NEWV : BLOCK_NEW;
+
+  }
+
+  ipntr[1] = 1;
+  ipntr[2] = nb*n+1;
+  ipntr[3] = 2*nb*n+1;
+
+  ARFLOAT* x = &workd[ipntr[1]];
+  ARFLOAT* y = &workd[ipntr[2]];
+  ARFLOAT* z = &workd[ipntr[3]];
+
+  for (;;) {
+
+    switch (state) {
+
+    case NEWV:
+
+      // Building v(j) from r. If B != I, r is first replaced by OP*B*r
+      // (to force the vector into the range of OP), as in dgetv0.
+
+      if (genB) {
+        copy(n, &r[0], 1, x, 1);
+        npass = 0;
+        state = NEWV_OP;
+        ido   = -1;
+        return;
+      }
+      npass = 0;
+      state = NEWV_ORTH;
+      break;
+
+    case NEWV_OP:
+
+      copy(n, y, 1, &r[0], 1);
+      nopx++;
+      copy(n, &r[0], 1, x, 1);
+      state = NEWV_BX;
+      ido   = 2;
+      return;
+
+    case NEWV_BX:
+
+      copy(n, y, 1, &br[0], 1);
+      nbx++;
+      state = NEWV_ORTH;
+      break;
+
+    case NEWV_ORTH:
+
+      // Two passes of Gram-Schmidt against v(0), ..., v(j-1).
+
+      if ((j > 0) && (npass < 2)) {
+        Orthogonalize(v, ldv, j);
+        npass++;
+        if (genB) {
+          copy(n, &r[0], 1, x, 1);
+          state = NEWV_BX;
+          ido   = 2;
+          return;
+        }
+        break;
+      }
+
+      rnorm = std::sqrt(std::abs(dot(n, &r[0], 1, Br(), 1)));
+
+      if (rnorm == (ARFLOAT)0.0) {
+        if (j == 0) {                       // Null starting vector.
+          info = -9;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        if (++ntry >= 3) {                  // No new direction found.
+          info = -9999;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        RandomVector();
+        state = NEWV;
+        break;
+      }
+
+      NextVector(v, ldv);
+      if (j > 0) T[(size_t)j*m+j-1] = T[(size_t)(j-1)*m+j] = (ARFLOAT)0.0;
+      ntry  = 0;
+      state = STEP;
+      break;
+
+    case STEP:
+
+      // Requesting OP*v(j). B*v(j) is also available when B != I.
+
+      copy(n, &v[(size_t)j*ldv], 1, x, 1);
+      if (genB) copy(n, &bv[0], 1, z, 1);
+      state = STEP_OP;
+      ido   = 1;
+      return;
+
+    case STEP_OP:
+
+      copy(n, y, 1, &r[0], 1);
+      nopx++;
+      if (genB) {
+        copy(n, &r[0], 1, x, 1);
+        state = STEP_BX;
+        ido   = 2;
+        return;
+      }
+      state = STEP_ORTH;
+      break;
+
+    case STEP_BX:
+
+      copy(n, y, 1, &br[0], 1);
+      nbx++;
+      state = STEP_ORTH;
+      break;
+
+    case STEP_ORTH:
+
+      // r <- r - V(:,0:j)*V(:,0:j)'*B*r. Only the diagonal of T is taken
+      // from h, the off-diagonal entries were set when v(j) was built.
+
+      wnorm = std::sqrt(std::abs(dot(n, &r[0], 1, Br(), 1)));
+      dgks  = false;
+      T[(size_t)j*m+j] = Orthogonalize(v, ldv, j+1);
+      if (genB) {
+        copy(n, &r[0], 1, x, 1);
+        state = STEP_BX2;
+        ido   = 2;
+        return;
+      }
+      state = STEP_NORM;
+      break;
+
+    case STEP_BX2:
+
+      copy(n, y, 1, &br[0], 1);
+      nbx++;
+      state = STEP_NORM;
+      break;
+
+    case STEP_NORM:
+
+      // DGKS test: one more pass of Gram-Schmidt if the norm of r was
+      // reduced too much. If this is not enough, r is set to zero.
+
+      rnorm = std::sqrt(std::abs(dot(n, &r[0], 1, Br(), 1)));
+      if (!dgks) {
+        if (rnorm > (ARFLOAT)0.717*wnorm) {
+          state = EXTEND;
+          break;
+        }
+        nrorth++;
+        dgks  = true;
+        wnorm = rnorm;
+        T[(size_t)j*m+j] += Orthogonalize(v, ldv, j+1);
+        if (genB) {
+          copy(n, &r[0], 1, x, 1);
+          state = STEP_BX2;
+          ido   = 2;
+          return;
+        }
+        break;
+      }
+      if (rnorm <= (ARFLOAT)0.717*wnorm) {
+        rnorm = (ARFLOAT)0.0;
+        std::fill(r.begin(), r.end(), (ARFLOAT)0.0);
+        std::fill(br.begin(), br.end(), (ARFLOAT)0.0);
+      }
+      state = EXTEND;
+      break;
+
+    case EXTEND:
+
+      j++;
+      if (j == m) {
+        state = RESTART;
+        break;
+      }
+      if (rnorm == (ARFLOAT)0.0) {          // Invariant subspace found.
+        RandomVector();
+        ntry  = 0;
+        state = NEWV;
+        break;
+      }
+      NextVector(v, ldv);
+      T[(size_t)j*m+j-1] = T[(size_t)(j-1)*m+j] = rnorm;
+      state = STEP;
+      break;
+
+    case RESTART:
+
+      {
+        // Computing the Ritz values and their error bounds, ||E*y||,
+        // where E is the coupling of V to the residual (rnorm*e(m-1)'
+        // when nb = 1).
+
+        ARint lwork = 3*m;
+        ARint ierr;
+
+        iter++;
+        std::copy(T.begin(), T.end(), Y.begin());
+        syev("V", "U", m, &Y[0], m, &theta[0], &work[0], lwork, ierr);
+        if (ierr != 0) {
+          info = -8;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        Sort(which);
+
+        if (nb == 1) {
+          std::fill(E.begin(), E.end(), (ARFLOAT)0.0);
+          E[m-1] = rnorm;
+        }
+        gemm("N", "N", nb, m, m, (ARFLOAT)1.0, &E[0], nb, &Y[0], m,
+             (ARFLOAT)0.0, &G[0], nb);
+
+        conv.clear();
+        for (ARint i=0; i<nev; i++) {
+          ARFLOAT bound = nrm2(nb, &G[(size_t)idx[i]*nb], 1);
+          ARFLOAT ritz  = std::abs(theta[idx[i]]);
+          if (bound <= tol*std::max(eps23, ritz)) conv.push_back(idx[i]);
+        }
+        nconv = (ARint)conv.size();
+
+        if (nconv >= nev) {
+          info = 0;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        if (iter >= iparam[3]) {
+          info = 1;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+
+        // Keeping nev wanted Ritz vectors plus a few more, as in dsaup2.
+
+        kept = nev + std::min(nconv, (m-nev)/2);
+        if ((kept == 1) && (m >= 6)) kept = m/2;
+        else if ((kept == 1) && (m > 2)) kept = 2;
+
+        // In block mode the new blocks must fill V exactly.
+
+        if (nb > 1) {
+          kept = m - nb*((m-kept+nb-1)/nb);
+          if (kept < nev) kept += nb;
+        }
+
+        for (ARint c=0; c<kept; c++) {
+          copy(m, &Y[(size_t)idx[c]*m], 1, &Q[(size_t)c*m], 1);
+        }
+        RitzVectors(v, ldv, kept);
+
+        // New projected matrix: diagonal plus one row and column with
+        // the coupling of the Ritz vectors kept to the residual (nb rows
+        // and columns in block mode, added by BLOCK_STEP).
+
+        std::fill(T.begin(), T.end(), (ARFLOAT)0.0);
+        std::fill(E.begin(), E.end(), (ARFLOAT)0.0);
+        for (ARint c=0; c<kept; c++) {
+          T[(size_t)c*m+c] = theta[idx[c]];
+          if (nb == 1) {
+            T[(size_t)c*m+kept] = T[(size_t)kept*m+c] = G[idx[c]];
+          }
+          else {
+            copy(nb, &G[(size_t)idx[c]*nb], 1, &E[(size_t)c*nb], 1);
+          }
+        }
+
+        j = kept;
+        if (nb > 1) {
+          state = BLOCK_STEP;
+          break;
+        }
+        NextVector(v, ldv);
+        state = STEP;
+      }
+      break;
+
+    case BLOCK_NEW:
+
+      // Starting block, orthonormalized.
+
+      if (!BlockQR(v, ldv, 0, &E[0])) {
+        info = -9;
+        Finish(ido, resid, iparam, info);
+        return;
+      }
+      std::fill(E.begin(), E.end(), (ARFLOAT)0.0);
+      state = BLOCK_STEP;
+      break;
+
+    case BLOCK_STEP:
+
+      // The residual block becomes v(j), ..., v(j+nb-1), its coupling to
+      // the previous vectors is moved from E to T, and OP*V(:,j:j+nb-1)
+      // is requested.
+
+      for (ARint c=0; c<nb; c++) {
+        copy(n, &r[(size_t)c*n], 1, &v[(size_t)(j+c)*ldv], 1);
+        copy(n, &r[(size_t)c*n], 1, &x[(size_t)c*n], 1);
+        for (ARint i=0; i<j; i++) {
+          T[(size_t)i*m+j+c] = T[(size_t)(j+c)*m+i] = E[(size_t)i*nb+c];
+        }
+      }
+      state = BLOCK_OP;
+      ido   = 1;
+      return;
+
+    case BLOCK_OP:
+
+      {
+        // r <- r - V(:,0:j+nb-1)*V(:,0:j+nb-1)'*r, with one more pass if
+        // the norm of a column was reduced too much (DGKS). A column that
+        // is still reduced too much is set to zero. Only the diagonal
+        // block of T is taken from the coefficients.
+
+        std::vector<ARFLOAT> wn(nb), rn(nb);
+        ARint                k = j+nb;
+        bool                 again = false;
+
+        copy(n*nb, y, 1, &r[0], 1);
+        nopx += nb;
+        for (ARint c=0; c<nb; c++) wn[c] = nrm2(n, &r[(size_t)c*n], 1);
+
+        basis.OrthogonalizeBlock(v, ldv, k, &r[0], n, nb);
+        for (ARint c=0; c<nb; c++) {
+          copy(nb, &basis.Coefficients()[(size_t)c*m+j], 1,
+               &T[(size_t)(j+c)*m+j], 1);
+          rn[c] = nrm2(n, &r[(size_t)c*n], 1);
+          if (rn[c] <= (ARFLOAT)0.717*wn[c]) again = true;
+        }
+
+        if (again) {
+          nrorth++;
+          basis.OrthogonalizeBlock(v, ldv, k, &r[0], n, nb);
+          for (ARint c=0; c<nb; c++) {
+            axpy(nb, (ARFLOAT)1.0, &basis.Coefficients()[(size_t)c*m+j], 1,
+                 &T[(size_t)(j+c)*m+j], 1);
+            ARFLOAT* rc = &r[(size_t)c*n];
+            if ((rn[c] <= (ARFLOAT)0.717*wn[c]) &&
+                (nrm2(n, rc, 1) <= (ARFLOAT)0.717*rn[c])) {
+              std::fill(rc, rc+n, (ARFLOAT)0.0);
+            }
+          }
+        }
+
+        for (ARint c=0; c<nb; c++) {
+          for (ARint i=0; i<c; i++) {
+            ARFLOAT t = ((ARFLOAT)0.5)*(T[(size_t)(j+c)*m+j+i] +
+                                        T[(size_t)(j+i)*m+j+c]);
+            T[(size_t)(j+c)*m+j+i] = T[(size_t)(j+i)*m+j+c] = t;
+          }
+        }
+
+        // New residual block and its coupling, E(:,j:j+nb-1).
+
+        j = k;
+        std::fill(E.begin(), E.end(), (ARFLOAT)0.0);
+        if (!BlockQR(v, ldv, j, &E[(size_t)(j-nb)*nb])) {
+          info = -9999;
+          Finish(ido, resid, iparam, info);
+          return;
+        }
+        state = (j == m) ? RESTART : BLOCK_STEP;
+      }
+      break;
+
+    case DONE:
+    default:
+
+      ido = 99;
+      return;
+
+    }
+  }
+
+} // Aupp.
+
+
+template<class ARFLOAT>
+void ARTRLanczos<ARFLOAT>::
+Eupp(bool rvec, char, ARFLOAT d[], ARFLOAT Z[], ARint ldz, ARFLOAT sigma,
+     char, ARint, const std::string&, ARint, ARFLOAT, ARFLOAT[], ARint,
+     ARFLOAT V[], ARint ldv, ARint iparam[], ARint[], ARFLOAT[], ARint& info)
+{
+
+  if ((state != DONE) || (nconv == 0)) {
+    info = -14;
+    return;
+  }
+
+  // Eigenvalues of the original problem, in ascending order.
+
+  int mode = (int)iparam[7];
+  std::vector<std::pair<ARFLOAT, int> > lambda(nconv);
+
+  for (ARint k=0; k<nconv; k++) {
+    ARFLOAT t = theta[conv[k]];
+    switch (mode) {
+    case 3:                                 // Shift and invert.
+      lambda[k].first = sigma + (ARFLOAT)1.0/t;
+      break;
+    case 4:                                 // Buckling.
+      lambda[k].first = sigma*t/(t-(ARFLOAT)1.0);
+      break;
+    case 5:                                 // Cayley.
+      lambda[k].first = sigma*(t+(ARFLOAT)1.0)/(t-(ARFLOAT)1.0);
+      break;
+    default:                                // Regular.
+      lambda[k].first = t;
+    }
+    lambda[k].second = conv[k];
+  }
+  std::stable_sort(lambda.begin(), lambda.end(),
+                   [](const std::pair<ARFLOAT, int>& a,
+                      const std::pair<ARFLOAT, int>& b) {
+                     return a.first < b.first;
+                   });
+  for (ARint k=0; k<nconv; k++) d[k] = lambda[k].first;
+
+  info = 0;
+  if (!rvec) return;
+
+  // Ritz vectors, stored in V(:,0:nconv-1) as dseupd does.
+
+  ARFLOAT* v = &V[1];
+
+  for (ARint k=0; k<nconv; k++) {
+    copy(m, &Y[(size_t)lambda[k].second*m], 1, &Q[(size_t)k*m], 1);
+  }
+  RitzVectors(v, ldv, nconv);
+
+  // In shift and invert mode each vector is corrected with the residual
+  // (x <- x + (s/theta)*r, where s is the last component of the
+  // eigenvector of T), as in dseupd.
+
+  if (mode == 3) {
+    for (ARint k=0; k<nconv; k++) {
+      int i = lambda[k].second;
+      if (nb == 1) {
+        ARFLOAT s = Y[(size_t)i*m+m-1]/theta[i];
+        axpy(n, s, &r[0], 1, &v[(size_t)k*ldv], 1);
+      }
+      else {                                // x <- x + r*E*y/theta.
+        gemv("N", n, nb, (ARFLOAT)1.0/theta[i], &r[0], n, &G[(size_t)i*nb], 1,
+             (ARFLOAT)1.0, &v[(size_t)k*ldv], 1);
+      }
+    }
+  }
+
+  if ((Z != NULL) && (Z != v)) {
+    for (ARint k=0; k<nconv; k++) {
+      copy(n, &v[(size_t)k*ldv], 1, &Z[(size_t)k*ldz], 1);
+    }
+  }
+
+} // Eupp.
+
+
+#endif // ARTRLAN_H
@@ -0,0 +1,540 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARTSMat.h.
+   Arpack++ class ARtdSymMatrix definition.
+
+   Real symmetric tridiagonal matrix, given by its diagonal and its
+   subdiagonal. Products with A cost O(n), and A - sigma*I is factored
+   in O(n) with pttrf (L*D*L') when it is positive definite, or with
+   gttrf (L*U with partial pivoting) otherwise. Only the factors are
+   stored: 2*n values for pttrf, 4*n values and n pivots for gttrf.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARTSMAT_H
+#define ARTSMAT_H
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "arch.h"
+#include "armat.h"
+#include "arerror.h"
+#include "blas1c.h"
+#include "lapackc.h"
+
+
+template<class ARTYPE>
+class ARtdSymMatrix: public ARMatrix<ARTYPE> {
+
+ protected:
+
+  bool     factored;
+  char     factor;      // 'P' (pttrf) or 'G' (gttrf).
+  ARint    info;
+  ARint*   ipiv;
+  ARTYPE*  D;           // Diagonal (n entries).
+  ARTYPE*  E;           // Subdiagonal (n-1 entries).
+  ARTYPE*  Ainv;        // d, e (pttrf) or dl, d, du, du2 (gttrf).
+
+  // A - sigma*I is not positive definite for sigma >= indefShift, so
+  // pttrf is not tried for those shifts.
+  bool     indefKnown;
+  ARTYPE   indefShift;
+
+  ARTYPE   shift;       // Shift of the current factorization.
+
+  void ClearMem();
+
+  virtual void Copy(const ARtdSymMatrix& other);
+
+  void Factor(ARTYPE sigma);
+  // Factors A - sigma*I.
+
+  void Solve(int k, ARTYPE* W, int ldw);
+  // Overwrites the k columns of W with the solution of AsI*X = W.
+
+  void Mult(const ARTYPE* v, ARTYPE* w);
+  // w = A*v, in a single pass over D, E and v.
+
+  int SturmCount(ARTYPE sigma);
+  // Number of negative pivots of the L*D*L' factorization of
+  // A - sigma*I without pivoting.
+
+  void ThrowError();
+
+ public:
+
+  bool IsFactored() { return factored; }
+
+  char Factorization() { return factor; }
+  // 'P' (pttrf, L*D*L') or 'G' (gttrf, L*U).
+
+  void FactorA();
+
+  void FactorAsI(ARTYPE sigma);
+
+  void Inertia(int& neg, int& zero, int& pos);
+  // Number of negative, zero and positive eigenvalues of the factored
+  // matrix (A or A - sigma*I). It is known from pttrf when A - sigma*I
+  // is positive definite, and is given by a Sturm sequence otherwise.
+
+  int CountEigenvaluesBelow(ARTYPE sigma);
+  // Number of eigenvalues of A smaller than sigma, from a Sturm
+  // sequence (O(n) operations, no extra memory). Unlike the other
+  // matrix classes, A - sigma*I is not factored, so the current
+  // factorization is kept.
+
+  void MultMv(ARTYPE* v, ARTYPE* w);
+
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
+  void MultInvv(ARTYPE* v, ARTYPE* w);
+
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V at once.
+
+  void DefineMatrix(int np, ARTYPE* Dp, ARTYPE* Ep);
+  // Dp holds the np diagonal entries and Ep the np-1 subdiagonal
+  // (and superdiagonal) entries of A. The arrays are not copied.
+
+  ARtdSymMatrix(): ARMatrix<ARTYPE>()
+  {
+    factored   = false;
+    factor     = 'P';
+    indefKnown = false;
+    Ainv       = NULL;
+    ipiv       = NULL;
+  }
+  // Short constructor that does nothing.
+
+  ARtdSymMatrix(int np, ARTYPE* Dp, ARTYPE* Ep);
+  // Long constructor.
+
+  ARtdSymMatrix(const ARtdSymMatrix& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARtdSymMatrix() { ClearMem(); }
+  // Destructor.
+
+  ARtdSymMatrix& operator=(const ARtdSymMatrix& other);
+  // Assignment operator.
+
+};
+
+// ------------------------------------------------------------------------ //
+// ARtdSymMatrix member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE>
+inline void ARtdSymMatrix<ARTYPE>::ClearMem()
+{
+
+  delete[] Ainv;
+  delete[] ipiv;
+  Ainv     = NULL;
+  ipiv     = NULL;
+  factored = false;
+
+} // ClearMem.
+
+
+template<class ARTYPE>
+inline void ARtdSymMatrix<ARTYPE>::Copy(const ARtdSymMatrix<ARTYPE>& other)
+{
+
+  // Copying very fundamental variables and user-defined parameters.
+
+  this->m         = other.m;
+  this->n         = other.n;
+  this->defined   = other.defined;
+  factored  = other.factored;
+  factor    = other.factor;
+  info      = other.info;
+  D         = other.D;
+  E         = other.E;
+  Ainv      = NULL;
+  ipiv      = NULL;
+  indefKnown = false;
+  shift     = other.shift;
+
+  // Returning from here if "other" was not factored.
+
+  if (!factored) return;
+
+  // Copying vectors.
+
+  size_t size = (size_t)this->n*((factor == 'P') ? 2 : 4);
+
+  Ainv = new ARTYPE[size];
+  for (size_t i=0; i<size; i++) Ainv[i] = other.Ainv[i];
+
+  if (other.ipiv) {
+    ipiv = new ARint[this->n];
+    for (int i=0; i<this->n; i++) ipiv[i] = other.ipiv[i];
+  }
+
+} // Copy.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::Factor(ARTYPE sigma)
+{
+
+  int     i, n = this->n;
+  ARTYPE* d;
+
+  ClearMem();
+  shift = sigma;
+
+  // Trying pttrf first, unless a smaller shift already gave an
+  // indefinite matrix.
+
+  if (!indefKnown || (sigma < indefShift)) {
+
+    factor = 'P';
+    Ainv   = new ARTYPE[(size_t)2*n];
+    d      = Ainv;
+
+    for (i=0; i<n; i++) d[i] = D[i] - sigma;
+    copy(n-1, E, 1, &d[n], 1);
+
+    pttrf(n, d, &d[n], info);
+
+    if (info == 0) {
+      factored = true;
+      return;
+    }
+    if (info > 0) {
+      indefKnown = true;
+      indefShift = sigma;
+    }
+
+    ClearMem();
+
+  }
+
+  // LU decomposition with partial pivoting (dl, d, du, du2).
+
+  factor = 'G';
+  Ainv   = new ARTYPE[(size_t)4*n];
+  ipiv   = new ARint[n];
+  d      = &Ainv[n];
+
+  for (i=0; i<n; i++) d[i] = D[i] - sigma;
+  copy(n-1, E, 1, Ainv, 1);
+  copy(n-1, E, 1, &Ainv[2*(size_t)n], 1);
+
+  gttrf(n, Ainv, d, &Ainv[2*(size_t)n], &Ainv[3*(size_t)n], ipiv, info);
+
+  // Handling errors.
+
+  ThrowError();
+
+  factored = true;
+
+} // Factor.
+
+
+template<class ARTYPE>
+inline void ARtdSymMatrix<ARTYPE>::Solve(int k, ARTYPE* W, int ldw)
+{
+
+  size_t n = this->n;
+
+  if (factor == 'P') {
+    pttrs(this->n, k, Ainv, &Ainv[n], W, ldw, info);
+  }
+  else {
+    gttrs("N", this->n, k, Ainv, &Ainv[n], &Ainv[2*n], &Ainv[3*n],
+          ipiv, W, ldw, info);
+  }
+
+} // Solve.
+
+
+template<class ARTYPE>
+inline void ARtdSymMatrix<ARTYPE>::ThrowError()
+{
+
+  if (info < 0)  {   // Illegal argument.
+    throw ArpackError(ArpackError::PARAMETER_ERROR,
+                      "ARtdSymMatrix::FactorA");
+  }
+  else if (info) {   // Matrix is singular.
+    throw ArpackError(ArpackError::MATRIX_IS_SINGULAR,
+                      "ARtdSymMatrix::FactorA");
+  }
+
+} // ThrowError.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::FactorA()
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARtdSymMatrix::FactorA");
+  }
+
+  // Decomposing A.
+
+  Factor((ARTYPE)0);
+
+} // FactorA.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARtdSymMatrix::FactorAsI");
+  }
+
+  // Decomposing AsI.
+
+  Factor(sigma);
+
+} // FactorAsI.
+
+
+template<class ARTYPE>
+int ARtdSymMatrix<ARTYPE>::SturmCount(ARTYPE sigma)
+{
+
+  int    i, n = this->n, neg = 0;
+  ARTYPE d, pivmin;
+
+  // As in dstebz, pivots smaller than pivmin are replaced by -pivmin.
+
+  pivmin = (ARTYPE)1;
+  for (i=0; i<n-1; i++) {
+    if (E[i]*E[i] > pivmin) pivmin = E[i]*E[i];
+  }
+  pivmin *= std::numeric_limits<ARTYPE>::min();
+
+  d = (ARTYPE)1;
+  for (i=0; i<n; i++) {
+    d = (D[i]-sigma) - ((i > 0) ? E[i-1]*E[i-1]/d : (ARTYPE)0);
+    if (std::abs(d) < pivmin) d = -pivmin;
+    if (d < (ARTYPE)0) neg++;
+  }
+
+  return neg;
+
+} // SturmCount.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::Inertia(int& neg, int& zero, int& pos)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARtdSymMatrix::Inertia");
+  }
+
+  neg  = (factor == 'P') ? 0 : SturmCount(shift);
+  zero = 0;
+  pos  = this->n-neg;
+
+} // Inertia.
+
+
+template<class ARTYPE>
+int ARtdSymMatrix<ARTYPE>::CountEigenvaluesBelow(ARTYPE sigma)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARtdSymMatrix::CountEigenvaluesBelow");
+  }
+
+  return SturmCount(sigma);
+
+} // CountEigenvaluesBelow.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::Mult(const ARTYPE* v, ARTYPE* w)
+{
+
+  int n = this->n;
+
+  if (n == 1) {
+    w[0] = D[0]*v[0];
+    return;
+  }
+
+  w[0] = D[0]*v[0] + E[0]*v[1];
+  for (int i=1; i<n-1; i++) {
+    w[i] = E[i-1]*v[i-1] + D[i]*v[i] + E[i]*v[i+1];
+  }
+  w[n-1] = E[n-2]*v[n-2] + D[n-1]*v[n-1];
+
+} // Mult.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARtdSymMatrix::MultMv");
+  }
+
+  // Determining w = M.v.
+
+  Mult(v, w);
+
+} // MultMv.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv,
+                                   ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARtdSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V one column at a time.
+
+  for (int r=0; r<k; r++) {
+    Mult(&V[(size_t)r*ldv], &W[(size_t)r*ldw]);
+  }
+
+} // MultMm.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARtdSymMatrix::MultInvv");
+  }
+
+  // Overwritting w with v.
+
+  copy(this->n, v, 1, w, 1);
+
+  // Solving A.w = v (or AsI.w = v).
+
+  Solve(1, w, this->n);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvv.
+
+
+template<class ARTYPE>
+void ARtdSymMatrix<ARTYPE>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                      ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARtdSymMatrix::MultInvMm");
+  }
+
+  // Overwritting W with V.
+
+  if (V != W) {
+    for (int r = 0; r < k; r++) {
+      copy(this->n, &V[(size_t)r*ldv], 1, &W[(size_t)r*ldw], 1);
+    }
+  }
+
+  // Solving A.W = V (or AsI.W = V).
+
+  Solve(k, W, ldw);
+
+  // Handling errors.
+
+  ThrowError();
+
+} // MultInvMm.
+
+
+template<class ARTYPE>
+inline void ARtdSymMatrix<ARTYPE>::DefineMatrix(int np, ARTYPE* Dp, ARTYPE* Ep)
+{
+
+  // Discarding the previous factorization.
+
+  ClearMem();
+
+  // Defining member variables.
+
+  this->m         = np;
+  this->n         = np;
+  D         = Dp;
+  E         = Ep;
+  this->defined   = true;
+  info      = 0;
+  indefKnown = false;
+
+} // DefineMatrix.
+
+
+template<class ARTYPE>
+inline ARtdSymMatrix<ARTYPE>::
+ARtdSymMatrix(int np, ARTYPE* Dp, ARTYPE* Ep) : ARMatrix<ARTYPE>(np)
+{
+
+  factored = false;
+  factor   = 'P';
+  Ainv     = NULL;
+  ipiv     = NULL;
+  DefineMatrix(np, Dp, Ep);
+
+} // Long constructor.
+
+
+template<class ARTYPE>
+ARtdSymMatrix<ARTYPE>& ARtdSymMatrix<ARTYPE>::
+operator=(const ARtdSymMatrix<ARTYPE>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARTSMAT_H
@@ -0,0 +1,163 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE ARTSSym.h.
+   Arpack++ class ARluSymStdEig definition
+   (tridiagonal matrix version).
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARTSSYM_H
+#define ARTSSYM_H
+
+#include <cstddef>
+#include <string>
+#include "arch.h"
+#include "arssym.h"
+#include "artsmat.h"
+
+
+template<class ARFLOAT>
+class ARluSymStdEig:
+  public virtual ARSymStdEig<ARFLOAT, ARtdSymMatrix<ARFLOAT> > {
+
+ public:
+
+ // a) Public functions:
+
+ // a.1) Functions that allow changes in problem parameters.
+
+  virtual void ChangeShift(ARFLOAT sigmaRp);
+
+  virtual void SetRegularMode();
+
+  virtual void SetShiftInvertMode(ARFLOAT sigmap);
+
+ // a.2) Constructors and destructor.
+
+  ARluSymStdEig() { }
+  // Short constructor.
+
+  ARluSymStdEig(int nevp, ARtdSymMatrix<ARFLOAT>& A,
+                const std::string& whichp = "LM", int ncvp = 0,
+                ARFLOAT tolp = 0.0, int maxitp = 0,
+                ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (regular mode).
+
+  ARluSymStdEig(int nevp, ARtdSymMatrix<ARFLOAT>& A,
+                ARFLOAT sigma, const std::string& whichp = "LM", int ncvp = 0,
+                ARFLOAT tolp = 0.0, int maxitp = 0,
+                ARFLOAT* residp = NULL, bool ishiftp = true);
+  // Long constructor (shift and invert mode).
+
+  ARluSymStdEig(const ARluSymStdEig& other) { Copy(other); }
+  // Copy constructor.
+
+  virtual ~ARluSymStdEig() { }
+  // Destructor.
+
+ // b) Operators.
+
+  ARluSymStdEig& operator=(const ARluSymStdEig& other);
+  // Assignment operator.
+
+}; // class ARluSymStdEig.
+
+
+// ------------------------------------------------------------------------ //
+// ARluSymStdEig member functions definition.                               //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARFLOAT>
+inline void ARluSymStdEig<ARFLOAT>::
+ChangeShift(ARFLOAT sigmaRp)
+{
+
+  this->sigmaR    = sigmaRp;
+  this->sigmaI    = 0.0;
+  this->mode      = 3;
+  this->iparam[7] = this->mode;
+
+  this->objOP->FactorAsI(this->sigmaR);
+  this->Restart();
+
+} // ChangeShift.
+
+
+template<class ARFLOAT>
+inline void ARluSymStdEig<ARFLOAT>::SetRegularMode()
+{
+
+  ARStdEig<ARFLOAT, ARFLOAT, ARtdSymMatrix<ARFLOAT> >::
+    SetRegularMode(this->objOP, &ARtdSymMatrix<ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARtdSymMatrix<ARFLOAT>::MultMm);
+
+} // SetRegularMode.
+
+
+template<class ARFLOAT>
+inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
+{
+
+  ARStdEig<ARFLOAT, ARFLOAT, ARtdSymMatrix<ARFLOAT> >::
+    SetShiftInvertMode(sigmap, this->objOP, &ARtdSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARtdSymMatrix<ARFLOAT>::MultInvMm);
+
+} // SetShiftInvertMode.
+
+
+template<class ARFLOAT>
+inline ARluSymStdEig<ARFLOAT>::
+ARluSymStdEig(int nevp, ARtdSymMatrix<ARFLOAT>& A,
+              const std::string& whichp, int ncvp, ARFLOAT tolp,
+              int maxitp, ARFLOAT* residp, bool ishiftp)
+{
+
+  this->NoShift();
+  this->DefineParameters(A.ncols(), nevp, &A, &ARtdSymMatrix<ARFLOAT>::MultMv,
+                   whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARtdSymMatrix<ARFLOAT>::MultMm);
+
+} // Long constructor (regular mode).
+
+
+template<class ARFLOAT>
+inline ARluSymStdEig<ARFLOAT>::
+ARluSymStdEig(int nevp, ARtdSymMatrix<ARFLOAT>& A,
+              ARFLOAT sigmap, const std::string& whichp, int ncvp, ARFLOAT tolp,
+              int maxitp, ARFLOAT* residp, bool ishiftp)
+
+{
+
+  this->DefineParameters(A.ncols(), nevp, &A, &ARtdSymMatrix<ARFLOAT>::MultInvv,
+                   whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARtdSymMatrix<ARFLOAT>::MultInvMm);
+  ChangeShift(sigmap);
+
+} // Long constructor (shift and invert mode).
+
+
+template<class ARFLOAT>
+ARluSymStdEig<ARFLOAT>& ARluSymStdEig<ARFLOAT>::
+operator=(const ARluSymStdEig<ARFLOAT>& other)
+{
+
+  if (this != &other) { // Stroustrup suggestion.
+    this->ClearMem();
+    Copy(other);
+  }
+  return *this;
+
+} // operator=.
+
+
+#endif // ARTSSYM_H
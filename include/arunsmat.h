@@ -22,12 +22,15 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include "arch.h"
 #include "armat.h"
 #include "arspmat.h"
 #include "arhbmat.h"
 #include "arerror.h"
+#include "argram.h"
+#include "arwork.h"
 #include "umfpackc.h"
 
 template<class ARTYPE, class ARFLOAT> class ARumNonSymPencil;
@@ -42,9 +45,9 @@ class ARumNonSymMatrix: public ARMatrix<ARTYPE> {
 
   double  control[UMFPACK_CONTROL];
   double  info[UMFPACK_INFO];
-  void*   Numeric;
   bool    factored;
   double  threshold;
+  ARTYPE  shift;   // Shift subtracted from A in AsI (see FactorAsI).
 
   // The input matrix
   ARSparseMatrix<ARTYPE>* mat;
@@ -65,51 +68,100 @@ class ARumNonSymMatrix: public ARMatrix<ARTYPE> {
   // Internal matrix storing A - s I
   ARSparseMatrix<ARTYPE>* AsI;
 
+  // Fused products A'*A*v and A*A'*v (used by MultMtMv and MultMMtv).
+  ARGramProduct<ARindex, ARTYPE> gram;
+
+  // Numeric factorization of pA. It is shared with the copies of this
+  // matrix, which only read it. FactorA and FactorAsI release it and
+  // build a new one, so a shared Numeric object never changes.
+  std::shared_ptr<void> Numeric;
+
+  // Symbolic analysis of the last matrix factored (mat or AsI), reused
+  // while FactorA or FactorAsI are called with the same pattern.
+  UmfpackSymbolic<ARTYPE> umfSymbolic;
+
+  void Factor(ARSparseMatrix<ARTYPE>* M);
+
  public:
 
-  int nzeros() { return mat->nzeros(); }
+  ARindex nzeros() { return mat->nzeros(); }
 
   bool IsSymmetric() { return false /*bool(icntl[5])*/; }
 
   bool IsFactored() { return factored; }
 
+  int Threads() const { return gram.Threads(); }
+
+  void SetThreads(int nthreadsp) { gram.SetThreads(nthreadsp); }
+  // Sets the number of threads used by MultMtMv and MultMMtv
+  // (0 means all cores).
+
   void FactorA();
 
   void FactorAsI(ARTYPE sigma);
 
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultMtv(ARTYPE* v, ARTYPE* w);
 
   void MultMtMv(ARTYPE* v, ARTYPE* w);
+  // w = A'*A*v, in a single pass over A and without temporary
+  // vectors. A copy of A stored by rows (nzeros() extra entries)
+  // is built on the first call.
 
   void MultMMtv(ARTYPE* v, ARTYPE* w);
+  // w = A*A'*v, in a single pass over A.
 
   void Mult0MMt0v(ARTYPE* v, ARTYPE* w);
 
-  void MultInvv(ARTYPE* v, ARTYPE* w);
+  void Solve(const ARTYPE* v, ARTYPE* w) const;
+  // Solves A*w = v (or AsI*w = v). The factorization is only read, and
+  // the work arrays are those of the calling thread, so several threads
+  // may solve at the same time with this matrix or with its copies.
 
-  void DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+  void Solve(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw) const;
+  // Same as above for the k columns of V (one at a time, with the
+  // same work arrays).
+
+  void MultInvv(ARTYPE* v, ARTYPE* w) { Solve(v, w); }
+
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+  { Solve(k, V, ldv, W, ldw); }
+  // Solves A*W = V (or AsI*W = V) for the k columns of V.
+
+  void UpdateValues(const ARTYPE* newvals);
+  // Replaces the nzeros() values of A by newvals, given in the order
+  // of the array passed to DefineMatrix (which may also be that array,
+  // after it was changed in place). The pattern must not change. The
+  // symbolic analysis is kept, and if A (or A-sigma*I) was factored,
+  // only the numeric factorization is redone, with the same shift.
+
+  void DefineMatrix(int mp, int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
                     double thresholdp = 0.1, bool check = true, bool owner = false);
 
-  ARumNonSymMatrix(): ARMatrix<ARTYPE>(), factored(false), Numeric(nullptr), mat(nullptr), AsI(nullptr)
+  ARumNonSymMatrix(): ARMatrix<ARTYPE>(), factored(false), mat(nullptr), AsI(nullptr)
   {
   }
   // Short constructor that does nothing.
 
-  ARumNonSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+  ARumNonSymMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
                    double thresholdp = 0.1);
   // Long constructor (square matrix).
 
-  ARumNonSymMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+  ARumNonSymMatrix(int mp, int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
                    double thresholdp = 0.1);
   // Long constructor (rectangular matrix).
 
   ARumNonSymMatrix(const std::string& name, double thresholdp = 0.1);
   // Long constructor (Harwell-Boeing file).
 
-  ARumNonSymMatrix(const ARumNonSymMatrix& other) { Copy(other); }
-  // Copy constructor.
+  ARumNonSymMatrix(const ARumNonSymMatrix& other)
+    : ARMatrix<ARTYPE>(), factored(false), mat(nullptr), pA(nullptr), AsI(nullptr)
+  { Copy(other); }
+  // Copy constructor. The copy shares the factorization of other,
+  // until one of them is factored again.
 
   virtual ~ARumNonSymMatrix() { ClearMem(); }
   // Destructor.
@@ -128,17 +180,16 @@ template<class ARTYPE, class ARFLOAT>
 inline void ARumNonSymMatrix<ARTYPE, ARFLOAT>::ClearMem()
 {
 
-  if (factored && Numeric)
-  {
-    umfpack_free_numeric<ARTYPE>(&Numeric);
-    Numeric = nullptr;
-  }
+  Numeric.reset();
 
   if (mat) { delete mat; mat = nullptr; }
   if (AsI) { delete AsI; AsI = nullptr; }
 
   pA = nullptr;
 
+  gram.Clear();
+  umfSymbolic.Free();
+
 } // ClearMem.
 
 
@@ -153,24 +204,32 @@ Copy(const ARumNonSymMatrix<ARTYPE, ARFLOAT>& other)
   this->n         = other.n;
   this->defined   = other.defined;
   factored  = other.factored;
+  shift     = other.shift;
+  threshold = other.threshold;
 
-  mat->Copy(*other.mat);
+  gram.Clear();
+  gram.SetThreads(other.gram.Threads());
 
   // Returning from here if "other" was not initialized.
 
   if (!this->defined) return;
 
+  // Copying the matrix (and AsI, if it was built).
+
+  mat = new ARSparseMatrix<ARTYPE>(*other.mat);
+  if (other.AsI) AsI = new ARSparseMatrix<ARTYPE>(*other.AsI);
+  pA = (other.pA == other.AsI) ? AsI : mat;
+
   // Copying arrays with static dimension.
 
   for (int i = 0; i < UMFPACK_CONTROL; i++) control[i] = other.control[i];
   for (int i = 0; i < UMFPACK_INFO; i++) info[i] = other.info[i];
 
-  // Returning from here if "other" was not factored.
+  // Sharing the numeric factorization of other. The symbolic analysis
+  // is not shared, so it is redone when the copy is factored.
 
-  if (!factored) return;
+  Numeric = other.Numeric;
 
-  factored = false;
-  
 } // Copy.
 
 
@@ -179,8 +238,8 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::SubtractAsI(ARTYPE sigma)
 {
   if (!AsI)
   {
-      int ndiag = mat->DiagIndices();
-      int nz = mat->nzeros();
+      ARindex ndiag = mat->DiagIndices();
+      ARindex nz = mat->nzeros();
 
       AsI = new ARSparseMatrix<ARTYPE>(this->m, this->n, nz + this->n - ndiag);
   }
@@ -193,6 +252,7 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::SubtractAsI(ARTYPE sigma)
   }
 
   pA = AsI;
+  gram.Clear();
 
 }
 
@@ -222,6 +282,30 @@ inline void ARumNonSymMatrix<ARTYPE, ARFLOAT>::Check(int status)
 } // Check.
 
 
+template<class ARTYPE, class ARFLOAT>
+inline void ARumNonSymMatrix<ARTYPE, ARFLOAT>::Factor(ARSparseMatrix<ARTYPE>* M)
+{
+
+  // umfpack_symbolic is skipped if M was the last matrix analyzed
+  // and its pattern is the same. The previous Numeric is released
+  // first, so it is freed here unless a copy of this matrix uses it.
+
+  factored = false;
+  Numeric.reset();
+
+  void* num    = nullptr;
+  int   status = umfSymbolic.Factor((const void*)M, (ARindex)this->m, (ARindex)this->n,
+                                    M->pcol(), M->irow(), M->values(),
+                                    &num, control, info);
+  Numeric = UmfpackShareNumeric<ARTYPE>(num);
+
+  Check(status);
+
+  factored = true;
+
+} // Factor.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
 {
@@ -241,19 +325,9 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::FactorA()
 
   // Decomposing A.
 
-  void *Symbolic;
-
-  auto ap = mat->pcol();
-  auto ai = mat->irow();
-  auto ax = mat->values();
-
-  Check(umfpack_symbolic(this->m, this->n, ap, ai, ax, &Symbolic, control, info));
-  Check(umfpack_numeric(ap, ai, ax, Symbolic, &Numeric, control, info));
-
-  umfpack_free_symbolic<ARTYPE>(&Symbolic);
-
-  factored = true;
+  Factor(mat);
 
+  if (pA != mat) gram.Clear();
   pA = mat;
 
 } // FactorA.
@@ -280,21 +354,12 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::FactorAsI(ARTYPE sigma)
   // Subtracting sigma*I from A (this will allocate AsI).
 
   SubtractAsI(sigma);
+  shift = sigma;
 
-  // Decomposing AsI.
-
-  void *Symbolic;
-
-  auto ap = AsI->pcol();
-  auto ai = AsI->irow();
-  auto ax = AsI->values();
-
-  Check(umfpack_symbolic(this->m, this->n, ap, ai, ax, &Symbolic, control, info));
-  Check(umfpack_numeric(ap, ai, ax, Symbolic, &Numeric, control, info));
+  // Decomposing AsI. Only its values change from one shift to
+  // the next, so the symbolic analysis is done once.
 
-  umfpack_free_symbolic<ARTYPE>(&Symbolic);
-
-  factored = true;
+  Factor(AsI);
 
   pA = AsI;
 
@@ -305,8 +370,9 @@ template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 {
 
-  int    i,j;
-  ARTYPE t;
+  int     i;
+  ARindex j;
+  ARTYPE  t;
 
   // Quitting the function if A was not defined.
 
@@ -332,12 +398,31 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMv(ARTYPE* v, ARTYPE* w)
 } // MultMv.
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
+MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumNonSymMatrix::MultMm");
+  }
+
+  // Determining W = M.V.
+
+  pA->MultMm(k, V, ldv, W, ldw);
+
+} // MultMm.
+
+
 template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  int    i,j;
-  ARTYPE t;
+  int     i;
+  ARindex j;
+  ARTYPE  t;
 
   // Quitting the function if A was not defined.
 
@@ -366,12 +451,15 @@ template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMtMv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[this->m];
+  // Quitting the function if A was not defined.
 
-  MultMv(v,t);
-  MultMtv(t,w);
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,"ARumNonSymMatrix::MultMtMv");
+  }
+
+  // Determining w = M'.M.v.
 
-  delete[] t;
+  gram.MultMtMv(this->m, this->n, pA->pcol(), pA->irow(), pA->values(), v, w);
 
 } // MultMtMv.
 
@@ -380,12 +468,15 @@ template<class ARTYPE, class ARFLOAT>
 void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultMMtv(ARTYPE* v, ARTYPE* w)
 {
 
-  ARTYPE* t = new ARTYPE[this->n];
+  // Quitting the function if A was not defined.
 
-  MultMtv(v,t);
-  MultMv(t,w);
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,"ARumNonSymMatrix::MultMMtv");
+  }
+
+  // Determining w = M.M'.v.
 
-  delete[] t;
+  gram.MultMMtv(this->m, this->n, pA->pcol(), pA->irow(), pA->values(), v, w);
 
 } // MultMMtv.
 
@@ -401,33 +492,73 @@ void ARumNonSymMatrix<ARTYPE, ARFLOAT>::Mult0MMt0v(ARTYPE* v, ARTYPE* w)
 
 
 template<class ARTYPE, class ARFLOAT>
-void ARumNonSymMatrix<ARTYPE, ARFLOAT>::MultInvv(ARTYPE* v, ARTYPE* w)
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::Solve(const ARTYPE* v, ARTYPE* w) const
 {
 
   // Quitting the function if A (or AsI) was not factored.
 
-  if (!IsFactored()) {
+  if (!factored) {
     throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
-                      "ARumNonSymMatrix::MultInvv");
+                      "ARumNonSymMatrix::Solve");
   }
 
   auto ap = pA->pcol();
   auto ai = pA->irow();
   auto ax = pA->values();
 
-  // Solving A.w = v (or AsI.w = v).
+  // Solving A.w = v (or AsI.w = v) with the work arrays of this thread.
 
-  int status = umfpack_solve(UMFPACK_A, ap, ai, ax, w, v, Numeric, control, info);
+  UmfpackThreadWork& tw = UmfpackLocalWork();
+
+  int status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, w, const_cast<ARTYPE*>(v),
+                              Numeric.get(), control, tw.Info, tw.Wi.Get(this->n),
+                              tw.W.Get(umfpack_wsize<ARTYPE>(this->n)));
 
   if (status != UMFPACK_OK)
-      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumNonSymMatrix::MultInvv");
+      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumNonSymMatrix::Solve");
 
-} // MultInvv.
+} // Solve.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
+Solve(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw) const
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!factored) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARumNonSymMatrix::Solve");
+  }
+
+  auto ap = pA->pcol();
+  auto ai = pA->irow();
+  auto ax = pA->values();
+
+  UmfpackThreadWork& tw = UmfpackLocalWork();
+
+  ARindex* Wi = tw.Wi.Get(this->n);
+  double*  Wd = tw.W.Get(umfpack_wsize<ARTYPE>(this->n));
+
+  // Solving A.W = V (or AsI.W = V), one column at a time.
+
+  for (int r = 0; r < k; r++) {
+    int status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, &W[(size_t)r*ldw],
+                                const_cast<ARTYPE*>(&V[(size_t)r*ldv]),
+                                Numeric.get(), control, tw.Info, Wi, Wd);
+    if (status != UMFPACK_OK) {
+      throw ArpackError(ArpackError::PARAMETER_ERROR,
+                        "ARumNonSymMatrix::Solve");
+    }
+  }
+
+} // Solve (k vectors).
 
 
 template<class ARTYPE, class ARFLOAT>
 inline void ARumNonSymMatrix<ARTYPE, ARFLOAT>::
-DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+DefineMatrix(int mp, int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
              double thresholdp, bool check, bool owner)
 {
 
@@ -435,6 +566,9 @@ DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
 
   mat = new ARSparseMatrix<ARTYPE>(mp, np, pcolp, irowp, ap, nnzp, '*', owner);
   pA  = mat;
+  shift = (ARTYPE)0;
+  gram.Clear();
+  umfSymbolic.Free();
 
   this->m  = mp;
   this->n  = np;
@@ -457,9 +591,43 @@ DefineMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
 } // DefineMatrix (rectangular).
 
 
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymMatrix<ARTYPE, ARFLOAT>::UpdateValues(const ARTYPE* newvals)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARumNonSymMatrix::UpdateValues");
+  }
+
+  // Storing the new values. The copies of A used by MultMv, MultMtMv
+  // and MultMMtv are rebuilt on their next call.
+
+  if (newvals != mat->values()) {
+    std::copy(newvals, newvals+mat->nzeros(), mat->values());
+  }
+  mat->ClearFormats();
+  gram.Clear();
+
+  // Redoing the numeric factorization of A (or AsI) with the same
+  // shift. umfpack_symbolic is skipped, as the pattern is the same.
+
+  if (pA == AsI) {
+    SubtractAsI(shift);
+    if (factored) Factor(AsI);
+  }
+  else if (factored) {
+    Factor(mat);
+  }
+
+} // UpdateValues.
+
+
 template<class ARTYPE, class ARFLOAT>
 inline ARumNonSymMatrix<ARTYPE, ARFLOAT>::
-ARumNonSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+ARumNonSymMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
                  double thresholdp)
   : ARMatrix<ARTYPE>(np), mat(nullptr), AsI(nullptr)
 {
@@ -472,8 +640,8 @@ ARumNonSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
 
 template<class ARTYPE, class ARFLOAT>
 inline ARumNonSymMatrix<ARTYPE, ARFLOAT>::
-ARumNonSymMatrix(int mp, int np, int nnzp, ARTYPE* ap, int* irowp,
-                 int* pcolp, double thresholdp)
+ARumNonSymMatrix(int mp, int np, ARindex nnzp, ARTYPE* ap,
+                 ARindex* irowp, ARindex* pcolp, double thresholdp)
   : ARMatrix<ARTYPE>(mp, np), mat(nullptr), AsI(nullptr)
 {
 
@@ -490,7 +658,7 @@ ARumNonSymMatrix(const std::string& name, double thresholdp)
 
   factored = false;
 
-  ARhbMatrix<int, ARTYPE> mat;
+  ARhbMatrix<ARindex, ARTYPE> mat;
   try {
     mat.Define(name, false);
   }
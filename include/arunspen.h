@@ -23,6 +23,7 @@
 #include "umfpackc.h"
 #include "arspmat.h"
 #include "arunsmat.h"
+#include "arwork.h"
 
 
 template<class ARTYPE, class ARFLOAT>
@@ -37,6 +38,7 @@ class ARumNonSymPencil
   ARumNonSymMatrix<ARTYPE, ARFLOAT>  AsB;
 #ifdef ARCOMP_H
   ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> AsBc;
+  ARWorkspace<arcomplex<ARFLOAT> > wcomp;  // Used by MultInvAsBv.
 #endif
 
   virtual void Copy(const ARumNonSymPencil& other);
@@ -69,6 +71,15 @@ class ARumNonSymPencil
 
   void MultInvAsBv(ARFLOAT* v, ARFLOAT* w);
 
+#ifdef ARCOMP_H
+  void MultInvAsBm(int k, const arcomplex<ARFLOAT>* V, int ldv,
+                   arcomplex<ARFLOAT>* W, int ldw);
+#endif
+
+  void MultInvAsBm(int k, const ARFLOAT* V, int ldv, ARFLOAT* W, int ldw);
+  // Solves (A-sigma*B)*W = V for the k columns of V. With a complex
+  // shift, W is the real (or imaginary) part of the solution.
+
   void DefineMatrices(ARumNonSymMatrix<ARTYPE, ARFLOAT>& Ap, 
                       ARumNonSymMatrix<ARTYPE, ARFLOAT>& Bp);
 
@@ -121,6 +132,8 @@ void ARumNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
                       "ARumNonSymPencil::FactorAsB");
   }
 
+  part = 'N';   // shift is real.
+
   // Quitting the function if A and B are not square.
 
   if ((A->nrows() != A->ncols()) || (B->nrows() != B->ncols())) {
@@ -128,20 +141,21 @@ void ARumNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
                       "ARumNonSymPencil::FactorAsB");
   }
 
-  // Defining matrix AsB.
+  // Defining matrix AsB. Its pattern is the union of the patterns
+  // of A and B, so it is built only once.
 
   if (!AsB.IsDefined()) {
 
-    int* count = new int[A->n];
-    int* work = new int[A->m];
+    ARindex* count = new ARindex[A->n];
+    ARindex* work = new ARindex[A->m];
 
-    int nnz = A->mat->PrepareAdd(*B->mat, count, work);
+    ARindex nnz = A->mat->PrepareAdd(*B->mat, count, work);
 
     delete[] count;
     delete[] work;
 
-    int* pcol = new int[A->n + 1];
-    int* irow = new int[nnz];
+    ARindex* pcol = new ARindex[A->n + 1];
+    ARindex* irow = new ARindex[nnz];
     ARTYPE* a = new ARTYPE[nnz];
 
     // Do not validate AsB since though the matrix is allocated, no
@@ -155,7 +169,7 @@ void ARumNonSymPencil<ARTYPE, ARFLOAT>::FactorAsB(ARTYPE sigma)
 
   A->mat->Add(-sigma, *B->mat, *AsB.mat);
 
-  // Decomposing AsB.
+  // Decomposing AsB (the symbolic analysis is done on the first call).
 
   AsB.FactorA();
 
@@ -182,18 +196,21 @@ FactorAsB(ARFLOAT sigmaR, ARFLOAT sigmaI, char partp)
                       "ARumNonSymPencil::FactorAsB");
   }
 
-  // Defining matrix AsB.
+  part = partp;
+
+  // Defining matrix AsBc (only once, as AsB).
 
   if (!AsBc.IsDefined()) {
 
-    part        = partp;
+    ARindex* count = new ARindex[A->n];
+    ARindex* work = new ARindex[A->m];
+    ARindex nnz = A->mat->PrepareAdd(*B->mat, count, work);
 
-    int* count = new int[A->n];
-    int* work = new int[A->m];
-    int nnz = A->mat->PrepareAdd(*B->mat, count, work);
+    delete[] count;
+    delete[] work;
 
-    int* ap = new int[A->n + 1];
-    int* ai = new int[nnz];
+    ARindex* ap = new ARindex[A->n + 1];
+    ARindex* ai = new ARindex[nnz];
     arcomplex<ARFLOAT>* ax = new arcomplex<ARFLOAT>[nnz];
 
     // Do not validate AsBc since though the matrix is allocated, no
@@ -207,7 +224,7 @@ FactorAsB(ARFLOAT sigmaR, ARFLOAT sigmaI, char partp)
 
   A->mat->Add(-sigmaR, -sigmaI, *B->mat, *AsBc.mat);
 
-  // Decomposing AsBc.
+  // Decomposing AsBc (the symbolic analysis is done on the first call).
 
   AsBc.FactorA();
 
@@ -257,8 +274,8 @@ void ARumNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
     int                i;
     arcomplex<ARFLOAT> *tv, *tw;
 
-    tv = new arcomplex<ARFLOAT>[AsBc.ncols()];
-    tw = new arcomplex<ARFLOAT>[AsBc.ncols()];
+    tv = wcomp.Get(2*(size_t)AsBc.ncols());
+    tw = tv + AsBc.ncols();
 
     for (i=0; i!=AsBc.ncols(); i++) tv[i] = arcomplex<ARFLOAT>(v[i], 0.0);
 
@@ -271,9 +288,6 @@ void ARumNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
       for (i=0; i!=AsBc.ncols(); i++) w[i] = real(tw[i]);
     }
 
-    delete[] tv;
-    delete[] tw;
-
 #endif // ARCOMP_H.
 
   }
@@ -281,6 +295,66 @@ void ARumNonSymPencil<ARTYPE, ARFLOAT>::MultInvAsBv(ARFLOAT* v, ARFLOAT* w)
 } // MultInvAsBv (ARFLOAT).
 
 
+#ifdef ARCOMP_H
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymPencil<ARTYPE, ARFLOAT>::
+MultInvAsBm(int k, const arcomplex<ARFLOAT>* V, int ldv,
+            arcomplex<ARFLOAT>* W, int ldw)
+{
+
+  AsB.MultInvMm(k, (const ARTYPE*)V, ldv, (ARTYPE*)W, ldw);
+
+} // MultInvAsBm (arcomplex<ARFLOAT>).
+#endif // ARCOMP_H.
+
+
+template<class ARTYPE, class ARFLOAT>
+void ARumNonSymPencil<ARTYPE, ARFLOAT>::
+MultInvAsBm(int k, const ARFLOAT* V, int ldv, ARFLOAT* W, int ldw)
+{
+
+  if (part == 'N') {    // shift is real.
+
+    AsB.MultInvMm(k, (const ARTYPE*)V, ldv, (ARTYPE*)W, ldw);
+
+  }
+  else {                // shift is complex.
+
+#ifdef ARCOMP_H
+
+    int                i, r;
+    int                n = AsBc.ncols();
+    arcomplex<ARFLOAT> *tv, *tw;
+
+    tv = wcomp.Get(2*(size_t)n*k);
+    tw = tv + (size_t)n*k;
+
+    for (r=0; r!=k; r++) {
+      for (i=0; i!=n; i++) {
+        tv[(size_t)r*n+i] = arcomplex<ARFLOAT>(V[(size_t)r*ldv+i], 0.0);
+      }
+    }
+
+    AsBc.MultInvMm(k, tv, n, tw, n);
+
+    for (r=0; r!=k; r++) {
+      ARFLOAT*                  w = &W[(size_t)r*ldw];
+      const arcomplex<ARFLOAT>* t = &tw[(size_t)r*n];
+      if (part=='I') {
+        for (i=0; i!=n; i++) w[i] = imag(t[i]);
+      }
+      else {
+        for (i=0; i!=n; i++) w[i] = real(t[i]);
+      }
+    }
+
+#endif // ARCOMP_H.
+
+  }
+
+} // MultInvAsBm (ARFLOAT).
+
+
 template<class ARTYPE, class ARFLOAT>
 inline void ARumNonSymPencil<ARTYPE, ARFLOAT>::
 DefineMatrices(ARumNonSymMatrix<ARTYPE, ARFLOAT>& Ap, 
@@ -304,6 +378,7 @@ ARumNonSymPencil(ARumNonSymMatrix<ARTYPE, ARFLOAT>& Ap,
                  ARumNonSymMatrix<ARTYPE, ARFLOAT>& Bp)
 {
 
+  part = 'N';
   DefineMatrices(Ap, Bp);
 
 } // Long constructor.
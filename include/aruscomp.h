@@ -99,6 +99,7 @@ inline void ARluCompStdEig<ARFLOAT>::SetRegularMode()
            ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetRegularMode(this->objOP, 
                    &ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -112,6 +113,7 @@ SetShiftInvertMode(arcomplex<ARFLOAT> sigmap)
            ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP,
                        &ARumNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARumNonSymMatrix<arcomplex<ARFLOAT>,ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -128,6 +130,7 @@ ARluCompStdEig(int nevp, ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A,
                    &ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -144,6 +147,7 @@ ARluCompStdEig(int nevp, ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARumNonSymMatrix<arcomplex<ARFLOAT>, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
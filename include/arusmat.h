@@ -27,13 +27,18 @@
 #ifndef ARUSMAT_H
 #define ARUSMAT_H
 
+#include <cmath>
 #include <cstddef>
 #include <string>
+#include <vector>
 #include "arch.h"
 #include "armat.h"
 #include "arspmat.h"
 #include "arhbmat.h"
 #include "arerror.h"
+#include "arthread.h"
+#include "arsymmv.h"
+#include "arwork.h"
 #include "umfpackc.h"
 
 template<class ARTYPE> class ARumSymPencil;
@@ -47,10 +52,25 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
   
   double  control[UMFPACK_CONTROL];
   double  info[UMFPACK_INFO];
-  void*   Numeric;
+  void*   Numeric = nullptr;
   bool    factored;
   char    uplo;
   double  threshold;
+  int     nthreads;
+
+  // Column blocks assigned to each thread by the parallel MultMv.
+  std::vector<int> bounds;
+
+  // Permuted vectors used when the matrix was reordered.
+  ARWorkspace<ARTYPE> pwork;
+
+  // Work arrays of umfpack_wsolve (used by MultInvv).
+  ARWorkspace<ARindex> umfWi;
+  ARWorkspace<double>  umfW;
+
+  // Symbolic analysis of the last matrix factored (Afull or AsI), reused
+  // while FactorA or FactorAsI are called with the same pattern.
+  UmfpackSymbolic<ARTYPE> umfSymbolic;
 
   // The input matrix.
   ARSparseMatrix<ARTYPE>* A;
@@ -58,6 +78,20 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
   // In case the input matrix is triangular, UMFPACK requires the expanded matrix.
   ARSparseMatrix<ARTYPE>* Afull;
 
+  // Copy of the stored triangle used by MultMv after CompressMultMv.
+  // cx holds the values in reduced precision. With 16 bit indices, cd
+  // holds the row increments, cc the first row of each column and cp
+  // the column pointers (explicit zeros are added where an increment
+  // does not fit), otherwise the pattern of A is used.
+  typedef typename ARReducedType<ARTYPE>::type ARREDUCED;
+  std::vector<ARREDUCED>      cx;
+  std::vector<ARindex>        cp;
+  std::vector<int>            cc;
+  std::vector<unsigned short> cd;
+  bool                        compressed = false;
+  bool                        compressedShort = false;
+  double                      cnorm = 0.0;
+
   virtual void Copy(const ARumSymMatrix& other);
 
   void ClearMem();
@@ -68,6 +102,18 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
 
   void Check(int status);
 
+  void Factor(ARSparseMatrix<ARTYPE>* M);
+
+  void MultMvParallel(ARTYPE* v, ARTYPE* w);
+
+  void MultMvStored(ARTYPE* v, ARTYPE* w);
+
+  void MultMvCompressed(ARTYPE* v, ARTYPE* w);
+
+  void CompressFull();
+
+  void MultMmStored(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
  private:
 
     // Internal matrix storing A - s I
@@ -78,7 +124,7 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
 
  public:
 
-  int nzeros() { return A->nzeros(); }
+  ARindex nzeros() { return A->nzeros(); }
 
   bool IsFactored() { return factored; }
 
@@ -86,20 +132,60 @@ class ARumSymMatrix: public ARMatrix<ARTYPE> {
 
   void FactorAsI(ARTYPE sigma);
 
+  int Threads() { return nthreads; }
+
+  void SetThreads(int nthreadsp);
+  // Sets the number of threads used by MultMv (0 means all cores).
+  // With more than one thread, the full symmetric pattern is built
+  // once and each thread computes a fixed block of w, so the result
+  // does not depend on the number of threads.
+
+  double CompressMultMv(bool shortIndices = false);
+  // Makes MultMv use a copy of the stored triangle with the values in
+  // single precision (and, if shortIndices is true, the row indices as
+  // 16 bit increments), while w is still accumulated in ARTYPE. For
+  // double precision this reduces the data read by MultMv from 12 to
+  // 8 (or 6) bytes per stored entry. With more than one thread (see
+  // SetThreads), the rows of w must be independent, so MultMv uses a
+  // compressed copy of the full matrix instead, which reads both
+  // triangles. The return value is ||E||_F, where A + E is the matrix
+  // used by MultMv, a bound on the change of each eigenvalue. MultMm
+  // and MultInvv are not affected.
+
+  bool IsCompressed() const { return compressed; }
+
+  double PerturbationNorm() const { return compressed ? cnorm : 0.0; }
+
+  bool IsReordered() { return A && A->IsReordered(); }
+
+  const int* Permutation() { return A ? A->Permutation() : nullptr; }
+  // Ordering used to store the matrix (see DefineMatrix), or null.
+
   void MultMv(ARTYPE* v, ARTYPE* w);
 
+  void MultMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+
   void MultInvv(ARTYPE* v, ARTYPE* w);
 
-  void DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
-                    char uplop = 'L', double thresholdp = 0.1, bool check = true,
-                    bool owner = false);
+  void MultInvMm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves A*W = V (or AsI*W = V) for the k columns of V. UMFPACK
+  // solves one vector at a time, but the work arrays are shared.
 
-  ARumSymMatrix(): ARMatrix<ARTYPE>(), factored(false), Numeric(nullptr), A(nullptr), AsI(nullptr), Afull(nullptr)
+  void DefineMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
+                    char uplop = 'L', double thresholdp = 0.1, bool check = true,
+                    bool owner = false, bool reorder = false);
+  // If reorder is true, a copy of the matrix is stored with a reverse
+  // Cuthill-McKee ordering, which improves the locality of MultMv on
+  // matrices with scattered patterns. MultMv, MultMm and MultInvv
+  // still work with vectors in the original ordering, so eigenvectors
+  // and starting vectors need no special treatment.
+
+  ARumSymMatrix(): ARMatrix<ARTYPE>(), factored(false), nthreads(1), Numeric(nullptr), A(nullptr), AsI(nullptr), Afull(nullptr)
   {
   }
   // Short constructor that does nothing.
 
-  ARumSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+  ARumSymMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
                 char uplop = 'L', double thresholdp = 0.1);
   // Long constructor.
 
@@ -126,13 +212,25 @@ template<class ARTYPE>
 inline void ARumSymMatrix<ARTYPE>::ClearMem()
 {
 
-  if (factored && Numeric)
+  if (Numeric)
   {
     umfpack_free_numeric<ARTYPE>(&Numeric);
     Numeric = nullptr;
   }
 
-  if (Afull && Afull != A) { delete Afull; Afull = nullptr; }
+  factored = false;
+  umfSymbolic.Free();
+
+  if (Afull && Afull != A) delete Afull;
+  Afull = nullptr;
+
+  cx.clear();
+  cp.clear();
+  cc.clear();
+  cd.clear();
+  compressed      = false;
+  compressedShort = false;
+  cnorm           = 0.0;
 
   if (A) { delete A; A = nullptr; }
   if (AsI) { delete AsI; AsI = nullptr; }
@@ -156,9 +254,13 @@ void ARumSymMatrix<ARTYPE>::Copy(const ARumSymMatrix<ARTYPE>& other)
   this->n         = other.n;
   this->defined   = other.defined;
 
-  factored = false;
+  factored  = false;
+  uplo      = other.uplo;
+  threshold = other.threshold;
+  nthreads  = other.nthreads;
+  bounds    = other.bounds;
 
-  A->Copy(*other.A);
+  if (other.A) A = new ARSparseMatrix<ARTYPE>(*other.A);
 
   // Returning from here if "other" was not initialized.
 
@@ -169,6 +271,8 @@ void ARumSymMatrix<ARTYPE>::Copy(const ARumSymMatrix<ARTYPE>& other)
   for (int i = 0; i < UMFPACK_CONTROL; i++) control[i] = other.control[i];
   for (int i = 0; i < UMFPACK_INFO; i++) info[i] = other.info[i];
 
+  if (other.compressed) CompressMultMv(other.compressedShort);
+
 } // Copy.
 
 template<class ARTYPE>
@@ -178,8 +282,8 @@ void ARumSymMatrix<ARTYPE>::ExpandA()
   {
       if (A->IsTriangular())
       {
-          int ndiag = A->DiagIndices();
-          int nz = 2 * (A->nzeros() - ndiag) + this->n;
+          ARindex ndiag = A->DiagIndices();
+          ARindex nz = 2 * (A->nzeros() - ndiag) + this->n;
 
           Afull = new ARSparseMatrix<ARTYPE>(this->m, this->n, nz);
 
@@ -199,8 +303,8 @@ void ARumSymMatrix<ARTYPE>::SubtratcAsI(ARTYPE sigma)
   {
       ExpandA();
 
-      int ndiag = Afull->DiagIndices();
-      int nz = Afull->nzeros();
+      ARindex ndiag = Afull->DiagIndices();
+      ARindex nz = Afull->nzeros();
 
       AsI = new ARSparseMatrix<ARTYPE>(this->m, this->n, nz + this->n - ndiag);
   }
@@ -240,6 +344,24 @@ inline void ARumSymMatrix<ARTYPE>::Check(int status)
 } // Check.
 
 
+template<class ARTYPE>
+inline void ARumSymMatrix<ARTYPE>::Factor(ARSparseMatrix<ARTYPE>* M)
+{
+
+  // umfpack_symbolic is skipped if M was the last matrix analyzed
+  // and its pattern is the same. The previous Numeric is freed.
+
+  factored = false;
+
+  Check(umfSymbolic.Factor((const void*)M, (ARindex)this->m, (ARindex)this->n,
+                           M->pcol(), M->irow(), M->values(),
+                           &Numeric, control, info));
+
+  factored = true;
+
+} // Factor.
+
+
 template<class ARTYPE>
 void ARumSymMatrix<ARTYPE>::FactorA()
 {
@@ -251,18 +373,7 @@ void ARumSymMatrix<ARTYPE>::FactorA()
 
   ExpandA();
 
-  void *Symbolic;
-
-  auto ap = Afull->pcol();
-  auto ai = Afull->irow();
-  auto ax = Afull->values();
-
-  Check(umfpack_symbolic(this->m, this->n, ap, ai, ax, &Symbolic, control, info));
-  Check(umfpack_numeric(ap, ai, ax, Symbolic, &Numeric, control, info));
-
-  umfpack_free_symbolic<ARTYPE>(&Symbolic);
-
-  factored = true;
+  Factor(Afull);
 
   pA = A;
 
@@ -281,20 +392,10 @@ void ARumSymMatrix<ARTYPE>::FactorAsI(ARTYPE sigma)
   // Subtracting sigma*I from A.
   SubtratcAsI(sigma);
 
-  // Decomposing AsI.
-
-  void *Symbolic;
-
-  auto ap = AsI->pcol();
-  auto ai = AsI->irow();
-  auto ax = AsI->values();
-
-  Check(umfpack_symbolic(this->m, this->n, ap, ai, ax, &Symbolic, control, info));
-  Check(umfpack_numeric(ap, ai, ax, Symbolic, &Numeric, control, info));
+  // Decomposing AsI. Only its values change from one shift to
+  // the next, so the symbolic analysis is done once.
 
-  umfpack_free_symbolic<ARTYPE>(&Symbolic);
-
-  factored = true;
+  Factor(AsI);
 
 } // FactorAsI.
 
@@ -303,69 +404,299 @@ template<class ARTYPE>
 void ARumSymMatrix<ARTYPE>::MultMv(ARTYPE* v, ARTYPE* w)
 {
 
-  int    i,j,k;
-  ARTYPE t;
-
   // Quitting the function if A was not defined.
 
   if (!this->IsDefined()) {
     throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumSymMatrix::MultMv");
   }
 
-  auto ax = A->values();
-  auto ap = A->pcol();
-  auto ai = A->irow();
+  // Using the reduced precision copy of the full matrix (it handles
+  // the ordering itself).
+
+  if (compressed && nthreads > 1) {
+    Afull->MultMv(v, w);
+    return;
+  }
 
   // Determining w = M.v.
 
-  for (i = 0; i != this->m; i++) w[i] = (ARTYPE)0;
+  const int* perm = A->Permutation();
+
+  if (perm) {
+    ARTYPE* pv = pwork.Get(2*(size_t)this->n);
+    ARTYPE* pw = pv + this->n;
+    PermuteVector(this->n, perm, v, pv);
+    MultMvStored(pv, pw);
+    UnpermuteVector(this->n, perm, pw, w);
+  }
+  else {
+    MultMvStored(v, w);
+  }
 
-  if (uplo == 'L') {
+} // MultMv.
 
-    for (i = 0; i != this->n; i++) {
-      t = v[i];
-      k = ap[i];
-      if (k != ap[i+1] && ai[k] == i) {
-        w[i] += t*ax[k];
-        k++;
-      }
-      for (j = k; j < ap[i+1]; j++) {
-        w[ai[j]] += t*ax[j];
-        w[i] += v[ai[j]]*ax[j];
-      }
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultMvStored(ARTYPE* v, ARTYPE* w)
+{
+
+  if (nthreads > 1) {
+    MultMvParallel(v, w);
+    return;
+  }
+
+  if (compressed) {
+    MultMvCompressed(v, w);
+    return;
+  }
+
+  SymCSCMultMv(this->n, A->pcol(), A->irow(), A->values(), uplo, v, w);
+
+} // MultMvStored.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultMvCompressed(ARTYPE* v, ARTYPE* w)
+{
+
+  if (cd.empty()) {
+    SymCSCMultMv(this->n, A->pcol(), A->irow(), cx.data(), uplo, v, w);
+    return;
+  }
+
+  // Decoding the 16 bit row increments. The padding zeros may be
+  // treated as ordinary entries.
+
+  int  n   = this->n;
+  bool sym = (uplo == 'L') || (uplo == 'U');
+
+  for (int i = 0; i < n; i++) w[i] = (ARTYPE)0;
+
+  for (int j = 0; j < n; j++) {
+    ARTYPE t = v[j];
+    ARTYPE s = (ARTYPE)0;
+    int    r = cc[j];
+    for (ARindex p = cp[j]; p < cp[j+1]; p++) {
+      r += cd[p];
+      ARTYPE a = (ARTYPE)cx[p];
+      w[r] += a*t;
+      if (sym && r != j) s += a*v[r];
     }
+    w[j] += s;
+  }
+
+} // MultMvCompressed.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultMvParallel(ARTYPE* v, ARTYPE* w)
+{
+
+  // Afull holds both triangles, so column i of Afull is also row i
+  // of A and w[i] can be computed without touching other entries of w.
+
+  ExpandA();
+
+  auto ax = Afull->values();
+  auto ap = Afull->pcol();
+  auto ai = Afull->irow();
 
+  if ((int)bounds.size() != nthreads + 1) {
+    bounds.resize(nthreads + 1);
+    ARPartition(nthreads, this->n, ap, bounds.data());
   }
-  else if (uplo == 'U') {
 
-    for (i=  0; i != this->n; i++) {
-      t = v[i];
-      k = ap[i+1];
-      if (k!=ap[i] && ai[k-1] == i) {
-        w[i] += t*ax[k-1];
-        k--;
-      }
-      for (j = ap[i]; j < k; j++) {
-        w[ai[j]] += t*ax[j];
-        w[i] += v[ai[j]]*ax[j];
+  ARParallelFor(nthreads, bounds.data(), [=](int, int first, int last) {
+    for (int i = first; i < last; i++) {
+      ARTYPE t = (ARTYPE)0;
+      for (ARindex j = ap[i]; j < ap[i+1]; j++) {
+        t += ax[j]*v[ai[j]];
       }
+      w[i] = t;
     }
+  });
 
+} // MultMvParallel.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultMm(int k, const ARTYPE* V, int ldv,
+                                   ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumSymMatrix::MultMm");
+  }
+
+  const int* perm = A->Permutation();
+
+  if (perm) {
+    int n = this->n;
+    ARTYPE* pv = pwork.Get(2*(size_t)n*k);
+    ARTYPE* pw = pv + (size_t)n*k;
+    for (int r = 0; r < k; r++) {
+      PermuteVector(n, perm, &V[(size_t)r*ldv], &pv[(size_t)r*n]);
+    }
+    MultMmStored(k, pv, n, pw, n);
+    for (int r = 0; r < k; r++) {
+      UnpermuteVector(n, perm, &pw[(size_t)r*n], &W[(size_t)r*ldw]);
+    }
   }
   else {
+    MultMmStored(k, V, ldv, W, ldw);
+  }
 
-      for (i = 0; i != this->n; i++)
-      {
-          t = v[i];
-          for (j = ap[i]; j != ap[i + 1]; j++)
-          {
-              w[ai[j]] += t * ax[j];
-          }
+} // MultMm.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultMmStored(int k, const ARTYPE* V, int ldv,
+                                         ARTYPE* W, int ldw)
+{
+
+  if (nthreads <= 1) {
+    SymCSCMultMm(this->n, A->pcol(), A->irow(), A->values(), uplo,
+                 k, V, ldv, W, ldw);
+    return;
+  }
+
+  // Row gather on the full pattern (see MultMvParallel).
+
+  ExpandA();
+
+  auto ax = Afull->values();
+  auto ap = Afull->pcol();
+  auto ai = Afull->irow();
+
+  if ((int)bounds.size() != nthreads + 1) {
+    bounds.resize(nthreads + 1);
+    ARPartition(nthreads, this->n, ap, bounds.data());
+  }
+
+  ARParallelFor(nthreads, bounds.data(), [=](int, int first, int last) {
+    for (int i = first; i < last; i++) {
+      for (int r = 0; r < k; r++) {
+        const ARTYPE* v = &V[(size_t)r*ldv];
+        ARTYPE t = (ARTYPE)0;
+        for (ARindex j = ap[i]; j < ap[i+1]; j++) {
+          t += ax[j]*v[ai[j]];
+        }
+        W[i+(size_t)r*ldw] = t;
       }
+    }
+  });
+
+} // MultMmStored.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::SetThreads(int nthreadsp)
+{
+
+  nthreads = ARThreadCount(nthreadsp);
+  bounds.clear();
+
+  // Building the mirrored pattern now, so that it is not
+  // done inside the first call to MultMv.
 
+  if (nthreads > 1 && this->IsDefined()) ExpandA();
+
+  if (compressed && nthreads > 1) CompressFull();
+
+} // SetThreads.
+
+
+template<class ARTYPE>
+double ARumSymMatrix<ARTYPE>::CompressMultMv(bool shortIndices)
+{
+
+  const ARindex maxinc = 65535;
+
+  // Quitting the function if A was not defined.
+
+  if (!this->IsDefined()) {
+    throw ArpackError(ArpackError::DATA_UNDEFINED,
+                      "ARumSymMatrix::CompressMultMv");
   }
 
-} // MultMv.
+  int            n  = this->n;
+  const ARindex* ap = A->pcol();
+  const ARindex* ai = A->irow();
+  const ARTYPE*  ax = A->values();
+  bool           sym = (uplo == 'L') || (uplo == 'U');
+
+  cx.clear();
+  cp.clear();
+  cc.clear();
+  cd.clear();
+  compressed = false;
+
+  // Rounding the values and measuring the perturbation of the whole
+  // matrix (off-diagonal entries of a triangle appear twice).
+
+  double e2 = 0.0;
+
+  if (shortIndices) {
+    cp.resize(n+1);
+    cc.resize(n);
+    cp[0] = 0;
+  }
+  cx.reserve(A->nzeros());
+
+  for (int j = 0; j < n; j++) {
+    if (shortIndices) cc[j] = (ap[j] < ap[j+1]) ? (int)ai[ap[j]] : 0;
+    for (ARindex p = ap[j]; p < ap[j+1]; p++) {
+      ARREDUCED x = (ARREDUCED)ax[p];
+      if (std::isinf(std::abs((ARTYPE)x)) && !std::isinf(std::abs(ax[p]))) {
+        cx.clear();
+        cp.clear();
+        cc.clear();
+        cd.clear();
+        throw ArpackError(ArpackError::RANGE_ERROR,
+                          "ARumSymMatrix::CompressMultMv");
+      }
+      double e = (double)std::abs(ax[p] - (ARTYPE)x);
+      e2 += (sym && ai[p] != j) ? 2.0*e*e : e*e;
+      if (shortIndices) {
+        ARindex inc = (p == ap[j]) ? 0 : ai[p] - ai[p-1];
+        for (; inc > maxinc; inc -= maxinc) {
+          cd.push_back((unsigned short)maxinc);
+          cx.push_back((ARREDUCED)0);
+        }
+        cd.push_back((unsigned short)inc);
+      }
+      cx.push_back(x);
+    }
+    if (shortIndices) cp[j+1] = (ARindex)cx.size();
+  }
+
+  compressed      = true;
+  compressedShort = shortIndices;
+  cnorm           = std::sqrt(e2);
+
+  // The threaded MultMv needs both triangles.
+
+  if (nthreads > 1) CompressFull();
+
+  return cnorm;
+
+} // CompressMultMv.
+
+
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::CompressFull()
+{
+
+  ExpandA();
+
+  if (Afull->MultMvFormat() < ARSparseMatrix<ARTYPE>::CSRF) {
+    Afull->CompressMultMv(compressedShort);
+  }
+  Afull->SetThreads(nthreads);
+
+} // CompressFull.
 
 
 template<class ARTYPE>
@@ -385,7 +716,21 @@ void ARumSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 
   // Solving A.w = v (or AsI.w = v).
 
-  int status = umfpack_solve(UMFPACK_A, ap, ai, ax, w, v, Numeric, control, info);
+  const int* perm = A->Permutation();
+  int status;
+  ARindex* Wi = umfWi.Get(this->n);
+  double*  W  = umfW.Get(umfpack_wsize<ARTYPE>(this->n));
+
+  if (perm) {
+    ARTYPE* pv = pwork.Get(2*(size_t)this->n);
+    ARTYPE* pw = pv + this->n;
+    PermuteVector(this->n, perm, v, pv);
+    status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, pw, pv, Numeric, control, info, Wi, W);
+    UnpermuteVector(this->n, perm, pw, w);
+  }
+  else {
+    status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, w, v, Numeric, control, info, Wi, W);
+  }
 
   if (status != UMFPACK_OK)
     throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumSymMatrix::MultInvv");
@@ -393,10 +738,56 @@ void ARumSymMatrix<ARTYPE>::MultInvv(ARTYPE* v, ARTYPE* w)
 } // MultInvv.
 
 
+template<class ARTYPE>
+void ARumSymMatrix<ARTYPE>::MultInvMm(int k, const ARTYPE* V, int ldv,
+                                      ARTYPE* W, int ldw)
+{
+
+  // Quitting the function if A (or AsI) was not factored.
+
+  if (!IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARumSymMatrix::MultInvMm");
+  }
+
+  auto ap = pA->pcol();
+  auto ai = pA->irow();
+  auto ax = pA->values();
+
+  // Solving A.W = V (or AsI.W = V), one column at a time.
+
+  const int* perm = A->Permutation();
+  int        n    = this->n;
+  ARindex*   Wi   = umfWi.Get(n);
+  double*    Wd   = umfW.Get(umfpack_wsize<ARTYPE>(n));
+  ARTYPE*    pv   = perm ? pwork.Get(2*(size_t)n) : nullptr;
+  ARTYPE*    pw   = pv + (perm ? n : 0);
+
+  for (int r = 0; r < k; r++) {
+    ARTYPE* v = const_cast<ARTYPE*>(&V[(size_t)r*ldv]);
+    ARTYPE* w = &W[(size_t)r*ldw];
+    int status;
+    if (perm) {
+      PermuteVector(n, perm, v, pv);
+      status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, pw, pv, Numeric, control, info, Wi, Wd);
+      UnpermuteVector(n, perm, pw, w);
+    }
+    else {
+      status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, w, v, Numeric, control, info, Wi, Wd);
+    }
+    if (status != UMFPACK_OK) {
+      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumSymMatrix::MultInvMm");
+    }
+  }
+
+} // MultInvMm.
+
+
 template<class ARTYPE>
 inline void ARumSymMatrix<ARTYPE>::
-DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
-             char uplop, double thresholdp, bool check, bool owner)
+DefineMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
+             char uplop, double thresholdp, bool check, bool owner,
+             bool reorder)
 {
   ClearMem();
 
@@ -405,6 +796,7 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
 
   uplo = uplop;
   threshold = thresholdp;
+  bounds.clear();
 
   A = new ARSparseMatrix<ARTYPE>(np, np, pcolp, irowp, ap, nnzp, uplop, owner);
 
@@ -414,6 +806,9 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
                       "ARumSymMatrix::DefineMatrix");
   }
 
+  // Storing a permuted copy (the user arrays are not changed).
+  if (reorder) A->Reorder();
+
   umfpack_defaults<ARTYPE>(control);
 
   control[UMFPACK_PIVOT_TOLERANCE] = thresholdp;
@@ -425,9 +820,9 @@ DefineMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
 
 template<class ARTYPE>
 inline ARumSymMatrix<ARTYPE>::
-ARumSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
+ARumSymMatrix(int np, ARindex nnzp, ARTYPE* ap, ARindex* irowp, ARindex* pcolp,
               char uplop, double thresholdp)
-    : ARMatrix<ARTYPE>(np), factored(false), Numeric(nullptr),
+    : ARMatrix<ARTYPE>(np), factored(false), nthreads(1), Numeric(nullptr),
       A(nullptr), AsI(nullptr), Afull(nullptr)
 {
 
@@ -439,10 +834,10 @@ ARumSymMatrix(int np, int nnzp, ARTYPE* ap, int* irowp, int* pcolp,
 template<class ARTYPE>
 ARumSymMatrix<ARTYPE>::
 ARumSymMatrix(const std::string& file, double thresholdp)
-    : ARMatrix<ARTYPE>(), factored(false), Numeric(nullptr),
+    : ARMatrix<ARTYPE>(), factored(false), nthreads(1), Numeric(nullptr),
       A(nullptr), AsI(nullptr), Afull(nullptr)
 {
-  ARhbMatrix<int, ARTYPE> mat;
+  ARhbMatrix<ARindex, ARTYPE> mat;
   try {
     mat.Define(file, false);
   }
@@ -98,6 +98,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARumNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetRegularMode(this->objOP, &ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -109,6 +110,7 @@ inline void ARluNonSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
   ARStdEig<ARFLOAT, ARFLOAT, ARumNonSymMatrix<ARFLOAT, ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, 
                        &ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -125,6 +127,7 @@ ARluNonSymStdEig(int nevp, ARumNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -140,6 +143,7 @@ ARluNonSymStdEig(int nevp, ARumNonSymMatrix<ARFLOAT, ARFLOAT>& A,
   this->DefineParameters(A.ncols(), nevp, &A, 
                    &ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARumNonSymMatrix<ARFLOAT, ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
@@ -39,9 +39,7 @@ class ARumSymPencil
 
   ARumSymMatrix<ARTYPE>* A;
   ARumSymMatrix<ARTYPE>* B;
-  ARumSymMatrix<ARTYPE>  AsB;
-
-  void* Numeric;
+  ARumSymMatrix<ARTYPE>  AsB;    // A - sigma*B and its factors.
 
   virtual void Copy(const ARumSymPencil& other);
 
@@ -51,7 +49,7 @@ class ARumSymPencil
 
  public:
 
-  bool IsFactored() { return (Numeric != nullptr); }
+  bool IsFactored() { return AsB.IsFactored(); }
 
   void FactorAsB(ARTYPE sigma);
 
@@ -63,9 +61,12 @@ class ARumSymPencil
 
   void MultInvAsBv(ARTYPE* v, ARTYPE* w);
 
+  void MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw);
+  // Solves AsB*W = V for the k columns of V (one UMFPACK solve each).
+
   void DefineMatrices(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp);
 
-  ARumSymPencil(): A(nullptr), B(nullptr), Numeric(nullptr) { }
+  ARumSymPencil(): A(nullptr), B(nullptr) { }
   // Short constructor that does nothing.
 
   ARumSymPencil(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp);
@@ -95,8 +96,8 @@ inline void ARumSymPencil<ARTYPE>::Expand(ARumSymMatrix<ARTYPE>* A)
     if (mat->IsTriangular())
     {
         int n = mat->nrows();
-        int ndiag = mat->DiagIndices();
-        int nz = 2 * mat->nzeros();
+        ARindex ndiag = mat->DiagIndices();
+        ARindex nz = 2 * mat->nzeros();
 
         if (ndiag > 0)
         {
@@ -104,13 +105,13 @@ inline void ARumSymPencil<ARTYPE>::Expand(ARumSymMatrix<ARTYPE>* A)
             nz -= ndiag;
         }
 
-        int* ap = new int[n + 1];
-        int* ai = new int[nz];
+        ARindex* ap = new ARindex[n + 1];
+        ARindex* ai = new ARindex[nz];
         ARTYPE* ax = new ARTYPE[nz];
 
         ARSparseMatrix<ARTYPE> full(n, n, ap, ai, ax, nz);
 
-        int status = mat->Expand(full);
+        ARindex status = mat->Expand(full);
 
         if (status > 0)
         {
@@ -154,23 +155,24 @@ void ARumSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
         throw ArpackError(ArpackError::DATA_UNDEFINED, "ARumSymPencil::FactorAsB");
     }
 
-    // Defining matrix AsB.
+    // Defining matrix AsB. Its pattern is the union of the patterns
+    // of A and B, so it is built only once.
 
     if (!AsB.IsDefined()) {
 
         Expand(A);
         Expand(B);
 
-        int* count = new int[A->n];
-        int* work = new int[A->m];
+        ARindex* count = new ARindex[A->n];
+        ARindex* work = new ARindex[A->m];
 
-        int nnz = A->A->PrepareAdd(*B->A, count, work);
+        ARindex nnz = A->A->PrepareAdd(*B->A, count, work);
 
         delete[] count;
         delete[] work;
 
-        int* ap = new int[A->n + 1];
-        int* ai = new int[nnz];
+        ARindex* ap = new ARindex[A->n + 1];
+        ARindex* ai = new ARindex[nnz];
         ARTYPE* ax = new ARTYPE[nnz];
 
         // Do not validate AsB since though the matrix is allocated, no
@@ -183,25 +185,10 @@ void ARumSymPencil<ARTYPE>::FactorAsB(ARTYPE sigma)
 
     A->A->Add(-sigma, *B->A, *AsB.A);
 
-    // Decomposing AsB.
-
-    void* Symbolic;
-
-    auto ap = AsB.A->pcol();
-    auto ai = AsB.A->irow();
-    auto ax = AsB.A->values();
-
-    if (umfpack_symbolic(A->n, A->n, ap, ai, ax, &Symbolic, AsB.control, AsB.info) != UMFPACK_OK) {
-      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumSymPencil::FactorAsB");
-    }
-
-    if (umfpack_numeric(ap, ai, ax, Symbolic, &Numeric, AsB.control, AsB.info) != UMFPACK_OK) {
-      throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumSymPencil::FactorAsB");
-    }
-
-    umfpack_free_symbolic<ARTYPE>(&Symbolic);
+    // Decomposing AsB. The symbolic analysis is done on the first
+    // call only, the other ones just refactor the new values.
 
-    AsB.factored = true;
+    AsB.Factor(AsB.A);
 }
 
 template<class ARTYPE>
@@ -219,9 +206,9 @@ void ARumSymPencil<ARTYPE>::MultInvBAv(ARTYPE* v, ARTYPE* w)
 template<class ARTYPE>
 void ARumSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
 {
-  if (!Numeric) {
+  if (!AsB.IsFactored()) {
     throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
-                      "ARchSymPencil::MultInvAsBv");
+                      "ARumSymPencil::MultInvAsBv");
   }
 
   auto ap = AsB.A->pcol();
@@ -230,13 +217,44 @@ void ARumSymPencil<ARTYPE>::MultInvAsBv(ARTYPE* v, ARTYPE* w)
 
   // Solving A.w = v (or AsI.w = v).
 
-  int status = umfpack_solve(UMFPACK_A, ap, ai, ax, w, v, Numeric, AsB.control, AsB.info);
+  int status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, w, v, AsB.Numeric, AsB.control, AsB.info,
+                              AsB.umfWi.Get(A->n), AsB.umfW.Get(umfpack_wsize<ARTYPE>(A->n)));
 
   if (status != UMFPACK_OK)
     throw ArpackError(ArpackError::PARAMETER_ERROR, "ARumSymPencil::MultInvv");
 
 } // MultInvAsBv
 
+template<class ARTYPE>
+void ARumSymPencil<ARTYPE>::
+MultInvAsBm(int k, const ARTYPE* V, int ldv, ARTYPE* W, int ldw)
+{
+  if (!AsB.IsFactored()) {
+    throw ArpackError(ArpackError::NOT_FACTORED_MATRIX,
+                      "ARumSymPencil::MultInvAsBm");
+  }
+
+  auto ap = AsB.A->pcol();
+  auto ai = AsB.A->irow();
+  auto ax = AsB.A->values();
+
+  ARindex* Wi = AsB.umfWi.Get(A->n);
+  double*  Wd = AsB.umfW.Get(umfpack_wsize<ARTYPE>(A->n));
+
+  // Solving AsB.W = V, one column at a time.
+
+  for (int r = 0; r < k; r++) {
+    int status = umfpack_wsolve(UMFPACK_A, ap, ai, ax, &W[(size_t)r*ldw],
+                                const_cast<ARTYPE*>(&V[(size_t)r*ldv]),
+                                AsB.Numeric, AsB.control, AsB.info, Wi, Wd);
+    if (status != UMFPACK_OK) {
+      throw ArpackError(ArpackError::PARAMETER_ERROR,
+                        "ARumSymPencil::MultInvAsBm");
+    }
+  }
+
+} // MultInvAsBm
+
 template<class ARTYPE>
 inline void ARumSymPencil<ARTYPE>::
 DefineMatrices(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp)
@@ -250,6 +268,14 @@ DefineMatrices(ARumSymMatrix<ARTYPE>& Ap, ARumSymMatrix<ARTYPE>& Bp)
                       "ARumSymPencil::DefineMatrices");
   }
 
+  // A - sigma*B is built from the stored arrays, so both matrices
+  // must keep the original ordering.
+
+  if (A->IsReordered() || B->IsReordered()) {
+    throw ArpackError(ArpackError::NOT_IMPLEMENTED,
+                      "ARumSymPencil::DefineMatrices");
+  }
+
 } // DefineMatrices.
 
 
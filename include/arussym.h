@@ -98,6 +98,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetRegularMode()
 
   ARStdEig<ARFLOAT, ARFLOAT, ARumSymMatrix<ARFLOAT> >::
     SetRegularMode(this->objOP, &ARumSymMatrix<ARFLOAT>::MultMv);
+  this->ChangeMultOPm(&ARumSymMatrix<ARFLOAT>::MultMm);
 
 } // SetRegularMode.
 
@@ -108,6 +109,7 @@ inline void ARluSymStdEig<ARFLOAT>::SetShiftInvertMode(ARFLOAT sigmap)
 
   ARStdEig<ARFLOAT, ARFLOAT, ARumSymMatrix<ARFLOAT> >::
     SetShiftInvertMode(sigmap, this->objOP, &ARumSymMatrix<ARFLOAT>::MultInvv);
+  this->ChangeMultOPm(&ARumSymMatrix<ARFLOAT>::MultInvMm);
 
 } // SetShiftInvertMode.
 
@@ -122,6 +124,7 @@ ARluSymStdEig(int nevp, ARumSymMatrix<ARFLOAT>& A,
   this->NoShift();
   this->DefineParameters(A.ncols(), nevp, &A, &ARumSymMatrix<ARFLOAT>::MultMv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARumSymMatrix<ARFLOAT>::MultMm);
 
 } // Long constructor (regular mode).
 
@@ -136,6 +139,7 @@ ARluSymStdEig(int nevp, ARumSymMatrix<ARFLOAT>& A,
 
   this->DefineParameters(A.ncols(), nevp, &A, &ARumSymMatrix<ARFLOAT>::MultInvv,
                    whichp, ncvp, tolp, maxitp, residp, ishiftp);
+  this->ChangeMultOPm(&ARumSymMatrix<ARFLOAT>::MultInvMm);
   ChangeShift(sigmap);
 
 } // Long constructor (shift and invert mode).
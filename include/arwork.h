@@ -0,0 +1,137 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE arwork.h
+   Persistent work arrays used by the matrix and pencil classes in the
+   functions called at every Arnoldi iteration (MultMv, MultInvv,
+   MultMtMv, ...). A work array is allocated on its first use, grows
+   when a larger one is needed and is reused in all other calls, so
+   the iteration itself does not allocate memory.
+
+   ARWorkspaceAllocations returns the number of times any work array
+   was (re)allocated. It can be used to check that no allocation is
+   made once the first iteration is done.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef ARWORK_H
+#define ARWORK_H
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include "arerror.h"
+
+
+/* ARWorkspaceCounter */
+
+inline std::atomic<long>& ARWorkspaceCounter()
+{
+  static std::atomic<long> count(0);
+  return count;
+
+} // ARWorkspaceCounter.
+
+
+/* ARWorkspaceAllocations */
+
+inline long ARWorkspaceAllocations()
+// Number of work arrays allocated so far by all ARWorkspace objects.
+{
+  return ARWorkspaceCounter().load();
+
+} // ARWorkspaceAllocations.
+
+
+template<class ARTYPE>
+class ARWorkspace {
+
+ protected:
+
+  ARTYPE* buf;
+  size_t  cap;
+
+ public:
+
+  static const size_t Alignment = 64;
+
+  size_t Size() const { return cap; }
+
+  ARTYPE* Get(size_t n);
+  // Returns an array with at least n elements, aligned on a cache line.
+  // The contents are not preserved when the array has to grow.
+
+  void Free();
+  // Releases the array.
+
+  ARWorkspace(): buf(nullptr), cap(0) { }
+  // Constructor.
+
+  ARWorkspace(const ARWorkspace&): buf(nullptr), cap(0) { }
+  // Copy constructor. Work arrays are never shared, so the copy
+  // starts empty.
+
+  ARWorkspace& operator=(const ARWorkspace&) { return *this; }
+  // Assignment operator (keeps the current array).
+
+  ~ARWorkspace() { Free(); }
+  // Destructor.
+
+}; // class ARWorkspace.
+
+
+// ------------------------------------------------------------------------ //
+// ARWorkspace member functions definition.                                 //
+// ------------------------------------------------------------------------ //
+
+
+template<class ARTYPE>
+inline ARTYPE* ARWorkspace<ARTYPE>::Get(size_t n)
+{
+
+  if (n <= cap) return buf;
+
+  Free();
+
+  void* p;
+  try {
+    p = ::operator new(n*sizeof(ARTYPE), std::align_val_t(Alignment));
+  }
+  catch (std::bad_alloc&) {
+    throw ArpackError(ArpackError::INSUFICIENT_MEMORY, "ARWorkspace::Get");
+  }
+
+  buf = static_cast<ARTYPE*>(p);
+  cap = n;
+  for (size_t i = 0; i < n; i++) new (buf + i) ARTYPE();
+
+  ARWorkspaceCounter()++;
+
+  return buf;
+
+} // Get.
+
+
+template<class ARTYPE>
+inline void ARWorkspace<ARTYPE>::Free()
+{
+
+  if (buf) {
+    for (size_t i = 0; i < cap; i++) buf[i].~ARTYPE();
+    ::operator delete(buf, std::align_val_t(Alignment));
+  }
+  buf = nullptr;
+  cap = 0;
+
+} // Free.
+
+
+#endif // ARWORK_H
@@ -3,7 +3,7 @@
    c++ interface to ARPACK code.
 
    MODULE blas1c.h.
-   Interface to blas 1 and blas 2 FORTRAN routines.
+   Interface to blas 1, blas 2 and some blas 3 FORTRAN routines.
 
    ARPACK Authors
       Richard Lehoucq
@@ -303,6 +303,46 @@ inline void gemv(const char* trans, const ARint &m,
 } // gemv (arcomplex<double>)
 #endif
 
+// GEMM
+
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const float &alpha,
+                 const float a[], const ARint &lda, const float b[],
+                 const ARint &ldb, const float &beta, float c[],
+                 const ARint &ldc) {
+  F77NAME(sgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (float)
+
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const double &alpha,
+                 const double a[], const ARint &lda, const double b[],
+                 const ARint &ldb, const double &beta, double c[],
+                 const ARint &ldc) {
+  F77NAME(dgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (double)
+
+#ifdef ARCOMP_H
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const arcomplex<float> &alpha,
+                 const arcomplex<float> a[], const ARint &lda, const arcomplex<float> b[],
+                 const ARint &ldb, const arcomplex<float> &beta, arcomplex<float> c[],
+                 const ARint &ldc) {
+  F77NAME(cgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (arcomplex<float>)
+
+inline void gemm(const char* transa, const char* transb, const ARint &m,
+                 const ARint &n, const ARint &k, const arcomplex<double> &alpha,
+                 const arcomplex<double> a[], const ARint &lda, const arcomplex<double> b[],
+                 const ARint &ldb, const arcomplex<double> &beta, arcomplex<double> c[],
+                 const ARint &ldc) {
+  F77NAME(zgemm)(transa, transb, &m, &n, &k, &alpha, a, &lda,
+                 b, &ldb, &beta, c, &ldc);
+} // gemm (arcomplex<double>)
+#endif
+
 // GBMV
 
 inline void gbmv(const char* trans, const ARint &m, const ARint &n, 
@@ -363,5 +403,53 @@ inline void sbmv(const char* uplo, const ARint &n, const ARint &k,
   F77NAME(dsbmv)(uplo, &n, &k, &alpha, a, &lda, x, &incx, &beta, y, &incy);
 } // sbmv (double)
 
+// SPMV
+
+inline void spmv(const char* uplo, const ARint &n, const float &alpha,
+                 const float ap[], const float x[], const ARint &incx,
+                 const float &beta, float y[], const ARint &incy) {
+  F77NAME(sspmv)(uplo, &n, &alpha, ap, x, &incx, &beta, y, &incy);
+} // spmv (float)
+
+inline void spmv(const char* uplo, const ARint &n, const double &alpha,
+                 const double ap[], const double x[], const ARint &incx,
+                 const double &beta, double y[], const ARint &incy) {
+  F77NAME(dspmv)(uplo, &n, &alpha, ap, x, &incx, &beta, y, &incy);
+} // spmv (double)
+
+// SYMV
+
+inline void symv(const char* uplo, const ARint &n, const float &alpha,
+                 const float a[], const ARint &lda, const float x[],
+                 const ARint &incx, const float &beta, float y[],
+                 const ARint &incy) {
+  F77NAME(ssymv)(uplo, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy);
+} // symv (float)
+
+inline void symv(const char* uplo, const ARint &n, const double &alpha,
+                 const double a[], const ARint &lda, const double x[],
+                 const ARint &incx, const double &beta, double y[],
+                 const ARint &incy) {
+  F77NAME(dsymv)(uplo, &n, &alpha, a, &lda, x, &incx, &beta, y, &incy);
+} // symv (double)
+
+// SYMM
+
+inline void symm(const char* side, const char* uplo, const ARint &m,
+                 const ARint &n, const float &alpha, const float a[],
+                 const ARint &lda, const float b[], const ARint &ldb,
+                 const float &beta, float c[], const ARint &ldc) {
+  F77NAME(ssymm)(side, uplo, &m, &n, &alpha, a, &lda, b, &ldb,
+                 &beta, c, &ldc);
+} // symm (float)
+
+inline void symm(const char* side, const char* uplo, const ARint &m,
+                 const ARint &n, const double &alpha, const double a[],
+                 const ARint &lda, const double b[], const ARint &ldb,
+                 const double &beta, double c[], const ARint &ldc) {
+  F77NAME(dsymm)(side, uplo, &m, &n, &alpha, a, &lda, b, &ldb,
+                 &beta, c, &ldc);
+} // symm (double)
+
 
 #endif // BLAS1C_H
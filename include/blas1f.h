@@ -3,7 +3,7 @@
   c++ interface to ARPACK code.
 
   MODULE blas1f.h
-  BLAS 1 and BLAS 2 FORTRAN routines.
+  BLAS 1, BLAS 2 and some BLAS 3 FORTRAN routines.
 
   ARPACK Authors
      Richard Lehoucq
@@ -65,6 +65,26 @@ extern "C"
                       const float *x, const ARint *incx, const float *beta, 
                       float *y, const ARint *incy);
 
+  void F77NAME(sspmv)(const char* uplo, const ARint *n, const float *alpha,
+                      const float *ap, const float *x, const ARint *incx,
+                      const float *beta, float *y, const ARint *incy);
+
+  void F77NAME(ssymv)(const char* uplo, const ARint *n, const float *alpha,
+                      const float *a, const ARint *lda, const float *x,
+                      const ARint *incx, const float *beta, float *y,
+                      const ARint *incy);
+
+  void F77NAME(ssymm)(const char* side, const char* uplo, const ARint *m,
+                      const ARint *n, const float *alpha, const float *a,
+                      const ARint *lda, const float *b, const ARint *ldb,
+                      const float *beta, float *c, const ARint *ldc);
+
+  void F77NAME(sgemm)(const char* transa, const char* transb, const ARint *m,
+                      const ARint *n, const ARint *k, const float *alpha,
+                      const float *a, const ARint *lda, const float *b,
+                      const ARint *ldb, const float *beta, float *c,
+                      const ARint *ldc);
+
 // Double precision real routines.
 
   double F77NAME(dasum)(const ARint *n, const double *dx, const ARint *incx);
@@ -108,6 +128,26 @@ extern "C"
                       const double *x, const ARint *incx, const double *beta, 
                       double *y, const ARint *incy);
 
+  void F77NAME(dspmv)(const char* uplo, const ARint *n, const double *alpha,
+                      const double *ap, const double *x, const ARint *incx,
+                      const double *beta, double *y, const ARint *incy);
+
+  void F77NAME(dsymv)(const char* uplo, const ARint *n, const double *alpha,
+                      const double *a, const ARint *lda, const double *x,
+                      const ARint *incx, const double *beta, double *y,
+                      const ARint *incy);
+
+  void F77NAME(dsymm)(const char* side, const char* uplo, const ARint *m,
+                      const ARint *n, const double *alpha, const double *a,
+                      const ARint *lda, const double *b, const ARint *ldb,
+                      const double *beta, double *c, const ARint *ldc);
+
+  void F77NAME(dgemm)(const char* transa, const char* transb, const ARint *m,
+                      const ARint *n, const ARint *k, const double *alpha,
+                      const double *a, const ARint *lda, const double *b,
+                      const ARint *ldb, const double *beta, double *c,
+                      const ARint *ldc);
+
   // Single precision complex routines.
 
 #ifdef ARCOMP_H
@@ -162,6 +202,12 @@ extern "C"
                       const arcomplex<float> *beta, arcomplex<float> *y,
                       const ARint *incy);
 
+  void F77NAME(cgemm)(const char* transa, const char* transb, const ARint *m,
+                      const ARint *n, const ARint *k, const arcomplex<float> *alpha,
+                      const arcomplex<float> *a, const ARint *lda, const arcomplex<float> *b,
+                      const ARint *ldb, const arcomplex<float> *beta, arcomplex<float> *c,
+                      const ARint *ldc);
+
   // Double precision complex routines.
 
   void F77NAME(zdotc)(arcomplex<double> *c, const ARint *n,
@@ -214,6 +260,12 @@ extern "C"
                       const arcomplex<double> *beta, arcomplex<double> *y,
                       const ARint *incy);
 
+  void F77NAME(zgemm)(const char* transa, const char* transb, const ARint *m,
+                      const ARint *n, const ARint *k, const arcomplex<double> *alpha,
+                      const arcomplex<double> *a, const ARint *lda, const arcomplex<double> *b,
+                      const ARint *ldb, const arcomplex<double> *beta, arcomplex<double> *c,
+                      const ARint *ldc);
+
 #endif // ARCOMP_H
 
 }
@@ -3,7 +3,9 @@
    c++ interface to ARPACK code.
 
    MODULE CHOLMODc.h.
-   Interface to CHOLMOD routines.
+   Interface to CHOLMOD routines. When ARPACKPP_INDEX64 is defined
+   (see arch.h) the cholmod_l_* routines are used, so sparse matrices
+   must use 64-bit indices (ARindex).
 
    Author of this class:
       Martin Reuter
@@ -24,12 +26,26 @@
 #ifndef CHOLMODC_H
 #define CHOLMODC_H
 
+#include <atomic>
+#include <memory>
 #include "arcomp.h"
+#include "arch.h"
 #include "arerror.h"
+#include "arwork.h"
 #include "cholmod.h"
 
-inline cholmod_sparse* CholmodCreateSparse_impl(int m, int n, int nnz,
-  void* a, int* irow, int* pcol, char uplo, int itype, int xtype, int dtype)
+// CHOLMODNAME(f) is the CHOLMOD routine f for the ARindex type.
+
+#ifdef ARPACKPP_INDEX64
+#define CHOLMODNAME(f) cholmod_l_##f
+#define CHOLMOD_ARINDEX CHOLMOD_LONG
+#else
+#define CHOLMODNAME(f) cholmod_##f
+#define CHOLMOD_ARINDEX CHOLMOD_INT
+#endif
+
+inline cholmod_sparse* CholmodCreateSparse_impl(int m, int n, ARindex nnz,
+  void* a, ARindex* irow, ARindex* pcol, char uplo, int itype, int xtype, int dtype)
 {
   cholmod_sparse* A = (cholmod_sparse*)malloc(sizeof(cholmod_sparse));
 
@@ -56,15 +72,8 @@ inline cholmod_sparse* CholmodCreateSparse_impl(int m, int n, int nnz,
   return A;
 }
 
-inline cholmod_dense* CholmodCreateDense_impl(int m, int n, void* a, int xtype, int dtype)
+inline void CholmodSetDense_impl(cholmod_dense* A, int m, int n, void* a, int xtype, int dtype)
 {
-  cholmod_dense* A = (cholmod_dense*)malloc(sizeof(cholmod_dense));
-
-  if (!A) {
-      throw new ArpackError(ArpackError::INSUFICIENT_MEMORY,
-          "CholmodCreateDense_impl");
-  }
-
   A->nrow = m;
   A->ncol = n;
   A->nzmax = m * n;
@@ -73,6 +82,18 @@ inline cholmod_dense* CholmodCreateDense_impl(int m, int n, void* a, int xtype,
   A->z = NULL;
   A->xtype = xtype;
   A->dtype = dtype;
+}
+
+inline cholmod_dense* CholmodCreateDense_impl(int m, int n, void* a, int xtype, int dtype)
+{
+  cholmod_dense* A = (cholmod_dense*)malloc(sizeof(cholmod_dense));
+
+  if (!A) {
+      throw new ArpackError(ArpackError::INSUFICIENT_MEMORY,
+          "CholmodCreateDense_impl");
+  }
+
+  CholmodSetDense_impl(A, m, n, a, xtype, dtype);
 
   return A;
 }
@@ -81,30 +102,30 @@ inline cholmod_dense* CholmodCreateDense_impl(int m, int n, void* a, int xtype,
 
 #if CHOLMOD_MAIN_VERSION >= 5
 
-inline cholmod_sparse* CholmodCreateSparse(int m, int n, int nnz,
-  float* a, int* irow, int* pcol, char uplo)
+inline cholmod_sparse* CholmodCreateSparse(int m, int n, ARindex nnz,
+  float* a, ARindex* irow, ARindex* pcol, char uplo)
 {
-  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_INT, CHOLMOD_REAL, CHOLMOD_SINGLE);
+  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_ARINDEX, CHOLMOD_REAL, CHOLMOD_SINGLE);
 }
 
-inline cholmod_sparse* CholmodCreateSparse(int m, int n, int nnz,
-  arcomplex<float>* a, int* irow, int* pcol, char uplo)
+inline cholmod_sparse* CholmodCreateSparse(int m, int n, ARindex nnz,
+  arcomplex<float>* a, ARindex* irow, ARindex* pcol, char uplo)
 {
-  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_INT, CHOLMOD_COMPLEX, CHOLMOD_SINGLE);
+  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_ARINDEX, CHOLMOD_COMPLEX, CHOLMOD_SINGLE);
 }
 
 #endif
 
-inline cholmod_sparse* CholmodCreateSparse(int m, int n, int nnz,
-  double* a, int* irow, int* pcol, char uplo)
+inline cholmod_sparse* CholmodCreateSparse(int m, int n, ARindex nnz,
+  double* a, ARindex* irow, ARindex* pcol, char uplo)
 {
-  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_INT, CHOLMOD_REAL, CHOLMOD_DOUBLE);
+  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_ARINDEX, CHOLMOD_REAL, CHOLMOD_DOUBLE);
 }
 
-inline cholmod_sparse* CholmodCreateSparse(int m, int n, int nnz,
-  arcomplex<double>* a, int* irow, int* pcol, char uplo)
+inline cholmod_sparse* CholmodCreateSparse(int m, int n, ARindex nnz,
+  arcomplex<double>* a, ARindex* irow, ARindex* pcol, char uplo)
 {
-  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_INT, CHOLMOD_COMPLEX, CHOLMOD_DOUBLE);
+  return CholmodCreateSparse_impl(m, n, nnz, a, irow, pcol, uplo, CHOLMOD_ARINDEX, CHOLMOD_COMPLEX, CHOLMOD_DOUBLE);
 }
 
 /* CholmodCreateDense */
@@ -133,6 +154,35 @@ inline cholmod_dense* CholmodCreateDense(int m, int n, arcomplex<double>* a)
   return CholmodCreateDense_impl(m, n, a, CHOLMOD_COMPLEX, CHOLMOD_DOUBLE);
 }
 
+/* CholmodSetDense */
+
+/* Same as CholmodCreateDense, but the header is given by the caller
+   (e.g. a local variable), so nothing is allocated. */
+
+#if CHOLMOD_MAIN_VERSION >= 5
+
+inline void CholmodSetDense(cholmod_dense* A, int m, int n, float* a)
+{
+  CholmodSetDense_impl(A, m, n, a, CHOLMOD_REAL, CHOLMOD_SINGLE);
+}
+
+inline void CholmodSetDense(cholmod_dense* A, int m, int n, arcomplex<float>* a)
+{
+  CholmodSetDense_impl(A, m, n, a, CHOLMOD_COMPLEX, CHOLMOD_SINGLE);
+}
+
+#endif
+
+inline void CholmodSetDense(cholmod_dense* A, int m, int n, double* a)
+{
+  CholmodSetDense_impl(A, m, n, a, CHOLMOD_REAL, CHOLMOD_DOUBLE);
+}
+
+inline void CholmodSetDense(cholmod_dense* A, int m, int n, arcomplex<double>* a)
+{
+  CholmodSetDense_impl(A, m, n, a, CHOLMOD_COMPLEX, CHOLMOD_DOUBLE);
+}
+
 /* CholmodGetDenseData */
 
 template <typename ARTYPE> inline void CholmodGetDenseData(cholmod_dense* A, int n, ARTYPE* a)
@@ -140,6 +190,209 @@ template <typename ARTYPE> inline void CholmodGetDenseData(cholmod_dense* A, int
   memcpy(a, A->x, n * sizeof(ARTYPE));
 }
 
+/* CholmodSolveWork */
+
+/* Dense arrays used by cholmod_solve2. They are kept between solves,
+   so only the first one allocates memory. Copies start empty. */
+
+struct CholmodSolveWork {
+
+  cholmod_dense* X;
+  cholmod_dense* Y;
+  cholmod_dense* E;
+
+  void Free(cholmod_common* c)
+  {
+    if (X) CHOLMODNAME(free_dense)(&X, c);
+    if (Y) CHOLMODNAME(free_dense)(&Y, c);
+    if (E) CHOLMODNAME(free_dense)(&E, c);
+    X = Y = E = NULL;
+  }
+
+  CholmodSolveWork() : X(NULL), Y(NULL), E(NULL) { }
+  CholmodSolveWork(const CholmodSolveWork&) : X(NULL), Y(NULL), E(NULL) { }
+  CholmodSolveWork& operator=(const CholmodSolveWork&) { return *this; }
+
+};
+
+/* CholmodThreadWork */
+
+/* cholmod_solve2 changes its cholmod_common and work arrays, so solves
+   with a factor shared by several threads are made with the ones of
+   the calling thread, returned by CholmodLocalWork. pwork holds the
+   permuted vectors of reordered matrices. */
+
+template <typename ARTYPE>
+struct CholmodThreadWork {
+
+  cholmod_common      c;
+  CholmodSolveWork    work;
+  ARWorkspace<ARTYPE> pwork;
+
+  CholmodThreadWork() { CHOLMODNAME(start)(&c); }
+  ~CholmodThreadWork() { work.Free(&c); CHOLMODNAME(finish)(&c); }
+
+  CholmodThreadWork(const CholmodThreadWork&) = delete;
+  CholmodThreadWork& operator=(const CholmodThreadWork&) = delete;
+};
+
+template <typename ARTYPE>
+inline CholmodThreadWork<ARTYPE>& CholmodLocalWork()
+{
+  static thread_local CholmodThreadWork<ARTYPE> work;
+  return work;
+}
+
+/* CholmodFactor */
+
+/* Reference counted cholmod_factor. Copies of a factored ARchSymMatrix
+   (or ARchSymPencil) share one CholmodFactor through a std::shared_ptr,
+   and a shared factor is never changed (see CholmodFactorize), so all
+   of them can solve with it at the same time. */
+
+struct CholmodFactor {
+
+  cholmod_factor* L;
+  cholmod_common  c;   // Used to free L.
+
+  explicit CholmodFactor(cholmod_factor* Lp = NULL) : L(Lp) { CHOLMODNAME(start)(&c); }
+  ~CholmodFactor() { if (L) CHOLMODNAME(free_factor)(&L, &c); CHOLMODNAME(finish)(&c); }
+
+  CholmodFactor(const CholmodFactor&) = delete;
+  CholmodFactor& operator=(const CholmodFactor&) = delete;
+};
+
+/* CholmodSolve */
+
+/* Solves L*x = b (x and b may be the same array) for one vector of
+   length n, reusing the arrays in work. Returns false on failure. */
+
+template <typename ARTYPE>
+inline bool CholmodSolve(cholmod_factor* L, int n, ARTYPE* b, ARTYPE* x,
+                         CholmodSolveWork& work, cholmod_common* c)
+{
+  cholmod_dense B;
+
+  CholmodSetDense(&B, n, 1, b);
+
+  if (!CHOLMODNAME(solve2)(CHOLMOD_A, L, &B, NULL, &work.X, NULL,
+                           &work.Y, &work.E, c)) {
+    return false;
+  }
+
+  CholmodGetDenseData(work.X, n, x);
+
+  return true;
+}
+
+/* Solves L*X = B for k vectors of length n stored by columns, with
+   leading dimensions ldb and ldx, in a single call to cholmod_solve2. */
+
+template <typename ARTYPE>
+inline bool CholmodSolve(cholmod_factor* L, int n, int k, const ARTYPE* b,
+                         int ldb, ARTYPE* x, int ldx,
+                         CholmodSolveWork& work, cholmod_common* c)
+{
+  cholmod_dense B;
+
+  CholmodSetDense(&B, n, k, const_cast<ARTYPE*>(b));
+  B.d     = ldb;
+  B.nzmax = (size_t)ldb*k;
+
+  if (!CHOLMODNAME(solve2)(CHOLMOD_A, L, &B, NULL, &work.X, NULL,
+                           &work.Y, &work.E, c)) {
+    return false;
+  }
+
+  const ARTYPE* X = (const ARTYPE*)work.X->x;
+
+  for (int r = 0; r < k; r++) {
+    memcpy(&x[(size_t)r*ldx], &X[(size_t)r*work.X->d], n*sizeof(ARTYPE));
+  }
+
+  return true;
+}
+
+/* CholmodFactorize */
+
+/* Computes the numeric factorization of A + beta[0]*I in L. L is
+   analyzed first if it is null. A supernodal factor is always LL', so
+   it fails when A + beta[0]*I is indefinite. In that case the analysis
+   is redone for a simplicial LDL' factor, which only needs nonzero
+   pivots. c is changed, so later analyses keep the simplicial factor.
+   Returns the value of cholmod_factorize_p. */
+
+inline int CholmodFactorize(cholmod_sparse* A, double beta[2],
+                            cholmod_factor*& L, cholmod_common* c)
+{
+  if (!L) L = CHOLMODNAME(analyze)(A, c);
+
+  int info = CHOLMODNAME(factorize_p)(A, beta, NULL, 0, L, c);
+
+  if ((c->status == CHOLMOD_NOT_POSDEF) && L->is_super) {
+    CHOLMODNAME(free_factor)(&L, c);
+    c->supernodal = CHOLMOD_SIMPLICIAL;
+    L    = CHOLMODNAME(analyze)(A, c);
+    info = CHOLMODNAME(factorize_p)(A, beta, NULL, 0, L, c);
+  }
+
+  return info;
+}
+
+/* Same as above for a reference counted factor. If F is shared with
+   another matrix, the new factorization is made in a copy of F (which
+   keeps the symbolic analysis), so the other owners are not affected. */
+
+inline int CholmodFactorize(cholmod_sparse* A, double beta[2],
+                            std::shared_ptr<CholmodFactor>& F, cholmod_common* c)
+{
+  if (F && (F.use_count() > 1)) {
+    F = std::make_shared<CholmodFactor>(CHOLMODNAME(copy_factor)(F->L, c));
+  }
+  if (!F) F = std::make_shared<CholmodFactor>();
+
+  return CholmodFactorize(A, beta, F->L, c);
+}
+
+/* CholmodInertia */
+
+/* Number of negative, zero and positive eigenvalues of the matrix
+   factored in L. An LL' factor exists only for a positive definite
+   matrix. A simplicial LDL' factor keeps D(j,j) as the first entry of
+   column j. */
+
+template <typename ARTYPE>
+inline void CholmodInertia(cholmod_factor* L, int& neg, int& zero, int& pos)
+{
+  neg = zero = pos = 0;
+
+  if (L->is_ll) {
+    pos = (int)L->n;
+    return;
+  }
+
+  const ARindex* Lp = (const ARindex*)L->p;
+  const ARTYPE*  Lx = (const ARTYPE*)L->x;
+
+  for (size_t j = 0; j < L->n; j++) {
+    ARTYPE d = Lx[Lp[j]];
+    if (d < (ARTYPE)0) neg++;
+    else if (d > (ARTYPE)0) pos++;
+    else zero++;
+  }
+}
+
+/* CholmodNewPattern */
+
+/* Returns a new number each time it is called. Used to tell whether
+   a symbolic analysis was made for the current pattern of a matrix. */
+
+inline long CholmodNewPattern()
+{
+  static std::atomic<long> id(0);
+  return ++id;
+}
+
 /* CholmodAdd */
 
 /* cholmod_add does not support xtype CHOLMOD_COMPLEX, so those are not provided. */
@@ -149,7 +402,7 @@ inline cholmod_sparse* CholmodAdd(cholmod_sparse* A, float sigma, cholmod_sparse
   if (sigma == 0.f) return A;
   double alpha[2] = { 1.0, 0.0 };
   double beta[2] = { sigma, 0.0 };
-  return cholmod_add(A, B, alpha, beta, 1, 0, c);
+  return CHOLMODNAME(add)(A, B, alpha, beta, 1, 0, c);
 }
 
 inline cholmod_sparse* CholmodAdd(cholmod_sparse* A, double sigma, cholmod_sparse* B, cholmod_common* c)
@@ -157,7 +410,7 @@ inline cholmod_sparse* CholmodAdd(cholmod_sparse* A, double sigma, cholmod_spars
   if (sigma == 0.0) return A;
   double alpha[2] = { 1.0, 0.0 };
   double beta[2] = { sigma, 0.0 };
-  return cholmod_add(A, B, alpha, beta, 1, 0, c);
+  return CHOLMODNAME(add)(A, B, alpha, beta, 1, 0, c);
 }
 
 #endif // CHOLMODC_H
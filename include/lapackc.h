@@ -295,6 +295,226 @@ inline void sptrs(const char* trans, const ARint &n, const ARint &nrhs,
 } // sptrs (double)
 
 
+// SYTRF
+
+inline void sytrf(const char* uplo, const ARint &n, float a[],
+                  const ARint &lda, ARint ipiv[], float work[],
+                  const ARint &lwork, ARint &info) {
+  F77NAME(ssytrf)(uplo, &n, a, &lda, ipiv, work, &lwork, &info);
+} // sytrf (float)
+
+inline void sytrf(const char* uplo, const ARint &n, double a[],
+                  const ARint &lda, ARint ipiv[], double work[],
+                  const ARint &lwork, ARint &info) {
+  F77NAME(dsytrf)(uplo, &n, a, &lda, ipiv, work, &lwork, &info);
+} // sytrf (double)
+
+
+// SYTRS
+
+inline void sytrs(const char* uplo, const ARint &n, const ARint &nrhs,
+                  const float a[], const ARint &lda, const ARint ipiv[],
+                  float b[], const ARint &ldb, ARint &info) {
+  F77NAME(ssytrs)(uplo, &n, &nrhs, a, &lda, ipiv, b, &ldb, &info);
+} // sytrs (float)
+
+inline void sytrs(const char* uplo, const ARint &n, const ARint &nrhs,
+                  const double a[], const ARint &lda, const ARint ipiv[],
+                  double b[], const ARint &ldb, ARint &info) {
+  F77NAME(dsytrs)(uplo, &n, &nrhs, a, &lda, ipiv, b, &ldb, &info);
+} // sytrs (double)
+
+
+// POTRF
+
+inline void potrf(const char* uplo, const ARint &n, float a[],
+                  const ARint &lda, ARint &info) {
+  F77NAME(spotrf)(uplo, &n, a, &lda, &info);
+} // potrf (float)
+
+inline void potrf(const char* uplo, const ARint &n, double a[],
+                  const ARint &lda, ARint &info) {
+  F77NAME(dpotrf)(uplo, &n, a, &lda, &info);
+} // potrf (double)
+
+
+// POTRS
+
+inline void potrs(const char* uplo, const ARint &n, const ARint &nrhs,
+                  const float a[], const ARint &lda, float b[],
+                  const ARint &ldb, ARint &info) {
+  F77NAME(spotrs)(uplo, &n, &nrhs, a, &lda, b, &ldb, &info);
+} // potrs (float)
+
+inline void potrs(const char* uplo, const ARint &n, const ARint &nrhs,
+                  const double a[], const ARint &lda, double b[],
+                  const ARint &ldb, ARint &info) {
+  F77NAME(dpotrs)(uplo, &n, &nrhs, a, &lda, b, &ldb, &info);
+} // potrs (double)
+
+
+// PBTRF
+
+inline void pbtrf(const char* uplo, const ARint &n, const ARint &kd,
+                  float ab[], const ARint &ldab, ARint &info) {
+  F77NAME(spbtrf)(uplo, &n, &kd, ab, &ldab, &info);
+} // pbtrf (float)
+
+inline void pbtrf(const char* uplo, const ARint &n, const ARint &kd,
+                  double ab[], const ARint &ldab, ARint &info) {
+  F77NAME(dpbtrf)(uplo, &n, &kd, ab, &ldab, &info);
+} // pbtrf (double)
+
+
+// PBTRS
+
+inline void pbtrs(const char* uplo, const ARint &n, const ARint &kd,
+                  const ARint &nrhs, const float ab[], const ARint &ldab,
+                  float b[], const ARint &ldb, ARint &info) {
+  F77NAME(spbtrs)(uplo, &n, &kd, &nrhs, ab, &ldab, b, &ldb, &info);
+} // pbtrs (float)
+
+inline void pbtrs(const char* uplo, const ARint &n, const ARint &kd,
+                  const ARint &nrhs, const double ab[], const ARint &ldab,
+                  double b[], const ARint &ldb, ARint &info) {
+  F77NAME(dpbtrs)(uplo, &n, &kd, &nrhs, ab, &ldab, b, &ldb, &info);
+} // pbtrs (double)
+
+
+// SYEV
+
+inline void syev(const char* jobz, const char* uplo, const ARint &n,
+                 float a[], const ARint &lda, float w[], float work[],
+                 const ARint &lwork, ARint &info) {
+  F77NAME(ssyev)(jobz, uplo, &n, a, &lda, w, work, &lwork, &info);
+} // syev (float)
+
+inline void syev(const char* jobz, const char* uplo, const ARint &n,
+                 double a[], const ARint &lda, double w[], double work[],
+                 const ARint &lwork, ARint &info) {
+  F77NAME(dsyev)(jobz, uplo, &n, a, &lda, w, work, &lwork, &info);
+} // syev (double)
+
+
+// GEES (Schur factorization, without ordering the eigenvalues).
+
+inline void gees(const char* jobvs, const ARint &n, float a[],
+                 const ARint &lda, ARint &sdim, float wr[], float wi[],
+                 float vs[], const ARint &ldvs, float work[],
+                 const ARint &lwork, ARlogical bwork[], ARint &info) {
+  F77NAME(sgees)(jobvs, "N", NULL, &n, a, &lda, &sdim, wr, wi, vs, &ldvs,
+                  work, &lwork, bwork, &info);
+} // gees (float)
+
+inline void gees(const char* jobvs, const ARint &n, double a[],
+                 const ARint &lda, ARint &sdim, double wr[], double wi[],
+                 double vs[], const ARint &ldvs, double work[],
+                 const ARint &lwork, ARlogical bwork[], ARint &info) {
+  F77NAME(dgees)(jobvs, "N", NULL, &n, a, &lda, &sdim, wr, wi, vs, &ldvs,
+                  work, &lwork, bwork, &info);
+} // gees (double)
+
+#ifdef ARCOMP_H
+inline void gees(const char* jobvs, const ARint &n, arcomplex<float> a[],
+                 const ARint &lda, ARint &sdim, arcomplex<float> w[],
+                 arcomplex<float> vs[], const ARint &ldvs, arcomplex<float> work[],
+                 const ARint &lwork, float rwork[], ARlogical bwork[],
+                 ARint &info) {
+  F77NAME(cgees)(jobvs, "N", NULL, &n, a, &lda, &sdim, w, vs, &ldvs,
+                  work, &lwork, rwork, bwork, &info);
+} // gees (arcomplex<float>)
+
+inline void gees(const char* jobvs, const ARint &n, arcomplex<double> a[],
+                 const ARint &lda, ARint &sdim, arcomplex<double> w[],
+                 arcomplex<double> vs[], const ARint &ldvs, arcomplex<double> work[],
+                 const ARint &lwork, double rwork[], ARlogical bwork[],
+                 ARint &info) {
+  F77NAME(zgees)(jobvs, "N", NULL, &n, a, &lda, &sdim, w, vs, &ldvs,
+                  work, &lwork, rwork, bwork, &info);
+} // gees (arcomplex<double>)
+#endif
+
+// TRSEN (reordering of a Schur factorization, job = 'N').
+
+inline void trsen(const char* compq, const ARlogical select[], const ARint &n,
+                  float t[], const ARint &ldt, float q[], const ARint &ldq,
+                  float wr[], float wi[], ARint &m, float work[],
+                  const ARint &lwork, ARint iwork[], const ARint &liwork,
+                  ARint &info) {
+  float s, sep;
+  F77NAME(strsen)("N", compq, select, &n, t, &ldt, q, &ldq, wr, wi, &m,
+                   &s, &sep, work, &lwork, iwork, &liwork, &info);
+} // trsen (float)
+
+inline void trsen(const char* compq, const ARlogical select[], const ARint &n,
+                  double t[], const ARint &ldt, double q[], const ARint &ldq,
+                  double wr[], double wi[], ARint &m, double work[],
+                  const ARint &lwork, ARint iwork[], const ARint &liwork,
+                  ARint &info) {
+  double s, sep;
+  F77NAME(dtrsen)("N", compq, select, &n, t, &ldt, q, &ldq, wr, wi, &m,
+                   &s, &sep, work, &lwork, iwork, &liwork, &info);
+} // trsen (double)
+
+#ifdef ARCOMP_H
+inline void trsen(const char* compq, const ARlogical select[], const ARint &n,
+                  arcomplex<float> t[], const ARint &ldt, arcomplex<float> q[],
+                  const ARint &ldq, arcomplex<float> w[], ARint &m,
+                  arcomplex<float> work[], const ARint &lwork, ARint &info) {
+  float s, sep;
+  F77NAME(ctrsen)("N", compq, select, &n, t, &ldt, q, &ldq, w, &m, &s, &sep,
+                   work, &lwork, &info);
+} // trsen (arcomplex<float>)
+
+inline void trsen(const char* compq, const ARlogical select[], const ARint &n,
+                  arcomplex<double> t[], const ARint &ldt, arcomplex<double> q[],
+                  const ARint &ldq, arcomplex<double> w[], ARint &m,
+                  arcomplex<double> work[], const ARint &lwork, ARint &info) {
+  double s, sep;
+  F77NAME(ztrsen)("N", compq, select, &n, t, &ldt, q, &ldq, w, &m, &s, &sep,
+                   work, &lwork, &info);
+} // trsen (arcomplex<double>)
+#endif
+
+// TREVC (eigenvectors of a quasi-triangular matrix).
+
+inline void trevc(const char* side, const char* howmny, const ARint &n,
+                  const float t[], const ARint &ldt, float vl[],
+                  const ARint &ldvl, float vr[], const ARint &ldvr,
+                  const ARint &mm, ARint &m, float work[], ARint &info) {
+  F77NAME(strevc)(side, howmny, NULL, &n, t, &ldt, vl, &ldvl, vr, &ldvr,
+                   &mm, &m, work, &info);
+} // trevc (float)
+
+inline void trevc(const char* side, const char* howmny, const ARint &n,
+                  const double t[], const ARint &ldt, double vl[],
+                  const ARint &ldvl, double vr[], const ARint &ldvr,
+                  const ARint &mm, ARint &m, double work[], ARint &info) {
+  F77NAME(dtrevc)(side, howmny, NULL, &n, t, &ldt, vl, &ldvl, vr, &ldvr,
+                   &mm, &m, work, &info);
+} // trevc (double)
+
+#ifdef ARCOMP_H
+inline void trevc(const char* side, const char* howmny, const ARint &n,
+                  arcomplex<float> t[], const ARint &ldt, arcomplex<float> vl[],
+                  const ARint &ldvl, arcomplex<float> vr[], const ARint &ldvr,
+                  const ARint &mm, ARint &m, arcomplex<float> work[],
+                  float rwork[], ARint &info) {
+  F77NAME(ctrevc)(side, howmny, NULL, &n, t, &ldt, vl, &ldvl, vr, &ldvr,
+                   &mm, &m, work, rwork, &info);
+} // trevc (arcomplex<float>)
+
+inline void trevc(const char* side, const char* howmny, const ARint &n,
+                  arcomplex<double> t[], const ARint &ldt, arcomplex<double> vl[],
+                  const ARint &ldvl, arcomplex<double> vr[], const ARint &ldvr,
+                  const ARint &mm, ARint &m, arcomplex<double> work[],
+                  double rwork[], ARint &info) {
+  F77NAME(ztrevc)(side, howmny, NULL, &n, t, &ldt, vl, &ldvl, vr, &ldvr,
+                   &mm, &m, work, rwork, &info);
+} // trevc (arcomplex<double>)
+#endif
+
+
 inline void second(const float &t) {
   F77NAME(second)(&t);
 }
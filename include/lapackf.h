@@ -70,6 +70,53 @@ extern "C"
                        const ARint *nrhs, float *ap, ARint *ipiv, 
                        float *b, const ARint *ldb, ARint *info);
 
+  void F77NAME(ssytrf)(const char* uplo, const ARint *n, float *a,
+                       const ARint *lda, ARint *ipiv, float *work,
+                       const ARint *lwork, ARint *info);
+
+  void F77NAME(ssytrs)(const char* uplo, const ARint *n,
+                       const ARint *nrhs, const float *a, const ARint *lda,
+                       const ARint *ipiv, float *b, const ARint *ldb,
+                       ARint *info);
+
+  void F77NAME(spotrf)(const char* uplo, const ARint *n, float *a,
+                       const ARint *lda, ARint *info);
+
+  void F77NAME(spotrs)(const char* uplo, const ARint *n,
+                       const ARint *nrhs, const float *a, const ARint *lda,
+                       float *b, const ARint *ldb, ARint *info);
+
+  void F77NAME(spbtrf)(const char* uplo, const ARint *n, const ARint *kd,
+                       float *ab, const ARint *ldab, ARint *info);
+
+  void F77NAME(spbtrs)(const char* uplo, const ARint *n, const ARint *kd,
+                       const ARint *nrhs, const float *ab,
+                       const ARint *ldab, float *b, const ARint *ldb,
+                       ARint *info);
+
+  void F77NAME(ssyev)(const char* jobz, const char* uplo, const ARint *n,
+                       float *a, const ARint *lda, float *w, float *work,
+                       const ARint *lwork, ARint *info);
+
+  void F77NAME(sgees)(const char* jobvs, const char* sort,
+                       const void *select, const ARint *n, float *a,
+                       const ARint *lda, ARint *sdim, float *wr, float *wi,
+                       float *vs, const ARint *ldvs, float *work,
+                       const ARint *lwork, ARlogical *bwork, ARint *info);
+
+  void F77NAME(strsen)(const char* job, const char* compq,
+                        const ARlogical *select, const ARint *n, float *t,
+                        const ARint *ldt, float *q, const ARint *ldq,
+                        float *wr, float *wi, ARint *m, float *s, float *sep,
+                        float *work, const ARint *lwork, ARint *iwork,
+                        const ARint *liwork, ARint *info);
+
+  void F77NAME(strevc)(const char* side, const char* howmny,
+                        const ARlogical *select, const ARint *n,
+                        const float *t, const ARint *ldt, float *vl,
+                        const ARint *ldvl, float *vr, const ARint *ldvr,
+                        const ARint *mm, ARint *m, float *work, ARint *info);
+
   // Double precision real routines.
 
   double F77NAME(dlapy2)(const double *x, const double *y);
@@ -118,6 +165,53 @@ extern "C"
                        const ARint *nrhs, double *ap, ARint *ipiv, 
                        double *b, const ARint *ldb, ARint *info);
 
+  void F77NAME(dsytrf)(const char* uplo, const ARint *n, double *a,
+                       const ARint *lda, ARint *ipiv, double *work,
+                       const ARint *lwork, ARint *info);
+
+  void F77NAME(dsytrs)(const char* uplo, const ARint *n,
+                       const ARint *nrhs, const double *a, const ARint *lda,
+                       const ARint *ipiv, double *b, const ARint *ldb,
+                       ARint *info);
+
+  void F77NAME(dpotrf)(const char* uplo, const ARint *n, double *a,
+                       const ARint *lda, ARint *info);
+
+  void F77NAME(dpotrs)(const char* uplo, const ARint *n,
+                       const ARint *nrhs, const double *a, const ARint *lda,
+                       double *b, const ARint *ldb, ARint *info);
+
+  void F77NAME(dpbtrf)(const char* uplo, const ARint *n, const ARint *kd,
+                       double *ab, const ARint *ldab, ARint *info);
+
+  void F77NAME(dpbtrs)(const char* uplo, const ARint *n, const ARint *kd,
+                       const ARint *nrhs, const double *ab,
+                       const ARint *ldab, double *b, const ARint *ldb,
+                       ARint *info);
+
+  void F77NAME(dsyev)(const char* jobz, const char* uplo, const ARint *n,
+                       double *a, const ARint *lda, double *w, double *work,
+                       const ARint *lwork, ARint *info);
+
+  void F77NAME(dgees)(const char* jobvs, const char* sort,
+                       const void *select, const ARint *n, double *a,
+                       const ARint *lda, ARint *sdim, double *wr, double *wi,
+                       double *vs, const ARint *ldvs, double *work,
+                       const ARint *lwork, ARlogical *bwork, ARint *info);
+
+  void F77NAME(dtrsen)(const char* job, const char* compq,
+                        const ARlogical *select, const ARint *n, double *t,
+                        const ARint *ldt, double *q, const ARint *ldq,
+                        double *wr, double *wi, ARint *m, double *s, double *sep,
+                        double *work, const ARint *lwork, ARint *iwork,
+                        const ARint *liwork, ARint *info);
+
+  void F77NAME(dtrevc)(const char* side, const char* howmny,
+                        const ARlogical *select, const ARint *n,
+                        const double *t, const ARint *ldt, double *vl,
+                        const ARint *ldvl, double *vr, const ARint *ldvr,
+                        const ARint *mm, ARint *m, double *work, ARint *info);
+
 #ifdef ARCOMP_H
 
   // Single precision complex routines.
@@ -157,6 +251,28 @@ extern "C"
                        const ARint *lda, const ARint *ipiv,
                        arcomplex<float>* b, const ARint *ldb, ARint *info);
 
+  void F77NAME(cgees)(const char* jobvs, const char* sort,
+                       const void *select, const ARint *n, arcomplex<float> *a,
+                       const ARint *lda, ARint *sdim, arcomplex<float> *w,
+                       arcomplex<float> *vs, const ARint *ldvs,
+                       arcomplex<float> *work, const ARint *lwork, float *rwork,
+                       ARlogical *bwork, ARint *info);
+
+  void F77NAME(ctrsen)(const char* job, const char* compq,
+                        const ARlogical *select, const ARint *n,
+                        arcomplex<float> *t, const ARint *ldt,
+                        arcomplex<float> *q, const ARint *ldq,
+                        arcomplex<float> *w, ARint *m, float *s, float *sep,
+                        arcomplex<float> *work, const ARint *lwork, ARint *info);
+
+  void F77NAME(ctrevc)(const char* side, const char* howmny,
+                        const ARlogical *select, const ARint *n,
+                        arcomplex<float> *t, const ARint *ldt,
+                        arcomplex<float> *vl, const ARint *ldvl,
+                        arcomplex<float> *vr, const ARint *ldvr,
+                        const ARint *mm, ARint *m, arcomplex<float> *work,
+                        float *rwork, ARint *info);
+
   // Double precision complex routines.
 
   void F77NAME(zlacpy)(const char* uplo, const ARint *m, const ARint *n,
@@ -194,6 +310,28 @@ extern "C"
                        const ARint *lda, const ARint *ipiv,
                        arcomplex<double>* b, const ARint *ldb, ARint *info);
 
+  void F77NAME(zgees)(const char* jobvs, const char* sort,
+                       const void *select, const ARint *n, arcomplex<double> *a,
+                       const ARint *lda, ARint *sdim, arcomplex<double> *w,
+                       arcomplex<double> *vs, const ARint *ldvs,
+                       arcomplex<double> *work, const ARint *lwork, double *rwork,
+                       ARlogical *bwork, ARint *info);
+
+  void F77NAME(ztrsen)(const char* job, const char* compq,
+                        const ARlogical *select, const ARint *n,
+                        arcomplex<double> *t, const ARint *ldt,
+                        arcomplex<double> *q, const ARint *ldq,
+                        arcomplex<double> *w, ARint *m, double *s, double *sep,
+                        arcomplex<double> *work, const ARint *lwork, ARint *info);
+
+  void F77NAME(ztrevc)(const char* side, const char* howmny,
+                        const ARlogical *select, const ARint *n,
+                        arcomplex<double> *t, const ARint *ldt,
+                        arcomplex<double> *vl, const ARint *ldvl,
+                        arcomplex<double> *vr, const ARint *ldvr,
+                        const ARint *mm, ARint *m, arcomplex<double> *work,
+                        double *rwork, ARint *info);
+
 #endif // ARCOMP_H
 
   void F77NAME(second)(const float *T);
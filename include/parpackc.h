@@ -0,0 +1,213 @@
+/*
+   ARPACK++ v1.2 2/20/2000
+   c++ interface to ARPACK code.
+
+   MODULE parpackc.h.
+   Interface to PARPACK subroutines pdsaupd, pssaupd, pdseupd, psseupd,
+   pdnaupd, psnaupd, pdneupd and psneupd.
+
+   These functions take the same parameters as saupp, seupp, naupp and
+   neupp (see saupp.h, seupp.h, naupp.h and neupp.h), preceded by the
+   MPI communicator shared by all processes. Each process passes only
+   the rows it stores: n is the local number of rows (ldv and ldz must
+   be set to n), and resid, V, workd and Z hold local slices of the
+   corresponding distributed arrays. All the other parameters must have
+   the same value in all processes. The restriction nev < ncv <= n
+   applies to the dimension of the whole problem, not to the local n.
+
+   ARPACK Authors
+      Richard Lehoucq
+      Kristyn Maschhoff
+      Danny Sorensen
+      Chao Yang
+      Dept. of Computational & Applied Mathematics
+      Rice University
+      Houston, Texas
+*/
+
+#ifndef PARPACKC_H
+#define PARPACKC_H
+
+#include <cstddef>
+#include <string>
+#include <mpi.h>
+#include "arch.h"
+#include "parpackf.h"
+
+
+// Symmetric problems (compare with saupp and seupp).
+
+inline void psaupp(MPI_Comm comm, ARint& ido, char bmat, ARint n,
+                   const std::string& which, ARint nev, double& tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint fcomm = MPI_Comm_c2f(comm);
+
+  F77NAME(pdsaupd)(&fcomm, &ido, &bmat, &n, which.c_str(), &nev, &tol,
+                   resid, &ncv, &V[1], &ldv, &iparam[1], &ipntr[1],
+                   &workd[1], &workl[1], &lworkl, &info);
+
+} // psaupp (double).
+
+inline void psaupp(MPI_Comm comm, ARint& ido, char bmat, ARint n,
+                   const std::string& which, ARint nev, float& tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint fcomm = MPI_Comm_c2f(comm);
+
+  F77NAME(pssaupd)(&fcomm, &ido, &bmat, &n, which.c_str(), &nev, &tol,
+                   resid, &ncv, &V[1], &ldv, &iparam[1], &ipntr[1],
+                   &workd[1], &workl[1], &lworkl, &info);
+
+} // psaupp (float).
+
+inline void pseupp(MPI_Comm comm, bool rvec, char HowMny, double d[],
+                   double Z[], ARint ldz, double sigma, char bmat, ARint n,
+                   const std::string& which, ARint nev, double tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint   fcomm;
+  ARint      irvec;
+  ARlogical* iselect;
+  double*    iZ;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(pdseupd)(&fcomm, &irvec, &HowMny, iselect, d, iZ, &ldz, &sigma,
+                   &bmat, &n, which.c_str(), &nev, &tol, resid, &ncv, &V[1],
+                   &ldv, &iparam[1], &ipntr[1], &workd[1], &workl[1],
+                   &lworkl, &info);
+
+  delete[] iselect;
+
+} // pseupp (double).
+
+inline void pseupp(MPI_Comm comm, bool rvec, char HowMny, float d[],
+                   float Z[], ARint ldz, float sigma, char bmat, ARint n,
+                   const std::string& which, ARint nev, float tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint   fcomm;
+  ARint      irvec;
+  ARlogical* iselect;
+  float*     iZ;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(psseupd)(&fcomm, &irvec, &HowMny, iselect, d, iZ, &ldz, &sigma,
+                   &bmat, &n, which.c_str(), &nev, &tol, resid, &ncv, &V[1],
+                   &ldv, &iparam[1], &ipntr[1], &workd[1], &workl[1],
+                   &lworkl, &info);
+
+  delete[] iselect;
+
+} // pseupp (float).
+
+
+// Nonsymmetric problems (compare with naupp and neupp).
+
+inline void pnaupp(MPI_Comm comm, ARint& ido, char bmat, ARint n,
+                   const std::string& which, ARint nev, double& tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint fcomm = MPI_Comm_c2f(comm);
+
+  F77NAME(pdnaupd)(&fcomm, &ido, &bmat, &n, which.c_str(), &nev, &tol,
+                   resid, &ncv, &V[1], &ldv, &iparam[1], &ipntr[1],
+                   &workd[1], &workl[1], &lworkl, &info);
+
+} // pnaupp (double).
+
+inline void pnaupp(MPI_Comm comm, ARint& ido, char bmat, ARint n,
+                   const std::string& which, ARint nev, float& tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint fcomm = MPI_Comm_c2f(comm);
+
+  F77NAME(psnaupd)(&fcomm, &ido, &bmat, &n, which.c_str(), &nev, &tol,
+                   resid, &ncv, &V[1], &ldv, &iparam[1], &ipntr[1],
+                   &workd[1], &workl[1], &lworkl, &info);
+
+} // pnaupp (float).
+
+inline void pneupp(MPI_Comm comm, bool rvec, char HowMny, double dr[],
+                   double di[], double Z[], ARint ldz, double sigmar,
+                   double sigmai, double workv[], char bmat, ARint n,
+                   const std::string& which, ARint nev, double tol,
+                   double resid[], ARint ncv, double V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], double workd[],
+                   double workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint   fcomm;
+  ARint      irvec;
+  ARlogical* iselect;
+  double*    iZ;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(pdneupd)(&fcomm, &irvec, &HowMny, iselect, dr, di, iZ, &ldz,
+                   &sigmar, &sigmai, &workv[1], &bmat, &n, which.c_str(),
+                   &nev, &tol, resid, &ncv, &V[1], &ldv, &iparam[1],
+                   &ipntr[1], &workd[1], &workl[1], &lworkl, &info);
+
+  delete[] iselect;
+
+} // pneupp (double).
+
+inline void pneupp(MPI_Comm comm, bool rvec, char HowMny, float dr[],
+                   float di[], float Z[], ARint ldz, float sigmar,
+                   float sigmai, float workv[], char bmat, ARint n,
+                   const std::string& which, ARint nev, float tol,
+                   float resid[], ARint ncv, float V[], ARint ldv,
+                   ARint iparam[], ARint ipntr[], float workd[],
+                   float workl[], ARint lworkl, ARint& info)
+{
+
+  MPI_Fint   fcomm;
+  ARint      irvec;
+  ARlogical* iselect;
+  float*     iZ;
+
+  fcomm   = MPI_Comm_c2f(comm);
+  irvec   = (ARint) rvec;
+  iselect = new ARlogical[ncv];
+  iZ = (Z == NULL) ? &V[1] : Z;
+
+  F77NAME(psneupd)(&fcomm, &irvec, &HowMny, iselect, dr, di, iZ, &ldz,
+                   &sigmar, &sigmai, &workv[1], &bmat, &n, which.c_str(),
+                   &nev, &tol, resid, &ncv, &V[1], &ldv, &iparam[1],
+                   &ipntr[1], &workd[1], &workl[1], &lworkl, &info);
+
+  delete[] iselect;
+
+} // pneupp (float).
+
+#endif // PARPACKC_H
@@ -57,6 +57,203 @@ inline void gstrf(superlu_options_t *options, SuperMatrix *A,
 } // gstrf.
 
 
+// ARluGlobalLU.
+// GlobalLU_t structure of any of the four precisions.
+
+union ARluGlobalLU {
+  sGlobalLU_t s;
+  dGlobalLU_t d;
+  cGlobalLU_t c;
+  zGlobalLU_t z;
+};
+
+
+// gstrf (with a given GlobalLU_t).
+// Same as gstrf above, but the GlobalLU_t structure is kept by the
+// caller, as gstrf needs the one of the previous factorization when
+// options->Fact = SamePattern_SameRowPerm.
+
+inline void gstrf(superlu_options_t *options, SuperMatrix *A,
+        int relax, int panel_size, int *etree, void *work, int lwork,
+        int *perm_c, int *perm_r, SuperMatrix *L, SuperMatrix *U,
+        ARluGlobalLU *Glu, SuperLUStat_t *stat, int *info)
+{
+
+  if (A->Dtype == SLU_D) {
+    dgstrf(options,A,relax,
+           panel_size,etree,work,lwork,perm_c,perm_r,L,U,&Glu->d,stat,info);
+  }
+  else if (A->Dtype == SLU_S) {
+    sgstrf(options,A,relax,
+           panel_size,etree,work,lwork,perm_c,perm_r,L,U,&Glu->s,stat,info);
+  }
+  else if (A->Dtype == SLU_Z) {
+#ifdef ARCOMP_H
+    zgstrf(options,A,relax,
+           panel_size,etree,work,lwork,perm_c,perm_r,L,U,&Glu->z,stat,info);
+#endif
+  }
+  else {
+#ifdef ARCOMP_H
+    cgstrf(options,A,relax,
+           panel_size,etree,work,lwork,perm_c,perm_r,L,U,&Glu->c,stat,info);
+#endif
+  }
+
+} // gstrf (with a given GlobalLU_t).
+
+
+// ARluRefactor.
+// Factors a sequence of matrices with the same pattern (A - sigma*I or
+// A - sigma*B for several shifts). The first matrix is factored from
+// scratch. The following ones reuse its column ordering, elimination
+// tree and row permutation (options->Fact = SamePattern_SameRowPerm),
+// so get_perm_c and the etree computation are skipped and gstrf
+// overwrites the L and U arrays of the previous factorization. SuperLU
+// still changes a pivot when the old one is too small for the new
+// values (see options->DiagPivotThresh).
+// Two matrices are taken to have the same pattern if they have the
+// same dimension, number of nonzeros and data type, so Clear must be
+// called whenever the pattern changes in another way.
+
+class ARluRefactor {
+
+ protected:
+
+  ARluGlobalLU Glu;
+  int*         etree;
+  int          n;
+  int          nnz;
+  Dtype_t      dtype;
+
+ public:
+
+  bool SamePattern(SuperMatrix* A)
+  {
+    return etree && (A->ncol == n) && (A->Dtype == dtype) &&
+           (((NCformat*)A->Store)->nnz == nnz);
+  }
+  // Tells if A has the pattern of the last matrix factored.
+
+  void Clear()
+  {
+    delete[] etree;
+    etree = NULL;
+    n     = 0;
+    nnz   = -1;
+  }
+  // Forgets the last factorization, so the next one starts from scratch.
+
+  int Factor(superlu_options_t* options, SuperMatrix* A, int order,
+             int* perm_c, int* perm_r, SuperMatrix* L, SuperMatrix* U,
+             SuperLUStat_t* stat, bool factored);
+  // Factors A (in NC format) and returns the gstrf info parameter.
+  // factored tells if L, U and stat hold a previous factorization,
+  // which is reused if A has the same pattern and freed otherwise.
+  // If info is not zero, L, U and stat are freed.
+
+  ARluRefactor(): etree(NULL), n(0), nnz(-1) { }
+  ARluRefactor(const ARluRefactor&): etree(NULL), n(0), nnz(-1) { }
+  ARluRefactor& operator=(const ARluRefactor&) { Clear(); return *this; }
+  ~ARluRefactor() { delete[] etree; }
+
+}; // class ARluRefactor.
+
+
+inline int ARluRefactor::
+Factor(superlu_options_t* options, SuperMatrix* A, int order,
+       int* perm_c, int* perm_r, SuperMatrix* L, SuperMatrix* U,
+       SuperLUStat_t* stat, bool factored)
+{
+
+  int         info;
+  SuperMatrix AC;
+
+  bool same = factored && SamePattern(A);
+
+  // Deleting previous versions of L and U if they cannot be reused.
+
+  if (factored && !same) {
+    Destroy_SuperNode_Matrix(L);
+    Destroy_CompCol_Matrix(U);
+    StatFree(stat);
+  }
+
+  if (!same) {
+
+    Clear();
+
+    // Defining LUStat and the column permutation of A
+    // (using minimum degree ordering).
+
+    StatInit(stat);
+    get_perm_c(order, A, perm_c);
+    etree = new int[A->ncol];
+    options->Fact = DOFACT;
+
+  }
+  else {
+    options->Fact = SamePattern_SameRowPerm;
+  }
+
+  // Permuting columns of A and creating the elimination tree (this
+  // last step is skipped by sp_preorder if the pattern is the same).
+
+  sp_preorder(options, A, perm_c, etree, &AC);
+
+  // Decomposing A.
+
+  gstrf(options, &AC, sp_ienv(2), sp_ienv(1), etree, NULL, 0,
+        perm_c, perm_r, L, U, &Glu, stat, &info);
+
+  Destroy_CompCol_Permuted(&AC);
+
+  if (info == 0) {
+    n     = A->ncol;
+    nnz   = ((NCformat*)A->Store)->nnz;
+    dtype = A->Dtype;
+  }
+  else {
+    if ((info > 0) && (info <= A->ncol)) {  // L and U were built.
+      Destroy_SuperNode_Matrix(L);
+      Destroy_CompCol_Matrix(U);
+    }
+    StatFree(stat);
+    Clear();
+  }
+
+  return info;
+
+} // ARluRefactor::Factor.
+
+
+// ARluLocalStat.
+// gstrs only reads L and U, but updates the SuperLUStat_t it is given.
+// Solves made by several threads with the same factorization use the
+// statistics of their own thread, returned by ARluLocalStat.
+
+struct ARluThreadStat {
+
+  SuperLUStat_t stat;
+
+  ARluThreadStat() { StatInit(&stat); }
+  ~ARluThreadStat() { StatFree(&stat); }
+
+  ARluThreadStat(const ARluThreadStat&) = delete;
+  ARluThreadStat& operator=(const ARluThreadStat&) = delete;
+
+}; // struct ARluThreadStat.
+
+
+inline SuperLUStat_t* ARluLocalStat()
+{
+
+  static thread_local ARluThreadStat local;
+  return &local.stat;
+
+} // ARluLocalStat.
+
+
 inline void gstrs(trans_t trans, SuperMatrix *L, SuperMatrix *U,
 	          int *perm_c, int *perm_r, SuperMatrix *B, SuperLUStat_t* stat, int *info)
 {
@@ -162,4 +359,62 @@ inline void Create_Dense_Matrix(SuperMatrix* A, int m, int n, arcomplex<float>*
 
 #endif // ARCOMP_H.
 
+
+// Define_Dense_Matrix.
+// Same as Create_Dense_Matrix, but the DNformat structure is given by
+// the caller, so no memory is allocated and Destroy_SuperMatrix_Store
+// must not be called. Used by the solve functions, which are called
+// at every iteration.
+
+inline void Define_Dense_Matrix(SuperMatrix* A, DNformat* store, int m,
+                                int n, void* x, int ldx, Dtype_t D)
+{
+
+  store->lda   = ldx;
+  store->nzval = x;
+  A->Stype     = SLU_DN;
+  A->Dtype     = D;
+  A->Mtype     = SLU_GE;
+  A->nrow      = m;
+  A->ncol      = n;
+  A->Store     = store;
+
+} // Define_Dense_Matrix.
+
+inline void Define_Dense_Matrix(SuperMatrix* A, DNformat* store, int m,
+                                int n, double* x, int ldx)
+{
+
+  Define_Dense_Matrix(A,store,m,n,(void*)x,ldx,SLU_D);
+
+} // Define_Dense_Matrix (double).
+
+inline void Define_Dense_Matrix(SuperMatrix* A, DNformat* store, int m,
+                                int n, float* x, int ldx)
+{
+
+  Define_Dense_Matrix(A,store,m,n,(void*)x,ldx,SLU_S);
+
+} // Define_Dense_Matrix (float).
+
+#ifdef ARCOMP_H
+
+inline void Define_Dense_Matrix(SuperMatrix* A, DNformat* store, int m,
+                                int n, arcomplex<double>* x, int ldx)
+{
+
+  Define_Dense_Matrix(A,store,m,n,(void*)x,ldx,SLU_Z);
+
+} // Define_Dense_Matrix (complex<double>).
+
+inline void Define_Dense_Matrix(SuperMatrix* A, DNformat* store, int m,
+                                int n, arcomplex<float>* x, int ldx)
+{
+
+  Define_Dense_Matrix(A,store,m,n,(void*)x,ldx,SLU_C);
+
+} // Define_Dense_Matrix (complex<float>).
+
+#endif // ARCOMP_H.
+
 #endif // SUPERLUC_H
@@ -3,7 +3,11 @@
    c++ interface to ARPACK code.
 
    MODULE UMFPACKc.h.
-   Interface to UMFPACK routines.
+   Interface to UMFPACK routines. The int32_t overloads call the
+   umfpack_di/zi routines, the int64_t ones umfpack_dl/zl. Symbolic
+   and Numeric objects are freed with the variant selected by ARindex
+   (see arch.h). UmfpackSymbolic keeps the symbolic analysis of a
+   matrix between factorizations with different shifts.
 
    Author of this class:
       Martin Reuter
@@ -24,8 +28,12 @@
 #ifndef UMFPACKC_H
 #define UMFPACKC_H
 
+#include <cstddef>
+#include <memory>
 #include "arcomp.h"
+#include "arch.h"
 #include "arerror.h"
+#include "arwork.h"
 #include <umfpack.h>
 
 /* umfpack_defaults */
@@ -60,6 +68,19 @@ inline int umfpack_triplet_to_col(int32_t n_row, int32_t n_col, int32_t nz,
         (double*)(&Tx[0]), nullptr, Ap, Ai, (double*)(&Ax[0]), nullptr, nullptr);
 }
 
+inline int umfpack_triplet_to_col(int64_t n_row, int64_t n_col, int64_t nz,
+    const int64_t Ti[], const int64_t Tj[], const double Tx[], int64_t Ap[], int64_t Ai[], double Ax[])
+{
+    return umfpack_dl_triplet_to_col(n_row, n_col, nz, Ti, Tj, Tx, Ap, Ai, Ax, nullptr);
+}
+
+inline int umfpack_triplet_to_col(int64_t n_row, int64_t n_col, int64_t nz,
+    const int64_t Ti[], const int64_t Tj[], const arcomplex<double> Tx[], int64_t Ap[], int64_t Ai[], arcomplex<double> Ax[])
+{
+    return umfpack_zl_triplet_to_col(n_row, n_col, nz, Ti, Tj,
+        (double*)(&Tx[0]), nullptr, Ap, Ai, (double*)(&Ax[0]), nullptr, nullptr);
+}
+
 /* umfpack_symbolic */
 
 inline int umfpack_symbolic(int32_t n_row, int32_t n_col, int32_t Ap[], int32_t Ai[], double Ax[],
@@ -74,6 +95,18 @@ inline int umfpack_symbolic(int32_t n_row, int32_t n_col, int32_t Ap[], int32_t
     return umfpack_zi_symbolic(n_row, n_col, Ap, Ai, (double*)(&Ax[0]), nullptr, Symbolic, Control, Info);
 }
 
+inline int umfpack_symbolic(int64_t n_row, int64_t n_col, int64_t Ap[], int64_t Ai[], double Ax[],
+    void** Symbolic, const double* Control, double* Info)
+{
+    return umfpack_dl_symbolic(n_row, n_col, Ap, Ai, Ax, Symbolic, Control, Info);
+}
+
+inline int umfpack_symbolic(int64_t n_row, int64_t n_col, int64_t Ap[], int64_t Ai[], arcomplex<double> Ax[],
+    void** Symbolic, const double* Control, double* Info)
+{
+    return umfpack_zl_symbolic(n_row, n_col, Ap, Ai, (double*)(&Ax[0]), nullptr, Symbolic, Control, Info);
+}
+
 /* umfpack_numeric */
 
 inline int umfpack_numeric(int32_t Ap[], int32_t Ai[], double Ax[],
@@ -88,6 +121,18 @@ inline int umfpack_numeric(int32_t Ap[], int32_t Ai[], arcomplex<double> Ax[],
     return umfpack_zi_numeric(Ap, Ai, (double*)(&Ax[0]), nullptr, Symbolic, Numeric, Control, Info);
 }
 
+inline int umfpack_numeric(int64_t Ap[], int64_t Ai[], double Ax[],
+    void* Symbolic, void** Numeric, const double* Control, double* Info)
+{
+    return umfpack_dl_numeric(Ap, Ai, Ax, Symbolic, Numeric, Control, Info);
+}
+
+inline int umfpack_numeric(int64_t Ap[], int64_t Ai[], arcomplex<double> Ax[],
+    void* Symbolic, void** Numeric, const double* Control, double* Info)
+{
+    return umfpack_zl_numeric(Ap, Ai, (double*)(&Ax[0]), nullptr, Symbolic, Numeric, Control, Info);
+}
+
 /* umfpack_solve */
 
 inline int umfpack_solve(int sys, int32_t Ap[], int32_t Ai[], double Ax[],
@@ -102,6 +147,60 @@ inline int umfpack_solve(int sys, int32_t Ap[], int32_t Ai[], arcomplex<double>
     return umfpack_zi_solve(sys, Ap, Ai, (double*)(&Ax[0]), nullptr, (double*)(&X[0]), nullptr, (double*)(&B[0]), nullptr, Numeric, Control, Info);
 }
 
+inline int umfpack_solve(int sys, int64_t Ap[], int64_t Ai[], double Ax[],
+    double* X, double* B, void* Numeric, const double* Control, double* Info)
+{
+    return umfpack_dl_solve(sys, Ap, Ai, Ax, X, B, Numeric, Control, Info);
+}
+
+inline int umfpack_solve(int sys, int64_t Ap[], int64_t Ai[], arcomplex<double> Ax[],
+    arcomplex<double>* X, arcomplex<double>* B, void* Numeric, const double* Control, double* Info)
+{
+    return umfpack_zl_solve(sys, Ap, Ai, (double*)(&Ax[0]), nullptr, (double*)(&X[0]), nullptr, (double*)(&B[0]), nullptr, Numeric, Control, Info);
+}
+
+/* umfpack_wsolve */
+
+/* Same as umfpack_solve, but the work arrays Wi (n entries) and W
+   (umfpack_wsize<T>(n) entries) are given by the caller, so repeated
+   solves do not allocate memory. */
+
+inline int umfpack_wsolve(int sys, int32_t Ap[], int32_t Ai[], double Ax[],
+    double* X, double* B, void* Numeric, const double* Control, double* Info,
+    int32_t* Wi, double* W)
+{
+    return umfpack_di_wsolve(sys, Ap, Ai, Ax, X, B, Numeric, Control, Info, Wi, W);
+}
+
+inline int umfpack_wsolve(int sys, int32_t Ap[], int32_t Ai[], arcomplex<double> Ax[],
+    arcomplex<double>* X, arcomplex<double>* B, void* Numeric, const double* Control, double* Info,
+    int32_t* Wi, double* W)
+{
+    return umfpack_zi_wsolve(sys, Ap, Ai, (double*)(&Ax[0]), nullptr, (double*)(&X[0]), nullptr, (double*)(&B[0]), nullptr, Numeric, Control, Info, Wi, W);
+}
+
+inline int umfpack_wsolve(int sys, int64_t Ap[], int64_t Ai[], double Ax[],
+    double* X, double* B, void* Numeric, const double* Control, double* Info,
+    int64_t* Wi, double* W)
+{
+    return umfpack_dl_wsolve(sys, Ap, Ai, Ax, X, B, Numeric, Control, Info, Wi, W);
+}
+
+inline int umfpack_wsolve(int sys, int64_t Ap[], int64_t Ai[], arcomplex<double> Ax[],
+    arcomplex<double>* X, arcomplex<double>* B, void* Numeric, const double* Control, double* Info,
+    int64_t* Wi, double* W)
+{
+    return umfpack_zl_wsolve(sys, Ap, Ai, (double*)(&Ax[0]), nullptr, (double*)(&X[0]), nullptr, (double*)(&B[0]), nullptr, Numeric, Control, Info, Wi, W);
+}
+
+/* umfpack_wsize */
+
+/* Size of the W array of umfpack_wsolve (with iterative refinement). */
+
+template <typename T> inline size_t umfpack_wsize(int n) { return 5*(size_t)n; }
+
+template <> inline size_t umfpack_wsize<arcomplex<double> >(int n) { return 10*(size_t)n; }
+
 /* umfpack_free_symbolic */
 
 template <typename T> inline void umfpack_free_symbolic(void** Symbolic)
@@ -111,12 +210,20 @@ template <typename T> inline void umfpack_free_symbolic(void** Symbolic)
 
 template <> inline void umfpack_free_symbolic<double>(void** Symbolic)
 {
+#ifdef ARPACKPP_INDEX64
+    umfpack_dl_free_symbolic(Symbolic);
+#else
     umfpack_di_free_symbolic(Symbolic);
+#endif
 }
 
 template <> inline void umfpack_free_symbolic<arcomplex<double>>(void** Symbolic)
 {
+#ifdef ARPACKPP_INDEX64
+    umfpack_zl_free_symbolic(Symbolic);
+#else
     umfpack_zi_free_symbolic(Symbolic);
+#endif
 }
 
 /* umfpack_free_numeric */
@@ -128,12 +235,96 @@ template <typename T> inline void umfpack_free_numeric(void** Numeric)
 
 template <> inline void umfpack_free_numeric<double>(void** Numeric)
 {
+#ifdef ARPACKPP_INDEX64
+    umfpack_dl_free_numeric(Numeric);
+#else
     umfpack_di_free_numeric(Numeric);
+#endif
 }
 
 template <> inline void umfpack_free_numeric<arcomplex<double>>(void** Numeric)
 {
+#ifdef ARPACKPP_INDEX64
+    umfpack_zl_free_numeric(Numeric);
+#else
     umfpack_zi_free_numeric(Numeric);
+#endif
+}
+
+/* UmfpackShareNumeric */
+
+/* Wraps a Numeric object in a std::shared_ptr, so the copies of a
+   factored matrix can share it. It is freed with the last owner. */
+
+template <typename T> inline std::shared_ptr<void> UmfpackShareNumeric(void* Numeric)
+{
+    return std::shared_ptr<void>(Numeric, [](void* p) { if (p) umfpack_free_numeric<T>(&p); });
 }
 
+/* UmfpackThreadWork */
+
+/* umfpack_wsolve only reads Numeric, but writes W, Wi and Info. Solves
+   with a Numeric object shared by several threads use the ones of the
+   calling thread, returned by UmfpackLocalWork. */
+
+struct UmfpackThreadWork {
+
+    ARWorkspace<ARindex> Wi;
+    ARWorkspace<double>  W;
+    double               Info[UMFPACK_INFO];
+};
+
+inline UmfpackThreadWork& UmfpackLocalWork()
+{
+    static thread_local UmfpackThreadWork work;
+    return work;
+}
+
+/* UmfpackSymbolic */
+
+/* Symbolic analysis kept between numeric factorizations of matrices
+   with the same pattern (A - sigma*I or A - sigma*B for a sequence of
+   shifts). Factor runs umfpack_symbolic only when the matrix differs
+   from the one analyzed last (another object or another number of
+   nonzeros), then umfpack_numeric, freeing the previous Numeric.
+   Free must be called whenever the pattern of a matrix changes in
+   place. Copies start empty. */
+
+template <typename T> struct UmfpackSymbolic {
+
+    void*       Symbolic;
+    const void* key;
+    ARindex     nnz;
+
+    void Free()
+    {
+        if (Symbolic) umfpack_free_symbolic<T>(&Symbolic);
+        Symbolic = nullptr;
+        key      = nullptr;
+        nnz      = 0;
+    }
+
+    template <typename I>
+    int Factor(const void* keyp, I n_row, I n_col, I Ap[], I Ai[], T Ax[],
+        void** Numeric, const double* Control, double* Info)
+    {
+        int status;
+        if (Symbolic && ((keyp != key) || ((ARindex)Ap[n_col] != nnz))) Free();
+        if (!Symbolic) {
+            status = umfpack_symbolic(n_row, n_col, Ap, Ai, Ax, &Symbolic, Control, Info);
+            if (status != UMFPACK_OK) { Free(); return status; }
+            key = keyp;
+            nnz = (ARindex)Ap[n_col];
+        }
+        if (*Numeric) umfpack_free_numeric<T>(Numeric);
+        *Numeric = nullptr;
+        return umfpack_numeric(Ap, Ai, Ax, Symbolic, Numeric, Control, Info);
+    }
+
+    UmfpackSymbolic(): Symbolic(nullptr), key(nullptr), nnz(0) { }
+    UmfpackSymbolic(const UmfpackSymbolic&): Symbolic(nullptr), key(nullptr), nnz(0) { }
+    UmfpackSymbolic& operator=(const UmfpackSymbolic&) { Free(); return *this; }
+    ~UmfpackSymbolic() { Free(); }
+};
+
 #endif // UMFPACKC_H
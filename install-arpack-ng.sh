@@ -6,6 +6,7 @@ version="3.9.1"
 
 build_type="Release"
 shared_libs="OFF"
+mpi="OFF"
 cleanup=0
 
 # Install into local folder "external", unless the --global-install option is used.
@@ -21,6 +22,10 @@ while [[ "$#" -gt 0 ]]; do
       shared_libs="ON"
       shift 1
       ;;
+    -m|--mpi)
+      mpi="ON"
+      shift 1
+      ;;
     -c|--cleanup)
       cleanup=1
       shift 1
@@ -73,7 +78,7 @@ if [ ! -z "$install_prefix" ]; then
   install_prefix_INST="--prefix $install_prefix"
 fi
 
-cmake -B build -D TESTS=OFF -D CMAKE_BUILD_TYPE=$build_type -D BUILD_SHARED_LIBS=$shared_libs $install_prefix_CONF $local_BLAS
+cmake -B build -D TESTS=OFF -D CMAKE_BUILD_TYPE=$build_type -D BUILD_SHARED_LIBS=$shared_libs -D MPI=$mpi $install_prefix_CONF $local_BLAS
 cmake --build build --config $build_type --parallel
 cmake --install build $install_prefix_INST
 